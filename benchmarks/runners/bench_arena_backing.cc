@@ -0,0 +1,167 @@
+#include <chrono> // to measure time
+#include <new>
+#include <vector>
+#include <memory>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cassert>
+
+#include "ictk/all.hpp"
+#include "ictk/core/arena_plan.hpp"
+#include "ictk/core/arena_backing.hpp"
+#include "ictk/control/pid/pid.hpp"
+
+using namespace ictk;
+using namespace ictk::control::pid;
+
+/*
+n SISO PIDCore loops (objects + state) in one arena, one sweep = every loop once in a fixed shuffled order
+    usage: bench_arena_backing [n] [sweeps] [numa_node] [--no-header]
+    rows: heap (std::vector), pages (mmap + mlock + prefault), huge (MAP_HUGETLB, else THP) -> backing column says
+        what the host granted; the shuffled order spreads the sweep over many pages (TLB reach)
+*/
+
+struct Stats {
+    double p50, p95, p99, p999, jmin, jmax;
+};
+
+static Stats summarize(std::vector<double>& ns){
+    std::sort(ns.begin(), ns.end());
+    const std::size_t n = ns.size();
+    assert(n > 0);
+    auto q = [&](double p) -> double {
+        const double pos = p * static_cast<double>(n - 1u);
+        return ns[static_cast<std::size_t>(pos)];
+    };
+    return { q(0.50), q(0.95), q(0.99), q(0.999), ns.front(), ns.back() };
+}
+
+struct Loop{
+    PIDCore ctl{};
+    Scalar y{0.0}, r{1.0}, u{0.0};
+};
+
+static constexpr dt_ns kDt = 1'000'000;
+
+static const Scalar Kp = 1.0, Ki = 0.5, Kd = 0.1, tf = 0.01, umin = -1.0, umax = 1.0, du = 20.0;
+
+static PIDConfig config(){
+    PIDConfig c{};
+    c.Kp = {&Kp, 1}; c.Ki = {&Ki, 1}; c.Kd = {&Kd, 1}; c.tau_f = {&tf, 1};
+    c.umin = {&umin, 1}; c.umax = {&umax, 1}; c.du_max = {&du, 1};
+    return c;
+}
+
+// // build n loops in `a`, sweep them, fill ns (one entry per sweep)
+static int run(MemoryArena& a, std::size_t n, const std::vector<std::uint32_t>& order, int sweeps, std::vector<double>& ns){
+    const PIDConfig c = config();
+    std::vector<Loop*> loops(n);
+    for (std::size_t i = 0; i < n; ++i){
+        void* mem = a.allocate(sizeof(Loop), alignof(Loop), "bench.loop");
+        if (!mem) return 3;
+        loops[i] = new (mem) Loop{};
+        if (loops[i]->ctl.init(Dims{1, 1, 0}, kDt, a, {}) != Status::kOK) return 3;
+        if (loops[i]->ctl.configure(c) != Status::kOK) return 3;
+        if (loops[i]->ctl.start() != Status::kOK) return 3;
+    }
+
+    UpdateContext ctx{};
+    Result out{};
+    auto sweep = [&](t_ns t){
+        for (std::uint32_t i : order){
+            Loop& l = *loops[i];
+            ctx.plant.y = std::span<const Scalar>(&l.y, 1);
+            ctx.plant.t = t;
+            ctx.plant.valid_bits = 1ull;
+            ctx.sp.r = std::span<const Scalar>(&l.r, 1);
+            out.u = std::span<Scalar>(&l.u, 1);
+            (void)l.ctl.update(ctx, out);
+            l.y += Scalar(0.01) * (l.u - l.y);
+        }
+    };
+
+    for (int k = 0; k < 50; ++k) sweep(static_cast<t_ns>(k) * kDt);   // warmup
+
+    using clk = std::chrono::steady_clock;
+    ns.assign(static_cast<std::size_t>(sweeps), 0.0);
+    for (int k = 0; k < sweeps; ++k){
+        auto t0 = clk::now();
+        sweep(static_cast<t_ns>(k + 50) * kDt);
+        auto t1 = clk::now();
+        ns[static_cast<std::size_t>(k)] = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    }
+
+    for (Loop* l : loops) l->~Loop();
+    return 0;
+}
+
+int main(int argc, char** argv){
+    int n_i = 20000;
+    int sweeps = 2000;
+    int node = -1;
+
+    if (argc > 1) n_i = std::atoi(argv[1]);
+    if (argc > 2) sweeps = std::atoi(argv[2]);
+    if (argc > 3) node = std::atoi(argv[3]);
+
+    bool opt_no_header = false;
+    for (int i = 4; i < argc; ++i){
+        if (std::strcmp(argv[i], "--no-header") == 0) opt_no_header = true;
+    }
+    if (n_i <= 0 || sweeps <= 0) return 1;
+    const std::size_t n = static_cast<std::size_t>(n_i);
+
+    // // region size: loop objects + controller state, planned
+    const PIDConfig c = config();
+    ArenaPlan one = plan_controller<PIDCore>(Dims{1, 1, 0}, kDt, c);
+    if (one.status != Status::kOK) return 2;
+    one.bytes = detail::align_up(sizeof(Loop), one.align) + one.bytes;
+    one.align = std::max(one.align, alignof(Loop));
+    const std::size_t bytes = packed_bytes(one, n) + 4096;
+
+    std::vector<std::uint32_t> order(n);
+    for (std::size_t i = 0; i < n; ++i) order[i] = static_cast<std::uint32_t>(i);
+    std::mt19937 rng(12345);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    if (!opt_no_header){
+        std::puts("label, backing, n, sweeps, bytes, locked, numa, p50, p95, p99, p999, jmin, jmax, ns_per_loop");
+    }
+
+    auto report = [&](const char* label, const char* kind, bool locked, int numa, std::vector<double>& ns){
+        const Stats S = summarize(ns);
+        std::printf("%s, %s, %zu, %d, %zu, %d, %d, %.1f, %.1f, %.1f, %.1f, %.1f, %.1f, %.3f\n",
+            label, kind, n, sweeps, bytes, locked ? 1 : 0, numa,
+            S.p50, S.p95, S.p99, S.p999, S.jmin, S.jmax, S.p50 / static_cast<double>(n));
+    };
+
+    std::vector<double> ns;
+
+    // // plain heap
+    {
+        std::vector<std::byte> mem(bytes + 64);
+        void* base = mem.data();
+        std::size_t space = mem.size();
+        if (!std::align(64, bytes, base, space)) return 2;
+        MemoryArena a(base, bytes);
+        if (int rc = run(a, n, order, sweeps, ns); rc) return rc;
+        report("heap", "heap", false, -1, ns);
+    }
+
+    // // base pages, locked + prefaulted, then hugepages
+    for (bool huge : {false, true}){
+        ArenaBacking back;
+        BackingOptions o{};
+        o.bytes = bytes;
+        o.hugepages = huge;
+        o.numa_node = node;
+        if (back.acquire(o) != Status::kOK) return 4;
+        MemoryArena a = back.arena();
+        if (int rc = run(a, n, order, sweeps, ns); rc) return rc;
+        report(huge ? "huge" : "pages", to_string(back.info().kind), back.info().locked, back.info().numa_node, ns);
+    }
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <chrono> // to measure time
+#include <vector>
+#include <memory>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cassert>
+
+#include "ictk/all.hpp"
+#include "ictk/control/pid/pid.hpp"
+#include "ictk/runtime/cyclic_executor.hpp"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+using namespace ictk;
+using namespace ictk::control::pid;
+using namespace ictk::runtime;
+
+/*
+n SISO PIDCore loops at mixed rates (1 ms / 10 ms / 100 ms, round robin) on one CyclicExecutor
+    usage: bench_cyclic_executor [n] [frames] [--no-header]
+    stagger: phases from build(); flat: build(false), every loop released on frame 0 of its period
+    frames are run back to back with step() (no sleeping); reports per minor frame latency percentiles
+        -> jmax is the worst tick the executor has to fit in 1 ms
+*/
+
+static void pin_thread_best_effort(){
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(0, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), 1);
+#endif
+}
+
+struct Stats {
+    double p50, p95, p99, p999, jmin, jmax;
+};
+
+static Stats summarize(std::vector<double>& ns){
+    std::sort(ns.begin(), ns.end());
+    const std::size_t n = ns.size();
+    assert(n > 0);
+    auto q = [&](double p) -> double {
+        const double pos = p * static_cast<double>(n - 1u);
+        return ns[static_cast<std::size_t>(pos)];
+    };
+    return { q(0.50), q(0.95), q(0.99), q(0.999), ns.front(), ns.back() };
+}
+
+// // one loop's controller + I/O (addresses must stay put -> held by unique_ptr)
+struct Loop{
+    PIDCore ctl{};
+    Scalar y{0.0}, r{1.0}, u{0.0};
+    UpdateContext ctx{};
+    Result out{};
+};
+
+static constexpr dt_ns kPeriods[3]{1'000'000, 10'000'000, 100'000'000};
+
+struct Setup{
+    std::vector<std::byte> mem;
+    std::unique_ptr<MemoryArena> arena;
+    std::vector<std::unique_ptr<Loop>> loops;
+    CyclicExecutor ex;
+};
+
+static int make(Setup& s, std::size_t n, bool stagger){
+    s.mem.assign(n * 2048 + 65536, std::byte{0});
+    s.arena = std::make_unique<MemoryArena>(s.mem.data(), s.mem.size());
+    MemoryArena* arena = s.arena.get();
+    if (s.ex.init(n, *arena) != Status::kOK) return 2;
+
+    static const Scalar Kp = 1.0, Ki = 0.5, Kd = 0.1, tf = 0.01, umin = -1.0, umax = 1.0;
+    const Dims d{ .ny=1, .nu=1, .nx=0 };
+    for (std::size_t i = 0; i < n; ++i){
+        auto l = std::make_unique<Loop>();
+        const dt_ns period = kPeriods[i % 3];
+
+        PIDConfig c{};
+        c.Kp = {&Kp, 1}; c.Ki = {&Ki, 1}; c.Kd = {&Kd, 1}; c.tau_f = {&tf, 1};
+        c.umin = {&umin, 1}; c.umax = {&umax, 1};
+        if (l->ctl.init(d, period, *arena, {}) != Status::kOK) return 3;
+        if (l->ctl.configure(c) != Status::kOK) return 3;
+        if (l->ctl.start() != Status::kOK) return 3;
+
+        l->ctx.plant.y = std::span<const Scalar>(&l->y, 1);
+        l->ctx.plant.valid_bits = 1ull;
+        l->ctx.sp.r = std::span<const Scalar>(&l->r, 1);
+        l->out.u = std::span<Scalar>(&l->u, 1);
+
+        CyclicTask t{};
+        t.ctl = &l->ctl;
+        t.period = period;
+        t.ctx = &l->ctx;
+        t.out = &l->out;
+        if (s.ex.add(t) != Status::kOK) return 4;
+        s.loops.push_back(std::move(l));
+    }
+    if (s.ex.build(stagger) != Status::kOK) return 5;
+    return 0;
+}
+
+int main(int argc, char** argv){
+    int n_i = 300;
+    int frames = 20000;
+
+    if (argc > 1) n_i = std::atoi(argv[1]);
+    if (argc > 2) frames = std::atoi(argv[2]);
+
+    bool opt_no_header = false;
+    for (int i = 3; i < argc; ++i){
+        if (std::strcmp(argv[i], "--no-header") == 0) opt_no_header = true;
+    }
+    if (n_i <= 0 || frames <= 0) return 1;
+    const std::size_t n = static_cast<std::size_t>(n_i);
+
+    pin_thread_best_effort();
+
+    Setup stag, flat;
+    if (int rc = make(stag, n, true)) return rc;
+    if (int rc = make(flat, n, false)) return rc;
+
+    using clk = std::chrono::steady_clock;
+    auto run_loop = [&](CyclicExecutor& ex){
+        // // warmup: one major cycle
+        for (std::uint32_t k = 0; k < ex.stats().frames; ++k) (void)ex.step();
+
+        std::vector<double> ns(static_cast<std::size_t>(frames));
+        for (int k = 0; k < frames; ++k){
+            auto t0 = clk::now();
+            (void)ex.step();
+            auto t1 = clk::now();
+            ns[static_cast<std::size_t>(k)] = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        }
+        return summarize(ns);
+    };
+
+    const Stats S_stag = run_loop(stag.ex);
+    const Stats S_flat = run_loop(flat.ex);
+
+    if (!opt_no_header){
+        std::puts("label, n, frames, p50, p95, p99, p999, jmin, jmax, max_frame_load");
+    }
+    auto report = [&](const Stats& S, const CyclicExecutor& ex, const char* label){
+        std::printf("%s, %zu, %d, %.1f, %.1f, %.1f, %.1f, %.1f, %.1f, %llu\n",
+            label, n, frames,
+            S.p50, S.p95, S.p99, S.p999, S.jmin, S.jmax,
+            static_cast<unsigned long long>(ex.stats().max_frame_load));
+    };
+    report(S_stag, stag.ex, "stagger");
+    report(S_flat, flat.ex, "flat");
+    return 0;
+}
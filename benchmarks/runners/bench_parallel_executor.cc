@@ -0,0 +1,143 @@
+#include <chrono> // to measure time
+#include <vector>
+#include <memory>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cassert>
+
+#include "ictk/all.hpp"
+#include "ictk/control/pid/pid.hpp"
+#include "ictk/runtime/parallel_executor.hpp"
+
+using namespace ictk;
+using namespace ictk::control::pid;
+using namespace ictk::runtime;
+
+/*
+n SISO PIDCore loops, one period, on a ParallelExecutor with 1..workers cores
+    usage: bench_parallel_executor [n] [ticks] [workers] [--no-header]
+    one row per worker count: tick latency percentiles, ns per loop, steals per tick, mean core utilization
+        (utilization against a 1 ms period)
+*/
+
+struct Stats {
+    double p50, p95, p99, p999, jmin, jmax;
+};
+
+static Stats summarize(std::vector<double>& ns){
+    std::sort(ns.begin(), ns.end());
+    const std::size_t n = ns.size();
+    assert(n > 0);
+    auto q = [&](double p) -> double {
+        const double pos = p * static_cast<double>(n - 1u);
+        return ns[static_cast<std::size_t>(pos)];
+    };
+    return { q(0.50), q(0.95), q(0.99), q(0.999), ns.front(), ns.back() };
+}
+
+struct Loop{
+    PIDCore ctl{};
+    Scalar y{0.0}, r{1.0}, u{0.0};
+    UpdateContext ctx{};
+    Result out{};
+};
+
+static constexpr dt_ns kDt = 1'000'000;
+
+int main(int argc, char** argv){
+    int n_i = 20000;
+    int ticks = 2000;
+    int max_workers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    if (argc > 1) n_i = std::atoi(argv[1]);
+    if (argc > 2) ticks = std::atoi(argv[2]);
+    if (argc > 3) max_workers = std::atoi(argv[3]);
+
+    bool opt_no_header = false;
+    for (int i = 4; i < argc; ++i){
+        if (std::strcmp(argv[i], "--no-header") == 0) opt_no_header = true;
+    }
+    if (n_i <= 0 || ticks <= 0 || max_workers <= 0 || max_workers > int(ParallelExecutor::kMaxWorkers)) return 1;
+    const std::size_t n = static_cast<std::size_t>(n_i);
+
+    if (!opt_no_header){
+        std::puts("label, n, workers, ticks, p50, p95, p99, p999, jmin, jmax, ns_per_loop, steals_per_tick, util");
+    }
+
+    static const Scalar Kp = 1.0, Ki = 0.5, Kd = 0.1, tf = 0.01, umin = -1.0, umax = 1.0;
+    for (int wi = 1; wi <= max_workers; wi *= 2){
+        const auto W = static_cast<std::size_t>(wi);
+
+        std::vector<std::vector<std::byte>> mem(W, std::vector<std::byte>(n * 1024 / W + 65536));
+        std::vector<std::unique_ptr<MemoryArena>> arenas;
+        std::vector<MemoryArena*> arena_ptrs;
+        for (auto& m : mem){
+            arenas.push_back(std::make_unique<MemoryArena>(m.data(), m.size()));
+            arena_ptrs.push_back(arenas.back().get());
+        }
+        std::vector<std::byte> tab(n * 128 + 65536);
+        MemoryArena tab_arena(tab.data(), tab.size());
+
+        ParallelOptions opts{};
+        opts.workers = W;
+        opts.first_cpu = 0;
+
+        ParallelExecutor ex;
+        if (ex.init(kDt, n, opts, tab_arena, arena_ptrs) != Status::kOK) return 2;
+
+        std::vector<std::unique_ptr<Loop>> loops;
+        const Dims d{ .ny=1, .nu=1, .nx=0 };
+        for (std::size_t i = 0; i < n; ++i){
+            auto l = std::make_unique<Loop>();
+            PIDConfig c{};
+            c.Kp = {&Kp, 1}; c.Ki = {&Ki, 1}; c.Kd = {&Kd, 1}; c.tau_f = {&tf, 1};
+            c.umin = {&umin, 1}; c.umax = {&umax, 1};
+            if (l->ctl.init(d, kDt, ex.arena_for(ex.next_id()), {}) != Status::kOK) return 3;
+            if (l->ctl.configure(c) != Status::kOK) return 3;
+            if (l->ctl.start() != Status::kOK) return 3;
+            l->ctx.plant.y = std::span<const Scalar>(&l->y, 1);
+            l->ctx.plant.valid_bits = 1ull;
+            l->ctx.sp.r = std::span<const Scalar>(&l->r, 1);
+            l->out.u = std::span<Scalar>(&l->u, 1);
+
+            CyclicTask t{};
+            t.ctl = &l->ctl;
+            t.ctx = &l->ctx;
+            t.out = &l->out;
+            if (ex.add(t) != Status::kOK) return 4;
+            loops.push_back(std::move(l));
+        }
+        if (ex.build() != Status::kOK) return 5;
+        if (ex.start() != Status::kOK) return 6;
+
+        for (int k = 0; k < 100; ++k) (void)ex.tick();   // warmup
+
+        using clk = std::chrono::steady_clock;
+        std::vector<double> ns(static_cast<std::size_t>(ticks));
+        for (int k = 0; k < ticks; ++k){
+            auto t0 = clk::now();
+            (void)ex.tick();
+            auto t1 = clk::now();
+            ns[static_cast<std::size_t>(k)] = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        }
+        if (ex.stop() != Status::kOK) return 7;
+
+        std::uint64_t steals = 0;
+        double util = 0.0;
+        for (std::size_t w = 0; w < W; ++w){
+            steals += ex.worker_stats(w).steals;
+            util += ex.worker_stats(w).utilization(kDt);
+        }
+        const double all_ticks = static_cast<double>(ticks + 100);
+
+        const Stats S = summarize(ns);
+        std::printf("parallel, %zu, %zu, %d, %.1f, %.1f, %.1f, %.1f, %.1f, %.1f, %.3f, %.2f, %.3f\n",
+            n, W, ticks, S.p50, S.p95, S.p99, S.p999, S.jmin, S.jmax,
+            S.p50 / static_cast<double>(n),
+            static_cast<double>(steals) / all_ticks,
+            util / static_cast<double>(W));
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <chrono> // to measure time
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cassert>
+
+#include "ictk/all.hpp"
+#include "ictk/control/pid/pid.hpp"
+#include "ictk/control/pid/pid_bank.hpp"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+using namespace ictk;
+using namespace ictk::control::pid;
+
+/*
+n SISO loops per tick: n x PIDCore::update (virtual, per loop safety objects) vs one PIDBank::update_all (SoA sweep)
+    usage: bench_pid_bank [n] [iters] [dt_ns] [--sat --rate --jerk --no-header]
+    reports per tick latency percentiles and ns per loop (p50 / n)
+*/
+
+static void pin_thread_best_effort(){
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(0, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), 1);
+#endif
+}
+
+struct Stats {
+    double p50, p95, p99, p999, jmin, jmax;
+};
+
+static Stats summarize(std::vector<double>& ns){
+    std::sort(ns.begin(), ns.end());
+    const std::size_t n = ns.size();
+    assert(n > 0);
+    auto q = [&](double p) -> double {
+        const double pos = p * static_cast<double>(n - 1u);
+        return ns[static_cast<std::size_t>(pos)];
+    };
+    return { q(0.50), q(0.95), q(0.99), q(0.999), ns.front(), ns.back() };
+}
+
+int main(int argc, char** argv){
+    int n_i = 4096;
+    int iters = 20000;
+    long long dt_arg_ns = 1'000'000; // 1 ms
+
+    if (argc > 1) n_i = std::atoi(argv[1]);
+    if (argc > 2) iters = std::atoi(argv[2]);
+    if (argc > 3) dt_arg_ns = std::strtoll(argv[3], nullptr, 10);
+
+    bool opt_sat=false, opt_rate=false, opt_jerk=false, opt_no_header=false;
+    for (int i = 4; i < argc; ++i){
+        if (std::strcmp(argv[i], "--sat") == 0)       opt_sat = true;
+        else if (std::strcmp(argv[i], "--rate") == 0) opt_rate = true;
+        else if (std::strcmp(argv[i], "--jerk") == 0) opt_jerk = true;
+        else if (std::strcmp(argv[i], "--no-header") == 0) opt_no_header = true;
+    }
+    if (n_i <= 0 || iters <= 0) return 1;
+
+    const std::size_t n = static_cast<std::size_t>(n_i);
+    const dt_ns dt = static_cast<dt_ns>(dt_arg_ns);
+
+    pin_thread_best_effort();
+
+    // per loop parameters (slightly different per loop so nothing folds)
+    std::vector<Scalar> Kp(n), Ki(n, 0.5), Kd(n, 0.1), tf(n, 0.01);
+    std::vector<Scalar> umin(n, -1.0), umax(n, 1.0), du(n, 5.0), ddu(n, 50.0);
+    for (std::size_t i=0; i<n; ++i) Kp[i] = 1.0 + 1e-3 * static_cast<Scalar>(i);
+
+    // // bank
+    std::vector<std::byte> bank_mem(n * 512 + 4096);
+    MemoryArena bank_arena(bank_mem.data(), bank_mem.size());
+    PIDBankConfig bc{};
+    bc.Kp = Kp; bc.Ki = Ki; bc.Kd = Kd; bc.tau_f = tf;
+    if (opt_sat){ bc.umin = umin; bc.umax = umax; }
+    if (opt_rate || opt_jerk) bc.du_max = du;
+    if (opt_jerk) bc.ddu_max = ddu;
+
+    PIDBank bank;
+    if (bank.init(n, dt, bank_arena) != Status::kOK) return 2;
+    if (bank.configure(bc) != Status::kOK) return 3;
+    if (bank.start() != Status::kOK) return 4;
+
+    // // n SISO cores
+    std::vector<std::byte> core_mem(n * 1024 + 4096);
+    MemoryArena core_arena(core_mem.data(), core_mem.size());
+    std::vector<PIDCore> cores(n);
+    const Dims d{ .ny=1, .nu=1, .nx=0 };
+    for (std::size_t i=0; i<n; ++i){
+        PIDConfig c{};
+        c.Kp = {&Kp[i], 1}; c.Ki = {&Ki[i], 1}; c.Kd = {&Kd[i], 1}; c.tau_f = {&tf[i], 1};
+        if (opt_sat){ c.umin = {&umin[i], 1}; c.umax = {&umax[i], 1}; }
+        if (opt_rate || opt_jerk) c.du_max = {&du[i], 1};
+        if (opt_jerk) c.ddu_max = {&ddu[i], 1};
+        if (cores[i].init(d, dt, core_arena, {}) != Status::kOK) return 2;
+        if (cores[i].configure(c) != Status::kOK) return 3;
+        if (cores[i].start() != Status::kOK) return 4;
+    }
+
+    std::vector<Scalar> y(n, 0.0), r(n, 1.0), u(n, 0.0);
+    t_ns t = 0;
+
+    auto tick_cores = [&]{
+        for (std::size_t i=0; i<n; ++i){
+            PlantState ps{ .y=std::span<const Scalar>(&y[i], 1), .xhat={}, .t=t, .valid_bits=1ull };
+            Setpoint sp{ .r=std::span<const Scalar>(&r[i], 1), .preview_horizon_len=0 };
+            Result res{ .u=std::span<Scalar>(&u[i], 1), .health={} };
+            (void)cores[i].update({ps, sp}, res);
+        }
+    };
+    auto tick_bank = [&]{
+        (void)bank.update_all(t, y, r, u);
+    };
+
+    // warmup
+    for (int k = 0; k < 1000; ++k){
+        t += dt;
+        tick_cores();
+        tick_bank();
+    }
+
+    using clk = std::chrono::steady_clock;
+    auto run_loop = [&](auto&& tick){
+        std::vector<double> ns(static_cast<std::size_t>(iters));
+        for (int k = 0; k < iters; ++k){
+            t += dt;
+            auto t0 = clk::now();
+            tick();
+            auto t1 = clk::now();
+            ns[static_cast<std::size_t>(k)] = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        }
+        return summarize(ns);
+    };
+
+    const Stats S_cores = run_loop(tick_cores);
+    const Stats S_bank = run_loop(tick_bank);
+
+    if (!opt_no_header){
+        std::puts("label, n, dt_ns, iters, p50, p95, p99, p999, jmin, jmax, ns_per_loop, sat, rate, jerk");
+    }
+    auto report = [&](const Stats& S, const char* label){
+        std::printf("%s, %zu, %lld, %d, %.1f, %.1f, %.1f, %.1f, %.1f, %.1f, %.3f, %d, %d, %d\n",
+            label, n, static_cast<long long>(dt), iters,
+            S.p50, S.p95, S.p99, S.p999, S.jmin, S.jmax,
+            S.p50 / static_cast<double>(n),
+            opt_sat ? 1 : 0, opt_rate ? 1 : 0, opt_jerk ? 1 : 0);
+    };
+    report(S_cores, "pidcore_x_n");
+    report(S_bank, "pid_bank");
+    return 0;
+}
@@ -7,9 +7,14 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <memory>
 
 #include "ictk/all.hpp"
+#include "ictk/core/arena_plan.hpp"
 #include "ictk/control/pid/pid.hpp"
+#include "ictk/control/pid/static_pid.hpp"
+#include "ictk/control/pid/pid_fixed.hpp"
+#include "ictk/safety/simd_kernels.hpp"
 
 // platform specific includes
 #if defined(_WIN32)
@@ -83,6 +88,54 @@ static Stats summarize(std::vector<double>& ns){
     };
 }
 
+constexpr int BATCH = 64; // amortize timer cost
+
+/*
+same config on a concrete (non virtual) PID type, reported next to the virtual PIDCore rows:
+    --static: StaticPIDCore<stages from --sat/--rate/--jerk> (whole tick inlined) -> pid_static / net_static
+    --fixed:  FixedPIDCore<nu> for nu in {1, 4, 16, 64} (std::array state, compile-time bounds) -> pid_fixed / net_fixed
+*/
+template <class C>
+static int bench_concrete(const Dims& d, dt_ns dt, const PIDConfig& c, PlantState ps, const Setpoint& sp, Result& res, int iters, Stats& out){
+    const ArenaPlan plan = plan_controller<C>(d, dt, c);
+    if (plan.status != Status::kOK) return 2;
+    std::vector<std::byte> storage(plan.bytes + plan.align);
+    void* base = storage.data();
+    std::size_t space = storage.size();
+    if (!std::align(plan.align, plan.bytes, base, space)) return 2;
+    MemoryArena arena(base, plan.bytes);
+
+    C pid;
+    if (pid.init(d, dt, arena) != Status::kOK) return 2;
+    if (pid.configure(c) != Status::kOK) return 3;
+    if (pid.start() != Status::kOK) return 4;
+
+    UpdateContext ctx;
+    for (int k = 0; k < 10000; ++k) {
+        ps.t += dt;
+        ctx.plant = ps;
+        ctx.sp = sp;
+        (void)pid.update(ctx, res);
+    }
+
+    using clk = std::chrono::steady_clock;
+    std::vector<double> ns(static_cast<std::size_t>(iters));
+    for (int k = 0; k < iters; ++k) {
+        auto t0 = clk::now();
+        for (int j = 0; j < BATCH; ++j){
+            ps.t += dt;
+            ctx.plant = ps;
+            ctx.sp = sp;
+            (void)pid.update(ctx, res);
+        }
+        auto t1 = clk::now();
+        ns[static_cast<std::size_t>(k)] =
+            std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(BATCH);
+    }
+    out = summarize(ns);
+    return 0;
+}
+
 int main(int argc, char** argv){
     // Defaults
     int nu_i = 1;
@@ -94,11 +147,23 @@ int main(int argc, char** argv){
     if (argc > 2) iters = std::atoi(argv[2]);
     if (argc > 3) dt_arg_ns = std::strtoll(argv[3], nullptr, 10);
 
-    bool opt_sat=false, opt_rate=false, opt_jerk=false, opt_no_header=false;
+    bool opt_sat=false, opt_rate=false, opt_jerk=false, opt_fused=false, opt_static=false, opt_fixed=false, opt_no_header=false;
     for (int i = 4; i < argc; ++i){
         if (std::strcmp(argv[i], "--sat") == 0)       opt_sat = true; 
         else if (std::strcmp(argv[i], "--rate") == 0) opt_rate = true;
         else if (std::strcmp(argv[i], "--jerk") == 0) opt_jerk = true;
+        else if (std::strcmp(argv[i], "--fused") == 0) opt_fused = true;
+        else if (std::strcmp(argv[i], "--static") == 0) opt_static = true;
+        else if (std::strcmp(argv[i], "--fixed") == 0) opt_fixed = true;
+        else if (std::strncmp(argv[i], "--isa=", 6) == 0){
+            // // pin the staged safety kernels: scalar | sse2 | avx2 | avx512
+            using safety::simd::Isa;
+            bool ok = false;
+            for (Isa isa : {Isa::kScalar, Isa::kSse2, Isa::kAvx2, Isa::kAvx512}){
+                if (std::strcmp(argv[i] + 6, safety::simd::isa_name(isa)) == 0) ok = safety::simd::select_isa(isa);
+            }
+            if (!ok) return 6;
+        }
         else if (std::strcmp(argv[i], "--no-header") == 0) opt_no_header = true;
     }
 
@@ -113,13 +178,6 @@ int main(int argc, char** argv){
         .nx = 0
     };
 
-            // 1 shift left by 20 buts 1 << 20 => 2^20 = 1,048,576 / 1024 => 1024/1024 = 1 MB
-    std::vector<std::byte> storage(1 << 20);
-    MemoryArena arena(storage.data(), storage.size());
-
-    PIDCore pid;
-    if (pid.init(d, dt, arena, {}) != Status::kOK) return 2;
-
     PIDConfig c{};
 
     // PID configs:
@@ -135,24 +193,38 @@ int main(int argc, char** argv){
     c.tau_f = {tf.data(), nu};
     c.u_ff_bias = {bias.data(), nu};
 
-    // Safety toggles
-    static Scalar umin[]{-1.0}, umax[]{1.0};
-    static Scalar du[]{5.0};
+    // Safety toggles -> per channel limits (saturation/rate index them up to nu)
+    std::vector<Scalar> umin(nu, -1.0), umax(nu, 1.0);
+    std::vector<Scalar> du(nu, 5.0);
     static Scalar ddu[]{50.0};
 
     if (opt_sat){
-        c.umin = {umin, 1};
-        c.umax = {umax, 1}; 
+        c.umin = {umin.data(), nu};
+        c.umax = {umax.data(), nu}; 
     }
     if (opt_rate){
-        c.du_max = {du, 1};
+        c.du_max = {du.data(), nu};
     } 
     if (opt_jerk){
-        c.du_max = {du, 1}; 
+        c.du_max = {du.data(), nu}; 
         c.ddu_max = {ddu, 1}; 
     }
 
+    // arena sized by a dry run of init + configure instead of a 1 MB guess
+    const ArenaPlan plan = plan_controller<PIDCore>(d, dt, c);
+    if (plan.status != Status::kOK) return 2;
+    std::vector<std::byte> storage(plan.bytes + plan.align);
+    void* base = storage.data();
+    std::size_t space = storage.size();
+    if (!std::align(plan.align, plan.bytes, base, space)) return 2;
+    MemoryArena arena(base, plan.bytes);
+
+    PIDCore pid;
+    if (pid.init(d, dt, arena, {}) != Status::kOK) return 2;
     if (pid.configure(c) != Status::kOK) return 3;
+
+    // single pass safety chain instead of the staged sweeps
+    if (opt_fused) pid.set_safety_chain(SafetyChainMode::kFused);
     if (pid.start() != Status::kOK) return 4;
 
     // buffer
@@ -190,7 +262,6 @@ int main(int argc, char** argv){
     // Benchmark
 
     using clk = std::chrono::steady_clock;
-    constexpr int BATCH = 64; // amortize timer cost
 
     auto run_loop = [&](bool do_pid) {
         std::vector<double> ns(static_cast<std::size_t>(iters));
@@ -210,16 +281,60 @@ int main(int argc, char** argv){
     };
 
     auto S_null = run_loop(false);
+
+    // // instrumentation build (-DICTK_ENABLE_STAGE_TIMING=ON): per stage split of the timed pid run
+    #if ICTK_STAGE_TIMING
+    static StageTimes stage_times;
+    pid.set_stage_timing(&stage_times);
+    #endif
+
     auto S_pid  = run_loop(true);
 
-    Stats S_net{
-        S_pid.p50 - S_null.p50,
-        S_pid.p95 - S_null.p95,
-        S_pid.p99 - S_null.p99,
-        S_pid.p999 - S_null.p999,
-        S_pid.jmin - S_null.jmin,
-        S_pid.jmax - S_null.jmax
+    #if ICTK_STAGE_TIMING
+    pid.set_stage_timing(nullptr);
+    #endif
+
+    auto net = [&](const Stats& S) -> Stats {
+        return {
+            S.p50 - S_null.p50,
+            S.p95 - S_null.p95,
+            S.p99 - S_null.p99,
+            S.p999 - S_null.p999,
+            S.jmin - S_null.jmin,
+            S.jmax - S_null.jmax
+        };
     };
+    Stats S_net = net(S_pid);
+
+    // // inlined variant: the stage list mirrors what configure() enabled (--jerk implies the rate stage)
+    Stats S_static{};
+    if (opt_static){
+        using safety::Saturation;
+        using safety::RateLimiter;
+        using safety::JerkLimiter;
+        const bool rate = opt_rate || opt_jerk;
+        int rc = 0;
+        if (opt_sat && opt_jerk)   rc = bench_concrete<StaticPIDCore<Saturation, RateLimiter, JerkLimiter>>(d, dt, c, ps, sp, res, iters, S_static);
+        else if (opt_sat && rate)  rc = bench_concrete<StaticPIDCore<Saturation, RateLimiter>>(d, dt, c, ps, sp, res, iters, S_static);
+        else if (opt_sat)          rc = bench_concrete<StaticPIDCore<Saturation>>(d, dt, c, ps, sp, res, iters, S_static);
+        else if (opt_jerk)         rc = bench_concrete<StaticPIDCore<RateLimiter, JerkLimiter>>(d, dt, c, ps, sp, res, iters, S_static);
+        else if (rate)             rc = bench_concrete<StaticPIDCore<RateLimiter>>(d, dt, c, ps, sp, res, iters, S_static);
+        else                       rc = bench_concrete<StaticPIDCore<>>(d, dt, c, ps, sp, res, iters, S_static);
+        if (rc) return rc;
+    }
+
+    Stats S_fixed{};
+    if (opt_fixed){
+        int rc = 0;
+        switch (nu){
+            case 1:  rc = bench_concrete<FixedPIDCore<1>>(d, dt, c, ps, sp, res, iters, S_fixed); break;
+            case 4:  rc = bench_concrete<FixedPIDCore<4>>(d, dt, c, ps, sp, res, iters, S_fixed); break;
+            case 16: rc = bench_concrete<FixedPIDCore<16>>(d, dt, c, ps, sp, res, iters, S_fixed); break;
+            case 64: rc = bench_concrete<FixedPIDCore<64>>(d, dt, c, ps, sp, res, iters, S_fixed); break;
+            default: rc = 5; break;  // // no instantiation for this nu
+        }
+        if (rc) return rc;
+    }
 
     if (!opt_no_header){
         std::puts("label, nu, dt_ns, iters, p50, p95, p99, p999, jmin, jmax, tag1, tag2, tag3, tag4, build");
@@ -233,7 +348,7 @@ int main(int argc, char** argv){
             static_cast<long long>(dt),
             iters,
             S.p50, S.p95, S.p99, S.p999, S.jmin, S.jmax,
-            "na", "na", "na", "na", "RelWithDebInfo"
+            (opt_fused ? "fused" : "staged"), safety::simd::isa_name(safety::simd::active_isa()), "na", "na", "RelWithDebInfo"
         );
     };
 
@@ -246,5 +361,40 @@ int main(int argc, char** argv){
     if (!opt_no_header) std::puts("net (pid only approx):");
     report(S_net,  "net");
 
+    if (opt_static){
+        if (!opt_no_header) std::puts("pid static (inlined, loop+timer):");
+        report(S_static, "pid_static");
+
+        if (!opt_no_header) std::puts("net static (pid only approx):");
+        report(net(S_static), "net_static");
+    }
+
+    if (opt_fixed){
+        if (!opt_no_header) std::puts("pid fixed (FixedPIDCore<nu>, loop+timer):");
+        report(S_fixed, "pid_fixed");
+
+        if (!opt_no_header) std::puts("net fixed (pid only approx):");
+        report(net(S_fixed), "net_fixed");
+    }
+
+    #if ICTK_STAGE_TIMING
+    // // histogram quantiles are bucket upper edges (log2), min / max are exact
+    if (!opt_no_header){
+        std::puts("stage (per update, ns):");
+        std::puts("label, stage, count, min, p50, p99, max, mean");
+    }
+    const double per_ns = stage_clock_per_ns();
+    for (std::size_t i = 0; i < kStageCount; ++i){
+        const auto s = static_cast<Stage>(i);
+        const StageSnapshot S = stage_times.read(s);
+        if (S.count == 0) continue;
+        auto ns_of = [&](std::uint64_t t){ return static_cast<double>(t) / per_ns; };
+        std::printf("stage, %s, %llu, %.1f, %.1f, %.1f, %.1f, %.1f\n",
+            to_string(s), static_cast<unsigned long long>(S.count),
+            ns_of(S.min), ns_of(S.quantile(0.50)), ns_of(S.quantile(0.99)), ns_of(S.max),
+            ns_of(S.sum) / static_cast<double>(S.count));
+    }
+    #endif
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include <chrono> // to measure time
+#include <cmath>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+
+#include "ictk/tools/recorder.hpp"
+#include "ictk/tools/columnar.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk;
+using namespace ictk::tools;
+
+/*
+Columnar recorder: write throughput on the calling thread, then mmap scans of what was written
+    usage: bench_recorder_columnar [records] [out_dir] [block_rows] [--compress] [--no-header]
+    columnar      : write_tick + rotate_if_needed per record; p50..jmax = one call, ns (columnar_ts: --compress)
+    columnar_scan : ACR-style pass over the mapped columns (IAE + max |u| + health counter sum); p50..jmax = one block, ns
+    columnar_verify: same pass after checking every block checksum
+    (page cache is warm: the segments were just written)
+*/
+
+struct Stats {
+    double p50, p95, p99, p999, jmin, jmax;
+};
+
+static Stats summarize(std::vector<double>& ns){
+    std::sort(ns.begin(), ns.end());
+    const std::size_t n = ns.size();
+    assert(n > 0);
+    auto q = [&](double p) -> double {
+        const double pos = p * static_cast<double>(n - 1u);
+        return ns[static_cast<std::size_t>(pos)];
+    };
+    return { q(0.50), q(0.95), q(0.99), q(0.999), ns.front(), ns.back() };
+}
+
+static void row(const char* label, std::size_t records, std::uintmax_t bytes, double s, std::vector<double>& ns){
+    const Stats S = summarize(ns);
+    std::printf("%s, %zu, %ju, %.3f, %.0f, %.1f, %.1f, %.1f, %.1f, %.1f, %.1f, %.1f\n",
+        label, records, bytes, s, static_cast<double>(records) / s,
+        static_cast<double>(bytes) / s / 1e6,
+        S.p50, S.p95, S.p99, S.p999, S.jmin, S.jmax);
+}
+
+int main(int argc, char** argv){
+    long records_i = 2'000'000;
+    const char* out_dir = "bench_columnar_out";
+    int block_rows = 4096;
+
+    if (argc > 1) records_i = std::atol(argv[1]);
+    if (argc > 2) out_dir = argv[2];
+    if (argc > 3) block_rows = std::atoi(argv[3]);
+
+    bool opt_no_header = false;
+    bool opt_compress = false;
+    for (int i = 4; i < argc; ++i){
+        if (std::strcmp(argv[i], "--no-header") == 0) opt_no_header = true;
+        if (std::strcmp(argv[i], "--compress") == 0) opt_compress = true;
+    }
+    if (records_i <= 0 || block_rows <= 0) return 1;
+    const auto records = static_cast<std::size_t>(records_i);
+
+    std::error_code ec;
+    fs::remove_all(out_dir, ec);
+    fs::create_directories(out_dir, ec);
+
+    RecorderOptions opt;
+    opt.backend = RecorderOptions::Columnar;
+    opt.out_dir = out_dir;
+    opt.dt_ns_hint = 1'000'000;
+    opt.block_rows = static_cast<std::size_t>(block_rows);
+    opt.compress = opt_compress;
+
+    using clk = std::chrono::steady_clock;
+    std::vector<double> ns(records);
+    double total_s = 0.0;
+    {
+        auto rec = Recorder::open(opt);
+        if (!rec) return 2;
+        rec->write_buildinfo();
+
+        TickSample s{};
+        const auto T0 = clk::now();
+        for (std::size_t i = 0; i < records; ++i){
+            s.t = static_cast<t_ns>(i) * 1'000'000;
+            s.y0 = 0.001 * static_cast<double>(i % 1000);
+            s.r0 = 1.0;
+            s.u_pre0 = 1.0 - s.y0;
+            s.u_post0 = s.u_pre0 * 0.5;
+            s.h.rate_limit_hits = i;
+            auto t0 = clk::now();
+            rec->write_tick(s);
+            rec->rotate_if_needed();
+            auto t1 = clk::now();
+            ns[i] = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        }
+        total_s = std::chrono::duration<double>(clk::now() - T0).count();
+        rec->write_kpi({});
+        rec->flush();
+    }
+
+    std::vector<fs::path> segs;
+    std::uintmax_t bytes = 0;
+    for (auto& e : fs::directory_iterator(out_dir)){
+        segs.push_back(e.path());
+        bytes += e.file_size();
+    }
+
+    if (!opt_no_header){
+        std::puts("label, records, bytes, seconds, records_per_s, mb_per_s, p50, p95, p99, p999, jmin, jmax");
+    }
+    row(opt_compress ? "columnar_ts" : "columnar", records, bytes, total_s, ns);
+
+    // // scan: the columns an audit touches, straight from the mapping (decoded first with --compress)
+    columnar::TickScratch scratch;
+    for (int verify = 0; verify < 2; ++verify){
+        std::vector<double> blk;
+        std::size_t rows = 0;
+        double iae = 0.0, umax = 0.0;
+        std::uint64_t hits = 0;
+        bool ok = true;
+        const auto T0 = clk::now();
+        for (const fs::path& p : segs){
+            auto r = columnar::Reader::open(p.string());
+            if (!r) return 3;
+            if (verify) ok = ok && r->verify();
+            for (std::size_t b = 0; b < r->index().size(); ++b){
+                if (r->index()[b].kind != static_cast<std::uint32_t>(columnar::BlockKind::kTicks)) continue;
+                const auto t0 = clk::now();
+                const columnar::TickBlock t = r->ticks(b, scratch);
+                for (std::size_t j = 0; j < t.rows(); ++j){
+                    iae += std::fabs(t.r0[j] - t.y0[j]);
+                    umax = std::max(umax, std::fabs(t.u_post0[j]));
+                    hits += t.rate_limit_hits[j];
+                }
+                rows += t.rows();
+                blk.push_back(std::chrono::duration<double, std::nano>(clk::now() - t0).count());
+            }
+        }
+        const double s = std::chrono::duration<double>(clk::now() - T0).count();
+        if (!ok || rows != records || blk.empty()) return 4;
+        if (opt_compress) row(verify ? "columnar_ts_verify" : "columnar_ts_scan", rows, bytes, s, blk);
+        else row(verify ? "columnar_verify" : "columnar_scan", rows, bytes, s, blk);
+        std::fprintf(stderr, "iae=%.3f umax=%.3f hits=%llu\n", iae, umax, static_cast<unsigned long long>(hits));
+    }
+
+    fs::remove_all(out_dir, ec);
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include <chrono> // to measure time
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+
+#include "ictk/tools/recorder.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk;
+using namespace ictk::tools;
+
+/*
+JSONL recorder throughput on the calling thread: write_tick + rotate_if_needed per record (tick + health pair)
+    usage: bench_recorder_jsonl [records] [out_dir] [fsync_n_mb] [--no-header]
+    rate = records per second of caller time; p50..jmax = single write_tick + rotate_if_needed call, ns
+        (a tail here means the caller waited for a buffer; fsync runs on the flusher thread)
+*/
+
+struct Stats {
+    double p50, p95, p99, p999, jmin, jmax;
+};
+
+static Stats summarize(std::vector<double>& ns){
+    std::sort(ns.begin(), ns.end());
+    const std::size_t n = ns.size();
+    assert(n > 0);
+    auto q = [&](double p) -> double {
+        const double pos = p * static_cast<double>(n - 1u);
+        return ns[static_cast<std::size_t>(pos)];
+    };
+    return { q(0.50), q(0.95), q(0.99), q(0.999), ns.front(), ns.back() };
+}
+
+int main(int argc, char** argv){
+    long records_i = 2'000'000;
+    const char* out_dir = "bench_recorder_out";
+    int fsync_mb = 16;
+
+    if (argc > 1) records_i = std::atol(argv[1]);
+    if (argc > 2) out_dir = argv[2];
+    if (argc > 3) fsync_mb = std::atoi(argv[3]);
+
+    bool opt_no_header = false;
+    for (int i = 4; i < argc; ++i){
+        if (std::strcmp(argv[i], "--no-header") == 0) opt_no_header = true;
+    }
+    if (records_i <= 0 || fsync_mb <= 0) return 1;
+    const auto records = static_cast<std::size_t>(records_i);
+
+    std::error_code ec;
+    fs::remove_all(out_dir, ec);
+    fs::create_directories(out_dir, ec);
+
+    RecorderOptions opt;
+    opt.out_dir = out_dir;
+    opt.dt_ns_hint = 1'000'000;
+    opt.fsync_n_mb = static_cast<std::size_t>(fsync_mb);
+
+    std::vector<double> ns(records);
+    double total_s = 0.0;
+    {
+        auto rec = Recorder::open(opt);
+        if (!rec) return 2;
+        rec->write_buildinfo();
+
+        using clk = std::chrono::steady_clock;
+        TickSample s{};
+        const auto T0 = clk::now();
+        for (std::size_t i = 0; i < records; ++i){
+            s.t = static_cast<t_ns>(i) * 1'000'000;
+            s.y0 = 0.001 * static_cast<double>(i % 1000);
+            s.r0 = 1.0;
+            s.u_pre0 = 1.0 - s.y0;
+            s.u_post0 = s.u_pre0 * 0.5;
+            s.h.rate_limit_hits = i;
+            auto t0 = clk::now();
+            rec->write_tick(s);
+            rec->rotate_if_needed();
+            auto t1 = clk::now();
+            ns[i] = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        }
+        total_s = std::chrono::duration<double>(clk::now() - T0).count();
+        rec->write_kpi({});
+        rec->flush();
+    }
+
+    std::uintmax_t bytes = 0;
+    for (auto& e : fs::directory_iterator(out_dir)) bytes += e.file_size();
+    fs::remove_all(out_dir, ec);
+
+    const Stats S = summarize(ns);
+    if (!opt_no_header){
+        std::puts("label, records, bytes, seconds, records_per_s, mb_per_s, p50, p95, p99, p999, jmin, jmax");
+    }
+    std::printf("jsonl, %zu, %ju, %.3f, %.0f, %.1f, %.1f, %.1f, %.1f, %.1f, %.1f, %.1f\n",
+        records, bytes, total_s, static_cast<double>(records) / total_s,
+        static_cast<double>(bytes) / total_s / 1e6,
+        S.p50, S.p95, S.p99, S.p999, S.jmin, S.jmax);
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <chrono> // to measure time
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <algorithm>
+#include <cassert>
+
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/safety/saturation.hpp"
+#include "ictk/safety/rate_limit.hpp"
+#include "ictk/safety/jerk_limit.hpp"
+#include "ictk/safety/simd_kernels.hpp"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+using namespace ictk;
+using namespace ictk::safety;
+
+/*
+staged safety stages on a wide command vector: Saturation / RateLimiter / JerkLimiter ::apply per ISA
+    usage: bench_safety_kernels [nu] [iters] [dt_ns] [--no-header] [--check-small]
+    one row per (stage, ISA this CPU supports); p50 / nu = ns per channel
+    --check-small: sat -> rate -> jerk on 1..8 channels, default table vs scalar; exit 3 if the default is
+        more than 25% (+ 10 ns) slower at any size (vector setup must not cost the short vectors)
+*/
+
+static void pin_thread_best_effort(){
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(0, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), 1);
+#endif
+}
+
+struct Stats {
+    double p50, p95, p99, p999, jmin, jmax;
+};
+
+static Stats summarize(std::vector<double>& ns){
+    std::sort(ns.begin(), ns.end());
+    const std::size_t n = ns.size();
+    assert(n > 0);
+    auto q = [&](double p) -> double {
+        const double pos = p * static_cast<double>(n - 1u);
+        return ns[static_cast<std::size_t>(pos)];
+    };
+    return { q(0.50), q(0.95), q(0.99), q(0.999), ns.front(), ns.back() };
+}
+
+int main(int argc, char** argv){
+    int nu_i = 1024;
+    int iters = 20000;
+    long long dt_arg_ns = 1'000'000; // 1 ms
+
+    if (argc > 1) nu_i = std::atoi(argv[1]);
+    if (argc > 2) iters = std::atoi(argv[2]);
+    if (argc > 3) dt_arg_ns = std::strtoll(argv[3], nullptr, 10);
+
+    bool opt_no_header = false;
+    bool opt_check_small = false;
+    for (int i = 4; i < argc; ++i){
+        if (std::strcmp(argv[i], "--no-header") == 0) opt_no_header = true;
+        else if (std::strcmp(argv[i], "--check-small") == 0) opt_check_small = true;
+    }
+    if (nu_i <= 0 || iters <= 0) return 1;
+
+    const std::size_t nu = static_cast<std::size_t>(nu_i);
+    const dt_ns dt = static_cast<dt_ns>(dt_arg_ns);
+
+    pin_thread_best_effort();
+
+    std::vector<std::byte> mem(nu * 64 + 4096);
+    MemoryArena arena(mem.data(), mem.size());
+
+    std::vector<Scalar> umin(nu, -1.0), umax(nu, 1.0), du(nu, 50.0);
+    Saturation sat(umin, umax);
+    RateLimiter rl(du, dt, arena, nu);
+    JerkLimiter jl(50.0, 2000.0, dt, arena, nu);
+    if (!rl.valid() || !jl.valid()) return 2;
+
+    // // square wave demand -> every stage clips part of the vector every tick
+    std::vector<Scalar> u(nu, 0.0);
+    int k = 0;
+    auto fill = [&]{
+        const Scalar a = (k++ / 50) % 2 ? Scalar(2.0) : Scalar(-2.0);
+        for (std::size_t i=0; i<nu; ++i) u[i] = (i % 3 == 0) ? a : Scalar(0.5) * a;
+    };
+
+    using clk = std::chrono::steady_clock;
+    auto run_loop = [&](auto&& stage){
+        for (int w = 0; w < 1000; ++w){ fill(); stage(); }
+        std::vector<double> ns(static_cast<std::size_t>(iters));
+        for (int it = 0; it < iters; ++it){
+            fill();
+            auto t0 = clk::now();
+            stage();
+            auto t1 = clk::now();
+            ns[static_cast<std::size_t>(it)] = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        }
+        return summarize(ns);
+    };
+
+    if (!opt_no_header){
+        std::puts("label, isa, nu, dt_ns, iters, p50, p95, p99, p999, jmin, jmax, ns_per_channel");
+    }
+    auto report = [&](const Stats& S, const char* label, simd::Isa isa){
+        std::printf("%s, %s, %zu, %lld, %d, %.1f, %.1f, %.1f, %.1f, %.1f, %.1f, %.3f\n",
+            label, simd::isa_name(isa), nu, static_cast<long long>(dt), iters,
+            S.p50, S.p95, S.p99, S.p999, S.jmin, S.jmax,
+            S.p50 / static_cast<double>(nu));
+    };
+
+    const simd::Isa best = simd::detected_isa();
+    for (int i = 0; i <= static_cast<int>(best); ++i){
+        const auto isa = static_cast<simd::Isa>(i);
+        if (!simd::select_isa(isa)) continue;
+        report(run_loop([&]{ (void)sat.apply(u); }), "saturation", isa);
+        report(run_loop([&]{ (void)rl.apply(u); }), "rate", isa);
+        report(run_loop([&]{ (void)jl.apply(u); }), "jerk", isa);
+    }
+
+    if (!opt_check_small) return 0;
+
+    // // small n regression check: whole staged chain per size, default table against scalar
+    int rc = 0;
+    const simd::Isa def = simd::default_isa();
+    std::puts("label, isa, n, p50_default, p50_scalar");
+    for (std::size_t n = 1; n <= 8 && n <= nu; ++n){
+        const std::span<Scalar> us(u.data(), n);
+        auto chain = [&]{ (void)sat.apply(us); (void)rl.apply(us); (void)jl.apply(us); };
+        if (!simd::select_isa(def)) return 4;
+        const Stats sd = run_loop(chain);
+        if (!simd::select_isa(simd::Isa::kScalar)) return 4;
+        const Stats ss = run_loop(chain);
+        std::printf("small_n, %s, %zu, %.1f, %.1f\n", simd::isa_name(def), n, sd.p50, ss.p50);
+        if (sd.p50 > 1.25 * ss.p50 + 10.0) rc = 3;
+    }
+    (void)simd::select_isa(def);
+    return rc;
+}
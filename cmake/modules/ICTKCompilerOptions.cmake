@@ -1,7 +1,8 @@
 function (ictk_apply_compiler_options tgt)
   target_compile_definitions(${tgt} PUBLIC
   $<$<BOOL:${ICTK_NO_EXCEPTIONS}>:ICTK_NO_EXCEPTIONS=1>
-  $<$<BOOL:${ICTK_NO_RTTI}>:ICTK_NO_RTTI=1>)
+  $<$<BOOL:${ICTK_NO_RTTI}>:ICTK_NO_RTTI=1>
+  $<$<BOOL:${ICTK_ENABLE_STAGE_TIMING}>:ICTK_STAGE_TIMING=1>)
 
   if (MSVC)
     target_compile_options(${tgt} PRIVATE
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <span>
+#include <cstddef>
+#include <cstdint>
+
+#include "ictk/core/types.hpp"
+#include "ictk/core/time.hpp"
+#include "ictk/core/status.hpp"
+#include "ictk/core/result.hpp"
+#include "ictk/core/controller.hpp"
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/core/update_context.hpp"
+
+/*
+CascadeController: outer loop -> inner loop, as one IController
+    the outer loop's command IS the inner loop's setpoint: outer out.u and inner sp.r are the same arena span
+    the inner loop writes straight into the caller's out.u; measurements are views into the caller's y
+        -> no copies, no glue buffers in user code
+
+    layout seen by the caller (dims passed to init):
+        ctx.plant.y = [ y_outer (outer.ny) | y_inner (inner.ny) ]   valid_bits split the same way
+        ctx.sp.r    = outer setpoint (outer.ny)
+        out.u       = inner command (inner.nu)
+
+    rates: the cascade ticks at the inner dt; the outer loop runs on every ratio-th tick (the first one included)
+        outer was init'ed with ratio * dt, inner with dt; the inner setpoint holds between outer ticks
+
+    inner saturation -> outer anti windup (optional, CascadeConfig::track):
+        inner channel j hit saturation during the outer period -> the outer command j was not achievable,
+        the outer loop tracks against y_inner[j] instead (back calculation with its own AW mode / Kt),
+        applied once per outer period, after the inner tick that closes it
+        TrackFn is how the cascade reaches the outer law; track_of(pid) wires PIDCore / StaticPIDCore / FixedPIDCore
+
+    health: inner health; deadline_miss_count summed, fallback_active / novelty_flag or-ed with the outer loop
+    sub-controllers are not owned; init + configure them first, the cascade forwards start / stop / reset
+*/
+namespace ictk::control{
+
+    // // outer loop asked for r_cmd, inner could only follow r_achieved
+    using TrackFn = void(*)(std::span<const Scalar> r_cmd, std::span<const Scalar> r_achieved, void* user);
+
+    struct CascadeTrack{
+        TrackFn fn{nullptr};
+        void* user{nullptr};
+    };
+
+    // // any controller with track(u_cmd, u_achieved) (PIDCore, StaticPIDCore, FixedPIDCore)
+    template <class C>
+    CascadeTrack track_of(C& c) noexcept{
+        return CascadeTrack{
+            [](std::span<const Scalar> cmd, std::span<const Scalar> ach, void* user){
+                static_cast<C*>(user)->track(cmd, ach);
+            },
+            &c
+        };
+    }
+
+    struct CascadeConfig{
+        IController* outer{nullptr};
+        IController* inner{nullptr};
+        Dims outer_dims{};
+        Dims inner_dims{};
+
+        // // outer period / inner period
+        std::uint32_t ratio{1};
+
+        // // inner saturation -> outer anti windup; empty -> off
+        CascadeTrack track{};
+    };
+
+    class CascadeController final : public IController{
+        public:
+            CascadeController() = default;
+
+            // // dims: ny = outer.ny + inner.ny, nu = inner.nu; dt = inner period. Hooks go on the inner controller.
+            [[nodiscard]] Status init(const Dims& dims, dt_ns dt, MemoryArena& arena, const Hooks& hooks = {}) noexcept override{
+                if (hooks.pre_clamp || hooks.post_arbitrate) return Status::kInvalidArg;
+                if (dims.nu == 0 || dims.ny == 0 || dt <= 0) return Status::kInvalidArg;
+                dims_ = dims;
+                arena_ = &arena;
+                cfg_ = {};
+                r_inner_ = nullptr;
+                started_ = false;
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status configure(const CascadeConfig& cfg) noexcept{
+                if (!arena_) return Status::kNotReady;
+                if (!cfg.outer || !cfg.inner || cfg.outer == cfg.inner || cfg.ratio == 0) return Status::kInvalidArg;
+
+                const Dims& o = cfg.outer_dims;
+                const Dims& in = cfg.inner_dims;
+                if (o.nu == 0 || o.ny == 0 || in.nu == 0 || in.ny == 0) return Status::kInvalidArg;
+                if (o.nu != in.ny) return Status::kInvalidArg;                        // outer command = inner setpoint
+                if (o.ny + in.ny != dims_.ny || in.nu != dims_.nu) return Status::kInvalidArg;
+                // // tracking maps inner channel j (command, measurement) to outer command j; masks are 64 bit
+                if (cfg.track.fn && (in.nu != in.ny || o.nu > 64)) return Status::kInvalidArg;
+
+                // // inner setpoint (= outer command) and the tracking target, from the arena once
+                r_inner_ = static_cast<Scalar*>(arena_->allocate(o.nu * sizeof(Scalar), alignof(Scalar)));
+                achieved_ = static_cast<Scalar*>(arena_->allocate(o.nu * sizeof(Scalar), alignof(Scalar)));
+                if (!r_inner_ || !achieved_) return Status::kNoMem;
+                for (std::size_t i=0; i<o.nu; ++i) r_inner_[i] = Scalar(0);
+
+                cfg_ = cfg;
+                tick_ = 0;
+                sat_accum_ = 0;
+                outer_health_ = {};
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status start() noexcept override{
+                if (!r_inner_) return Status::kNotReady;
+                if (Status st = cfg_.outer->start(); st != Status::kOK) return st;
+                if (Status st = cfg_.inner->start(); st != Status::kOK) return st;
+                tick_ = 0;
+                sat_accum_ = 0;
+                started_ = true;
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status stop() noexcept override{
+                started_ = false;
+                if (!r_inner_) return Status::kOK;
+                const Status a = cfg_.outer->stop();
+                const Status b = cfg_.inner->stop();
+                return (a != Status::kOK) ? a : b;
+            }
+
+            [[nodiscard]] Status reset() noexcept override{
+                tick_ = 0;
+                sat_accum_ = 0;
+                outer_health_ = {};
+                if (!r_inner_) return Status::kOK;
+                for (std::size_t i=0; i<cfg_.outer_dims.nu; ++i) r_inner_[i] = Scalar(0);
+                const Status a = cfg_.outer->reset();
+                const Status b = cfg_.inner->reset();
+                return (a != Status::kOK) ? a : b;
+            }
+
+            [[nodiscard]] Status update(const UpdateContext& ctx, Result& out) noexcept override{
+                if (!started_) return Status::kNotReady;
+                if (ctx.plant.y.size() != dims_.ny || out.u.size() != dims_.nu) return Status::kInvalidArg;
+
+                const std::size_t ny_o = cfg_.outer_dims.ny;
+                const std::size_t ny_i = cfg_.inner_dims.ny;
+                const std::size_t nr = cfg_.outer_dims.nu;
+                if (ctx.sp.r.size() != ny_o) return Status::kInvalidArg;
+
+                const std::span<const Scalar> y_inner = ctx.plant.y.subspan(ny_o, ny_i);
+                const std::span<Scalar> r_inner(r_inner_, nr);
+                const std::uint32_t phase = static_cast<std::uint32_t>(tick_ % cfg_.ratio);
+
+                // // 1- outer loop on its own rate, commanding straight into the inner setpoint
+                if (phase == 0){
+                    UpdateContext oc{};
+                    oc.plant.y = ctx.plant.y.first(ny_o);
+                    oc.plant.t = ctx.plant.t;
+                    oc.plant.valid_bits = ctx.plant.valid_bits;
+                    oc.sp = ctx.sp;
+                    Result orr{};
+                    orr.u = r_inner;
+                    if (Status st = cfg_.outer->update(oc, orr); st != Status::kOK) return st;
+                    outer_health_ = orr.health;
+                }
+
+                // // 2- inner loop, setpoint = outer command (same memory), command = caller's buffer
+                UpdateContext ic{};
+                ic.plant.y = y_inner;
+                ic.plant.t = ctx.plant.t;
+                ic.plant.valid_bits = (ny_o < 64) ? (ctx.plant.valid_bits >> ny_o) : 0ull;
+                ic.sp.r = r_inner;
+                ic.sp.preview_horizon_len = 0;
+                if (Status st = cfg_.inner->update(ic, out); st != Status::kOK) return st;
+
+                // // 3- inner saturation -> outer anti windup, once per outer period
+                if (cfg_.track.fn){
+                    sat_accum_ |= out.health.sat_hit_mask;
+                    if (phase + 1 == cfg_.ratio){
+                        if (sat_accum_){
+                            for (std::size_t j=0; j<nr; ++j){
+                                achieved_[j] = ((sat_accum_ >> j) & 1ull) ? y_inner[j] : r_inner_[j];
+                            }
+                            cfg_.track.fn(std::span<const Scalar>(r_inner_, nr), std::span<const Scalar>(achieved_, nr), cfg_.track.user);
+                        }
+                        sat_accum_ = 0;
+                    }
+                }
+
+                // // 4- one health record for the pair
+                out.health.deadline_miss_count += outer_health_.deadline_miss_count;
+                out.health.fallback_active = out.health.fallback_active || outer_health_.fallback_active;
+                out.health.novelty_flag = out.health.novelty_flag || outer_health_.novelty_flag;
+
+                ++tick_;
+                return Status::kOK;
+            }
+
+            CommandMode mode() const noexcept override{
+                return cfg_.inner ? cfg_.inner->mode() : CommandMode::Primary;
+            }
+
+            // // inner setpoint = last outer command (read only view)
+            std::span<const Scalar> inner_setpoint() const noexcept{
+                return {r_inner_, r_inner_ ? cfg_.outer_dims.nu : 0};
+            }
+
+            // // outer health of its last tick
+            const ControllerHealth& outer_health() const noexcept{
+                return outer_health_;
+            }
+
+        private:
+            Dims dims_{};
+            MemoryArena* arena_{nullptr};
+            CascadeConfig cfg_{};
+
+            Scalar* r_inner_{nullptr};
+            Scalar* achieved_{nullptr};
+
+            std::uint64_t tick_{0};
+            std::uint64_t sat_accum_{0};
+            ControllerHealth outer_health_{};
+            bool started_{false};
+    };
+
+} // namespace ictk::control
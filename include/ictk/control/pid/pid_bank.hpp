@@ -0,0 +1,505 @@
+#pragma once
+
+#include <span>
+#include <cmath>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+
+#include "ictk/core/config.hpp"
+#include "ictk/core/types.hpp"
+#include "ictk/core/time.hpp"
+#include "ictk/core/status.hpp"
+#include "ictk/core/health.hpp"
+#include "ictk/core/memory_arena.hpp"
+
+#include "ictk/safety/watchdog.hpp"
+#include "ictk/safety/anti_windup.hpp"
+
+#include "ictk/control/pid/pid.hpp"
+
+/*
+PIDBank: thousands of independent SISO PID loops in one structure-of-arrays engine
+
+    loop i of the bank == a SISO PIDCore (nu = ny = 1) fed y[i], r[i]
+        same control law, same safety order (sat -> rate -> jerk), same anti windup, same health numbers
+        output is bit-identical to running n PIDCores one by one (tests_pid/property/pid_bank_equivalence)
+
+    layout: every per loop parameter/state is one contiguous arena array (64 B aligned)
+        update_all() is a single branch-free sweep over i -> the compiler vectorizes it
+        no virtual calls, no per loop span/optional bookkeeping
+
+    per loop: gains, beta/gamma, derivative filter, bias, limits, AW mode + Kt, schedule
+    bank wide: dt, which safety stages exist, watchdog/deadline accounting (one timestamp per tick)
+*/
+namespace ictk::control::pid{
+
+    // // every span: length n (per loop), length 1 (broadcast) or empty (default); shorter -> rest default
+    // // tau_f / N follow PIDConfig: per loop only, no broadcast (law::tustin)
+    struct PIDBankConfig{
+        // // gains
+        std::span<const Scalar> Kp, Kd, Ki;
+        // // setpoint weights
+        std::span<const Scalar> beta, gamma;
+        // // derivative filter
+        std::span<const Scalar> tau_f, N;
+        // // feed forward bias
+        std::span<const Scalar> u_ff_bias;
+        // // safety => umin+umax both set -> saturation; du_max -> rate; ddu_max -> jerk (rate bound = du_max or 0)
+        // // a loop opts out of a configured stage with +-inf limits
+        std::span<const Scalar> umin, umax, du_max, ddu_max;
+
+        // anti windup
+        std::span<const safety::AWMode> aw_mode;
+        std::span<const Scalar> Kt;
+
+        // watchdog (bank wide, needs the timestamped update_all)
+        std::uint32_t miss_threshold{0};
+        dt_ns watchdog_slack{0};
+
+        // per loop schedule over that loop's own y[i]; empty bp -> loop not scheduled
+        std::span<const ScheduleConfig> sched;
+    };
+
+    // // bank wide roll up of the last tick
+    struct BankHealth{
+        std::uint64_t deadline_miss_count{0};   // cumulative, like ControllerHealth
+        std::uint64_t sat_loops{0};             // loops clamped by saturation
+        std::uint64_t rate_limit_hits{0};       // loops clipped by the rate limiter
+        std::uint64_t jerk_limit_hits{0};       // loops clipped by the jerk limiter
+        double max_clamp_mag{0.0};
+        double max_rate_clip_mag{0.0};
+        double max_jerk_clip_mag{0.0};
+        double aw_term_sum{0.0};
+        bool fallback_active{false};
+    };
+
+
+    class PIDBank{
+        public:
+            PIDBank() = default;
+
+            // // n loops, fixed tick; all arrays carved out of the arena here (nothing after)
+            [[nodiscard]] Status init(std::size_t n, dt_ns dt, MemoryArena& a) noexcept{
+                if (n == 0 || dt <= 0 || n > std::numeric_limits<std::uint32_t>::max()) return Status::kInvalidArg;
+                n_ = n;
+                dt_ = dt;
+                arena_ = &a;
+
+                // gains and weights (scheduled loops get theirs rewritten every tick)
+                kp_ = alloc(n); kd_ = alloc(n); kidt_ = alloc(n);
+                beta_ = alloc(n); gamma_ = alloc(n); uff_ = alloc(n);
+                // derivative filter
+                a1_ = alloc(n); b_ = alloc(n);
+                // controller state
+                integ_ = alloc(n); y_prev_ = alloc(n); r_prev_ = alloc(n); dyf_ = alloc(n); drf_ = alloc(n);
+                // safety limits (per tick steps precomputed) and limiter state
+                umin_ = alloc(n); umax_ = alloc(n); rstep_ = alloc(n); jrstep_ = alloc(n); jstep_ = alloc(n);
+                rprev_ = alloc(n); jprev_ = alloc(n); jdprev_ = alloc(n);
+                // anti windup
+                kt_ = alloc(n);
+                aw_code_ = alloc(n);
+                // last tick health
+                clamp_mag_ = alloc_d(n); rate_mag_ = alloc_d(n); jerk_mag_ = alloc_d(n); aw_mag_ = alloc_d(n);
+                jerk_hit_ = alloc(n);
+                // schedule index list
+                sched_idx_ = static_cast<std::uint32_t*>(a.allocate(n * sizeof(std::uint32_t), kAlign, "bank.sched_idx"));
+
+                if (!kp_ || !kd_ || !kidt_ || !beta_ || !gamma_ || !uff_ || !a1_ || !b_ ||
+                    !integ_ || !y_prev_ || !r_prev_ || !dyf_ || !drf_ ||
+                    !umin_ || !umax_ || !rstep_ || !jrstep_ || !jstep_ || !rprev_ || !jprev_ || !jdprev_ ||
+                    !kt_ || !aw_code_ || !clamp_mag_ || !rate_mag_ || !jerk_mag_ || !aw_mag_ || !jerk_hit_ || !sched_idx_){
+                    n_ = 0;
+                    return Status::kNoMem;
+                }
+
+                started_ = false;
+                configured_ = false;
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status configure(const PIDBankConfig& cfg) noexcept{
+                if (n_ == 0) return Status::kNotReady;
+                const Scalar dt_s = static_cast<Scalar>(dt_) * 1e-9;
+
+                // // one sided saturation is ambiguous per loop -> reject instead of guessing
+                if (cfg.umin.empty() != cfg.umax.empty()) return Status::kInvalidArg;
+                sat_on_ = !cfg.umin.empty();
+                rate_on_ = !cfg.du_max.empty();
+                jerk_on_ = !cfg.ddu_max.empty();
+
+                if (!cfg.sched.empty() && cfg.sched.size() != 1 && cfg.sched.size() < n_) return Status::kInvalidArg;
+                sched_ = cfg.sched;
+                n_sched_ = 0;
+
+                // // β, γ ranges: same rule as PIDCore
+                if (Status st = law::check_weights(cfg, n_); st != Status::kOK) return st;
+
+                const Scalar inf = std::numeric_limits<Scalar>::infinity();
+                using law::pick;
+
+                for (std::size_t i=0; i<n_; ++i){
+                    kp_[i] = pick(cfg.Kp, i, 0);
+                    kd_[i] = pick(cfg.Kd, i, 0);
+                    kidt_[i] = pick(cfg.Ki, i, 0) * dt_s;   // cache ki*dt per loop
+                    beta_[i] = pick(cfg.beta, i, 1);
+                    gamma_[i] = pick(cfg.gamma, i, 0);
+                    uff_[i] = pick(cfg.u_ff_bias, i, 0);
+
+                    // // derivative filter: the Tustin coefficients PIDCore computes for channel i
+                    const law::Tustin<Scalar> f = law::tustin(cfg, i, dt_s);
+                    a1_[i] = f.a1;
+                    b_[i] = f.b;
+
+                    // // safety: per tick steps, same products as RateLimiter/JerkLimiter::begin_tick
+                    umin_[i] = sat_on_ ? pick(cfg.umin, i, -inf) : -inf;
+                    umax_[i] = sat_on_ ? pick(cfg.umax, i, inf) : inf;
+                    if (!(umin_[i] <= umax_[i])) return Status::kInvalidArg;
+
+                    const Scalar du = rate_on_ ? pick(cfg.du_max, i, inf) : Scalar(0);
+                    const Scalar ddu = jerk_on_ ? pick(cfg.ddu_max, i, inf) : Scalar(0);
+                    if (!(du >= 0) || !(ddu >= 0)) return Status::kInvalidArg;
+                    rstep_[i] = du * dt_s;
+                    jrstep_[i] = du * dt_s;
+                    jstep_[i] = ddu * dt_s;
+
+                    safety::AWMode m = safety::AWMode::kBackCalc;
+                    if (cfg.aw_mode.size() == 1) m = cfg.aw_mode[0];
+                    else if (i < cfg.aw_mode.size()) m = cfg.aw_mode[i];
+                    aw_code_[i] = aw_code(m);
+                    kt_[i] = pick(cfg.Kt, i, 0);
+
+                    // // schedule: validate like PIDCore, remember which loops need the per tick lerp
+                    if (!sched_.empty()){
+                        const ScheduleConfig& s = sched_of(i);
+                        if (Status st = law::check_schedule(s); st != Status::kOK) return st;
+                        if (!s.bp.empty()) sched_idx_[n_sched_++] = static_cast<std::uint32_t>(i);
+                    }
+
+                    integ_[i] = 0; y_prev_[i] = 0; r_prev_[i] = 0; dyf_[i] = 0; drf_[i] = 0;
+                    rprev_[i] = 0; jprev_[i] = 0; jdprev_[i] = 0;
+                    clamp_mag_[i] = 0; rate_mag_[i] = 0; jerk_mag_[i] = 0; aw_mag_[i] = 0; jerk_hit_[i] = 0;
+                }
+
+                wd_.reset();
+                if (cfg.miss_threshold > 0) wd_.emplace(dt_, cfg.miss_threshold, cfg.watchdog_slack);
+
+                dt_s_ = dt_s;
+                configured_ = true;
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status start() noexcept{
+                if (!configured_) return Status::kNotReady;
+                started_ = true;
+                last_t_ = -1;
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status stop() noexcept{
+                started_ = false;
+                return Status::kOK;
+            }
+
+            // // controller state only (limiter memory kept), same as PIDCore::reset
+            [[nodiscard]] Status reset() noexcept{
+                last_t_ = -1;
+                if (!configured_) return Status::kOK;
+                for (std::size_t i=0; i<n_; ++i){
+                    integ_[i] = 0; dyf_[i] = 0; drf_[i] = 0; y_prev_[i] = 0; r_prev_[i] = 0;
+                    clamp_mag_[i] = 0; rate_mag_[i] = 0; jerk_mag_[i] = 0; aw_mag_[i] = 0; jerk_hit_[i] = 0;
+                }
+                return Status::kOK;
+            }
+
+            // // one tick for every loop: y, r, u all length n
+            [[nodiscard]] Status update_all(std::span<const Scalar> y, std::span<const Scalar> r, std::span<Scalar> u) noexcept{
+                if (!started_) return Status::kNotReady;
+                if (y.size() != n_ || r.size() != n_ || u.size() != n_) return Status::kInvalidArg;
+                run_(y.data(), r.data(), u.data());
+                return Status::kOK;
+            }
+
+            // // timestamped tick: adds deadline accounting and the watchdog, like ControllerBase::update
+            [[nodiscard]] Status update_all(t_ns t, std::span<const Scalar> y, std::span<const Scalar> r, std::span<Scalar> u) noexcept{
+                if (!started_) return Status::kNotReady;
+                if (y.size() != n_ || r.size() != n_ || u.size() != n_) return Status::kInvalidArg;
+
+                const auto d = t - last_t_;
+                if (last_t_ >= 0 && d != dt_) deadline_miss_count_ += std::max<t_ns>(1, d / dt_) - 1;
+                last_t_ = t;
+                if (wd_ && wd_->tick(t)) fallback_active_ = true;
+
+                run_(y.data(), r.data(), u.data());
+                return Status::kOK;
+            }
+
+            // Bumpless transfer of loop i (scheduled loops use the gains of the last tick)
+            void align_bumpless(std::size_t i, Scalar u_hold, Scalar r0, Scalar y0) noexcept{
+                if (i >= n_ || !configured_) return;
+                integ_[i] = law::bumpless_integ(u_hold, kp_[i], kd_[i], beta_[i], uff_[i], r0, y0, dyf_[i]);
+                y_prev_[i] = y0;
+                r_prev_[i] = r0;
+            }
+
+            // // health of loop i for the last tick, shaped like a SISO PIDCore's ControllerHealth
+            ControllerHealth health(std::size_t i) const noexcept{
+                ControllerHealth h{};
+                h.deadline_miss_count = deadline_miss_count_;
+                h.fallback_active = fallback_active_;
+                if (i >= n_ || !configured_) return h;
+
+                // // a limiter that clipped always moved u (and vice versa) -> mag > 0 is the hit flag
+                const bool sat_hit = clamp_mag_[i] > 0.0;
+                const bool rate_hit = rate_mag_[i] > 0.0;
+                h.saturation_pct = sat_hit ? 100.0 : 0.0;
+                h.rate_limit_hits = rate_hit ? 1u : 0u;
+                h.jerk_limit_hits = (jerk_hit_[i] != Scalar(0)) ? 1u : 0u;
+                h.aw_term_mag = aw_mag_[i];
+                h.last_clamp_mag = clamp_mag_[i];
+                h.last_rate_clip_mag = rate_mag_[i];
+                h.last_jerk_clip_mag = jerk_mag_[i];
+                h.sat_hit_mask = sat_hit ? 1u : 0u;
+                h.rate_hit_mask = rate_hit ? 1u : 0u;
+                h.jerk_hit_mask = (jerk_mag_[i] > 0.0) ? 1u : 0u;
+                return h;
+            }
+
+            // // bank roll up of the last tick (O(n), call off the hot path)
+            BankHealth summary() const noexcept{
+                BankHealth b{};
+                b.deadline_miss_count = deadline_miss_count_;
+                b.fallback_active = fallback_active_;
+                if (!configured_) return b;
+                for (std::size_t i=0; i<n_; ++i){
+                    b.sat_loops += (clamp_mag_[i] > 0.0) ? 1u : 0u;
+                    b.rate_limit_hits += (rate_mag_[i] > 0.0) ? 1u : 0u;
+                    b.jerk_limit_hits += (jerk_hit_[i] != Scalar(0)) ? 1u : 0u;
+                    b.max_clamp_mag = std::max(b.max_clamp_mag, clamp_mag_[i]);
+                    b.max_rate_clip_mag = std::max(b.max_rate_clip_mag, rate_mag_[i]);
+                    b.max_jerk_clip_mag = std::max(b.max_jerk_clip_mag, jerk_mag_[i]);
+                    b.aw_term_sum += aw_mag_[i];
+                }
+                return b;
+            }
+
+            std::size_t size() const noexcept{
+                return n_;
+            }
+            dt_ns dt() const noexcept{
+                return dt_;
+            }
+
+        private:
+            static constexpr std::size_t kAlign = 64;  // cache line, widest vector
+
+            /*
+            AW mode as a Scalar code: the sweep selects on FP compares only
+                (mixing bool/integer masks with double lanes stops the vectorizer)
+            */
+            static constexpr Scalar kAwOff = 0, kAwBackCalc = 1, kAwCond = 2;
+            static Scalar aw_code(safety::AWMode m) noexcept{
+                switch (m){
+                    case safety::AWMode::kOff: return kAwOff;
+                    case safety::AWMode::kConditional: return kAwCond;
+                    case safety::AWMode::kBackCalc: break;
+                }
+                return kAwBackCalc;
+            }
+
+            Scalar* alloc(std::size_t n) noexcept{
+                return static_cast<Scalar*>(arena_->allocate(n * sizeof(Scalar), kAlign, "bank"));
+            }
+            double* alloc_d(std::size_t n) noexcept{
+                return static_cast<double*>(arena_->allocate(n * sizeof(double), kAlign, "bank"));
+            }
+
+            const ScheduleConfig& sched_of(std::size_t i) const noexcept{
+                return sched_[sched_.size() == 1 ? 0 : i];
+            }
+
+            // // scheduled loops: rewrite their effective gains from y[i] (law::scheduled, as PIDCore over y[0])
+            void schedule_(const Scalar* y) noexcept{
+                for (std::size_t k=0; k<n_sched_; ++k){
+                    const std::size_t i = sched_idx_[k];
+                    const law::Gains<Scalar> g = law::scheduled(sched_of(i), y[i]);
+                    kp_[i] = g.kp;
+                    kd_[i] = g.kd;
+                    kidt_[i] = g.ki * dt_s_;
+                    beta_[i] = g.beta;
+                    gamma_[i] = g.gamma;
+                }
+            }
+
+            void run_(const Scalar* y, const Scalar* r, Scalar* u) noexcept{
+                if (n_sched_) schedule_(y);
+
+                // // configured stage set -> one of 8 branch-free sweeps
+                switch ((sat_on_ ? 1 : 0) | (rate_on_ ? 2 : 0) | (jerk_on_ ? 4 : 0)){
+                    case 0: sweep_<false, false, false>(y, r, u); break;
+                    case 1: sweep_<true,  false, false>(y, r, u); break;
+                    case 2: sweep_<false, true,  false>(y, r, u); break;
+                    case 3: sweep_<true,  true,  false>(y, r, u); break;
+                    case 4: sweep_<false, false, true >(y, r, u); break;
+                    case 5: sweep_<true,  false, true >(y, r, u); break;
+                    case 6: sweep_<false, true,  true >(y, r, u); break;
+                    default: sweep_<true, true,  true >(y, r, u); break;
+                }
+            }
+
+            /*
+            one pass per loop: PID law -> sat -> rate -> jerk -> anti windup -> health
+                every branch is a flat select on an FP compare so the body if-converts and vectorizes across loops
+                (nested ?: sinks compares into branches; bool/int masks next to double lanes block the vectorizer)
+                expression order matches PIDCore + the limiters exactly (no reassociation, no fma)
+            */
+            // // below ? lo : above ? hi : v written as two flat selects -> both compares unconditional, so it if-converts (FP compares can't be speculated)
+            static inline Scalar clamp_(Scalar v, Scalar lo, Scalar hi) noexcept{
+                const Scalar t = (v > hi) ? hi : v;
+                return (v < lo) ? lo : t;
+            }
+            // // max(0, |a - b|) like ControllerBase::stage_delta_ (NaN -> 0)
+            static inline double mag_(Scalar a, Scalar b) noexcept{
+                return std::max(0.0, std::abs(static_cast<double>(a - b)));
+            }
+
+            template <bool kSat, bool kRate, bool kJerk>
+            void sweep_(const Scalar* y, const Scalar* r, Scalar* u) noexcept{
+                // // hoisted locals: stores through the arrays can't be seen as touching *this
+                const Scalar* kp = kp_;
+                const Scalar* kd = kd_;
+                const Scalar* kidt = kidt_;
+                const Scalar* beta = beta_;
+                const Scalar* gamma = gamma_;
+                const Scalar* uff = uff_;
+                const Scalar* a1 = a1_;
+                const Scalar* bf = b_;
+                Scalar* integ = integ_;
+                Scalar* y_prev = y_prev_;
+                Scalar* r_prev = r_prev_;
+                Scalar* dyf = dyf_;
+                Scalar* drf = drf_;
+                const Scalar* umin = umin_;
+                const Scalar* umax = umax_;
+                const Scalar* rstep = rstep_;
+                const Scalar* jrstep = jrstep_;
+                const Scalar* jstep = jstep_;
+                Scalar* rprev = rprev_;
+                Scalar* jprev = jprev_;
+                Scalar* jdprev = jdprev_;
+                const Scalar* kt = kt_;
+                const Scalar* aw_code = aw_code_;
+                double* clamp_mag = clamp_mag_;
+                double* rate_mag = rate_mag_;
+                double* jerk_mag = jerk_mag_;
+                double* aw_mag = aw_mag_;
+                Scalar* jerk_hit = jerk_hit_;
+
+                const std::size_t n = n_;
+                ICTK_IVDEP
+                for (std::size_t i=0; i<n; ++i){
+                    // // PID law (PIDCore::compute_core, one channel)
+                    const Scalar yk = y[i];
+                    const Scalar rk = r[i];
+                    const Scalar e = beta[i] * rk - yk;
+
+                    const Scalar dy = bf[i] * (yk - y_prev[i]) + a1[i] * dyf[i];
+                    const Scalar dr = bf[i] * (rk - r_prev[i]) + a1[i] * drf[i];
+                    dyf[i] = dy;
+                    drf[i] = dr;
+                    y_prev[i] = yk;
+                    r_prev[i] = rk;
+
+                    const Scalar P = kp[i] * e;
+                    const Scalar D = -kd[i] * (dy - gamma[i] * dr);
+                    const Scalar u_pre = P + integ[i] + D + uff[i];
+
+                    Scalar v = u_pre;
+
+                    // // SAT: [umin, umax]
+                    if constexpr (kSat){
+                        const Scalar lo = umin[i], hi = umax[i];
+                        const Scalar s = clamp_(v, lo, hi);
+                        clamp_mag[i] = mag_(s, v);
+                        v = s;
+                    }
+
+                    // // RATE: |u - u_prev| <= du_max * dt
+                    if constexpr (kRate){
+                        const Scalar lo = rprev[i] - rstep[i];
+                        const Scalar hi = rprev[i] + rstep[i];
+                        const Scalar s = clamp_(v, lo, hi);
+                        rprev[i] = s;
+                        rate_mag[i] = mag_(s, v);
+                        v = s;
+                    }
+
+                    // // JERK: rate clamp then |du - du_prev| <= ddu_max * dt
+                    if constexpr (kJerk){
+                        const Scalar p = jprev[i];
+                        const Scalar lo_r = p - jrstep[i];
+                        const Scalar hi_r = p + jrstep[i];
+                        const Scalar u_rate = clamp_(v, lo_r, hi_r);
+
+                        const Scalar lo = jdprev[i] - jstep[i];
+                        const Scalar hi = jdprev[i] + jstep[i];
+                        const Scalar du = u_rate - p;
+                        const Scalar hit_hi = (du > hi) ? Scalar(1) : Scalar(0);
+                        const Scalar hit = (du < lo) ? Scalar(1) : hit_hi;
+                        const Scalar s = p + clamp_(du, lo, hi);
+
+                        jdprev[i] = s - p;
+                        jprev[i] = s;
+                        jerk_mag[i] = mag_(s, v);
+                        jerk_hit[i] = hit;
+                        v = s;
+                    }
+
+                    // // anti windup (PIDCore::anti_windup_update, one channel)
+                    const Scalar m = aw_code[i];
+                    const Scalar bt = (v - u_pre) * kt[i];                      // back calculation
+                    const Scalar bc_cond = (v != u_pre) ? bt : Scalar(0);       // conditional
+                    const Scalar bc_on = (m == kAwCond) ? bc_cond : bt;
+                    const Scalar bc = (m == kAwOff) ? Scalar(0) : bc_on;
+                    integ[i] += kidt[i] * e + bc;
+
+                    aw_mag[i] = std::abs(static_cast<double>(v - u_pre));
+                    u[i] = v;
+                }
+            }
+
+            std::size_t n_{0};
+            dt_ns dt_{0};
+            Scalar dt_s_{0};
+            MemoryArena* arena_{nullptr};
+            bool configured_{false};
+            bool started_{false};
+            t_ns last_t_{-1};
+
+            // // bank wide stage set
+            bool sat_on_{false}, rate_on_{false}, jerk_on_{false};
+
+            // // SoA: parameters
+            Scalar *kp_{}, *kd_{}, *kidt_{}, *beta_{}, *gamma_{}, *uff_{}, *a1_{}, *b_{};
+            Scalar *umin_{}, *umax_{}, *rstep_{}, *jrstep_{}, *jstep_{}, *kt_{};
+            Scalar* aw_code_{};
+            // // SoA: state
+            Scalar *integ_{}, *y_prev_{}, *r_prev_{}, *dyf_{}, *drf_{}, *rprev_{}, *jprev_{}, *jdprev_{};
+            // // SoA: last tick health
+            double *clamp_mag_{}, *rate_mag_{}, *jerk_mag_{}, *aw_mag_{};
+            Scalar* jerk_hit_{};
+
+            // // scheduling
+            std::span<const ScheduleConfig> sched_{};
+            std::uint32_t* sched_idx_{};
+            std::size_t n_sched_{0};
+
+            // // bank wide deadline accounting
+            std::optional<safety::Watchdog> wd_;
+            std::uint64_t deadline_miss_count_{0};
+            bool fallback_active_{false};
+    };
+
+} // namespace ictk::control::pid
@@ -0,0 +1,363 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <type_traits>
+
+#include "ictk/core/health.hpp"
+#include "ictk/core/controller.hpp"
+#include "ictk/core/memory_arena.hpp"
+
+#include "ictk/safety/watchdog.hpp"
+#include "ictk/safety/chain_step.hpp"   // ChainStep, safety::fold
+#include "ictk/safety/jerk_limit.hpp"
+#include "ictk/safety/rate_limit.hpp"
+#include "ictk/safety/saturation.hpp"
+#include "ictk/safety/anti_windup.hpp"
+
+#include "ictk/control/pid/pid_law.hpp"
+
+/*
+FixedPIDCore<N, T>: PIDCore with the channel count fixed at build time
+    PIDCore: nu known at init -> every loop has a runtime bound, arena arrays, n>64 check + mask build per tick,
+        virtual compute_core / apply_* per tick
+    here: N is a template parameter -> std::array state inside the object (zero arena bytes), loops the compiler can unroll,
+        valid mask is a constant, stages run fused (sat -> rate -> jerk per channel), no virtual call inside the tick
+
+    T: arithmetic of the law and the limiters (Scalar by default). I/O stays Scalar (PlantState, Setpoint, Result).
+        T = Scalar -> byte-identical u and health to PIDCore with the same PIDConfig
+    the math is not repeated here: the law, config rules and filter are pid::law (pid_law.hpp), the limiter steps
+        are safety::clamp_scalar / rate_limiter_scalar / jerk_step_scalar, anti windup is safety::aw_term;
+        this class only owns the std::array state and the compile-time loops around them
+
+    configure() takes the same PIDConfig; validate() is constexpr -> a config built from constexpr arrays
+        (e.g. returned by a constexpr function) can be checked with static_assert(FixedPIDCore<2>::validate(cfg()) == Status::kOK)
+
+    stricter than PIDCore where PIDCore would read past a span:
+        per channel spans must have 0, 1 (broadcast) or N entries; umin/umax come together
+*/
+namespace ictk::control::pid{
+
+    template <std::size_t N, class T = Scalar>
+    class FixedPIDCore final : public IController{
+            static_assert(N >= 1 && N <= 64, "FixedPIDCore: 1..64 channels (one u64 validity mask)");
+            static_assert(std::is_floating_point_v<T>, "FixedPIDCore: T must be a floating point type");
+
+            using Arr = std::array<T, N>;
+
+        public:
+            static constexpr std::size_t kChannels = N;
+            static constexpr std::uint64_t kValidMask = (N == 64) ? ~0ull : ((1ull << N) - 1ull);
+
+            FixedPIDCore() = default;
+
+            // // all rules configure() applies; usable in constant expressions
+            [[nodiscard]] static constexpr Status validate(const PIDConfig& cfg) noexcept{
+                // // 0, 1 (broadcast) or N entries
+                constexpr auto fits = [](std::span<const Scalar> s) noexcept{
+                    return s.empty() || s.size() == 1 || s.size() == N;
+                };
+                if (!fits(cfg.Kp) || !fits(cfg.Kd) || !fits(cfg.Ki) || !fits(cfg.beta) || !fits(cfg.gamma) ||
+                    !fits(cfg.tau_f) || !fits(cfg.N) || !fits(cfg.u_ff_bias) ||
+                    !fits(cfg.umin) || !fits(cfg.umax) || !fits(cfg.du_max)) return Status::kInvalidArg;
+
+                // // one sided saturation is not a limit
+                if (cfg.umin.empty() != cfg.umax.empty()) return Status::kInvalidArg;
+
+                // // β in [0, 1], γ = 0 (PIDLaw's rule)
+                if (Status st = law::check_weights(cfg, N); st != Status::kOK) return st;
+
+                // // jerk limit: uniform rmax = du_max[0], jmax = ddu_max[0], both >= 0
+                if (!cfg.ddu_max.empty()){
+                    if (!(cfg.ddu_max[0] >= 0)) return Status::kInvalidArg;
+                    if (!cfg.du_max.empty() && !(cfg.du_max[0] >= 0)) return Status::kInvalidArg;
+                }
+
+                // // schedule: PIDLaw's rule
+                return law::check_schedule(cfg.sched);
+            }
+
+            // // arena is not touched: all state lives in the object
+            [[nodiscard]] Status init(const Dims& d, dt_ns dt_ns_i, MemoryArena&, const Hooks& h = {}) noexcept override{
+                if (d.nu != N || d.ny != N) return Status::kInvalidArg;
+
+                dims_ = d;
+                dt_ = dt_ns_i;
+                hooks_ = h;
+                started_ = false;
+                configured_ = false;
+                last_t_ = -1;
+                health_ = {};
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status configure(const PIDConfig& cfg) noexcept{
+                if (Status st = validate(cfg); st != Status::kOK) return st;
+
+                const T dt_s = static_cast<T>(dt_) * T(1e-9);
+
+                // // gains, weights, bias (broadcast / default like PIDLaw::fill_array)
+                fill(kp_, cfg.Kp, 0);
+                fill(kd_, cfg.Kd, 0);
+                fill(ki_, cfg.Ki, 0);
+                fill(beta_, cfg.beta, 1);
+                fill(gamma_, cfg.gamma, 0);
+                fill(uff_, cfg.u_ff_bias, 0);
+
+                // // Tustin derivative filter per channel
+                for (std::size_t i=0; i<N; ++i) filt_[i] = law::tustin(cfg, i, dt_s);
+
+                aw_mode_ = cfg.aw_mode;
+                Kt_ = static_cast<T>(cfg.Kt);
+                sched_ = cfg.sched;
+
+                // // safety stages (same step sizes the arena limiters compute per tick)
+                sat_on_ = !cfg.umin.empty();
+                rate_on_ = !cfg.du_max.empty();
+                jerk_on_ = !cfg.ddu_max.empty();
+                if (sat_on_){
+                    fill(umin_, cfg.umin, 0);
+                    fill(umax_, cfg.umax, 0);
+                }
+                if (rate_on_){
+                    Arr r{};
+                    fill(r, cfg.du_max, 0);
+                    for (std::size_t i=0; i<N; ++i) rstep_[i] = r[i] * dt_s;
+                }
+                if (jerk_on_){
+                    const T rmax = (!cfg.du_max.empty() ? static_cast<T>(cfg.du_max[0]) : T(0));
+                    jl_rstep_ = rmax * dt_s;
+                    jl_jstep_ = static_cast<T>(cfg.ddu_max[0]) * dt_s;
+                }
+
+                // watchdog
+                wd_.reset();
+                if (cfg.miss_threshold > 0) wd_.emplace(dt_, cfg.miss_threshold, cfg.watchdog_slack);
+
+                // // integrator, filter and limiter state
+                for (std::size_t i=0; i<N; ++i){
+                    integ_[i] = 0;
+                    dyf_[i] = 0;
+                    drf_[i] = 0;
+                    y_prev_[i] = 0;
+                    r_prev_[i] = 0;
+                    kidt_[i] = ki_[i] * dt_s;
+                    rl_prev_[i] = 0;
+                    jl_prev_[i] = 0;
+                    jl_dprev_[i] = 0;
+                }
+
+                dt_s_ = dt_s;
+                configured_ = true;
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status start() noexcept override{
+                if (!configured_) return Status::kNotReady;
+                started_ = true;
+                last_t_ = -1;
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status stop() noexcept override{
+                started_ = false;
+                return Status::kOK;
+            }
+
+            // // same as PIDCore::reset: law state cleared, limiter history kept
+            [[nodiscard]] Status reset() noexcept override{
+                last_t_ = -1;
+                health_.clear_runtime();
+                for (std::size_t i=0; i<N; ++i){
+                    integ_[i] = 0;
+                    dyf_[i] = 0;
+                    drf_[i] = 0;
+                    y_prev_[i] = 0;
+                    r_prev_[i] = 0;
+                }
+                return Status::kOK;
+            }
+
+            // // same order and health wiring as ControllerBase::update
+            [[nodiscard]] Status update(const UpdateContext& ctx, Result& out) noexcept override{
+                health_.clear_runtime();
+
+                if (!started_) return Status::kNotReady;
+
+                if (out.u.size() != N) return Status::kInvalidArg;
+                if (ctx.plant.y.size() != N) return Status::kInvalidArg;
+                if (ctx.sp.r.size() != N) return Status::kInvalidArg;
+                if (!ctx.plant.xhat.empty() && ctx.plant.xhat.size() != dims_.nx) return Status::kInvalidArg;
+
+                const auto d = ctx.plant.t - last_t_;
+                if (last_t_ >= 0 && d != dt_) health_.deadline_miss_count += std::max<t_ns>(1, d / dt_) - 1;
+                last_t_ = ctx.plant.t;
+
+                // // 1- core control law
+                if ((ctx.plant.valid_bits & kValidMask) != kValidMask) return Status::kPreconditionFail;
+                if (wd_){
+                    if (wd_->tick(ctx.plant.t)) health_.fallback_active = true;
+                }
+                compute_(ctx, out.u);
+
+                // // 2- pre output clamp hook
+                if (hooks_.pre_clamp) hooks_.pre_clamp(out.u, hooks_.user);
+
+                // // 3- safety chain, one pass per channel
+                ChainStep chain{};
+                const unsigned sel = (sat_on_ ? 4u : 0u) | (rate_on_ ? 2u : 0u) | (jerk_on_ ? 1u : 0u);
+                switch (sel){
+                    case 0: chain_<false, false, false>(out.u, chain); break;
+                    case 1: chain_<false, false, true >(out.u, chain); break;
+                    case 2: chain_<false, true,  false>(out.u, chain); break;
+                    case 3: chain_<false, true,  true >(out.u, chain); break;
+                    case 4: chain_<true,  false, false>(out.u, chain); break;
+                    case 5: chain_<true,  false, true >(out.u, chain); break;
+                    case 6: chain_<true,  true,  false>(out.u, chain); break;
+                    default: chain_<true, true,  true >(out.u, chain); break;
+                }
+
+                // // 4- anti windup
+                anti_windup_(out.u);
+
+                // // 5- health wiring
+                health_.saturation_pct = chain.sat.pct;
+                health_.rate_limit_hits += chain.rate_hits;
+                health_.jerk_limit_hits += chain.jerk_hits;
+                health_.last_clamp_mag = chain.clamp_mag;
+                health_.last_rate_clip_mag = chain.rate_mag;
+                health_.last_jerk_clip_mag = chain.jerk_mag;
+                health_.sat_hit_mask = chain.sat_mask;
+                health_.rate_hit_mask = chain.rate_mask;
+                health_.jerk_hit_mask = chain.jerk_mask;
+                health_.aw_term_mag = chain.aw_sum;
+
+                // // 6- post output arbitration
+                if (hooks_.post_arbitrate) hooks_.post_arbitrate(std::span<const Scalar>(pre_.data(), N), out.u, hooks_.user);
+
+                // // 7- attach health
+                out.health = health_;
+                return Status::kOK;
+            }
+
+            CommandMode mode() const noexcept override{
+                return CommandMode::Primary;
+            }
+
+            // Bumpless transfer (same rule as PIDLaw::align_bumpless)
+            void align_bumpless(std::span<const Scalar> u_hold, std::span<const Scalar> r0, std::span<const Scalar> y0) noexcept{
+                const std::size_t m = std::min({u_hold.size(), r0.size(), y0.size(), N});
+                for (std::size_t i=0; i<m; ++i){
+                    integ_[i] = law::bumpless_integ(static_cast<T>(u_hold[i]), kp_[i], kd_[i], beta_[i], uff_[i],
+                                                       static_cast<T>(r0[i]), static_cast<T>(y0[i]), dyf_[i]);
+                    y_prev_[i] = static_cast<T>(y0[i]);
+                    r_prev_[i] = static_cast<T>(r0[i]);
+                }
+            }
+
+            // // outer loop of a cascade (see PIDCore::track)
+            void track(std::span<const Scalar> u_cmd, std::span<const Scalar> u_achieved) noexcept{
+                const std::size_t m = std::min({u_cmd.size(), u_achieved.size(), N});
+                for (std::size_t i=0; i<m; ++i){
+                    integ_[i] += safety::aw_term(aw_mode_, static_cast<T>(u_cmd[i]), static_cast<T>(u_achieved[i]), Kt_);
+                }
+            }
+
+        private:
+            static void fill(Arr& dst, std::span<const Scalar> src, Scalar def) noexcept{
+                for (std::size_t i=0; i<N; ++i) dst[i] = static_cast<T>(law::pick(src, i, def));
+            }
+
+            void compute_(const UpdateContext& ctx, std::span<Scalar> u) noexcept{
+                // // scheduling over y[0] (PIDLaw's interpolation)
+                const bool use_sched = !sched_.bp.empty();
+                const law::Gains<T> sg = use_sched ? law::scheduled(sched_, static_cast<T>(ctx.plant.y[0])) : law::Gains<T>{};
+
+                for (std::size_t i=0; i<N; ++i){
+                    const law::Gains<T> g = use_sched ? sg : law::Gains<T>{kp_[i], ki_[i], kd_[i], beta_[i], gamma_[i]};
+                    u[i] = static_cast<Scalar>(law::step(g, filt_[i], static_cast<T>(ctx.plant.y[i]), static_cast<T>(ctx.sp.r[i]),
+                                                           integ_[i], uff_[i], law::ChannelState<T>{y_prev_[i], r_prev_[i], dyf_[i], drf_[i]}, e_[i]));
+                    kidt_[i] = g.ki * dt_s_;
+                }
+            }
+
+            // // sat -> rate -> jerk per channel, one pass; stages off at compile time; health via safety::fold
+            template <bool kSat, bool kRate, bool kJerk>
+            void chain_(std::span<Scalar> u, ChainStep& step) noexcept{
+                for (std::size_t i=0; i<N; ++i){
+                    const T v0 = static_cast<T>(u[i]);
+                    const std::uint64_t bit = safety::chain_bit(i);
+                    pre_[i] = u[i];
+                    T v = v0;
+
+                    if constexpr (kSat){
+                        const auto c = safety::clamp_scalar(v, umin_[i], umax_[i]);
+                        safety::fold<StageKind::kSaturation>(step, c, v, bit);
+                        v = c.val;
+                    }
+
+                    if constexpr (kRate){
+                        const auto c = safety::rate_limiter_scalar(v, rl_prev_[i], rstep_[i]);
+                        safety::fold<StageKind::kRate>(step, c, v, bit);
+                        rl_prev_[i] = c.val;
+                        v = c.val;
+                    }
+
+                    if constexpr (kJerk){
+                        const auto c = safety::jerk_step_scalar(v, jl_prev_[i], jl_dprev_[i], jl_rstep_, jl_jstep_);
+                        safety::fold<StageKind::kJerk>(step, c, v, bit);
+                        v = c.val;
+                    }
+
+                    safety::fold_channel(step, v, v0);
+                    u[i] = static_cast<Scalar>(v);
+                }
+
+                if constexpr (kSat) safety::fold_sat_pct(step, N);
+            }
+
+            void anti_windup_(std::span<const Scalar> u_sat) noexcept{
+                for (std::size_t i=0; i<N; ++i){
+                    const T us = static_cast<T>(u_sat[i]);
+                    const T uu = static_cast<T>(pre_[i]);
+                    const T i_inc = kidt_[i] * e_[i];
+                    integ_[i] += i_inc + safety::aw_term(aw_mode_, uu, us, Kt_);
+                }
+            }
+
+            Dims             dims_{};
+            dt_ns            dt_{0};
+            Hooks            hooks_{};
+            bool             started_{false};
+            bool             configured_{false};
+            t_ns             last_t_{-1};
+            ControllerHealth health_{};
+
+            // // law
+            Arr kp_{}, kd_{}, ki_{}, beta_{}, gamma_{}, uff_{};
+            Arr integ_{}, y_prev_{}, r_prev_{}, dyf_{}, drf_{};
+            std::array<law::Tustin<T>, N> filt_{};
+            Arr e_{}, kidt_{};
+            T dt_s_{0};
+            T Kt_{0};
+            safety::AWMode aw_mode_{safety::AWMode::kBackCalc};
+            ScheduleConfig sched_{};
+
+            // // safety stages
+            bool sat_on_{false}, rate_on_{false}, jerk_on_{false};
+            Arr umin_{}, umax_{};
+            Arr rstep_{}, rl_prev_{};
+            Arr jl_prev_{}, jl_dprev_{};
+            T jl_rstep_{0}, jl_jstep_{0};
+            std::optional<safety::Watchdog> wd_;
+
+            // // post pre clamp snapshot (u_pre for anti windup and post_arbitrate)
+            std::array<Scalar, N> pre_{};
+    };
+
+} // namespace ictk::control::pid
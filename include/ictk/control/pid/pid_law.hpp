@@ -0,0 +1,382 @@
+#pragma once
+
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include "ictk/core/types.hpp"
+#include "ictk/core/time.hpp"
+#include "ictk/core/status.hpp"
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/core/update_context.hpp"
+
+#include "ictk/safety/anti_windup.hpp"
+
+/*
+PID law shared by PIDCore (virtual ControllerBase) and StaticPIDCore (CRTP StaticControllerBase)
+    owns gains, filter coefficients and integrator/derivative state (arena arrays)
+    no safety objects, no health: the controller around it wires those
+    per channel math (config rules, filter coefficients, schedule, the law itself) lives in law:: below
+        -> FixedPIDCore<N, T> runs the same functions over std::array state, nothing is written twice
+*/
+namespace ictk::control::pid{
+
+    // picewise-linear gain scheduling
+    struct ScheduleConfig{
+        // bp => strictly increasing breakpoints, *_tab => same length as bp, pre breakpoints value || interpolate at runtimeS
+        std::span<const Scalar> bp, kp_tab, ki_tab, kd_tab, beta_tab, gamma_tab;
+    };
+
+
+    struct PIDConfig{
+        // // gains
+        std::span<const Scalar> Kp, Kd, Ki;
+        // // setpoint weights
+        std::span<const Scalar> beta, gamma;
+        // // derivative filter
+        std::span<const Scalar> tau_f, N;
+        // // feed forward bias
+        std::span<const Scalar> u_ff_bias;
+        // // safety => umin, umax -> saturation; du_max, ddu_max -> rate, jerk limits/
+        std::span<const Scalar> umin, umax, du_max, ddu_max;
+
+        // anti windup
+        ictk::safety::AWMode aw_mode{ictk::safety::AWMode::kBackCalc};
+        Scalar Kt{0.0}; // back calc gain
+
+        // watchdog
+        std::uint32_t miss_threshold{0};
+        dt_ns watchdog_slack{0};
+
+        // fallback targ
+        std::span<const Scalar> safe_u;
+
+        // ramp speed
+        Scalar fb_ramp_rate{0.0};
+
+        // breakpoint and tables
+        ScheduleConfig sched{};
+    };
+
+
+    namespace law{
+        // // value of a per channel config span: one entry broadcasts, missing entries take def
+        constexpr Scalar pick(std::span<const Scalar> s, std::size_t i, Scalar def) noexcept{
+            return s.size() == 1 ? s[0] : (i < s.size() ? s[i] : def);
+        }
+
+        // // β in [0, 1], γ = 0 on channels [0, n); Cfg: PIDConfig or PIDBankConfig
+        template <class Cfg>
+        constexpr Status check_weights(const Cfg& cfg, std::size_t n) noexcept{
+            for (std::size_t i=0; i<n; ++i){
+                const Scalar b = pick(cfg.beta, i, Scalar(1));
+                const Scalar g = pick(cfg.gamma, i, Scalar(0));
+                if (!(b>=0 && b<=1)) return Status::kInvalidArg;
+                if (g != Scalar(0))  return Status::kInvalidArg;
+            }
+            return Status::kOK;
+        }
+
+        // // empty, or >= 2 strictly increasing breakpoints (cannot interpolate from 1) with every table 1:1 with bp
+        constexpr Status check_schedule(const ScheduleConfig& s) noexcept{
+            if (s.bp.empty()) return Status::kOK;
+            const std::size_t B = s.bp.size();
+            if (B < 2) return Status::kInvalidArg;
+            for (std::size_t i=1; i<B; ++i) if (!(s.bp[i] > s.bp[i-1])) return Status::kInvalidArg;
+            if (s.kp_tab.size()!= B || s.ki_tab.size()!= B || s.kd_tab.size() != B ||
+                s.beta_tab.size() !=B || s.gamma_tab.size()!= B) return Status::kInvalidArg;
+            return Status::kOK;
+        }
+
+        // // first order derivative filter, bilinear (Tustin): dy_k = b (y_k - y_{k-1}) + a1 dy_{k-1}
+        template <class T>
+        struct Tustin{
+            T a1{0};
+            T b{0};
+        };
+
+        // // channel i: tau_f wins over N (no broadcast for either); Cfg: PIDConfig or PIDBankConfig
+        template <class Cfg, class T>
+        Tustin<T> tustin(const Cfg& cfg, std::size_t i, T dt_s) noexcept{
+            T tf = 0;
+            if (i < cfg.tau_f.size()) tf = static_cast<T>(cfg.tau_f[i]);
+            else if (i < cfg.N.size()){
+                const T N = static_cast<T>(cfg.N[i]);
+                tf = (N > 0) ? (T(1)/N) : T(0);
+            }
+            const T den = T(2) * tf + dt_s;
+            const T num = T(2) * tf - dt_s;
+            return {(den > 0) ? (num / den) : T(0), (den > 0) ? (T(2) / den) : T(0)};
+        }
+
+        // // gains and setpoint weights of one channel for this tick
+        template <class T>
+        struct Gains{
+            T kp{0}, ki{0}, kd{0}, beta{1}, gamma{0};
+        };
+
+        template <class T>
+        inline T lerp(T a, T b, T t) noexcept{
+            return a + (b-a) * t;
+        }
+
+        // // piecewise linear schedule over var (clamped to the end breakpoints); s.bp must be non empty
+        template <class T>
+        Gains<T> scheduled(const ScheduleConfig& s, T var) noexcept{
+            const std::size_t B = s.bp.size();
+            auto it = std::upper_bound(s.bp.begin(), s.bp.end(), static_cast<Scalar>(var));
+            const std::size_t i1 = std::clamp<std::size_t>(static_cast<std::size_t>(it - s.bp.begin()), 1, B - 1);
+
+            // parametic weight for interpolation between bp[i0] and bp[i1]
+            const std::size_t i0 = i1 - 1;
+            const T x0 = static_cast<T>(s.bp[i0]), x1 = static_cast<T>(s.bp[i1]);
+            const T t = (x1!=x0) ? (std::clamp(var, x0, x1) - x0) / (x1-x0) : T(0);
+
+            const auto at = [t, i0, i1](std::span<const Scalar> tab) noexcept{
+                return lerp(static_cast<T>(tab[i0]), static_cast<T>(tab[i1]), t);
+            };
+            return {at(s.kp_tab), at(s.ki_tab), at(s.kd_tab), at(s.beta_tab), at(s.gamma_tab)};
+        }
+
+        // // filter and sample history of one channel
+        template <class T>
+        struct ChannelState{
+            T& y_prev;
+            T& r_prev;
+            T& dyf;
+            T& drf;
+        };
+
+        // // one channel, one tick: 2-DOF PID with filtered derivative on (γ r - y); returns u, e_out = weighted error
+        template <class T>
+        T step(const Gains<T>& g, const Tustin<T>& f, T yk, T rk, T integ, T uff, ChannelState<T> st, T& e_out) noexcept{
+            const T e = g.beta * rk - yk;
+
+            const T dy = f.b * (yk - st.y_prev) + f.a1 * st.dyf;
+            const T dr = f.b * (rk - st.r_prev) + f.a1 * st.drf;
+
+            st.dyf = dy;
+            st.drf = dr;
+            st.y_prev = yk;
+            st.r_prev = rk;
+
+            const T P = g.kp * e;
+            const T D = -g.kd * (dy - g.gamma * dr);
+            e_out = e;
+            return P + integ + D + uff;
+        }
+
+        // // integrator so that the law gives u_hold at (r0, y0) with the filter state as it is (bumpless transfer)
+        template <class T>
+        T bumpless_integ(T u_hold, T kp, T kd, T beta, T uff, T r0, T y0, T ydot0) noexcept{
+            const T e0 = beta * r0 - y0;
+            return u_hold - (kp * e0 - kd * ydot0 + uff);
+        }
+    } // namespace law
+
+
+    class PIDLaw{
+        public:
+            // // allocate + fill per channel arrays, validate beta/gamma and the schedule
+            [[nodiscard]] Status configure(const PIDConfig& cfg, std::size_t nu, dt_ns dt, MemoryArena& a) noexcept{
+                const Scalar dt_s = static_cast<Scalar>(dt) * 1e-9;
+                arena_ = &a;
+                n_ = nu;
+
+                // gains
+                kp_ = alloc(nu, "pid.kp"); // proportional gains
+                kd_ = alloc(nu, "pid.kd"); // derivative gains
+                ki_ = alloc(nu, "pid.ki"); // integral gains
+
+                // setpoint weights -> for PIDF
+                /*
+                if B = 1: e = r - y
+                if B < 1: reduce proportional action on step changes setpoint (less overshoot)
+                gamma: weight of derivative on setpoint
+                */
+                beta_ = alloc(nu, "pid.beta");
+                gamma_ = alloc(nu, "pid.gamma");
+
+                // feed forward bias
+                uff_ = alloc(nu, "pid.uff");
+
+                // integrator state
+                integ_=alloc(nu, "pid.integ");
+
+                // last samples for difference operations
+                y_prev_=alloc(nu, "pid.y_prev"); // measurement
+                r_prev_=alloc(nu, "pid.r_prev"); // reference
+
+                // filtered derivatives or y and r
+                dyf_=alloc(nu, "pid.dyf"); // filtered derivative for reference y
+                drf_=alloc(nu, "pid.drf"); // filtered derivative for reference r
+
+                // filter coefficients for 1st order derivative filter
+                a1_=alloc(nu, "pid.a1");
+                b_=alloc(nu, "pid.b");
+
+                // scratch
+                tmp_=alloc(nu, "pid.tmp");
+
+                // cached Ki * dt_s per channel for fast integration
+                kidt_=alloc(nu, "pid.kidt");
+
+                // // If any allocs fails: return kNoMem
+                if (!ready()) return Status::kNoMem;
+
+                // // fill_array(destination, source, default)
+                fill_array(kp_, cfg.Kp, 0);
+                fill_array(kd_, cfg.Kd, 0);
+                fill_array(ki_, cfg.Ki, 0);
+
+                fill_array(beta_, cfg.beta, 1);
+                fill_array(gamma_, cfg.gamma, 0);
+                fill_array(uff_, cfg.u_ff_bias, 0);
+
+                // // derivative filter coefficients (Tustin: feedback a1, feed forward b)
+                for (std::size_t i=0; i<nu; ++i){
+                    const law::Tustin<Scalar> f = law::tustin(cfg, i, dt_s);
+                    a1_[i] = f.a1;
+                    b_[i] = f.b;
+                }
+
+                // β, γ ranges
+                if (Status st = law::check_weights(cfg, nu); st != Status::kOK) return st;
+
+                aw_mode_ = cfg.aw_mode;
+                Kt_ = cfg.Kt;
+
+                // // Scheduling setup: breakpoints strictly increasing, each table 1:1 with bp
+                if (Status st = law::check_schedule(cfg.sched); st != Status::kOK) return st;
+                if (!cfg.sched.bp.empty()) sched_ = cfg.sched;
+
+                for (std::size_t i=0; i<nu; ++i){
+                    integ_[i] = 0;              // integrator sate reset
+                    dyf_[i] = 0;                // filtered d(y)
+                    drf_[i] = 0;                // filtered d(r) if used
+                    y_prev_[i] = 0;             // last measurement
+                    r_prev_[i] = 0;             // last setpoit
+                    kidt_[i] = ki_[i] * dt_s;   // cache ki*dt per channel
+                }
+
+                dt_s_ = dt_s;
+                return Status::kOK;
+            }
+
+            bool ready() const noexcept{
+                return kp_ && ki_ && kd_ && beta_ && gamma_ && uff_ && integ_ && y_prev_ && r_prev_ &&
+                       dyf_ && drf_ && a1_ && b_ && tmp_ && kidt_;
+            }
+
+            // // reset
+            void reset() noexcept{
+                if (!integ_ || !dyf_ || !drf_ || !y_prev_ || !r_prev_ ) return;
+                for (std::size_t i=0; i<n_; ++i){
+                    integ_[i] = 0;
+                    dyf_[i] = 0;
+                    drf_[i] = 0;
+                    y_prev_[i] = 0;
+                    r_prev_[i] = 0;
+                }
+            }
+
+            // Bumpless transfer
+            void align_bumpless(std::span<const Scalar> u_hold, std::span<const Scalar> r0, std::span<const Scalar> y0) noexcept{
+                const std::size_t m = std::min({
+                    u_hold.size(),
+                    r0.size(),
+                    y0.size()
+                });
+
+                for (std::size_t i=0; i<m; ++i){
+                    // // ydot0 = dyf_: simple consistent init; To DO: Back solve (reminder: check during gold cart impl)
+                    integ_[i] = law::bumpless_integ(u_hold[i], kp_[i], kd_[i], beta_[i], uff_[i], r0[i], y0[i], dyf_[i]);
+                    y_prev_[i] = y0[i];
+                    r_prev_[i] = r0[i];
+                }
+            }
+
+            // // channel count and validity mask; runs before anything mutates
+            [[nodiscard]] Status precheck(const UpdateContext& ctx) const noexcept{
+                // // no of outputs/channels
+                const std::size_t n = n_;
+
+                if (n > 64) return Status::kInvalidArg;  // cannot validate >64 bits with a u64
+
+                // check al n channels valid this tick
+                const std::uint64_t mask = (n == 64) ? ~0ull : ((1ull << n) - 1ull);
+                if ((ctx.plant.valid_bits & mask) != mask) return Status::kPreconditionFail;
+                return Status::kOK;
+            }
+
+            void compute(const UpdateContext& ctx, std::span<Scalar> u) noexcept{
+                const std::size_t n = n_;
+
+                // scheduling over y[0] -> to do: put it PID.md
+                const bool use_sched = !sched_.bp.empty();
+                const law::Gains<Scalar> sg = use_sched ? law::scheduled(sched_, ctx.plant.y[0]) : law::Gains<Scalar>{};
+
+                // / Per channel PID form
+                for (std::size_t i=0; i<n; ++i){
+                    // pick scheduled gains if enabled, else per channel
+                    const law::Gains<Scalar> g = use_sched ? sg : law::Gains<Scalar>{kp_[i], ki_[i], kd_[i], beta_[i], gamma_[i]};
+
+                    u[i] = law::step(g, law::Tustin<Scalar>{a1_[i], b_[i]}, ctx.plant.y[i], ctx.sp.r[i], integ_[i], uff_[i],
+                                       law::ChannelState<Scalar>{y_prev_[i], r_prev_[i], dyf_[i], drf_[i]}, tmp_[i]);
+                    kidt_[i] = g.ki * dt_s_;
+                }
+            }
+
+            void anti_windup(std::span<const Scalar> u_unsat, std::span<const Scalar> u_sat) noexcept{
+                const std::size_t n = n_;
+                for (std::size_t i=0;i<n;++i){
+                    const Scalar e = tmp_[i];
+                    const Scalar i_inc = kidt_[i] * e;
+                    integ_[i] += i_inc + aw_term(u_unsat[i], u_sat[i]);
+                }
+            }
+
+            // // external tracking (cascade outer loop): downstream could only follow u_achieved of u_cmd
+            // // same AW mode and Kt, no integration step; channels past either span are left alone
+            void track(std::span<const Scalar> u_cmd, std::span<const Scalar> u_achieved) noexcept{
+                const std::size_t m = std::min({u_cmd.size(), u_achieved.size(), n_});
+                for (std::size_t i=0; i<m; ++i){
+                    integ_[i] += aw_term(u_cmd[i], u_achieved[i]);
+                }
+            }
+
+        private:
+            Scalar aw_term(Scalar u_unsat, Scalar u_sat) const noexcept{
+                return safety::aw_term(aw_mode_, u_unsat, u_sat, Kt_);
+            }
+
+            Scalar* alloc(std::size_t n, const char* label) noexcept{
+                return static_cast<Scalar*>(arena_->allocate(n*sizeof(Scalar), alignof(Scalar), label));
+            }
+
+            /*
+            solves user config -> PIDConfig -> provides gains and weights as span const scalar
+            */
+            void fill_array(Scalar* dst, std::span<const Scalar> src, Scalar def) noexcept{
+                // // one value broadcasts to all channels, else copy what is given and fill the rest with def
+                for (std::size_t i=0; i<n_; ++i) dst[i] = law::pick(src, i, def);
+            }
+
+            MemoryArena* arena_{nullptr};
+            std::size_t n_{0};
+
+            Scalar *kp_{}, *kd_{}, *ki_{}, *beta_{}, *gamma_{}, *uff_{};
+            Scalar *integ_{}, *y_prev_{}, *r_prev_{}, *dyf_{}, *drf_{}, *a1_{}, *b_{};
+            Scalar *tmp_{}, *kidt_{};
+            Scalar dt_s_{0};
+
+            ictk::safety::AWMode aw_mode_{
+                ictk::safety::AWMode::kBackCalc
+            };
+
+            Scalar Kt_{0};
+            ScheduleConfig sched_{};
+    };
+
+} // namespace ictk::control::pid
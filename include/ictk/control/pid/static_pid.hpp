@@ -0,0 +1,136 @@
+#pragma once
+
+#include <span>
+#include <cstddef>
+#include <optional>
+
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/core/static_controller_base.hpp"
+
+#include "ictk/safety/saturation.hpp"
+#include "ictk/safety/rate_limit.hpp"
+#include "ictk/safety/jerk_limit.hpp"
+#include "ictk/safety/watchdog.hpp"
+#include "ictk/safety/stage_traits.hpp"
+
+#include "ictk/control/pid/pid_law.hpp"
+
+/*
+StaticPIDCore<Stages...>: PIDCore on StaticControllerBase
+    same PIDLaw, same limiters, same numbers; the stage list is the chain (in order), fixed at compile time
+        StaticPIDCore<>                                                  -> no limits
+        StaticPIDCore<safety::Saturation>                                -> umin/umax
+        StaticPIDCore<safety::Saturation, safety::RateLimiter, safety::JerkLimiter> -> PIDCore with all limits
+
+    configure(): a listed stage needs its limits in PIDConfig, limits for an unlisted stage are rejected
+        (kInvalidArg either way -> the config and the type can not silently disagree)
+    hooks: BasicStaticPIDCore<Hk, Stages...> derives from Hk; Hk::pre_clamp / Hk::post_arbitrate are picked up at compile time
+    IController view: StaticControllerAdapter<StaticPIDCore<...>>
+*/
+namespace ictk::control::pid{
+
+    // // hook policy with no hooks
+    struct NoStaticHooks{};
+
+    template <class Hk, class... Stages>
+    class BasicStaticPIDCore final
+        : public StaticControllerBase<BasicStaticPIDCore<Hk, Stages...>, Stages...>,
+          public Hk{
+
+            using Base = StaticControllerBase<BasicStaticPIDCore<Hk, Stages...>, Stages...>;
+            friend Base;
+
+        public:
+            BasicStaticPIDCore() = default;
+
+            [[nodiscard]] Status init(const Dims& d, dt_ns dt_ns_i, MemoryArena& a) noexcept{
+                if (d.nu == 0 || d.ny == 0 || d.nu != d.ny) return Status::kInvalidArg;
+                return Base::init(d, dt_ns_i, a);
+            }
+
+            [[nodiscard]] Status configure(const PIDConfig& cfg) noexcept{
+                const std::size_t nu = this->dims().nu;
+
+                // // stage list and config must agree
+                const bool has_sat = !cfg.umin.empty() || !cfg.umax.empty();
+                const bool has_rate = !cfg.du_max.empty();
+                const bool has_jerk = !cfg.ddu_max.empty();
+                if (has_sat != Base::template has_stage<safety::Saturation>()) return Status::kInvalidArg;
+                if (has_rate != Base::template has_stage<safety::RateLimiter>()) return Status::kInvalidArg;
+                if (has_jerk != Base::template has_stage<safety::JerkLimiter>()) return Status::kInvalidArg;
+
+                if (Status st = law_.configure(cfg, nu, this->dt(), this->arena()); st != Status::kOK) return st;
+
+                // // same construction as PIDCore::configure
+                if constexpr (Base::template has_stage<safety::Saturation>()){
+                    this->template stage<safety::Saturation>().emplace(cfg.umin, cfg.umax);
+                }
+                if constexpr (Base::template has_stage<safety::RateLimiter>()){
+                    auto& rl = this->template stage<safety::RateLimiter>();
+                    rl.emplace(cfg.du_max, this->dt(), this->arena(), nu);
+                    if (!rl->valid()) return Status::kNoMem;
+                }
+                if constexpr (Base::template has_stage<safety::JerkLimiter>()){
+                    const Scalar rmax = (!cfg.du_max.empty() ? cfg.du_max[0] : Scalar(0));
+                    const Scalar jmax = cfg.ddu_max[0];
+                    auto& jl = this->template stage<safety::JerkLimiter>();
+                    jl.emplace(rmax, jmax, this->dt(), this->arena(), nu);
+                    if (!jl->valid()) return Status::kNoMem;
+                }
+
+                // watchdog
+                if (cfg.miss_threshold > 0) wd_.emplace(this->dt(), cfg.miss_threshold, cfg.watchdog_slack);
+
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status start() noexcept{
+                if (!law_.ready()) return Status::kNotReady;
+                return Base::start();
+            }
+
+            [[nodiscard]] Status reset() noexcept{
+                Status base = Base::reset();
+                law_.reset();
+                return base;
+            }
+
+            // Bumpless transfer
+            void align_bumpless(std::span<const Scalar> u_hold, std::span<const Scalar> r0, std::span<const Scalar> y0) noexcept{
+                law_.align_bumpless(u_hold, r0, y0);
+            }
+
+            // // outer loop of a cascade (see PIDCore::track)
+            void track(std::span<const Scalar> u_cmd, std::span<const Scalar> u_achieved) noexcept{
+                law_.track(u_cmd, u_achieved);
+            }
+
+        private:
+            [[nodiscard]] Status compute_core(const UpdateContext& ctx, std::span<Scalar> u) noexcept{
+                if (Status st = law_.precheck(ctx); st != Status::kOK) return st;
+
+                // fallback latch
+                if (wd_){
+                    if (wd_->tick(ctx.plant.t)) this->health().fallback_active = true;
+                }
+
+                law_.compute(ctx, u);
+                return Status::kOK;
+            }
+
+            void anti_windup_update(
+                const UpdateContext&,
+                std::span<const Scalar> u_unsat,
+                std::span<const Scalar> u_sat
+            ) noexcept{
+                law_.anti_windup(u_unsat, u_sat);
+            }
+
+            PIDLaw law_{};
+            std::optional<safety::Watchdog> wd_;
+    };
+
+    template <class... Stages>
+    using StaticPIDCore = BasicStaticPIDCore<NoStaticHooks, Stages...>;
+
+} // namespace ictk::control::pid
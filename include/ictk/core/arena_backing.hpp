@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ictk/core/status.hpp"
+#include "ictk/core/memory_arena.hpp"
+
+/*
+ArenaBacking: RT grade memory under a MemoryArena (acquire once, at configuration time, before start())
+    order of attempts (Linux):
+        1- MAP_HUGETLB 2 MB pages (needs a reserved pool: vm.nr_hugepages)
+        2- plain anonymous mapping, madvise(MADV_HUGEPAGE) -> transparent hugepages where the kernel agrees
+        3- plain 4 KB pages
+        other platforms: aligned heap
+    then, on whatever was mapped:
+        numa_node >= 0 -> mbind(MPOL_BIND) before the first touch, so every page lands on that node
+        lock          -> mlock, no page of the region is swapped out / faulted back in from the tick
+        prefault      -> one write per page, the page tables exist before the first update()
+    a step the host refuses (no hugepage pool, RLIMIT_MEMLOCK, no NUMA) is reported in BackingInfo and skipped;
+        strict = true turns it into kPreconditionFail (region released)
+
+    the region is 64 B aligned (page aligned when mapped); arena() carves controllers out of it as usual
+*/
+namespace ictk{
+
+    enum class BackingKind : std::uint8_t{
+        kNone = 0,
+        kHeap = 1,         // aligned operator new (non Linux, or mapping refused)
+        kPages = 2,        // anonymous mapping, base pages
+        kTHP = 3,          // anonymous mapping, MADV_HUGEPAGE accepted
+        kHugeTLB = 4       // MAP_HUGETLB, 2 MB pages
+    };
+
+    const char* to_string(BackingKind k) noexcept;
+
+    struct BackingOptions{
+        std::size_t bytes{0};
+        bool hugepages{true};      // try MAP_HUGETLB, then THP
+        int numa_node{-1};         // -1 -> first touch policy (thread that prefaults)
+        bool lock{true};           // mlock
+        bool prefault{true};       // touch every page now
+        bool strict{false};        // any refused step -> kPreconditionFail
+    };
+
+    struct BackingInfo{
+        BackingKind kind{BackingKind::kNone};
+        std::size_t bytes{0};      // mapped (requested rounded up to the page size)
+        std::size_t page_size{0};
+        int numa_node{-1};         // node the region is bound to, -1 if not bound
+        bool locked{false};
+        bool prefaulted{false};
+    };
+
+    class ArenaBacking{
+        public:
+            ArenaBacking() = default;
+            ~ArenaBacking();
+
+            ArenaBacking(const ArenaBacking&) = delete;
+            ArenaBacking& operator=(const ArenaBacking&) = delete;
+
+            // // maps a fresh region (an earlier one is released first)
+            [[nodiscard]] Status acquire(const BackingOptions& opts) noexcept;
+            void release() noexcept;
+
+            void* data() const noexcept{
+                return base_;
+            }
+            std::size_t size() const noexcept{
+                return info_.bytes;
+            }
+            const BackingInfo& info() const noexcept{
+                return info_;
+            }
+
+            // // arena over the whole region (call once; a second arena over the same region aliases the first)
+            MemoryArena arena() const noexcept{
+                return MemoryArena(base_, info_.bytes);
+            }
+
+        private:
+            void* base_{nullptr};
+            BackingInfo info_{};
+    };
+
+} // namespace ictk
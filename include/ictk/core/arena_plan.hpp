@@ -0,0 +1,126 @@
+#pragma once
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+#include "ictk/core/time.hpp"
+#include "ictk/core/types.hpp"
+#include "ictk/core/status.hpp"
+#include "ictk/core/controller.hpp"
+#include "ictk/core/memory_arena.hpp"
+
+/*
+Arena planning: how many bytes will init() + configure() take, before building anything for real
+    dry run: the setup runs once against a scratch arena (heap, kPlanBaseAlign aligned), grown until nothing
+        failed (no kNoMem, no failed allocate()); the scratch and the controller are thrown away afterwards
+    result: bytes = arena used(), align = the largest alignment asked for
+        a region aligned to `align` with `bytes` free reproduces the same layout -> the real setup fits exactly
+        a region at any offset with align_up(offset, align) + bytes free also fits (allocation is monotone in the start)
+    packing: ArenaPlanner adds plans the same way -> size of one region for thousands of loops
+
+    planning allocates (scratch buffer): call it at configuration time, never from the tick
+*/
+namespace ictk{
+
+    struct ArenaPlan{
+        Status status{Status::kOK};   // first non kNoMem error of the setup, kOK otherwise
+        std::size_t bytes{0};         // arena used() after the setup, from an `align` aligned base
+        std::size_t align{1};         // largest alignment asked for
+        std::size_t blocks{0};        // allocate() calls that succeeded
+    };
+
+    inline constexpr std::size_t kPlanBaseAlign = 4096;
+    inline constexpr std::size_t kPlanMaxBytes = std::size_t{1} << 32;
+
+    namespace detail{
+        constexpr std::size_t align_up(std::size_t x, std::size_t a) noexcept{
+            return (x + (a - 1)) & ~(a - 1);
+        }
+    } // namespace detail
+
+    // // setup: Status(MemoryArena&) -> run it on a scratch arena until it stops running out of memory
+    template <class Setup>
+    ArenaPlan plan_arena(Setup&& setup, std::size_t first_guess = 4096) noexcept{
+        ArenaPlan p{};
+        for (std::size_t cap = (first_guess ? first_guess : 4096); cap <= kPlanMaxBytes; cap *= 2){
+            void* mem = ::operator new(cap, std::align_val_t{kPlanBaseAlign}, std::nothrow);
+            if (!mem){
+                p.status = Status::kNoMem;
+                return p;
+            }
+
+            MemoryArena scratch(mem, cap);
+            const Status st = setup(scratch);
+            const bool short_of_memory = (st == Status::kNoMem) || scratch.misses() != 0;
+
+            p.status = st;
+            p.bytes = scratch.used();
+            p.align = scratch.max_align();
+            p.blocks = scratch.allocations();
+            ::operator delete(mem, std::align_val_t{kPlanBaseAlign});
+
+            if (!short_of_memory) return p;
+        }
+        p.status = Status::kNoMem;
+        return p;
+    }
+
+    // // C::init(dims, dt, arena) + C::configure(cfg); C default constructible (PIDCore, StaticPIDCore, FixedPIDCore, ...)
+    template <class C, class Cfg>
+    ArenaPlan plan_controller(const Dims& dims, dt_ns dt, const Cfg& cfg) noexcept{
+        return plan_arena([&](MemoryArena& a) noexcept -> Status{
+            C c{};
+            if (Status st = c.init(dims, dt, a); st != Status::kOK) return st;
+            return c.configure(cfg);
+        });
+    }
+
+    // // same with runtime hooks (IController based cores)
+    template <class C, class Cfg>
+    ArenaPlan plan_controller(const Dims& dims, dt_ns dt, const Cfg& cfg, const Hooks& hooks) noexcept{
+        return plan_arena([&](MemoryArena& a) noexcept -> Status{
+            C c{};
+            if (Status st = c.init(dims, dt, a, hooks); st != Status::kOK) return st;
+            return c.configure(cfg);
+        });
+    }
+
+    // // bytes for `count` copies of one plan, back to back, from an `align` aligned base
+    constexpr std::size_t packed_bytes(const ArenaPlan& p, std::size_t count) noexcept{
+        if (count == 0 || p.bytes == 0) return 0;
+        return (count - 1) * detail::align_up(p.bytes, p.align) + p.bytes;
+    }
+
+    // // one region for many controllers: add() in build order, then size the region with bytes() / align()
+    class ArenaPlanner{
+        public:
+            void add(const ArenaPlan& p, std::size_t count = 1) noexcept{
+                if (count == 0 || p.bytes == 0) return;
+                if (p.align > align_) align_ = p.align;
+                const std::size_t stride = detail::align_up(p.bytes, p.align);
+                bytes_ = detail::align_up(bytes_, p.align) + (count - 1) * stride + p.bytes;
+                items_ += count;
+            }
+
+            // // region size: build the controllers in add() order into a MemoryArena over at least this many bytes
+            std::size_t bytes() const noexcept{
+                return bytes_;
+            }
+
+            // // region base alignment
+            std::size_t align() const noexcept{
+                return align_;
+            }
+
+            std::size_t items() const noexcept{
+                return items_;
+            }
+
+        private:
+            std::size_t bytes_{0};
+            std::size_t align_{1};
+            std::size_t items_{0};
+    };
+
+} // namespace ictk
@@ -13,4 +13,15 @@ namespace ictk{
     inline constexpr bool kNoRTTI = false;
     #endif
 
-} // namespace ictk
\ No newline at end of file
+} // namespace ictk
+
+// // loop has no cross iteration memory dependences (SoA arrays never alias) -> vectorize without runtime overlap checks
+#if defined(__clang__)
+    #define ICTK_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+    #define ICTK_IVDEP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+    #define ICTK_IVDEP __pragma(loop(ivdep))
+#else
+    #define ICTK_IVDEP
+#endif
@@ -9,12 +9,20 @@
 #include "ictk/core/health.hpp"       // // Struct ControllerHealth -> track saturation, watchdog misses, etc
 #include "ictk/core/controller.hpp"   // // Inherit IController
 #include "ictk/core/memory_arena.hpp" // // include MemoryArena -> some controller may allcoate scratch state in init
+#include "ictk/safety/chain_step.hpp"  // // SatStep, ChainStep
+#include "ictk/core/stage_timing_macros.hpp"  // // ICTK_STAGE_* stamps; empty unless ICTK_STAGE_TIMING=1
+
+#if ICTK_STAGE_TIMING
+    #include "ictk/core/stage_timing.hpp"     // // StageTimes, stage_clock (instrumentation build only)
+#endif
 
 namespace ictk{
 
-    struct SatStep{
-        std::uint64_t hits{0};  // how many channels saturated per tick
-        double pct{0.0};        // hits/nu
+    // // kStaged: one pass per stage on scratch buffers (default)
+    // // kFused: one pass per channel through all stages, if the derived controller implements apply_safety_fused()
+    enum class SafetyChainMode : std::uint8_t{
+        kStaged = 0,
+        kFused = 1
     };
     
     // // Reusable base that locks safety order and the lifecycle
@@ -43,11 +51,11 @@ namespace ictk{
                     // Buffers
                     // // preallocating working buffers -> to preserve post pre clamp snapshot even for large nu
                     // snapshot of unsaturated command after core (raw commands): for anti windup
-                    pre_buf_ = static_cast<Scalar*>(arena_->allocate(dims_.nu * sizeof(Scalar), alignof(Scalar)));  
+                    pre_buf_ = static_cast<Scalar*>(arena_->allocate(dims_.nu * sizeof(Scalar), alignof(Scalar), "ctl.pre"));  
                     // mutable comamnds 
-                    work_buf_ = static_cast<Scalar*>(arena_->allocate(dims_.nu * sizeof(Scalar), alignof(Scalar))); 
+                    work_buf_ = static_cast<Scalar*>(arena_->allocate(dims_.nu * sizeof(Scalar), alignof(Scalar), "ctl.work")); 
                     // per stage to compute that stage's del mag
-                    stage_buf_ = static_cast<Scalar*>(arena_->allocate(dims_.nu * sizeof(Scalar), alignof(Scalar)));
+                    stage_buf_ = static_cast<Scalar*>(arena_->allocate(dims_.nu * sizeof(Scalar), alignof(Scalar), "ctl.stage"));
 
                     // // Guard: Alloc failure
                     if (!pre_buf_ || !work_buf_ || !stage_buf_) return Status::kNoMem;
@@ -80,6 +88,8 @@ namespace ictk{
             }
 
             [[nodiscard]] Status update(const UpdateContext& ctx, Result& out) noexcept override{
+                ICTK_STAGE_STAMP(t_in);
+
                 // // avoid stale values if a stage make no change
                 health_.clear_runtime();
 
@@ -98,60 +108,53 @@ namespace ictk{
                 last_t_ = ctx.plant.t;
 
                 // // 1- core control law
+                ICTK_STAGE_STAMP(t_core);
                 Status st = compute_core(ctx, out.u); // algo controller (eg: PID)
                 if (st != Status::kOK) return st;
+                ICTK_STAGE_STAMP(t_hook);
+                ICTK_STAGE_ADD(stage_times_, Stage::kCore, t_core, t_hook);
                 
                 // // 2- pre output clamp hook
                 if (hooks_.pre_clamp) hooks_.pre_clamp(out.u, hooks_.user);
+                ICTK_STAGE_STAMP(t_chain);
+                ICTK_STAGE_ADD(stage_times_, Stage::kPreClamp, t_hook, t_chain);
 
-                // snapshot after pre clamp, before safety -> taking unsafe commands
-                std::memcpy(pre_buf_, out.u.data(), dims_.nu * sizeof(Scalar)); // copy to pre buf
+                // // 3- safety chain -> u_pre keeps the post pre clamp snapshot (unsafe commands)
+                if (!pre_buf_) return Status::kNoMem;
+                ChainStep chain{};
                 std::span<const Scalar> u_pre(pre_buf_, dims_.nu);
-
-                // // 3- safery chain on a seprate work buffer
-                std::memcpy(work_buf_, pre_buf_, dims_.nu * sizeof(Scalar));
-                std::span<Scalar> u_work(work_buf_, dims_.nu);  // // Mutable vector -> without touching u_pre
-
-                if (!stage_buf_ || !work_buf_ || !pre_buf_) return Status::kNoMem;
-
-                // SAT stage
-                std::memcpy(stage_buf_, work_buf_, dims_.nu * sizeof(Scalar));
-                // // clamp to actuators limits
-                SatStep sat = apply_saturation({work_buf_, dims_.nu});
-                double clamp_mag = 0.0; // change by saturation
-                for (std::size_t i=0;i<dims_.nu;++i) clamp_mag = std::max(clamp_mag, std::abs(double(work_buf_[i]-stage_buf_[i])));
-                health_.last_clamp_mag = clamp_mag; 
-
-                // RATE stage
-                std::memcpy(stage_buf_, work_buf_, dims_.nu * sizeof(Scalar));
-                // // limiting the spikes
-                std::uint64_t rate_hits = apply_rate_limit({work_buf_, dims_.nu});
-                double rate_mag = 0.0;
-                for (std::size_t i=0;i<dims_.nu;++i) rate_mag = std::max(rate_mag, std::abs(double(work_buf_[i]-stage_buf_[i])));
-                health_.last_rate_clip_mag = rate_mag;
-
-                // JERK stage
-                std::memcpy(stage_buf_, work_buf_, dims_.nu * sizeof(Scalar));
-                // // reducing mechanical shock
-                std::uint64_t jerk_hits = apply_jerk_limit({work_buf_, dims_.nu});
-                double jerk_mag = 0.0;
-                for (std::size_t i=0;i<dims_.nu;++i) jerk_mag = std::max(jerk_mag, std::abs(double(work_buf_[i]-stage_buf_[i])));
-                health_.last_jerk_clip_mag = jerk_mag;
+                std::span<const Scalar> u_sat;
+
+                if (chain_mode_ == SafetyChainMode::kFused && apply_safety_fused(out.u, {pre_buf_, dims_.nu}, chain)){
+                    u_sat = out.u;  // // fused pass wrote u_pre and the limited command in place
+                    ICTK_STAGE_STAMP(t_fused);
+                    ICTK_STAGE_ADD(stage_times_, Stage::kFused, t_chain, t_fused);
+                }else{
+                    if (!stage_buf_ || !work_buf_) return Status::kNoMem;
+                    staged_chain_(out.u, chain);
+                    u_sat = {work_buf_, dims_.nu};
+                }
 
                 // // 4- Anti windup uses
-                anti_windup_update(ctx, u_pre, u_work); // // inform integrators/observers about clamping so they don't wind up
+                ICTK_STAGE_STAMP(t_aw);
+                anti_windup_update(ctx, u_pre, u_sat); // // inform integrators/observers about clamping so they don't wind up
+                ICTK_STAGE_STAMP(t_post);
+                ICTK_STAGE_ADD(stage_times_, Stage::kAntiWindup, t_aw, t_post);
 
                 // // 5- Health wiring
-                health_.saturation_pct = sat.pct;
-                health_.rate_limit_hits += rate_hits;
-                health_.jerk_limit_hits += jerk_hits;
-                double aw_sum = 0.0;
-
-                for (std::size_t i=0; i<dims_.nu; ++i) aw_sum += std::abs(static_cast<double>(u_work[i] - u_pre[i]));
-                health_.aw_term_mag = aw_sum;
+                health_.saturation_pct = chain.sat.pct;
+                health_.rate_limit_hits += chain.rate_hits;
+                health_.jerk_limit_hits += chain.jerk_hits;
+                health_.last_clamp_mag = chain.clamp_mag;
+                health_.last_rate_clip_mag = chain.rate_mag;
+                health_.last_jerk_clip_mag = chain.jerk_mag;
+                health_.sat_hit_mask = chain.sat_mask;
+                health_.rate_hit_mask = chain.rate_mask;
+                health_.jerk_hit_mask = chain.jerk_mask;
+                health_.aw_term_mag = chain.aw_sum;
 
                 // // copy safety result to output buffer
-                std::memcpy(out.u.data(), work_buf_, dims_.nu * sizeof(Scalar));
+                if (u_sat.data() != out.u.data()) std::memcpy(out.u.data(), work_buf_, dims_.nu * sizeof(Scalar));
 
                 // // 6- post output arbitration sees the post-pre clamp sanpshot -> u_pre
                 if (hooks_.post_arbitrate) hooks_.post_arbitrate(u_pre, out.u, hooks_.user);
@@ -159,9 +162,28 @@ namespace ictk{
                 // // 7- attach health
                 out.health = health_;
 
+                ICTK_STAGE_STAMP(t_out);
+                ICTK_STAGE_ADD(stage_times_, Stage::kPostArbitrate, t_post, t_out);
+                ICTK_STAGE_ADD(stage_times_, Stage::kTotal, t_in, t_out);
                 return Status::kOK;
             }
 
+            // // select staged or fused safety chain; both produce byte-identical u and health
+            void set_safety_chain(SafetyChainMode m) noexcept{
+                chain_mode_ = m;
+            }
+
+            SafetyChainMode safety_chain() const noexcept{
+                return chain_mode_;
+            }
+
+            #if ICTK_STAGE_TIMING
+            // // instrumentation build only: per stage ticks go to t (caller owned, outlives the controller); nullptr -> off
+            void set_stage_timing(StageTimes* t) noexcept{
+                stage_times_ = t;
+            }
+            #endif
+
             CommandMode mode() const noexcept override{ 
                 return CommandMode::Primary; 
             }
@@ -175,6 +197,9 @@ namespace ictk{
             virtual std::uint64_t apply_rate_limit(std::span<Scalar> /*u*/) noexcept{ return 0; }
             virtual std::uint64_t apply_jerk_limit(std::span<Scalar> /*u*/) noexcept{ return 0; }
 
+            // // optional single pass chain: copy u into u_pre, limit u in place, fill step; return false if unsupported (u untouched)
+            virtual bool apply_safety_fused(std::span<Scalar> /*u*/, std::span<Scalar> /*u_pre*/, ChainStep& /*step*/) noexcept{ return false; }
+
             virtual void anti_windup_update(const UpdateContext& /*ctx*/,
                                             [[maybe_unused]] std::span<const Scalar> u_unsat,
                                             [[maybe_unused]] std::span<const Scalar> u_sat) noexcept {}
@@ -194,6 +219,50 @@ namespace ictk{
             }
 
         private:
+            // // max |work - stage| over channels and the mask of changed channels
+            void stage_delta_(double& mag, std::uint64_t& mask) const noexcept{
+                for (std::size_t i=0;i<dims_.nu;++i){
+                    mag = std::max(mag, std::abs(double(work_buf_[i]-stage_buf_[i])));
+                    if (i < 64 && (work_buf_[i] < stage_buf_[i] || stage_buf_[i] < work_buf_[i])) mask |= (1ull << i);
+                }
+            }
+
+            // // reference chain: each stage sweeps the whole vector on work_buf_, stage_buf_ holds its input
+            void staged_chain_(std::span<const Scalar> u, ChainStep& chain) noexcept{
+                // snapshot after pre clamp, before safety -> taking unsafe commands
+                std::memcpy(pre_buf_, u.data(), dims_.nu * sizeof(Scalar)); // copy to pre buf
+
+                // // Mutable vector -> without touching u_pre
+                std::memcpy(work_buf_, pre_buf_, dims_.nu * sizeof(Scalar));
+
+                // SAT stage
+                ICTK_STAGE_STAMP(t_sat);
+                std::memcpy(stage_buf_, work_buf_, dims_.nu * sizeof(Scalar));
+                // // clamp to actuators limits
+                chain.sat = apply_saturation({work_buf_, dims_.nu});
+                stage_delta_(chain.clamp_mag, chain.sat_mask);
+
+                // RATE stage
+                ICTK_STAGE_STAMP(t_rate);
+                ICTK_STAGE_ADD(stage_times_, Stage::kSaturation, t_sat, t_rate);
+                std::memcpy(stage_buf_, work_buf_, dims_.nu * sizeof(Scalar));
+                // // limiting the spikes
+                chain.rate_hits = apply_rate_limit({work_buf_, dims_.nu});
+                stage_delta_(chain.rate_mag, chain.rate_mask);
+
+                // JERK stage
+                ICTK_STAGE_STAMP(t_jerk);
+                ICTK_STAGE_ADD(stage_times_, Stage::kRate, t_rate, t_jerk);
+                std::memcpy(stage_buf_, work_buf_, dims_.nu * sizeof(Scalar));
+                // // reducing mechanical shock
+                chain.jerk_hits = apply_jerk_limit({work_buf_, dims_.nu});
+                stage_delta_(chain.jerk_mag, chain.jerk_mask);
+                ICTK_STAGE_STAMP(t_done);
+                ICTK_STAGE_ADD(stage_times_, Stage::kJerk, t_jerk, t_done);
+
+                for (std::size_t i=0; i<dims_.nu; ++i) chain.aw_sum += std::abs(static_cast<double>(work_buf_[i] - pre_buf_[i]));
+            }
+
             Dims             dims_{};
             dt_ns            dt_{0};
             Hooks            hooks_{};
@@ -201,11 +270,16 @@ namespace ictk{
             bool             started_{false};
             t_ns             last_t_{-1};
             ControllerHealth health_{};
+            SafetyChainMode  chain_mode_{SafetyChainMode::kStaged};
 
             // // buffer to preserve post pre clamp snapshot 
             Scalar* pre_buf_{nullptr};
             Scalar* work_buf_{nullptr};
             Scalar* stage_buf_{nullptr};
+
+            #if ICTK_STAGE_TIMING
+            StageTimes* stage_times_{nullptr};
+            #endif
            
     };
     
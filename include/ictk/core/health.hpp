@@ -34,6 +34,11 @@ namespace ictk{
         // // mag of last jerk clip
         double last_jerk_clip_mag{0.0};
 
+        // // per channel bitmasks of the last tick: bit i set if stage changed u[i] (channels >= 64 not tracked)
+        std::uint64_t sat_hit_mask{0};
+        std::uint64_t rate_hit_mask{0};
+        std::uint64_t jerk_hit_mask{0};
+
         
         // // Reset per tick runtime counter to 0
         void clear_runtime(){
@@ -44,6 +49,9 @@ namespace ictk{
             last_clamp_mag= 0.0;
             last_rate_clip_mag = 0.0;
             last_jerk_clip_mag = 0.0;
+            sat_hit_mask = 0;
+            rate_hit_mask = 0;
+            jerk_hit_mask = 0;
         }
     };
 
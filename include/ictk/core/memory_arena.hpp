@@ -1,16 +1,28 @@
 #pragma once
+#include <span>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 
 // // Allocate chunks inside a fixed memory block, check usage and reset
 namespace ictk{
+
+    // // one entry of the optional allocation map: [offset, offset + bytes) belongs to `label`
+    struct ArenaBlock{
+        std::size_t offset{0};        // from the arena base
+        std::size_t bytes{0};
+        std::size_t align{0};
+        std::size_t pad{0};           // alignment gap in front of the block
+        const char* label{nullptr};   // call site name, nullptr if the caller gave none
+        std::uint32_t owner{0};       // set_owner() value at allocation time (e.g. loop index)
+    };
+
     class MemoryArena{
         public:
-            MemoryArena(void *base, std::size_t bytes) noexcept 
+            MemoryArena(void *base, std::size_t bytes) noexcept
                 : base_(static_cast<std::byte*>(base)), cap_(bytes) {}
 
-            inline void *allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) noexcept{
+            inline void *allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t), const char* label = nullptr) noexcept{
 
                 // // basic visibility
                 if (!base_ || bytes ==0) return nullptr;
@@ -26,8 +38,19 @@ namespace ictk{
                 const std::size_t head = static_cast<std::size_t>(aligned - base);
 
                 // // overflow -safe capacity check: head + bytes <= cap
-                if (head > cap_ || bytes > cap_ - head) return nullptr;  // nullptr returned cause RT can't throw
+                if (head > cap_ || bytes > cap_ - head){
+                    ++misses_;
+                    return nullptr;  // nullptr returned cause RT can't throw
+                }
 
+                // // optional map: record the block while there is room, count the rest
+                if (map_){
+                    if (map_n_ < map_cap_) map_[map_n_++] = ArenaBlock{head, bytes, align, head - offset_, label, owner_};
+                    else ++map_dropped_;
+                }
+
+                if (align > max_align_) max_align_ = align;
+                ++count_;
                 offset_ = head + bytes;
 
                 return reinterpret_cast<void*>(aligned);
@@ -35,6 +58,11 @@ namespace ictk{
 
             inline void reset() noexcept{
                 offset_ = 0;
+                misses_ = 0;
+                count_ = 0;
+                max_align_ = 1;
+                map_n_ = 0;
+                map_dropped_ = 0;
             }
 
             inline std::size_t capacity() const noexcept {
@@ -45,10 +73,57 @@ namespace ictk{
                 return offset_;
             }
 
+            // // successful allocate() calls since construction / reset
+            inline std::size_t allocations() const noexcept{
+                return count_;
+            }
+
+            // // failed allocate() calls since construction / reset (a controller that ignores a nullptr still shows up here)
+            inline std::size_t misses() const noexcept{
+                return misses_;
+            }
+
+            // // largest alignment handed out; the base must be aligned to this for used() to be reproducible
+            inline std::size_t max_align() const noexcept{
+                return max_align_;
+            }
+
+            // // allocation map: caller owned storage, off by default (no cost besides one branch)
+            // // entries past `cap` are counted in map_dropped(); pass nullptr to switch it off
+            inline void set_map(ArenaBlock* blocks, std::size_t cap) noexcept{
+                map_ = blocks;
+                map_cap_ = blocks ? cap : 0;
+                map_n_ = 0;
+                map_dropped_ = 0;
+            }
+
+            // // tag for the blocks that follow (e.g. set_owner(i) before building loop i)
+            inline void set_owner(std::uint32_t owner) noexcept{
+                owner_ = owner;
+            }
+
+            inline std::span<const ArenaBlock> map() const noexcept{
+                return {map_, map_n_};
+            }
+
+            inline std::size_t map_dropped() const noexcept{
+                return map_dropped_;
+            }
+
         private:
             std::byte* base_{nullptr};
             std::size_t offset_{0};
             std::size_t cap_{0};
-            
+
+            std::size_t misses_{0};
+            std::size_t count_{0};
+            std::size_t max_align_{1};
+
+            ArenaBlock* map_{nullptr};
+            std::size_t map_cap_{0};
+            std::size_t map_n_{0};
+            std::size_t map_dropped_{0};
+            std::uint32_t owner_{0};
+
     };
 } // namespace ictk
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <span>
+#include "ictk/core/time.hpp"
 #include "ictk/core/types.hpp"
 #include "ictk/core/health.hpp"
 
@@ -13,6 +14,10 @@ namespace ictk{
         // // Status report of the controller after producing u
         ControllerHealth health;
 
+        // // wall time of the last update() call, set by the executor that timed it (0 -> not measured)
+        //      feeds TickSample::lat_ns / TickVector::lat_ns -> the recorder's latency KPIs
+        dt_ns update_ns{0};
+
         // // diag fields can be extended, after adding more controller mode, or condition numbers of MPC
     };
     
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#endif
+
+#include "ictk/core/stage_timing_macros.hpp"   // // ICTK_STAGE_TIMING default + ICTK_STAGE_* stamps
+
+/*
+Per stage timing of ControllerBase::update (instrumentation build only)
+    build with ICTK_STAGE_TIMING=1 (CMake: -DICTK_ENABLE_STAGE_TIMING=ON); without it the ICTK_STAGE_* macros
+        expand to nothing and ControllerBase has no timing member -> same code as an uninstrumented build
+    stamps: stage_clock() at every stage boundary (x86: rdtsc, aarch64: cntvct_el0, else steady_clock ns)
+    side structure: StageTimes, caller owned, attached with ControllerBase::set_stage_timing(&t)
+        per stage count / sum / min / max + a log2 histogram of the clock ticks
+        one writer (the control thread): plain relaxed loads + stores, no read-modify-write, no lock
+        readers (any thread): relaxed loads; a snapshot taken mid tick may mix two ticks, never tears a value
+*/
+
+namespace ictk{
+
+    enum class Stage : std::uint8_t{
+        kCore = 0,        // compute_core
+        kPreClamp,        // pre_clamp hook
+        kSaturation,      // staged chain: saturation sweep
+        kRate,            // staged chain: rate sweep
+        kJerk,            // staged chain: jerk sweep
+        kFused,           // fused chain (all limiters, one pass)
+        kAntiWindup,      // anti_windup_update
+        kPostArbitrate,   // health wiring + copy out + post_arbitrate hook
+        kTotal,           // whole update(), checks included
+        kCount
+    };
+
+    inline constexpr std::size_t kStageCount = static_cast<std::size_t>(Stage::kCount);
+    inline constexpr std::size_t kStageBuckets = 64;
+
+    inline const char* to_string(Stage s) noexcept{
+        switch (s){
+            case Stage::kCore: return "core";
+            case Stage::kPreClamp: return "pre_clamp";
+            case Stage::kSaturation: return "saturation";
+            case Stage::kRate: return "rate";
+            case Stage::kJerk: return "jerk";
+            case Stage::kFused: return "fused";
+            case Stage::kAntiWindup: return "anti_windup";
+            case Stage::kPostArbitrate: return "post_arbitrate";
+            case Stage::kTotal: return "total";
+            case Stage::kCount: break;
+        }
+        return "?";
+    }
+
+    // // cheapest monotonic counter of the target (not serializing; stage bodies are long compared to the skew)
+    inline std::uint64_t stage_clock() noexcept{
+        #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+            return __rdtsc();
+        #elif defined(__aarch64__)
+            std::uint64_t v;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+            return v;
+        #else
+            return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        #endif
+    }
+
+    // // stage_clock ticks per ns, measured once against steady_clock (~2 ms busy wait on first call; not for the tick)
+    inline double stage_clock_per_ns() noexcept{
+        static const double k = []{
+            using clk = std::chrono::steady_clock;
+            const auto t0 = clk::now();
+            const std::uint64_t c0 = stage_clock();
+            auto t1 = t0;
+            while (t1 - t0 < std::chrono::milliseconds(2)) t1 = clk::now();
+            const std::uint64_t c1 = stage_clock();
+            const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+            return ns > 0.0 ? static_cast<double>(c1 - c0) / ns : 1.0;
+        }();
+        return k;
+    }
+
+    struct StageSnapshot{
+        std::uint64_t count{0};
+        std::uint64_t sum{0};
+        std::uint64_t min{0};
+        std::uint64_t max{0};
+        std::array<std::uint64_t, kStageBuckets> hist{};   // bucket b: ticks in [2^(b-1), 2^b)
+
+        // // upper edge of the bucket holding quantile q (0..1), in ticks
+        std::uint64_t quantile(double q) const noexcept{
+            if (count == 0) return 0;
+            const auto want = static_cast<std::uint64_t>(q * static_cast<double>(count - 1)) + 1;
+            std::uint64_t seen = 0;
+            for (std::size_t b = 0; b < kStageBuckets; ++b){
+                seen += hist[b];
+                if (seen >= want) return b == 0 ? 0 : (b >= 63 ? max : std::min<std::uint64_t>(max, (std::uint64_t{1} << b) - 1));
+            }
+            return max;
+        }
+    };
+
+    class StageTimes{
+        public:
+            StageTimes() noexcept{
+                clear();
+            }
+
+            StageTimes(const StageTimes&) = delete;
+            StageTimes& operator=(const StageTimes&) = delete;
+
+            // // control thread only
+            void add(Stage s, std::uint64_t ticks) noexcept{
+                Slot& x = slots_[static_cast<std::size_t>(s)];
+                bump_(x.count, 1);
+                bump_(x.sum, ticks);
+                if (ticks < x.min.load(std::memory_order_relaxed)) x.min.store(ticks, std::memory_order_relaxed);
+                if (ticks > x.max.load(std::memory_order_relaxed)) x.max.store(ticks, std::memory_order_relaxed);
+                const auto b = static_cast<std::size_t>(std::bit_width(ticks));
+                bump_(x.hist[b < kStageBuckets ? b : kStageBuckets - 1], 1);
+            }
+
+            // // any thread
+            StageSnapshot read(Stage s) const noexcept{
+                const Slot& x = slots_[static_cast<std::size_t>(s)];
+                StageSnapshot o{};
+                o.count = x.count.load(std::memory_order_relaxed);
+                o.sum = x.sum.load(std::memory_order_relaxed);
+                o.min = o.count ? x.min.load(std::memory_order_relaxed) : 0;
+                o.max = x.max.load(std::memory_order_relaxed);
+                for (std::size_t b = 0; b < kStageBuckets; ++b) o.hist[b] = x.hist[b].load(std::memory_order_relaxed);
+                return o;
+            }
+
+            // // not concurrent with add()
+            void clear() noexcept{
+                for (Slot& x : slots_){
+                    x.count.store(0, std::memory_order_relaxed);
+                    x.sum.store(0, std::memory_order_relaxed);
+                    x.min.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+                    x.max.store(0, std::memory_order_relaxed);
+                    for (auto& h : x.hist) h.store(0, std::memory_order_relaxed);
+                }
+            }
+
+        private:
+            struct alignas(64) Slot{
+                std::atomic<std::uint64_t> count{0};
+                std::atomic<std::uint64_t> sum{0};
+                std::atomic<std::uint64_t> min{0};
+                std::atomic<std::uint64_t> max{0};
+                std::array<std::atomic<std::uint64_t>, kStageBuckets> hist{};
+            };
+
+            // // single writer -> load + store, no locked add
+            static void bump_(std::atomic<std::uint64_t>& a, std::uint64_t d) noexcept{
+                a.store(a.load(std::memory_order_relaxed) + d, std::memory_order_relaxed);
+            }
+
+            std::array<Slot, kStageCount> slots_{};
+    };
+
+} // namespace ictk
@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+ICTK_STAGE_* stamps without the timing machinery (no includes)
+    ICTK_STAGE_TIMING defaults to 0 -> the stamps expand to nothing
+    ICTK_STAGE_TIMING=1 -> they call stage_clock() / StageTimes::add from stage_timing.hpp, which the user includes
+*/
+
+#if !defined(ICTK_STAGE_TIMING)
+    #define ICTK_STAGE_TIMING 0
+#endif
+
+#if ICTK_STAGE_TIMING
+    #define ICTK_STAGE_STAMP(name) const std::uint64_t name = ::ictk::stage_clock()
+    #define ICTK_STAGE_ADD(times, stage, a, b) do{ if (times) (times)->add((stage), (b) - (a)); }while(0)
+#else
+    #define ICTK_STAGE_STAMP(name) static_cast<void>(0)
+    #define ICTK_STAGE_ADD(times, stage, a, b) static_cast<void>(0)
+#endif
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <tuple>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <type_traits>
+
+#include "ictk/core/health.hpp"
+#include "ictk/core/controller.hpp"
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/safety/clip.hpp"
+#include "ictk/safety/chain_step.hpp"  // ChainStep, StageKind, safety::fold
+
+/*
+StaticControllerBase<Derived, Stages...>: ControllerBase with everything resolved at compile time
+    ControllerBase: compute_core / apply_* / anti_windup_update are virtual, hooks are function pointers
+        -> one indirect call per stage per tick, nothing inlines across them
+    here: Derived's core law (CRTP), the safety stages (type list, in order) and the hooks (Derived members)
+        are all known to the compiler -> update() is one function, the chain is one sweep per channel
+
+    Derived provides (public, or befriend the base):
+        Status compute_core(const UpdateContext&, std::span<Scalar> u) noexcept
+        void anti_windup_update(const UpdateContext&, std::span<const Scalar> u_unsat, std::span<const Scalar> u_sat) noexcept
+    optional compile-time hooks, detected by signature:
+        void pre_clamp(std::span<Scalar> u) noexcept
+        void post_arbitrate(std::span<const Scalar> u_pre, std::span<Scalar> u_out) noexcept
+
+    Stages: limiter types with a StageTraits<> specialization (ictk/safety/stage_traits.hpp)
+        in ControllerBase's chain order: saturation -> rate -> jerk, each at most once (static_assert, by StageTraits::kind)
+        every listed stage must be emplaced by configure(); start() refuses otherwise -> no per tick "is it configured" checks
+        health numbers are byte-identical to ControllerBase for the same limiters
+
+    StaticControllerAdapter<C> exposes any of these as an IController where runtime polymorphism is needed
+*/
+namespace ictk{
+
+    /*
+    specialize per limiter type:
+        static constexpr StageKind kind;
+        static bool ready(const S&) noexcept;          // allocation ok
+        static void begin(S&) noexcept;                // once per tick, before the sweep
+        static safety::Clip step(S&, std::size_t i, Scalar v) noexcept;  // limit one channel (and commit limiter state)
+    */
+    template <class S>
+    struct StageTraits;
+
+    namespace detail{
+        // // stage kinds strictly increasing -> the fixed sat -> rate -> jerk order of the dynamic chain
+        template <class... Stages>
+        constexpr bool canonical_stages() noexcept{
+            const std::array<StageKind, sizeof...(Stages)> k{StageTraits<Stages>::kind...};
+            for (std::size_t i = 1; i < k.size(); ++i){
+                if (k[i] <= k[i - 1]) return false;
+            }
+            return true;
+        }
+    } // namespace detail
+
+    template <class Derived, class... Stages>
+    class StaticControllerBase{
+        static_assert(detail::canonical_stages<Stages...>(),
+                      "StaticControllerBase: stages must be in saturation -> rate -> jerk order, each at most once");
+
+        public:
+            StaticControllerBase() = default;
+
+            [[nodiscard]] Status init(const Dims& dims, dt_ns dt, MemoryArena& arena) noexcept{
+                if (dims.nu == 0 || dims.ny ==0) return Status::kInvalidArg;
+
+                dims_ = dims;
+                dt_ = dt;
+                arena_ = &arena;
+
+                // // post pre clamp snapshot; the chain writes the limited command straight into out.u
+                pre_buf_ = static_cast<Scalar*>(arena_->allocate(dims_.nu * sizeof(Scalar), alignof(Scalar), "ctl.pre"));
+                if (!pre_buf_) return Status::kNoMem;
+
+                started_ = false;
+                last_t_ = -1;
+                health_ = {};
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status start() noexcept{
+                // // a listed stage that configure() did not emplace is a config error, not a runtime branch
+                if (!stages_ready_(std::index_sequence_for<Stages...>{})) return Status::kNotReady;
+                started_ = true;
+                last_t_ = -1;
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status stop() noexcept{
+                started_ = false;
+                return Status::kOK;
+            }
+
+            [[nodiscard]] Status reset() noexcept{
+                last_t_ = -1;
+                health_.clear_runtime();
+                return Status::kOK;
+            }
+
+            // // same order and health wiring as ControllerBase::update
+            [[nodiscard]] Status update(const UpdateContext& ctx, Result& out) noexcept{
+                health_.clear_runtime();
+
+                if (!started_) return Status::kNotReady;
+
+                if (out.u.size() != dims_.nu) return Status::kInvalidArg;
+                if (ctx.plant.y.size() != dims_.ny) return Status::kInvalidArg;
+                if (ctx.sp.r.size() != dims_.ny) return Status::kInvalidArg;
+                if (!ctx.plant.xhat.empty() && ctx.plant.xhat.size() != dims_.nx) return Status::kInvalidArg;
+
+                const auto d = ctx.plant.t - last_t_;
+                if (last_t_ >= 0 && d != dt_) health_.deadline_miss_count += std::max<t_ns>(1, d / dt_) - 1;
+                last_t_ = ctx.plant.t;
+
+                // // 1- core control law
+                Status st = derived_().compute_core(ctx, out.u);
+                if (st != Status::kOK) return st;
+
+                // // 2- pre output clamp hook
+                if constexpr (requires(Derived& c, std::span<Scalar> u){ c.pre_clamp(u); }){
+                    derived_().pre_clamp(out.u);
+                }
+
+                // // 3- safety chain: one sweep, u_pre snapshot + limited u in place
+                ChainStep chain{};
+                chain_(out.u, chain, std::index_sequence_for<Stages...>{});
+                std::span<const Scalar> u_pre(pre_buf_, dims_.nu);
+
+                // // 4- anti windup
+                derived_().anti_windup_update(ctx, u_pre, out.u);
+
+                // // 5- health wiring
+                health_.saturation_pct = chain.sat.pct;
+                health_.rate_limit_hits += chain.rate_hits;
+                health_.jerk_limit_hits += chain.jerk_hits;
+                health_.last_clamp_mag = chain.clamp_mag;
+                health_.last_rate_clip_mag = chain.rate_mag;
+                health_.last_jerk_clip_mag = chain.jerk_mag;
+                health_.sat_hit_mask = chain.sat_mask;
+                health_.rate_hit_mask = chain.rate_mask;
+                health_.jerk_hit_mask = chain.jerk_mask;
+                health_.aw_term_mag = chain.aw_sum;
+
+                // // 6- post output arbitration
+                if constexpr (requires(Derived& c, std::span<const Scalar> a, std::span<Scalar> b){ c.post_arbitrate(a, b); }){
+                    derived_().post_arbitrate(u_pre, out.u);
+                }
+
+                // // 7- attach health
+                out.health = health_;
+                return Status::kOK;
+            }
+
+            CommandMode mode() const noexcept{
+                return CommandMode::Primary;
+            }
+
+            // // limiter storage of stage S (configure() emplaces it)
+            template <class S>
+            std::optional<S>& stage() noexcept{
+                return std::get<std::optional<S>>(stages_);
+            }
+
+            template <class S>
+            static constexpr bool has_stage() noexcept{
+                return (std::is_same_v<S, Stages> || ...);
+            }
+
+        protected:
+            ~StaticControllerBase() = default;
+
+            const Dims &dims() const noexcept{
+                return dims_;
+            }
+            dt_ns dt() const noexcept{
+                return dt_;
+            }
+            MemoryArena& arena() noexcept{
+                return *arena_;
+            }
+            ControllerHealth &health() noexcept{
+                return health_;
+            }
+
+        private:
+            Derived& derived_() noexcept{
+                return static_cast<Derived&>(*this);
+            }
+
+            template <std::size_t... I>
+            bool stages_ready_(std::index_sequence<I...>) const noexcept{
+                return ((std::get<I>(stages_).has_value() &&
+                         StageTraits<Stages>::ready(*std::get<I>(stages_))) && ...);
+            }
+
+            // // one stage on one channel, health folded like the fused chain (safety::fold)
+            template <class S>
+            static void step_(S& s, std::size_t i, Scalar& v, std::uint64_t bit, ChainStep& step) noexcept{
+                const safety::Clip c = StageTraits<S>::step(s, i, v);
+                safety::fold<StageTraits<S>::kind>(step, c, v, bit);
+                v = c.val;
+            }
+
+            template <std::size_t... I>
+            void chain_(std::span<Scalar> u, ChainStep& step, std::index_sequence<I...>) noexcept{
+                (StageTraits<Stages>::begin(*std::get<I>(stages_)), ...);
+
+                const std::size_t n = u.size();
+                for (std::size_t i=0; i<n; ++i){
+                    const Scalar v0 = u[i];
+                    [[maybe_unused]] const std::uint64_t bit = safety::chain_bit(i);
+                    pre_buf_[i] = v0;
+                    Scalar v = v0;
+                    (step_(*std::get<I>(stages_), i, v, bit, step), ...);
+                    safety::fold_channel(step, v, v0);
+                    u[i] = v;
+                }
+
+                if constexpr (((StageTraits<Stages>::kind == StageKind::kSaturation) || ...)){
+                    safety::fold_sat_pct(step, n);
+                }
+            }
+
+            Dims             dims_{};
+            dt_ns            dt_{0};
+            MemoryArena*     arena_{nullptr};
+            bool             started_{false};
+            t_ns             last_t_{-1};
+            ControllerHealth health_{};
+            Scalar*          pre_buf_{nullptr};
+
+            std::tuple<std::optional<Stages>...> stages_{};
+    };
+
+
+    // // IController view of a static controller (one virtual call per tick instead of one per stage)
+    template <class C>
+    class StaticControllerAdapter final : public IController{
+        public:
+            StaticControllerAdapter() = default;
+
+            // // hooks are compile-time members of C; runtime function pointers are rejected
+            [[nodiscard]] Status init(const Dims& dims, dt_ns dt, MemoryArena& arena, const Hooks& hooks = {}) noexcept override{
+                if (hooks.pre_clamp || hooks.post_arbitrate) return Status::kInvalidArg;
+                return c_.init(dims, dt, arena);
+            }
+
+            [[nodiscard]] Status start() noexcept override{
+                return c_.start();
+            }
+
+            [[nodiscard]] Status stop() noexcept override{
+                return c_.stop();
+            }
+
+            [[nodiscard]] Status reset() noexcept override{
+                return c_.reset();
+            }
+
+            [[nodiscard]] Status update(const UpdateContext& ctx, Result& out) noexcept override{
+                return c_.update(ctx, out);
+            }
+
+            CommandMode mode() const noexcept override{
+                return c_.mode();
+            }
+
+            // // configure/align through the concrete type
+            C& get() noexcept{
+                return c_;
+            }
+            const C& get() const noexcept{
+                return c_;
+            }
+
+        private:
+            C c_{};
+    };
+
+} // namespace ictk
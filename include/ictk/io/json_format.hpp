@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cmath>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <charconv>
+#include <system_error>
+
+/*
+Number formatting for JSON evidence (recorder JSONL backend, ACR reports)
+    std::to_chars, no locale, no allocation: put_*() write into the caller's buffer and return the new end
+    real: shortest text that parses back to the same double (round trip exact), -0 -> 0, nan / inf -> null
+        the shortest form is unique, so the bytes only depend on the value -> stable hashes across runs / hosts
+    buffer room: kMaxU64 / kMaxI64 / kMaxReal bytes per call
+*/
+namespace ictk::jsonfmt{
+
+    inline constexpr std::size_t kMaxU64 = 20;
+    inline constexpr std::size_t kMaxI64 = 20;
+    inline constexpr std::size_t kMaxReal = 24;     // "-2.2250738585072014e-308"
+
+    inline char* put_u64(char* p, std::uint64_t v) noexcept{
+        return std::to_chars(p, p + kMaxU64, v).ptr;
+    }
+
+    inline char* put_i64(char* p, std::int64_t v) noexcept{
+        return std::to_chars(p, p + kMaxI64, v).ptr;
+    }
+
+    inline char* put_real(char* p, double v) noexcept{
+        // // JSON has no nan / inf
+        if (!std::isfinite(v)){
+            p[0] = 'n'; p[1] = 'u'; p[2] = 'l'; p[3] = 'l';
+            return p + 4;
+        }
+        if (v == 0.0){           // // -0 -> 0
+            *p = '0';
+            return p + 1;
+        }
+        const std::to_chars_result r = std::to_chars(p, p + kMaxReal, v);
+        return r.ec == std::errc{} ? r.ptr : p;
+    }
+
+    inline char* put_bool(char* p, bool b) noexcept{
+        if (b){
+            p[0] = 't'; p[1] = 'r'; p[2] = 'u'; p[3] = 'e';
+            return p + 4;
+        }
+        p[0] = 'f'; p[1] = 'a'; p[2] = 'l'; p[3] = 's'; p[4] = 'e';
+        return p + 5;
+    }
+
+    // // std::string appenders (cold paths, reports)
+    inline void append_u64(std::string& out, std::uint64_t v){
+        char buf[kMaxU64];
+        out.append(buf, put_u64(buf, v));
+    }
+
+    inline void append_i64(std::string& out, std::int64_t v){
+        char buf[kMaxI64];
+        out.append(buf, put_i64(buf, v));
+    }
+
+    inline void append_real(std::string& out, double v){
+        char buf[kMaxReal];
+        out.append(buf, put_real(buf, v));
+    }
+
+} // namespace ictk::jsonfmt
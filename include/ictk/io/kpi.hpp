@@ -17,6 +17,9 @@ namespace ictk{
 
         // //  Too high means, commands are beyond pyhsical capability -> poor tuning, wrong model or unsafe request
         std::uint64_t limit_hits{0};
+
+        // // telemetry records dropped because the recorder ring was full (evidence gap, the loop never waited)
+        std::uint64_t telemetry_drops{0};
     };
     
 
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/*
+LatencyHistogram: fixed memory log-linear (HDR style) histogram of durations in ns
+    below 256 ns every value has its own bucket; above, each power of two is split into 128 linear sub buckets
+        -> a bucket is at most 1/128 (0.8 %) of its lower edge wide
+    range 10 ns .. 10 s (kHighestNs); larger values land in the last bucket and are counted in saturated(), max() stays exact
+    record(): O(1), a bit_width, a shift and an increment; no allocation (counts live in the object, ~28 KB)
+    merge(): bucket wise sum -> per thread / per segment histograms combine into exactly the histogram of all samples
+    quantile(q): highest value of the bucket holding rank ceil(q * count), clamped to [min, max] (max for the overflow bucket)
+    not thread safe: one histogram per writer, merge() off the hot path
+*/
+namespace ictk{
+
+    namespace detail{
+        // // bucket of v: exact below 2^(sub_bits+1), then 2^sub_bits linear buckets per power of two
+        constexpr std::size_t hist_index(std::uint64_t v, unsigned sub_bits) noexcept{
+            const auto k = static_cast<unsigned>(std::bit_width(v));
+            const unsigned shift = k > sub_bits + 1 ? k - (sub_bits + 1) : 0;
+            return static_cast<std::size_t>((std::uint64_t{shift} << sub_bits) + (v >> shift));
+        }
+    } // namespace detail
+
+    class LatencyHistogram{
+        public:
+            static constexpr unsigned kSubBits = 7;
+            static constexpr std::uint64_t kSub = std::uint64_t{1} << kSubBits;     // linear sub buckets per octave
+            static constexpr std::uint64_t kLowestNs = 10;                          // nominal, everything below is exact too
+            static constexpr std::uint64_t kHighestNs = 10'000'000'000ull;          // 10 s
+
+            static constexpr std::size_t index_of(std::uint64_t v) noexcept{
+                return detail::hist_index(v, kSubBits);
+            }
+
+            static constexpr std::size_t kBuckets = detail::hist_index(kHighestNs, kSubBits) + 1;
+
+            // // [low, high] of bucket i
+            static constexpr std::uint64_t lowest_of(std::size_t i) noexcept{
+                const std::uint64_t shift = i < 2 * kSub ? 0 : (i >> kSubBits) - 1;
+                return (std::uint64_t{i} - (shift << kSubBits)) << shift;
+            }
+            static constexpr std::uint64_t highest_of(std::size_t i) noexcept{
+                const std::uint64_t shift = i < 2 * kSub ? 0 : (i >> kSubBits) - 1;
+                return lowest_of(i) + (std::uint64_t{1} << shift) - 1;
+            }
+
+            void record(std::uint64_t ns) noexcept{
+                if (ns > kHighestNs){
+                    ++saturated_;
+                    ++counts_[kBuckets - 1];
+                }else{
+                    ++counts_[index_of(ns)];
+                }
+                ++count_;
+                sum_ += ns;
+                if (ns < min_) min_ = ns;
+                if (ns > max_) max_ = ns;
+            }
+
+            void merge(const LatencyHistogram& o) noexcept{
+                for (std::size_t i = 0; i < kBuckets; ++i) counts_[i] += o.counts_[i];
+                count_ += o.count_;
+                sum_ += o.sum_;
+                saturated_ += o.saturated_;
+                if (o.min_ < min_) min_ = o.min_;
+                if (o.max_ > max_) max_ = o.max_;
+            }
+
+            void reset() noexcept{
+                counts_.fill(0);
+                count_ = sum_ = saturated_ = max_ = 0;
+                min_ = std::numeric_limits<std::uint64_t>::max();
+            }
+
+            // // q in [0, 1]; 0 when empty
+            std::uint64_t quantile(double q) const noexcept{
+                if (count_ == 0) return 0;
+                if (!(q > 0.0)) return min_;
+                if (q >= 1.0) return max_;
+                const double want_d = q * static_cast<double>(count_);
+                auto want = static_cast<std::uint64_t>(want_d);
+                if (static_cast<double>(want) < want_d) ++want;
+                if (want == 0) want = 1;
+
+                std::uint64_t seen = 0;
+                for (std::size_t i = 0; i < kBuckets; ++i){
+                    seen += counts_[i];
+                    if (seen >= want){
+                        const std::uint64_t v = (i == kBuckets - 1 && saturated_) ? max_ : highest_of(i);
+                        return v < min_ ? min_ : (v > max_ ? max_ : v);
+                    }
+                }
+                return max_;
+            }
+
+            std::uint64_t count() const noexcept{
+                return count_;
+            }
+            std::uint64_t min() const noexcept{
+                return count_ ? min_ : 0;
+            }
+            std::uint64_t max() const noexcept{
+                return max_;
+            }
+            double mean() const noexcept{
+                return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0;
+            }
+            // // samples above kHighestNs
+            std::uint64_t saturated() const noexcept{
+                return saturated_;
+            }
+            std::uint64_t bucket(std::size_t i) const noexcept{
+                return i < kBuckets ? counts_[i] : 0;
+            }
+
+        private:
+            std::array<std::uint64_t, kBuckets> counts_{};
+            std::uint64_t count_{0};
+            std::uint64_t sum_{0};
+            std::uint64_t saturated_{0};
+            std::uint64_t min_{std::numeric_limits<std::uint64_t>::max()};
+            std::uint64_t max_{0};
+    };
+
+} // namespace ictk
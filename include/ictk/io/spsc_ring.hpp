@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "ictk/core/status.hpp"
+#include "ictk/core/memory_arena.hpp"
+
+/*
+SpscRing<T>: one producer (the control loop), one consumer (a writer thread), fixed slots from a MemoryArena
+    wait free on both sides: a push / pop is a bounded number of loads and stores, never a lock or a syscall
+    full ring -> try_push() returns false and counts a drop (the producer never waits for the consumer)
+    indices run freely (64 bit), slot = index & mask; capacity is rounded up to a power of two
+    head (consumer) and tail (producer) sit on separate cache lines, each side keeps a cached copy of the
+        other's index and only reloads it when the cached value says full / empty
+    T must be trivially copyable (records are memcpy'd in and out)
+    side data per slot (variable width payloads): try_push(v, fill) / consume_n(max, f) hand out the slot index,
+        the caller keeps a parallel array of capacity() entries
+*/
+namespace ictk{
+
+    template <class T>
+    class SpscRing{
+        static_assert(std::is_trivially_copyable_v<T>, "SpscRing<T>: T must be trivially copyable");
+
+        public:
+            SpscRing() = default;
+
+            SpscRing(const SpscRing&) = delete;
+            SpscRing& operator=(const SpscRing&) = delete;
+
+            [[nodiscard]] Status init(std::size_t capacity, MemoryArena& arena) noexcept{
+                if (capacity == 0 || capacity > (std::size_t{1} << 31)) return Status::kInvalidArg;
+                const std::size_t cap = std::bit_ceil(capacity);
+                slots_ = static_cast<T*>(arena.allocate(cap * sizeof(T), alignof(T) > 64 ? alignof(T) : 64, "spsc.slots"));
+                if (!slots_) return Status::kNoMem;
+                mask_ = cap - 1;
+                prod_.tail.store(0, std::memory_order_relaxed);
+                prod_.head_cache = 0;
+                prod_.drops.store(0, std::memory_order_relaxed);
+                cons_.head.store(0, std::memory_order_relaxed);
+                cons_.tail_cache = 0;
+                return Status::kOK;
+            }
+
+            // // producer side
+            bool try_push(const T& v) noexcept{
+                return try_push(v, [](std::size_t) noexcept{});
+            }
+
+            // // fill(slot) runs once the slot is known to be free, before the record is published
+            template <class F>
+            bool try_push(const T& v, F&& fill) noexcept{
+                const std::uint64_t t = prod_.tail.load(std::memory_order_relaxed);
+                if (t - prod_.head_cache > mask_){
+                    prod_.head_cache = cons_.head.load(std::memory_order_acquire);
+                    if (t - prod_.head_cache > mask_){
+                        prod_.drops.store(prod_.drops.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                        return false;
+                    }
+                }
+                fill(static_cast<std::size_t>(t & mask_));
+                slots_[t & mask_] = v;
+                prod_.tail.store(t + 1, std::memory_order_release);
+                return true;
+            }
+
+            // // consumer side
+            bool try_pop(T& out) noexcept{
+                return pop_n(&out, 1) == 1;
+            }
+
+            // // up to max records in one go (one acquire, one release)
+            std::size_t pop_n(T* out, std::size_t max) noexcept{
+                const std::uint64_t h = cons_.head.load(std::memory_order_relaxed);
+                if (cons_.tail_cache == h) cons_.tail_cache = prod_.tail.load(std::memory_order_acquire);
+                const std::uint64_t avail = cons_.tail_cache - h;
+                const std::size_t n = static_cast<std::size_t>(avail < max ? avail : max);
+                for (std::size_t i = 0; i < n; ++i) out[i] = slots_[(h + i) & mask_];
+                if (n) cons_.head.store(h + n, std::memory_order_release);
+                return n;
+            }
+
+            // // in place: f(record, slot) for up to max records; the slots are released after the last call
+            template <class F>
+            std::size_t consume_n(std::size_t max, F&& f) noexcept{
+                const std::uint64_t h = cons_.head.load(std::memory_order_relaxed);
+                if (cons_.tail_cache == h) cons_.tail_cache = prod_.tail.load(std::memory_order_acquire);
+                const std::uint64_t avail = cons_.tail_cache - h;
+                const std::size_t n = static_cast<std::size_t>(avail < max ? avail : max);
+                for (std::size_t i = 0; i < n; ++i){
+                    const auto slot = static_cast<std::size_t>((h + i) & mask_);
+                    f(static_cast<const T&>(slots_[slot]), slot);
+                }
+                if (n) cons_.head.store(h + n, std::memory_order_release);
+                return n;
+            }
+
+            std::size_t capacity() const noexcept{
+                return slots_ ? mask_ + 1 : 0;
+            }
+
+            // // approximate from any thread, exact from either side when the other is idle
+            std::size_t size() const noexcept{
+                const std::uint64_t t = prod_.tail.load(std::memory_order_acquire);
+                const std::uint64_t h = cons_.head.load(std::memory_order_acquire);
+                return static_cast<std::size_t>(t - h);
+            }
+
+            // // records the producer could not place (ring full)
+            std::uint64_t drops() const noexcept{
+                return prod_.drops.load(std::memory_order_relaxed);
+            }
+
+            // // records accepted so far
+            std::uint64_t pushed() const noexcept{
+                return prod_.tail.load(std::memory_order_relaxed);
+            }
+
+        private:
+            struct alignas(64) Producer{
+                std::atomic<std::uint64_t> tail{0};
+                std::uint64_t head_cache{0};
+                std::atomic<std::uint64_t> drops{0};
+            };
+            struct alignas(64) Consumer{
+                std::atomic<std::uint64_t> head{0};
+                std::uint64_t tail_cache{0};
+            };
+
+            Producer prod_{};
+            Consumer cons_{};
+            T* slots_{nullptr};
+            std::size_t mask_{0};
+    };
+
+} // namespace ictk
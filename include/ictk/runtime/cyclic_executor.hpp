@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+
+#include "ictk/core/time.hpp"
+#include "ictk/core/status.hpp"
+#include "ictk/core/result.hpp"
+#include "ictk/core/controller.hpp"
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/core/update_context.hpp"
+
+/*
+CyclicExecutor: one thread drives many IControllers with different periods (1 ms, 10 ms, 100 ms, ...)
+    offline (build()):
+        minor frame = gcd of the periods, major cycle = lcm (at most kMaxFrames minor frames)
+        each task gets a phase (first frame) -> released every period/minor frames from there
+        phases are staggered: heaviest task first, each one takes the phase that keeps the worst frame load lowest
+            (load = wcet_ns estimate per task, 1 if unknown) -> the 10 ms loops do not all land on the 1 ms tick 0
+        schedule table: per minor frame, the task list (fastest period first); allocated from the arena once
+    online:
+        step(): runs the next frame on the caller's clock (logical time only, deterministic, for tests/sim)
+        run(frames) / start(): absolute CLOCK_MONOTONIC deadlines + clock_nanosleep (no drift), Linux only
+            start() owns a thread: pinned to opts.cpu, SCHED_FIFO opts.priority (both best effort)
+
+    per release: ctx->plant.t = release time (k * minor, from 0) -> sense(ctx) -> ctl->update(ctx, out) -> actuate(out)
+        clocked runs time the update() call itself -> out->update_ns (the recorder's TickSample::lat_ns)
+        the controller's dt must equal the task period (its deadline accounting checks t spacing)
+    overruns:
+        a task that finishes after the end of its minor frame -> overrun, added to out->health.deadline_miss_count
+        frames that already ended when the loop gets to them are skipped, not replayed
+            -> the controller sees a timestamp gap and counts the miss itself (no double count)
+
+    no allocation after build(); stats are for reading after stop() / between step() calls
+*/
+namespace ictk::runtime{
+
+    // // fill ctx (y, r, ...) for this release; ctx->plant.t is already set
+    using SenseFn = void(*)(UpdateContext& ctx, void* user);
+
+    // // consume the command; st is what update() returned
+    using ActuateFn = void(*)(const Result& out, Status st, void* user);
+
+    struct CyclicTask{
+        IController* ctl{nullptr};
+        dt_ns period{0};
+
+        // // caller owned I/O, reused every release (out->u sized to the controller's nu)
+        UpdateContext* ctx{nullptr};
+        Result* out{nullptr};
+
+        // // optional
+        SenseFn sense{nullptr};
+        ActuateFn actuate{nullptr};
+        void* user{nullptr};
+
+        // // worst case execution estimate, only used to balance frames (0 -> counts as 1)
+        dt_ns wcet_ns{0};
+    };
+
+    struct CyclicTaskStats{
+        std::uint32_t phase{0};              // first minor frame
+        std::uint64_t releases{0};
+        std::uint64_t overruns{0};           // finished after its frame ended
+        std::uint64_t errors{0};             // update() != kOK
+        dt_ns worst_exec_ns{0};              // sense + update + actuate (clocked runs only)
+    };
+
+    struct CyclicExecutorStats{
+        dt_ns minor_ns{0};
+        dt_ns major_ns{0};
+        std::uint32_t frames{0};             // minor frames per major cycle
+        std::uint64_t max_frame_load{0};     // planned, sum of wcet_ns (or task count) in the worst frame
+        std::uint64_t frames_run{0};
+        std::uint64_t frames_skipped{0};
+        dt_ns worst_frame_ns{0};             // clocked runs only
+    };
+
+    struct RtOptions{
+        int cpu{-1};                         // pin the executor thread; -1 -> leave affinity alone
+        int priority{0};                     // SCHED_FIFO priority; 0 -> keep the default policy
+    };
+
+    class CyclicExecutor{
+        public:
+            // // largest major cycle in minor frames (periods with a huge lcm/gcd ratio are rejected)
+            static constexpr std::uint32_t kMaxFrames = 1u << 16;
+
+            CyclicExecutor() = default;
+            ~CyclicExecutor();
+
+            CyclicExecutor(const CyclicExecutor&) = delete;
+            CyclicExecutor& operator=(const CyclicExecutor&) = delete;
+
+            // // task slots from the arena
+            [[nodiscard]] Status init(std::size_t max_tasks, MemoryArena& arena) noexcept;
+
+            // // before build(); id = index for task_stats()
+            [[nodiscard]] Status add(const CyclicTask& task, std::size_t* id = nullptr) noexcept;
+
+            // // compute phases + schedule table; stagger = false puts every phase at 0 (worst case, for comparison)
+            [[nodiscard]] Status build(bool stagger = true) noexcept;
+
+            // // run the next minor frame now (no clock, no sleeping)
+            [[nodiscard]] Status step() noexcept;
+
+            // // run `frames` minor frames on the calling thread against the monotonic clock
+            [[nodiscard]] Status run(std::uint64_t frames) noexcept;
+
+            // // run until stop() on an executor owned thread
+            [[nodiscard]] Status start(const RtOptions& opts = {}) noexcept;
+            [[nodiscard]] Status stop() noexcept;
+
+            bool running() const noexcept{
+                return running_;
+            }
+
+            std::size_t size() const noexcept{
+                return n_;
+            }
+
+            const CyclicExecutorStats& stats() const noexcept{
+                return stats_;
+            }
+
+            const CyclicTaskStats& task_stats(std::size_t id) const noexcept;
+
+            // // planned load of minor frame f (f < stats().frames)
+            std::uint64_t frame_load(std::uint32_t f) const noexcept;
+
+        private:
+            struct Slot{
+                CyclicTask task{};
+                std::uint32_t stride{0};     // period in minor frames
+                CyclicTaskStats st{};
+            };
+
+            void run_frame_(std::uint64_t k, bool clocked, t_ns deadline) noexcept;
+            Status loop_(std::uint64_t frames) noexcept;
+
+            MemoryArena* arena_{nullptr};
+            Slot* slots_{nullptr};
+            std::size_t cap_{0};
+            std::size_t n_{0};
+
+            // // schedule table: frame f runs order_[begin_[f] .. begin_[f+1])
+            std::uint32_t* begin_{nullptr};
+            std::uint32_t* order_{nullptr};
+            std::uint64_t* load_{nullptr};
+            bool built_{false};
+
+            std::uint64_t next_frame_{0};
+            CyclicExecutorStats stats_{};
+
+            RtOptions opts_{};
+            std::atomic<bool> stop_req_{false};
+            bool running_{false};
+            std::thread thread_{};
+    };
+
+} // namespace ictk::runtime
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+
+#include "ictk/core/time.hpp"
+#include "ictk/core/status.hpp"
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/runtime/cyclic_executor.hpp"   // CyclicTask, RtOptions
+
+/*
+ParallelExecutor: one period, tens of thousands of independent loops, several cores
+    homes: task id -> worker id % workers; build its controller in arena_for(id) (that worker's MemoryArena)
+    shards: each worker's tasks, in id order, cut into runs of shard_tasks (cache sized, see ParallelOptions)
+    tick:
+        the caller is worker 0, workers 1.. are executor threads (started by start(), pinned first_cpu + w)
+        every worker claims its own shards first, then steals whole shards from the others (atomic claim counter
+        per worker; owner and thieves take from the same end, so a shard runs exactly once)
+    determinism:
+        a task only touches its own controller / ctx / out -> its output does not depend on which core ran it
+        or in which order the shards went; same bits as calling update() on one thread (test_parallel_executor)
+        sense/actuate run on whichever worker owns the shard that tick
+    deadlines (run() only): a shard that starts after the tick deadline counts one overrun for each of its tasks,
+        added to out->health.deadline_miss_count (same contract as CyclicExecutor)
+        and every update() is timed -> out->update_ns
+
+    no allocation after build(); stats are for reading between ticks / after stop()
+*/
+namespace ictk::runtime{
+
+    struct ParallelOptions{
+        std::size_t workers{1};              // including the calling thread, <= kMaxWorkers
+        std::size_t shard_tasks{0};          // tasks per shard; 0 -> from shard_bytes and the arena use per task
+        std::size_t shard_bytes{256 * 1024}; // target controller state per shard (per core L2 share)
+        int first_cpu{-1};                   // worker w pinned to first_cpu + w; -1 -> no pinning
+        int priority{0};                     // SCHED_FIFO for workers 1.. (and the caller via run()); 0 -> default
+    };
+
+    struct WorkerStats{
+        std::uint64_t ticks{0};
+        std::uint64_t tasks_run{0};
+        std::uint64_t shards_run{0};         // own + stolen
+        std::uint64_t steals{0};             // shards taken from another worker
+        dt_ns busy_ns{0};                    // time spent running shards
+
+        // // busy share of the tick period (1.0 = fully loaded core)
+        double utilization(dt_ns period) const noexcept{
+            return (ticks && period > 0) ? double(busy_ns) / (double(ticks) * double(period)) : 0.0;
+        }
+    };
+
+    struct ParallelExecutorStats{
+        std::uint64_t ticks{0};
+        std::uint64_t late_ticks{0};         // a shard started after the deadline
+        std::uint64_t ticks_skipped{0};      // run(): whole periods missed
+        std::size_t shards{0};
+        std::size_t shard_tasks{0};
+        dt_ns worst_tick_ns{0};
+    };
+
+    class ParallelExecutor{
+        public:
+            static constexpr std::size_t kMaxWorkers = 64;
+
+            ParallelExecutor() = default;
+            ~ParallelExecutor();
+
+            ParallelExecutor(const ParallelExecutor&) = delete;
+            ParallelExecutor& operator=(const ParallelExecutor&) = delete;
+
+            // // arena: executor tables; worker_arenas: one per worker (controller state lives there)
+            [[nodiscard]] Status init(dt_ns period, std::size_t max_tasks, const ParallelOptions& opts,
+                                      MemoryArena& arena, std::span<MemoryArena* const> worker_arenas) noexcept;
+
+            // // arena the controller of task `id` should be built in (ids are given out in add() order)
+            MemoryArena& arena_for(std::size_t id) noexcept{
+                return *arenas_[id % opts_.workers];
+            }
+            std::size_t next_id() const noexcept{
+                return n_;
+            }
+
+            // // task.period must be 0 or the executor period
+            [[nodiscard]] Status add(const CyclicTask& task, std::size_t* id = nullptr) noexcept;
+
+            // // cut shards, allocate the claim counters
+            [[nodiscard]] Status build() noexcept;
+
+            // // spawn workers 1..workers-1
+            [[nodiscard]] Status start() noexcept;
+            [[nodiscard]] Status stop() noexcept;
+
+            // // one tick at logical time k * period (blocking; caller is worker 0)
+            [[nodiscard]] Status tick() noexcept;
+
+            // // `ticks` ticks against CLOCK_MONOTONIC deadlines (absolute sleep), Linux only
+            [[nodiscard]] Status run(std::uint64_t ticks) noexcept;
+
+            std::size_t size() const noexcept{
+                return n_;
+            }
+            std::size_t workers() const noexcept{
+                return opts_.workers;
+            }
+            dt_ns period() const noexcept{
+                return period_;
+            }
+
+            const ParallelExecutorStats& stats() const noexcept{
+                return stats_;
+            }
+            const WorkerStats& worker_stats(std::size_t w) const noexcept;
+
+            std::uint64_t overruns(std::size_t id) const noexcept;
+
+        private:
+            struct Slot{
+                CyclicTask task{};
+                std::uint64_t overruns{0};
+            };
+
+            struct Shard{
+                std::uint32_t first{0};          // into order_
+                std::uint32_t count{0};
+            };
+
+            // // one cache line of shared state per worker (no false sharing between claim counters)
+            struct alignas(64) Worker{
+                std::atomic<std::uint32_t> next{0};   // next own shard to claim this tick
+                std::uint32_t shard_begin{0};
+                std::uint32_t shard_count{0};
+                WorkerStats st{};
+            };
+
+            void tick_(bool clocked, t_ns deadline) noexcept;
+            void work_(std::size_t w) noexcept;
+            void run_shard_(const Shard& sh) noexcept;
+            void worker_main_(std::size_t w, std::uint64_t seen) noexcept;
+
+            dt_ns period_{0};
+            ParallelOptions opts_{};
+            MemoryArena* arena_{nullptr};
+            std::array<MemoryArena*, kMaxWorkers> arenas_{};
+
+            Slot* slots_{nullptr};
+            std::size_t cap_{0};
+            std::size_t n_{0};
+
+            Worker* workers_{nullptr};
+            Shard* shards_{nullptr};
+            std::uint32_t* order_{nullptr};
+            bool built_{false};
+
+            // // tick hand off: epoch_ bumps release the workers, pending_ counts the ones still busy
+            std::atomic<std::uint64_t> epoch_{0};
+            std::atomic<std::uint32_t> pending_{0};
+            std::atomic<bool> quit_{false};
+            std::atomic<bool> tick_late_{false};
+            t_ns tick_t_{0};
+            t_ns deadline_{0};
+            bool clocked_{false};
+
+            std::uint64_t next_tick_{0};
+            ParallelExecutorStats stats_{};
+            std::array<std::thread, kMaxWorkers> threads_{};
+            bool running_{false};
+    };
+
+} // namespace ictk::runtime
@@ -14,12 +14,28 @@ namespace ictk::safety{
     };
 
     // helpers
-    inline Scalar aw_backcalc_term(Scalar u_unsat, Scalar u_sat, Scalar Kt) noexcept{
+    template <class T>
+    inline T aw_backcalc_term(T u_unsat, T u_sat, T Kt) noexcept{
         return (u_sat - u_unsat) * Kt;
     }
 
-    inline Scalar aw_conditional_term(Scalar u_unsat, Scalar u_sat, Scalar Kt) noexcept{
-        return (u_sat != u_unsat) ? (u_sat - u_unsat) * Kt : Scalar(0);
+    template <class T>
+    inline T aw_conditional_term(T u_unsat, T u_sat, T Kt) noexcept{
+        return (u_sat != u_unsat) ? (u_sat - u_unsat) * Kt : T(0);
+    }
+
+    // // one channel's correction for mode -> shared by PIDLaw and FixedPIDCore
+    template <class T>
+    inline T aw_term(AWMode mode, T u_unsat, T u_sat, T Kt) noexcept{
+        switch (mode){
+            case AWMode::kBackCalc:
+                return aw_backcalc_term(u_unsat, u_sat, Kt);
+            case AWMode::kConditional:
+                return aw_conditional_term(u_unsat, u_sat, Kt);
+            case AWMode::kOff:
+                break;
+        }
+        return T(0);
     }
 
     // // back calculation: e_aw = (u_sat - u_unsat) * Kt; caller integrates e_aw into integrator state
@@ -0,0 +1,92 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include "ictk/safety/clip.hpp"
+
+// // per tick results of the safety chain; filled by the staged chain (ControllerBase), fused_chain and the
+// // static chains (StaticControllerBase, FixedPIDCore), read by the health wiring
+namespace ictk{
+
+    struct SatStep{
+        std::uint64_t hits{0};  // how many channels saturated per tick
+        double pct{0.0};        // hits/nu
+    };
+
+    // // one tick of the safety chain: sat -> rate -> jerk
+    struct ChainStep{
+        SatStep sat{};
+        std::uint64_t rate_hits{0};
+        std::uint64_t jerk_hits{0};
+
+        // max |del u| per stage
+        double clamp_mag{0.0};
+        double rate_mag{0.0};
+        double jerk_mag{0.0};
+
+        // bit i set if the stage changed u[i] (first 64 channels)
+        std::uint64_t sat_mask{0};
+        std::uint64_t rate_mask{0};
+        std::uint64_t jerk_mask{0};
+
+        // sum |u_sat - u_pre| over channels
+        double aw_sum{0.0};
+    };
+
+    // // which health counters a stage feeds
+    enum class StageKind : std::uint8_t{
+        kSaturation,
+        kRate,
+        kJerk
+    };
+
+    namespace safety{
+        // // true iff the stage moved the value; false for NaN so an untouched NaN is not reported as a hit
+        template <class T>
+        constexpr bool moved(T a, T b) noexcept{
+            return a < b || b < a;
+        }
+
+        /*
+        health fold of the per channel chains (fused_chain, StaticControllerBase, FixedPIDCore) -> one rule for all:
+            fold<K>(step, c, v, bit): stage K turned v into c -> hit count, max |c.val - v|, mask bit if it moved
+            fold_channel(step, v, v0): channel done, v0 in / v out -> aw sum
+            fold_sat_pct(step, n): sweep done over n channels -> saturation percent
+        */
+        template <StageKind K, class T>
+        inline void fold(ChainStep& step, const BasicClip<T>& c, T v, std::uint64_t bit) noexcept{
+            const double mag = std::abs(static_cast<double>(c.val - v));
+            const bool mv = moved(c.val, v);
+            if constexpr (K == StageKind::kSaturation){
+                if (c.hit) ++step.sat.hits;
+                step.clamp_mag = std::max(step.clamp_mag, mag);
+                if (mv) step.sat_mask |= bit;
+            }else if constexpr (K == StageKind::kRate){
+                if (c.hit) ++step.rate_hits;
+                step.rate_mag = std::max(step.rate_mag, mag);
+                if (mv) step.rate_mask |= bit;
+            }else{
+                if (c.hit) ++step.jerk_hits;
+                step.jerk_mag = std::max(step.jerk_mag, mag);
+                if (mv) step.jerk_mask |= bit;
+            }
+        }
+
+        template <class T>
+        inline void fold_channel(ChainStep& step, T v, T v0) noexcept{
+            step.aw_sum += std::abs(static_cast<double>(v - v0));
+        }
+
+        inline void fold_sat_pct(ChainStep& step, std::size_t n) noexcept{
+            if (n) step.sat.pct = 100.0 * double(step.sat.hits) / double(n);
+        }
+
+        // // mask bit of channel i; channels past 64 are counted but not masked
+        constexpr std::uint64_t chain_bit(std::size_t i) noexcept{
+            return (i < 64) ? (1ull << i) : 0ull;
+        }
+    } // namespace safety
+
+} // namespace ictk
@@ -2,9 +2,13 @@
 #include "ictk/core/types.hpp"
 
 namespace ictk::safety{
-struct Clip{
-    Scalar val;
-    bool   hit;
-    Scalar mag;
+// // T: arithmetic of the stage (Scalar everywhere but FixedPIDCore<N, float>)
+template <class T>
+struct BasicClip{
+    T    val;
+    bool hit;
+    T    mag;
 };
+
+using Clip = BasicClip<Scalar>;
 } // namespace ictk::safety
@@ -27,7 +27,7 @@ namespace ictk::safety{
                 std::size_t nu                  
             ) noexcept: safe_(safe_u), rmax_(rmax), dt_(dt){
                 // // internal working copy stored in arena -> holds fallback last output
-                u_ = static_cast<Scalar*>(arena.allocate(nu*sizeof(Scalar), alignof(Scalar)));  
+                u_ = static_cast<Scalar*>(arena.allocate(nu*sizeof(Scalar), alignof(Scalar), "fallback.u"));  
                 nu_ = nu; // // no of output channel
                 // // seeds u[i] = safe[i] if present else 0
                 if (u_) for (std::size_t i=0; i<nu; ++i) u_[i] = (i < safe_u.size() ? safe_u[i] : Scalar(0));
@@ -0,0 +1,95 @@
+#pragma once
+#include <span>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include "ictk/core/types.hpp"
+#include "ictk/safety/clip.hpp"
+#include "ictk/safety/saturation.hpp"
+#include "ictk/safety/rate_limit.hpp"
+#include "ictk/safety/jerk_limit.hpp"
+#include "ictk/safety/chain_step.hpp"
+
+/*
+Goal: run saturation -> rate -> jerk in one sweep over the command vector
+    The staged chain in ControllerBase copies u into scratch buffers and sweeps it once per stage plus
+    once per stage for the clip magnitude. Here each channel walks through all stages while it is in a register:
+    u_pre[i] is written once, u[i] is written once, magnitudes/masks/hits are accumulated on the way.
+
+    Per element math is the same step_at()/clamp_at() the staged apply() uses -> byte-identical output and health.
+    Absent stages are removed at compile time (8 instantiations), so no per element branch on configuration.
+*/
+namespace ictk::safety{
+    namespace detail{
+        template <bool kSat, bool kRate, bool kJerk>
+        inline void fused_chain_pass(
+            std::span<Scalar> u,
+            std::span<Scalar> u_pre,
+            const Saturation* sat,
+            RateLimiter* rl,
+            JerkLimiter* jl,
+            ChainStep& step) noexcept{
+
+            const std::size_t n = u.size();
+            for (std::size_t i=0; i<n; ++i){
+                const Scalar v0 = u[i];
+                const std::uint64_t bit = chain_bit(i);
+                u_pre[i] = v0;
+                Scalar v = v0;
+
+                if constexpr (kSat){
+                    const Clip c = sat->clamp_at(i, v);
+                    fold<StageKind::kSaturation>(step, c, v, bit);
+                    v = c.val;
+                }
+
+                if constexpr (kRate){
+                    const Clip c = rl->step_at(i, v);
+                    fold<StageKind::kRate>(step, c, v, bit);
+                    v = c.val;
+                }
+
+                if constexpr (kJerk){
+                    const Clip c = jl->step_at(i, v);
+                    fold<StageKind::kJerk>(step, c, v, bit);
+                    v = c.val;
+                }
+
+                fold_channel(step, v, v0);
+                u[i] = v;
+            }
+
+            if constexpr (kSat) fold_sat_pct(step, n);
+        }
+    } // namespace detail
+
+    // // nullptr (or an invalid limiter) disables a stage; u_pre must hold u.size() elements
+    inline void fused_chain(
+        std::span<Scalar> u,
+        std::span<Scalar> u_pre,
+        const Saturation* sat,
+        RateLimiter* rl,
+        JerkLimiter* jl,
+        ChainStep& step) noexcept{
+
+        if (rl && !rl->valid()) rl = nullptr;
+        if (jl && !jl->valid()) jl = nullptr;
+        if (rl) rl->begin_tick();
+        if (jl) jl->begin_tick();
+
+        using detail::fused_chain_pass;
+        const unsigned sel = (sat ? 4u : 0u) | (rl ? 2u : 0u) | (jl ? 1u : 0u);
+        switch (sel){
+            case 0: fused_chain_pass<false, false, false>(u, u_pre, sat, rl, jl, step); break;
+            case 1: fused_chain_pass<false, false, true >(u, u_pre, sat, rl, jl, step); break;
+            case 2: fused_chain_pass<false, true,  false>(u, u_pre, sat, rl, jl, step); break;
+            case 3: fused_chain_pass<false, true,  true >(u, u_pre, sat, rl, jl, step); break;
+            case 4: fused_chain_pass<true,  false, false>(u, u_pre, sat, rl, jl, step); break;
+            case 5: fused_chain_pass<true,  false, true >(u, u_pre, sat, rl, jl, step); break;
+            case 6: fused_chain_pass<true,  true,  false>(u, u_pre, sat, rl, jl, step); break;
+            default: fused_chain_pass<true, true,  true >(u, u_pre, sat, rl, jl, step); break;
+        }
+    }
+} // namespace ictk::safety
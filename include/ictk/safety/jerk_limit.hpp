@@ -10,6 +10,7 @@
 #include "ictk/core/types.hpp"
 #include "ictk/safety/clip.hpp"
 #include "ictk/core/memory_arena.hpp"
+#include "ictk/safety/simd_kernels.hpp"
 
 /*
 Goal: To cap both rate and jerk of the command vector u for each tick.
@@ -27,17 +28,18 @@ namespace ictk::safety{
     #ifndef ICTK_SAFETY_CLIP_DEFINED
     #define ICTK_SAFETY_CLIP_DEFINED
 
-    static inline Clip jerk_limit_scalar(
-        Scalar u_now,
-        Scalar u_prev,
-        Scalar du_prev,
-        Scalar ddu_max
+    template <class T>
+    inline BasicClip<T> jerk_limit_scalar(
+        T u_now,
+        T u_prev,
+        T du_prev,
+        T ddu_max
     ) noexcept{
-        const Scalar lo = du_prev - ddu_max;
-        const Scalar hi = du_prev + ddu_max;
+        const T lo = du_prev - ddu_max;
+        const T hi = du_prev + ddu_max;
 
-        Scalar du = u_now - u_prev; // desired step this tick
-        Scalar mag = Scalar(0);
+        T du = u_now - u_prev; // desired step this tick
+        T mag = T(0);
         bool hit = false;
 
         if (du < lo){
@@ -53,6 +55,20 @@ namespace ictk::safety{
         return {u_prev + du, hit, mag};
     }
 
+    // // rate band then jerk band on one element, prev / dprev committed -> shared by step_at() and FixedPIDCore's chain
+    template <class T>
+    inline BasicClip<T> jerk_step_scalar(T v, T& prev, T& dprev, T rstep, T jstep) noexcept{
+        // Rate clamp of output.
+        const T u_rate = std::clamp(v, prev - rstep, prev + rstep);
+
+        // Jerk clamp of step.
+        const BasicClip<T> c = jerk_limit_scalar(u_rate, prev, dprev, jstep);
+
+        dprev = c.val - prev;
+        prev = c.val;
+        return c;
+    }
+
     #endif  
     class JerkLimiter{
         public:
@@ -66,50 +82,45 @@ namespace ictk::safety{
                     assert(nu > 0);
                 #endif
 
-                prev_ = static_cast<Scalar*>(arena.allocate(nu*sizeof(Scalar), alignof(Scalar)));   // last output -> u[i] at k-1
-                dprev_ = static_cast<Scalar*>(arena.allocate(nu*sizeof(Scalar), alignof(Scalar)));  // last step   -> u[k-1] - u[k-2]
+                prev_ = static_cast<Scalar*>(arena.allocate(nu*sizeof(Scalar), alignof(Scalar), "jerk.prev"));   // last output -> u[i] at k-1
+                dprev_ = static_cast<Scalar*>(arena.allocate(nu*sizeof(Scalar), alignof(Scalar), "jerk.dprev"));  // last step   -> u[k-1] - u[k-2]
                 nu_ = nu;
 
                 // // seeds both to 0
                 if (prev_) for (std::size_t i=0; i<nu;++i) prev_[i]=Scalar(0);
                 if (dprev_) for (std::size_t i=0; i<nu; ++i) dprev_[i]=Scalar(0);
+
+                // // per tick bands, fixed for the limiter's lifetime
+                const Scalar dt_s = Scalar(dt_) * 1e-9; // ns to sec conv
+                rstep_ = rmax_ * dt_s;                  // max |du| per tick
+                jstep_ = jmax_ * dt_s;                  // max |du - dprev| per tick
             }
 
             std::uint64_t apply(std::span<Scalar> u) noexcept{
                 if (!prev_ || !dprev_) return 0;
-
-                std::uint64_t hits = 0;
-                last_mag_ = Scalar(0);
-                
-                const Scalar dt_s = Scalar(dt_) * 1e-9; // ns to sec conv
-                const Scalar rstep = rmax_ * dt_s;      // max |du| this tick
-                const Scalar jstep = jmax_ * dt_s;      // max |du - dprev| this tick
+                begin_tick();
 
                 #ifndef NDEBUG
-                    assert(std::isfinite(dt_s) && dt_s > Scalar(0));
+                    assert(u.size() <= nu_);
                 #endif
+                // // O(n) cost, SIMD kernel (same math as step_at)
+                return simd::kernels().jerk(u.data(), prev_, dprev_, rstep_, jstep_, u.size(), last_mag_);
+            }
 
-                // // O(n) cost
-                 for (std::size_t i = 0; i < u.size(); ++i){
-                    const Scalar lo_r = prev_[i] - rstep;
-                    const Scalar hi_r = prev_[i] + rstep;
-
-                    // Rate clamp of output.
-                    const Scalar u_rate = std::clamp(u[i], lo_r, hi_r);
-
-                    // Jerk clamp of step.
-                    const Clip c = jerk_limit_scalar(u_rate, prev_[i], dprev_[i], jstep);
+            // // per tick prologue for element wise use (fused safety chain); apply() calls it itself
+            void begin_tick() noexcept{
+                last_mag_ = Scalar(0);
 
-                    u[i] = c.val;
-                    dprev_[i] = u[i] - prev_[i];
-                    prev_[i] = u[i];
+                #ifndef NDEBUG
+                    assert(std::isfinite(Scalar(dt_) * 1e-9) && dt_ > 0);
+                #endif
+            }
 
-                    if (c.hit){     // if clamped -> increment hit
-                        ++hits;
-                        if (c.mag > last_mag_) last_mag_ = c.mag;
-                    }
-                }
-                return hits;
+            // // rate + jerk limit one element and commit it; requires valid() and begin_tick()
+            Clip step_at(std::size_t i, Scalar v) noexcept{
+                const Clip c = jerk_step_scalar(v, prev_[i], dprev_[i], rstep_, jstep_);
+                if (c.hit && c.mag > last_mag_) last_mag_ = c.mag;
+                return c;
             }
 
             void reset(std::span<const Scalar> u0) noexcept{
@@ -139,5 +150,6 @@ namespace ictk::safety{
             std::size_t nu_{0};
 
             Scalar last_mag_{0};
+            Scalar rstep_{0}, jstep_{0};
     };
 } // namespace ictk::safety
@@ -10,21 +10,24 @@
 #include "ictk/core/types.hpp"
 #include "ictk/safety/clip.hpp"
 #include "ictk/core/memory_arena.hpp"
+#include "ictk/safety/simd_kernels.hpp"
 
 /*
 Goal: To bound, how fast each command element can change per tick
     
     It supports per channel tick or one uniform limit, keeps the previous output in arena backend memory for RT safety,
     and returns how many elements were clamped this tick
+    The per channel step rmax*dt is computed once at construction (arena array step_), apply() runs the SIMD kernel
 */
 namespace ictk::safety{
 
-    // helper function
-    static inline Clip rate_limiter_scalar(Scalar u_now, Scalar u_prev, Scalar du_max){
-        const Scalar lo=u_prev - du_max, hi = u_prev + du_max;
+    // helper function -> shared by step_at() and FixedPIDCore's chain
+    template <class T>
+    inline BasicClip<T> rate_limiter_scalar(T u_now, T u_prev, T du_max) noexcept{
+        const T lo=u_prev - du_max, hi = u_prev + du_max;
         if (u_now < lo) return {lo, true, std::abs(lo - u_now)};
         if (u_now > hi) return {hi, true, std::abs(u_now - hi)};
-        return {u_now, false, Scalar(0)};
+        return {u_now, false, T(0)};
     }
     
     class RateLimiter{
@@ -39,42 +42,43 @@ namespace ictk::safety{
             // // Per channel limit
             RateLimiter(std::span<const Scalar> rmax, dt_ns dt, MemoryArena &arena, std::size_t nu) noexcept
             : rmax_(rmax), dt_(dt){
-                prev_ = static_cast<Scalar*>(arena.allocate(nu * sizeof(Scalar), alignof(Scalar))); // // last emitted ouput of each channel
+                prev_ = static_cast<Scalar*>(arena.allocate(nu * sizeof(Scalar), alignof(Scalar), "rate.prev")); // // last emitted ouput of each channel
                 nu_ = nu;
                 if (prev_) for (std::size_t i=0; i<nu; ++i) prev_[i] = 0;                           // // zero init
+                init_steps_(arena);
             }
 
             // // uniform rmax for all channel  || No implicit conversions || Same limit for all channel
             explicit RateLimiter (Scalar rmax_uniform, dt_ns dt, MemoryArena& arena, std::size_t nu) noexcept
             : dt_(dt), rmax_s_(rmax_uniform){
-                prev_ = static_cast<Scalar*>(arena.allocate(nu * sizeof(Scalar), alignof(Scalar)));
+                prev_ = static_cast<Scalar*>(arena.allocate(nu * sizeof(Scalar), alignof(Scalar), "rate.prev"));
                 nu_ = nu;
                 if (prev_) for (std::size_t i=0; i<nu; ++i) prev_[i] = 0;
+                init_steps_(arena);
             }
 
 
             std::uint64_t apply(std::span<Scalar> u) noexcept{
-                if (!prev_) return 0;                   // // inert if no storage
-                std::uint64_t hits=0;
-                last_mag_ = 0;
-                const Scalar dts = Scalar(dt_) * 1e-9;  // // convert ns to seconds 
-                const bool per = !rmax_.empty();
-            
+                if (!valid()) return 0;                 // // inert if no storage
+                begin_tick();
+
                 #ifndef NDEBUG
-                    if (per) assert(rmax_.size() >= u.size());      // shape guard for DEBUG
+                    assert(u.size() <= nu_);            // shape guard for DEBUG
                 #endif
-                    for (std::size_t i=0; i<u.size(); ++i){
-                        const Scalar r = per ? rmax_[i] : rmax_s_;  // pick limit r
-                        const auto c = rate_limiter_scalar(u[i], prev_[i], r*dts);
-                        u[i] = c.val;
-                        prev_[i] = u[i];
-                        if (c.hit){     // if clamped -> increment hit
-                            ++hits;
-                            last_mag_ = std::max(last_mag_, c.mag);
-                        }
-                    }
+                return simd::kernels().rate(u.data(), prev_, step_, u.size(), last_mag_);
+            }
+
+            // // per tick prologue for element wise use (fused safety chain); apply() calls it itself
+            void begin_tick() noexcept{
+                last_mag_ = 0;
+            }
 
-                    return hits;
+            // // limit one element against its previous output and commit it; requires valid() and begin_tick()
+            Clip step_at(std::size_t i, Scalar v) noexcept{
+                const Clip c = rate_limiter_scalar(v, prev_[i], step_[i]);
+                prev_[i] = c.val;
+                if (c.hit) last_mag_ = std::max(last_mag_, c.mag);
+                return c;
             }
 
             // reset to given initial vector 
@@ -85,7 +89,7 @@ namespace ictk::safety{
 
             // chck alloc
             bool valid() const noexcept{
-                return prev_!=nullptr;
+                return prev_!=nullptr && step_!=nullptr;
             }
 
             // biggest mag clipped
@@ -95,9 +99,21 @@ namespace ictk::safety{
 
 
         private:
+            // // step_[i] = rmax_i * dt [s]; a one element span is broadcast, missing channels fall back to the uniform limit
+            void init_steps_(MemoryArena& arena) noexcept{
+                step_ = static_cast<Scalar*>(arena.allocate(nu_ * sizeof(Scalar), alignof(Scalar), "rate.step"));
+                if (!step_) return;
+                const Scalar dts = Scalar(dt_) * 1e-9;  // // convert ns to seconds
+                for (std::size_t i=0; i<nu_; ++i){
+                    const Scalar r = rmax_.size() == 1 ? rmax_[0] : (i < rmax_.size() ? rmax_[i] : rmax_s_);
+                    step_[i] = r * dts;
+                }
+            }
+
             std::span <const Scalar> rmax_{};
             dt_ns dt_{0};
             Scalar* prev_{nullptr};
+            Scalar* step_{nullptr};
             std::size_t  nu_{0};
             Scalar rmax_s_{0};
             Scalar last_mag_{0};
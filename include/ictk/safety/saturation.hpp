@@ -7,6 +7,8 @@
 #include <cassert>
 
 #include "ictk/core/types.hpp"
+#include "ictk/safety/clip.hpp"
+#include "ictk/safety/simd_kernels.hpp"
 
 /*
 Goal: 
@@ -21,6 +23,14 @@ namespace ictk::safety{
         double saturation_pct{0.0}; // hits / u.size() * 100
     };
 
+    // // one element into [lo, hi] -> shared by clamp_at() and FixedPIDCore's chain
+    template <class T>
+    inline BasicClip<T> clamp_scalar(T v, T lo, T hi) noexcept{
+        if (v < lo) return {lo, true, lo - v};
+        if (v > hi) return {hi, true, v - hi};
+        return {v, false, T(0)};
+    }
+
     class Saturation{
         public:
             Saturation(std::span<const Scalar> umin, std::span<const Scalar> umax) noexcept : umin_(umin), umax_(umax) {}
@@ -37,22 +47,10 @@ namespace ictk::safety{
                     }
                 #endif
 
-                // // choose limits per elements
-                for (std::size_t i=0; i<u.size(); ++i){
-                    // // clamp each u[i] to [low, high]
-                    const Scalar lo = per ? umin_[i] : umin_s_;
-                    const Scalar hi = per ? umax_[i] : umax_s_;
-
-                    // // counts each elements that was clamped
-                    if (u[i] < lo){
-                        u[i] = lo;
-                        rep.hits++;
-                    }else if (u[i] > hi){
-                        u[i] = hi;
-                        rep.hits++;
-                    }
-
-                }
+                // // whole vector clamp on the best ISA (same compares as clamp_at)
+                const auto& k = simd::kernels();
+                rep.hits = per ? k.sat(u.data(), umin_.data(), umax_.data(), u.size())
+                               : k.sat_uniform(u.data(), umin_s_, umax_s_, u.size());
 
                 // // computes percent of channels that hit a clamp this tick 
                 if (!u.empty()){
@@ -63,7 +61,17 @@ namespace ictk::safety{
                 // // cost: O(n)
             }
         
+            // // single element clamp -> shared by apply() and the fused safety chain
+            Clip clamp_at(std::size_t i, Scalar v) const noexcept{
+                return clamp_at(i, v, !umin_.empty() && !umax_.empty());
+            }
+
         private:
+            Clip clamp_at(std::size_t i, Scalar v, bool per) const noexcept{
+                // // clamp u[i] to [low, high]
+                return clamp_scalar(v, per ? umin_[i] : umin_s_, per ? umax_[i] : umax_s_);
+            }
+
             std::span<const Scalar> umin_{}, umax_{};
             Scalar umin_s_{0}, umax_s_{0};
     };
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "ictk/core/types.hpp"
+
+/*
+Goal: whole-vector kernels for the staged safety stages (Saturation / RateLimiter / JerkLimiter ::apply)
+    one kernel table per instruction set, picked once by CPU detection (first use, AVX2 at most), scalar fallback everywhere
+    calls shorter than the table's lane count run the scalar loop
+    compiled in the ictk library (src/safety/simd_kernels.cc): callers only pay one indirect call per stage per tick
+
+    every kernel is the branch-free form of the scalar step (clamp_at / step_at):
+        same IEEE ops in the same order, no FMA (-ffp-contract=off), compares are false on NaN
+        -> bit-identical outputs, hit counts and last clip magnitudes on every ISA
+
+    x86-64 with GCC/Clang: SSE2, AVX2, AVX-512F (double lanes). Elsewhere, and for ICTK_SCALAR_FLOAT, the scalar table.
+*/
+namespace ictk::safety::simd{
+
+    enum class Isa : std::uint8_t{
+        kScalar = 0,
+        kSse2 = 1,
+        kAvx2 = 2,
+        kAvx512 = 3
+    };
+
+    struct Kernels{
+        // // u[i] = clamp(u[i], lo[i], hi[i]); returns hits
+        std::uint64_t (*sat)(Scalar* u, const Scalar* lo, const Scalar* hi, std::size_t n) noexcept;
+
+        // // same with one [lo, hi] for all channels
+        std::uint64_t (*sat_uniform)(Scalar* u, Scalar lo, Scalar hi, std::size_t n) noexcept;
+
+        // // u[i] limited to prev[i] ± step[i], prev <- u; last_mag = max(last_mag, clip mags); returns hits
+        std::uint64_t (*rate)(Scalar* u, Scalar* prev, const Scalar* step, std::size_t n, Scalar& last_mag) noexcept;
+
+        // // rate band ±rstep, then jerk band dprev ± jstep on the step; prev/dprev <- new output/step; returns hits
+        std::uint64_t (*jerk)(Scalar* u, Scalar* prev, Scalar* dprev, Scalar rstep, Scalar jstep, std::size_t n, Scalar& last_mag) noexcept;
+    };
+
+    // // best ISA this CPU (and build) supports
+    Isa detected_isa() noexcept;
+
+    // // ISA kernels() starts on: detected_isa() capped at AVX2 (AVX-512 is opt in through select_isa)
+    Isa default_isa() noexcept;
+
+    // // ISA of the table kernels() returns
+    Isa active_isa() noexcept;
+
+    // // pin a lower ISA (tests, benchmarks); false if not supported here. Not for use while control threads run.
+    bool select_isa(Isa isa) noexcept;
+
+    // // current table; detection runs on first call
+    const Kernels& kernels() noexcept;
+
+    const char* isa_name(Isa isa) noexcept;
+
+} // namespace ictk::safety::simd
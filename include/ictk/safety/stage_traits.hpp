@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+
+#include "ictk/core/types.hpp"
+#include "ictk/core/static_controller_base.hpp"
+#include "ictk/safety/clip.hpp"
+#include "ictk/safety/saturation.hpp"
+#include "ictk/safety/rate_limit.hpp"
+#include "ictk/safety/jerk_limit.hpp"
+
+/*
+StageTraits for the built-in limiters -> usable as StaticControllerBase<Derived, Stages...> stages
+    step() is the same per element call the fused chain uses (clamp_at / step_at) -> same numbers as ControllerBase
+*/
+namespace ictk{
+
+    template <>
+    struct StageTraits<safety::Saturation>{
+        static constexpr StageKind kind = StageKind::kSaturation;
+        static bool ready(const safety::Saturation&) noexcept{ return true; }
+        static void begin(safety::Saturation&) noexcept{}
+        static safety::Clip step(safety::Saturation& s, std::size_t i, Scalar v) noexcept{
+            return s.clamp_at(i, v);
+        }
+    };
+
+    template <>
+    struct StageTraits<safety::RateLimiter>{
+        static constexpr StageKind kind = StageKind::kRate;
+        static bool ready(const safety::RateLimiter& s) noexcept{ return s.valid(); }
+        static void begin(safety::RateLimiter& s) noexcept{ s.begin_tick(); }
+        static safety::Clip step(safety::RateLimiter& s, std::size_t i, Scalar v) noexcept{
+            return s.step_at(i, v);
+        }
+    };
+
+    template <>
+    struct StageTraits<safety::JerkLimiter>{
+        static constexpr StageKind kind = StageKind::kJerk;
+        static bool ready(const safety::JerkLimiter& s) noexcept{ return s.valid(); }
+        static void begin(safety::JerkLimiter& s) noexcept{ s.begin_tick(); }
+        static safety::Clip step(safety::JerkLimiter& s, std::size_t i, Scalar v) noexcept{
+            return s.step_at(i, v);
+        }
+    };
+
+} // namespace ictk
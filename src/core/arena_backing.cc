@@ -0,0 +1,187 @@
+#include "ictk/core/arena_backing.hpp"
+
+#include <new>
+#include <cstddef>
+
+#if defined(__linux__)
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+#endif
+
+namespace ictk{
+
+    namespace{
+
+        constexpr std::size_t kHugePage = std::size_t{2} << 20;
+        constexpr std::size_t kHeapAlign = 64;
+
+        // // mbind(2) without libnuma: nodes 0..kMaxNodes-1
+        constexpr std::size_t kMaxNodes = 1024;
+        constexpr int kMpolBind = 2;
+        constexpr unsigned kMpolMfStrict = 1u;
+        constexpr unsigned kMpolMfMove = 2u;
+
+        constexpr std::size_t round_up(std::size_t x, std::size_t a) noexcept{
+            return (x + (a - 1)) / a * a;
+        }
+
+        void* heap_alloc(std::size_t bytes) noexcept{
+            return ::operator new(bytes, std::align_val_t{kHeapAlign}, std::nothrow);
+        }
+
+        #if defined(__linux__)
+        const auto kMapFailed = reinterpret_cast<void*>(std::intptr_t{-1});
+
+        std::size_t base_page() noexcept{
+            const long p = sysconf(_SC_PAGESIZE);
+            return p > 0 ? static_cast<std::size_t>(p) : 4096u;
+        }
+
+        bool bind_node(void* p, std::size_t bytes, int node) noexcept{
+            #if defined(SYS_mbind)
+                if (node < 0 || static_cast<std::size_t>(node) >= kMaxNodes) return false;
+                constexpr std::size_t kBits = 8 * sizeof(unsigned long);
+                unsigned long mask[kMaxNodes / kBits]{};
+                const auto n = static_cast<std::size_t>(node);
+                mask[n / kBits] = 1ul << (n % kBits);
+                return syscall(SYS_mbind, p, bytes, kMpolBind, mask, kMaxNodes + 1, kMpolMfStrict | kMpolMfMove) == 0;
+            #else
+                (void)p; (void)bytes; (void)node;
+                return false;
+            #endif
+        }
+        #endif
+
+    } // namespace
+
+    const char* to_string(BackingKind k) noexcept{
+        switch (k){
+            case BackingKind::kHeap: return "heap";
+            case BackingKind::kPages: return "pages";
+            case BackingKind::kTHP: return "thp";
+            case BackingKind::kHugeTLB: return "hugetlb";
+            case BackingKind::kNone: break;
+        }
+        return "none";
+    }
+
+    ArenaBacking::~ArenaBacking(){
+        release();
+    }
+
+    Status ArenaBacking::acquire(const BackingOptions& opts) noexcept{
+        release();
+        if (opts.bytes == 0) return Status::kInvalidArg;
+
+        BackingInfo info{};
+        bool refused = false;
+
+        #if defined(__linux__)
+            // // 1- 2 MB pages from the reserved pool
+            if (opts.hugepages){
+                const std::size_t len = round_up(opts.bytes, kHugePage);
+                void* p = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (p != kMapFailed){
+                    base_ = p;
+                    info.kind = BackingKind::kHugeTLB;
+                    info.bytes = len;
+                    info.page_size = kHugePage;
+                }
+            }
+
+            // // 2/3- anonymous mapping; THP when the size allows a huge page at all
+            if (!base_){
+                const bool thp = opts.hugepages && opts.bytes >= kHugePage;
+                const std::size_t len = thp ? round_up(opts.bytes, kHugePage) : round_up(opts.bytes, base_page());
+                // // THP only backs 2 MB aligned ranges: over map by one huge page, trim head and tail
+                const std::size_t extra = thp ? kHugePage : 0;
+                void* p = mmap(nullptr, len + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p != kMapFailed){
+                    auto* raw = static_cast<std::byte*>(p);
+                    if (thp){
+                        const auto at = reinterpret_cast<std::uintptr_t>(raw);
+                        const std::size_t head = static_cast<std::size_t>(round_up(at, kHugePage) - at);
+                        if (head) munmap(raw, head);
+                        if (extra - head) munmap(raw + head + len, extra - head);
+                        raw += head;
+                    }
+                    base_ = raw;
+                    info.bytes = len;
+                    info.kind = BackingKind::kPages;
+                    info.page_size = base_page();
+                    #if defined(MADV_HUGEPAGE)
+                        if (thp && madvise(raw, len, MADV_HUGEPAGE) == 0){
+                            info.kind = BackingKind::kTHP;
+                            info.page_size = kHugePage;
+                        }
+                    #endif
+                }
+            }
+            if (opts.hugepages && info.kind != BackingKind::kHugeTLB && info.kind != BackingKind::kTHP) refused = true;
+        #endif
+
+        // // last resort / non Linux
+        if (!base_){
+            base_ = heap_alloc(opts.bytes);
+            if (!base_) return Status::kNoMem;
+            info.kind = BackingKind::kHeap;
+            info.bytes = opts.bytes;
+            info.page_size = 4096;
+            if (opts.hugepages) refused = true;
+        }
+        info_ = info;
+
+        // // placement before the first touch: the pages are allocated on the node when faulted below
+        if (opts.numa_node >= 0){
+            #if defined(__linux__)
+                if (info_.kind != BackingKind::kHeap && bind_node(base_, info_.bytes, opts.numa_node)) info_.numa_node = opts.numa_node;
+                else refused = true;
+            #else
+                refused = true;
+            #endif
+        }
+
+        if (opts.lock){
+            #if defined(__linux__)
+                if (mlock(base_, info_.bytes) == 0) info_.locked = true;
+                else refused = true;
+            #else
+                refused = true;
+            #endif
+        }
+
+        // // one write per page: page tables (and THP collapse) now, not in the first tick
+        if (opts.prefault){
+            auto* p = static_cast<volatile unsigned char*>(base_);
+            // // THP may still hand out base pages (no free huge page, khugepaged later) -> touch every base page
+            #if defined(__linux__)
+                const std::size_t step = (info_.kind == BackingKind::kHugeTLB) ? kHugePage : base_page();
+            #else
+                const std::size_t step = 4096;
+            #endif
+            for (std::size_t off = 0; off < info_.bytes; off += step) p[off] = 0;
+            info_.prefaulted = true;
+        }
+
+        if (opts.strict && refused){
+            release();
+            return Status::kPreconditionFail;
+        }
+        return Status::kOK;
+    }
+
+    void ArenaBacking::release() noexcept{
+        if (!base_) return;
+        #if defined(__linux__)
+            if (info_.locked) munlock(base_, info_.bytes);
+            if (info_.kind != BackingKind::kHeap) munmap(base_, info_.bytes);
+            else ::operator delete(base_, std::align_val_t{kHeapAlign});
+        #else
+            ::operator delete(base_, std::align_val_t{kHeapAlign});
+        #endif
+        base_ = nullptr;
+        info_ = {};
+    }
+
+} // namespace ictk
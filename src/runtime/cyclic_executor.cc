@@ -0,0 +1,280 @@
+#include "ictk/runtime/cyclic_executor.hpp"
+
+#include <new>
+#include <numeric>
+#include <algorithm>
+
+#include "rt_clock.hpp"
+
+namespace ictk::runtime{
+
+    namespace{
+
+        inline std::uint64_t weight(const CyclicTask& t) noexcept{
+            return t.wcet_ns > 0 ? static_cast<std::uint64_t>(t.wcet_ns) : 1u;
+        }
+
+    } // namespace
+
+    CyclicExecutor::~CyclicExecutor(){
+        (void)stop();
+    }
+
+    Status CyclicExecutor::init(std::size_t max_tasks, MemoryArena& arena) noexcept{
+        if (running_) return Status::kPreconditionFail;
+        if (max_tasks == 0 || max_tasks > kMaxFrames) return Status::kInvalidArg;
+
+        arena_ = &arena;
+        slots_ = static_cast<Slot*>(arena.allocate(max_tasks * sizeof(Slot), alignof(Slot)));
+        if (!slots_) return Status::kNoMem;
+        for (std::size_t i = 0; i < max_tasks; ++i) new (&slots_[i]) Slot{};
+
+        cap_ = max_tasks;
+        n_ = 0;
+        begin_ = order_ = nullptr;
+        load_ = nullptr;
+        built_ = false;
+        next_frame_ = 0;
+        stats_ = {};
+        return Status::kOK;
+    }
+
+    Status CyclicExecutor::add(const CyclicTask& task, std::size_t* id) noexcept{
+        if (!slots_ || built_) return Status::kPreconditionFail;
+        if (!task.ctl || !task.ctx || !task.out || task.period <= 0 || task.wcet_ns < 0) return Status::kInvalidArg;
+        if (n_ == cap_) return Status::kNoMem;
+
+        slots_[n_].task = task;
+        if (id) *id = n_;
+        ++n_;
+        return Status::kOK;
+    }
+
+    Status CyclicExecutor::build(bool stagger) noexcept{
+        if (!slots_ || built_) return Status::kPreconditionFail;
+        if (n_ == 0) return Status::kNotReady;
+
+        // // minor frame = gcd, major cycle = lcm (in minor frames, capped)
+        dt_ns minor = slots_[0].task.period;
+        for (std::size_t i = 1; i < n_; ++i) minor = std::gcd(minor, slots_[i].task.period);
+
+        std::uint64_t frames = 1;
+        for (std::size_t i = 0; i < n_; ++i){
+            const std::uint64_t stride = static_cast<std::uint64_t>(slots_[i].task.period / minor);
+            frames = std::lcm(frames, stride);
+            if (frames > kMaxFrames) return Status::kInvalidArg;
+            slots_[i].stride = static_cast<std::uint32_t>(stride);
+        }
+        const auto H = static_cast<std::uint32_t>(frames);
+
+        std::size_t releases = 0;
+        for (std::size_t i = 0; i < n_; ++i) releases += H / slots_[i].stride;
+
+        // // everything from the arena, once
+        load_ = static_cast<std::uint64_t*>(arena_->allocate(H * sizeof(std::uint64_t), alignof(std::uint64_t)));
+        begin_ = static_cast<std::uint32_t*>(arena_->allocate((H + 1u) * sizeof(std::uint32_t), alignof(std::uint32_t)));
+        order_ = static_cast<std::uint32_t*>(arena_->allocate(releases * sizeof(std::uint32_t), alignof(std::uint32_t)));
+        auto* idx = static_cast<std::uint32_t*>(arena_->allocate(n_ * sizeof(std::uint32_t), alignof(std::uint32_t)));
+        if (!load_ || !begin_ || !order_ || !idx) return Status::kNoMem;
+
+        std::fill(load_, load_ + H, std::uint64_t{0});
+        for (std::size_t i = 0; i < n_; ++i) idx[i] = static_cast<std::uint32_t>(i);
+
+        // // placement order: heaviest first, then the least phase freedom (short period), then insertion order
+        std::sort(idx, idx + n_, [this](std::uint32_t a, std::uint32_t b){
+            const std::uint64_t wa = weight(slots_[a].task), wb = weight(slots_[b].task);
+            if (wa != wb) return wa > wb;
+            if (slots_[a].stride != slots_[b].stride) return slots_[a].stride < slots_[b].stride;
+            return a < b;
+        });
+
+        for (std::size_t j = 0; j < n_; ++j){
+            Slot& s = slots_[idx[j]];
+            const std::uint64_t w = weight(s.task);
+
+            // // phase with the lowest worst frame after adding this task (lowest phase on ties)
+            std::uint32_t best = 0;
+            if (stagger){
+                std::uint64_t best_cost = ~0ull;
+                for (std::uint32_t ph = 0; ph < s.stride; ++ph){
+                    std::uint64_t cost = 0;
+                    for (std::uint32_t f = ph; f < H; f += s.stride) cost = std::max(cost, load_[f]);
+                    if (cost < best_cost){
+                        best_cost = cost;
+                        best = ph;
+                    }
+                }
+            }
+            for (std::uint32_t f = best; f < H; f += s.stride) load_[f] += w;
+            s.st = {};
+            s.st.phase = best;
+        }
+
+        // // schedule table (CSR); inside a frame the fastest loops run first (least release jitter)
+        std::sort(idx, idx + n_, [this](std::uint32_t a, std::uint32_t b){
+            if (slots_[a].stride != slots_[b].stride) return slots_[a].stride < slots_[b].stride;
+            return a < b;
+        });
+
+        std::fill(begin_, begin_ + H + 1u, std::uint32_t{0});
+        for (std::size_t i = 0; i < n_; ++i){
+            for (std::uint32_t f = slots_[i].st.phase; f < H; f += slots_[i].stride) ++begin_[f + 1u];
+        }
+        for (std::uint32_t f = 0; f < H; ++f) begin_[f + 1u] += begin_[f];
+
+        std::uint64_t max_load = 0;
+        for (std::uint32_t f = 0; f < H; ++f) max_load = std::max(max_load, load_[f]);
+
+        // // load_ doubles as the per frame write cursor, then gets the planned loads back
+        for (std::uint32_t f = 0; f < H; ++f) load_[f] = begin_[f];
+        for (std::size_t j = 0; j < n_; ++j){
+            const Slot& s = slots_[idx[j]];
+            for (std::uint32_t f = s.st.phase; f < H; f += s.stride) order_[load_[f]++] = idx[j];
+        }
+
+        std::fill(load_, load_ + H, std::uint64_t{0});
+        for (std::size_t i = 0; i < n_; ++i){
+            for (std::uint32_t f = slots_[i].st.phase; f < H; f += slots_[i].stride) load_[f] += weight(slots_[i].task);
+        }
+
+        stats_ = {};
+        stats_.minor_ns = minor;
+        stats_.major_ns = minor * static_cast<dt_ns>(H);
+        stats_.frames = H;
+        stats_.max_frame_load = max_load;
+        next_frame_ = 0;
+        built_ = true;
+        return Status::kOK;
+    }
+
+    void CyclicExecutor::run_frame_(std::uint64_t k, bool clocked, t_ns deadline) noexcept{
+        const auto f = static_cast<std::uint32_t>(k % stats_.frames);
+        const t_ns t = static_cast<t_ns>(k) * stats_.minor_ns;
+
+        #if defined(__linux__)
+        t_ns t0 = clocked ? detail::mono_now() : 0;
+        const t_ns frame_t0 = t0;
+        #else
+        (void)clocked; (void)deadline;
+        #endif
+
+        for (std::uint32_t j = begin_[f]; j < begin_[f + 1u]; ++j){
+            Slot& s = slots_[order_[j]];
+            CyclicTask& tk = s.task;
+
+            tk.ctx->plant.t = t;
+            if (tk.sense) tk.sense(*tk.ctx, tk.user);
+
+            #if defined(__linux__)
+            const t_ns tu = clocked ? detail::mono_now() : 0;
+            #endif
+            const Status st = tk.ctl->update(*tk.ctx, *tk.out);
+            ++s.st.releases;
+            if (st != Status::kOK) ++s.st.errors;
+
+            #if defined(__linux__)
+            if (clocked){
+                const t_ns t1 = detail::mono_now();
+                tk.out->update_ns = t1 - tu;
+                s.st.worst_exec_ns = std::max(s.st.worst_exec_ns, t1 - t0);
+                if (t1 > deadline) ++s.st.overruns;
+                t0 = t1;
+            }
+            #endif
+
+            // // executor overruns on top of the controller's own deadline accounting; a failed update() left
+            //      out.health as it was, so its overruns were already added (the error is in s.st.errors)
+            if (st == Status::kOK) tk.out->health.deadline_miss_count += s.st.overruns;
+
+            if (tk.actuate) tk.actuate(*tk.out, st, tk.user);
+        }
+
+        #if defined(__linux__)
+        if (clocked) stats_.worst_frame_ns = std::max(stats_.worst_frame_ns, detail::mono_now() - frame_t0);
+        #endif
+        ++stats_.frames_run;
+    }
+
+    Status CyclicExecutor::step() noexcept{
+        if (!built_) return Status::kNotReady;
+        if (running_) return Status::kPreconditionFail;
+        run_frame_(next_frame_++, false, 0);
+        return Status::kOK;
+    }
+
+    Status CyclicExecutor::loop_(std::uint64_t frames) noexcept{
+        #if defined(__linux__)
+        const t_ns minor = stats_.minor_ns;
+        const std::uint64_t k0 = next_frame_;
+
+        // // frame k0 starts one minor frame from now; frame k at origin + (k - k0) * minor
+        const t_ns origin = detail::mono_now() + minor;
+        std::uint64_t k = k0;
+        std::uint64_t done = 0;
+
+        while ((frames == 0 || done < frames) && !stop_req_.load(std::memory_order_relaxed)){
+            const t_ns release = origin + static_cast<t_ns>(k - k0) * minor;
+            detail::sleep_until(release);
+            run_frame_(k, true, release + minor);
+            ++done;
+
+            // // frames whose window is already over are skipped (the loop runs the one in progress)
+            const t_ns now = detail::mono_now();
+            std::uint64_t next = k + 1;
+            const t_ns next_end = origin + static_cast<t_ns>(next - k0 + 1) * minor;
+            if (now >= next_end){
+                const std::uint64_t cur = k0 + static_cast<std::uint64_t>((now - origin) / minor);
+                stats_.frames_skipped += cur - next;
+                next = cur;
+            }
+            k = next;
+        }
+        next_frame_ = k;
+        return Status::kOK;
+        #else
+        (void)frames;
+        return Status::kPreconditionFail;
+        #endif
+    }
+
+    Status CyclicExecutor::run(std::uint64_t frames) noexcept{
+        if (!built_) return Status::kNotReady;
+        if (running_ || frames == 0) return Status::kPreconditionFail;
+        return loop_(frames);
+    }
+
+    Status CyclicExecutor::start(const RtOptions& opts) noexcept{
+        if (!built_) return Status::kNotReady;
+        if (running_) return Status::kPreconditionFail;
+        #if defined(__linux__)
+        opts_ = opts;
+        stop_req_.store(false, std::memory_order_relaxed);
+        running_ = true;
+        thread_ = std::thread([this]{
+            detail::place_this_thread(opts_.cpu, opts_.priority);
+            (void)loop_(0);
+        });
+        return Status::kOK;
+        #else
+        (void)opts;
+        return Status::kPreconditionFail;
+        #endif
+    }
+
+    Status CyclicExecutor::stop() noexcept{
+        if (!running_) return Status::kOK;
+        stop_req_.store(true, std::memory_order_relaxed);
+        if (thread_.joinable()) thread_.join();
+        running_ = false;
+        return Status::kOK;
+    }
+
+    const CyclicTaskStats& CyclicExecutor::task_stats(std::size_t id) const noexcept{
+        return slots_[id].st;
+    }
+
+    std::uint64_t CyclicExecutor::frame_load(std::uint32_t f) const noexcept{
+        return (built_ && f < stats_.frames) ? load_[f] : 0u;
+    }
+
+} // namespace ictk::runtime
@@ -0,0 +1,284 @@
+#include "ictk/runtime/parallel_executor.hpp"
+
+#include <new>
+#include <algorithm>
+
+#include "rt_clock.hpp"
+
+namespace ictk::runtime{
+
+    ParallelExecutor::~ParallelExecutor(){
+        (void)stop();
+    }
+
+    Status ParallelExecutor::init(dt_ns period, std::size_t max_tasks, const ParallelOptions& opts,
+                                  MemoryArena& arena, std::span<MemoryArena* const> worker_arenas) noexcept{
+        if (running_) return Status::kPreconditionFail;
+        if (period <= 0 || max_tasks == 0 || max_tasks > 0xffffffffu) return Status::kInvalidArg;
+        if (opts.workers == 0 || opts.workers > kMaxWorkers) return Status::kInvalidArg;
+        if (worker_arenas.size() != opts.workers) return Status::kInvalidArg;
+        for (MemoryArena* a : worker_arenas) if (!a) return Status::kInvalidArg;
+
+        slots_ = static_cast<Slot*>(arena.allocate(max_tasks * sizeof(Slot), alignof(Slot)));
+        if (!slots_) return Status::kNoMem;
+        for (std::size_t i = 0; i < max_tasks; ++i) new (&slots_[i]) Slot{};
+
+        period_ = period;
+        opts_ = opts;
+        arena_ = &arena;
+        arenas_ = {};
+        std::copy(worker_arenas.begin(), worker_arenas.end(), arenas_.begin());
+        cap_ = max_tasks;
+        n_ = 0;
+        workers_ = nullptr;
+        shards_ = nullptr;
+        order_ = nullptr;
+        built_ = false;
+        next_tick_ = 0;
+        stats_ = {};
+        return Status::kOK;
+    }
+
+    Status ParallelExecutor::add(const CyclicTask& task, std::size_t* id) noexcept{
+        if (!slots_ || built_) return Status::kPreconditionFail;
+        if (!task.ctl || !task.ctx || !task.out) return Status::kInvalidArg;
+        if (task.period != 0 && task.period != period_) return Status::kInvalidArg;
+        if (n_ == cap_) return Status::kNoMem;
+
+        slots_[n_].task = task;
+        if (id) *id = n_;
+        ++n_;
+        return Status::kOK;
+    }
+
+    Status ParallelExecutor::build() noexcept{
+        if (!slots_ || built_) return Status::kPreconditionFail;
+        if (n_ == 0) return Status::kNotReady;
+
+        const std::size_t W = opts_.workers;
+
+        // // shard size: explicit, or shard_bytes over the controller state per task (arena use / tasks)
+        std::size_t per_shard = opts_.shard_tasks;
+        if (per_shard == 0){
+            std::size_t used = 0;
+            for (std::size_t w = 0; w < W; ++w) used += arenas_[w]->used();
+            const std::size_t per_task = std::max<std::size_t>(1, used / n_);
+            per_shard = std::max<std::size_t>(1, opts_.shard_bytes / per_task);
+
+            // // at least ~4 shards per worker, or there is nothing to steal
+            const std::size_t per_worker = (n_ + W - 1) / W;
+            per_shard = std::min(per_shard, std::max<std::size_t>(1, per_worker / 4));
+        }
+
+        std::size_t n_shards = 0;
+        for (std::size_t w = 0; w < W; ++w){
+            const std::size_t mine = (n_ > w) ? (n_ - w + W - 1) / W : 0;
+            n_shards += (mine + per_shard - 1) / per_shard;
+        }
+
+        workers_ = static_cast<Worker*>(arena_->allocate(W * sizeof(Worker), alignof(Worker)));
+        shards_ = static_cast<Shard*>(arena_->allocate(n_shards * sizeof(Shard), alignof(Shard)));
+        order_ = static_cast<std::uint32_t*>(arena_->allocate(n_ * sizeof(std::uint32_t), alignof(std::uint32_t)));
+        if (!workers_ || !shards_ || !order_) return Status::kNoMem;
+
+        // // worker w: ids w, w + W, ... in order, cut into shards
+        std::uint32_t pos = 0, sh = 0;
+        for (std::size_t w = 0; w < W; ++w){
+            Worker* wk = new (&workers_[w]) Worker{};
+            wk->shard_begin = sh;
+
+            const std::uint32_t first = pos;
+            for (std::size_t id = w; id < n_; id += W) order_[pos++] = static_cast<std::uint32_t>(id);
+
+            for (std::uint32_t s = first; s < pos; s += static_cast<std::uint32_t>(per_shard)){
+                shards_[sh].first = s;
+                shards_[sh].count = std::min<std::uint32_t>(static_cast<std::uint32_t>(per_shard), pos - s);
+                ++sh;
+            }
+            wk->shard_count = sh - wk->shard_begin;
+        }
+
+        stats_ = {};
+        stats_.shards = n_shards;
+        stats_.shard_tasks = per_shard;
+        built_ = true;
+        return Status::kOK;
+    }
+
+    Status ParallelExecutor::start() noexcept{
+        if (!built_) return Status::kNotReady;
+        if (running_) return Status::kPreconditionFail;
+
+        quit_.store(false, std::memory_order_relaxed);
+        pending_.store(0, std::memory_order_relaxed);
+
+        // // epoch sampled here: a tick() right after start() can not be missed by a worker still spinning up
+        const std::uint64_t e = epoch_.load(std::memory_order_relaxed);
+        for (std::size_t w = 1; w < opts_.workers; ++w){
+            threads_[w] = std::thread([this, w, e]{ worker_main_(w, e); });
+        }
+        running_ = true;
+        return Status::kOK;
+    }
+
+    Status ParallelExecutor::stop() noexcept{
+        if (!running_) return Status::kOK;
+        quit_.store(true, std::memory_order_relaxed);
+        epoch_.fetch_add(1, std::memory_order_release);
+        epoch_.notify_all();
+        for (std::size_t w = 1; w < opts_.workers; ++w){
+            if (threads_[w].joinable()) threads_[w].join();
+        }
+        running_ = false;
+        return Status::kOK;
+    }
+
+    void ParallelExecutor::worker_main_(std::size_t w, std::uint64_t seen) noexcept{
+        #if defined(__linux__)
+        detail::place_this_thread(opts_.first_cpu >= 0 ? opts_.first_cpu + static_cast<int>(w) : -1, opts_.priority);
+        #endif
+
+        for (;;){
+            epoch_.wait(seen, std::memory_order_acquire);
+            seen = epoch_.load(std::memory_order_acquire);
+            if (quit_.load(std::memory_order_relaxed)) return;
+
+            work_(w);
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) pending_.notify_one();
+        }
+    }
+
+    void ParallelExecutor::run_shard_(const Shard& sh) noexcept{
+        // // late start -> every task of the shard misses this tick
+        bool late = false;
+        #if defined(__linux__)
+        if (clocked_) late = detail::mono_now() > deadline_;
+        #endif
+        if (late) tick_late_.store(true, std::memory_order_relaxed);
+
+        for (std::uint32_t j = sh.first; j < sh.first + sh.count; ++j){
+            Slot& s = slots_[order_[j]];
+            CyclicTask& tk = s.task;
+
+            tk.ctx->plant.t = tick_t_;
+            if (tk.sense) tk.sense(*tk.ctx, tk.user);
+
+            #if defined(__linux__)
+            const t_ns tu = clocked_ ? detail::mono_now() : 0;
+            #endif
+            const Status st = tk.ctl->update(*tk.ctx, *tk.out);
+            #if defined(__linux__)
+            if (clocked_) tk.out->update_ns = detail::mono_now() - tu;
+            #endif
+            if (late) ++s.overruns;
+            // // a failed update() leaves out.health unrefreshed -> adding again would count the same overruns twice
+            if (st == Status::kOK) tk.out->health.deadline_miss_count += s.overruns;
+
+            if (tk.actuate) tk.actuate(*tk.out, st, tk.user);
+        }
+    }
+
+    void ParallelExecutor::work_(std::size_t w) noexcept{
+        const std::size_t W = opts_.workers;
+        Worker& me = workers_[w];
+
+        #if defined(__linux__)
+        const t_ns t0 = detail::mono_now();
+        #endif
+
+        // // own shards first, then whole shards from the others (nearest neighbour first)
+        for (std::size_t k = 0; k < W; ++k){
+            Worker& v = workers_[(w + k) % W];
+            for (;;){
+                const std::uint32_t s = v.next.fetch_add(1, std::memory_order_relaxed);
+                if (s >= v.shard_count) break;
+                const Shard& sh = shards_[v.shard_begin + s];
+                run_shard_(sh);
+                ++me.st.shards_run;
+                me.st.tasks_run += sh.count;
+                if (k) ++me.st.steals;
+            }
+        }
+
+        ++me.st.ticks;
+        #if defined(__linux__)
+        me.st.busy_ns += detail::mono_now() - t0;
+        #endif
+    }
+
+    void ParallelExecutor::tick_(bool clocked, t_ns deadline) noexcept{
+        const std::size_t W = opts_.workers;
+
+        #if defined(__linux__)
+        const t_ns t0 = detail::mono_now();
+        #endif
+
+        tick_t_ = static_cast<t_ns>(next_tick_++) * period_;
+        clocked_ = clocked;
+        deadline_ = deadline;
+        tick_late_.store(false, std::memory_order_relaxed);
+        for (std::size_t w = 0; w < W; ++w) workers_[w].next.store(0, std::memory_order_relaxed);
+
+        // // release: everything above is visible to the workers through the epoch bump
+        pending_.store(static_cast<std::uint32_t>(W - 1), std::memory_order_relaxed);
+        epoch_.fetch_add(1, std::memory_order_release);
+        epoch_.notify_all();
+
+        work_(0);
+
+        for (std::uint32_t p = pending_.load(std::memory_order_acquire); p != 0; p = pending_.load(std::memory_order_acquire)){
+            pending_.wait(p, std::memory_order_acquire);
+        }
+
+        ++stats_.ticks;
+        #if defined(__linux__)
+        stats_.worst_tick_ns = std::max(stats_.worst_tick_ns, detail::mono_now() - t0);
+        #endif
+        if (tick_late_.load(std::memory_order_relaxed)) ++stats_.late_ticks;
+    }
+
+    Status ParallelExecutor::tick() noexcept{
+        if (!built_) return Status::kNotReady;
+        if (!running_ && opts_.workers > 1) return Status::kNotReady;
+        tick_(false, 0);
+        return Status::kOK;
+    }
+
+    Status ParallelExecutor::run(std::uint64_t ticks) noexcept{
+        if (!built_) return Status::kNotReady;
+        if (!running_ && opts_.workers > 1) return Status::kNotReady;
+        if (ticks == 0) return Status::kPreconditionFail;
+        #if defined(__linux__)
+        detail::place_this_thread(opts_.first_cpu, opts_.priority);
+
+        const std::uint64_t k0 = next_tick_;
+        const t_ns origin = detail::mono_now() + period_;
+        for (std::uint64_t done = 0; done < ticks; ++done){
+            const t_ns release = origin + static_cast<t_ns>(next_tick_ - k0) * period_;
+            detail::sleep_until(release);
+            tick_(true, release + period_);
+
+            // // whole periods already over are skipped (controllers see the timestamp gap)
+            const t_ns now = detail::mono_now();
+            const t_ns next_end = origin + static_cast<t_ns>(next_tick_ - k0 + 1) * period_;
+            if (now >= next_end){
+                const std::uint64_t cur = k0 + static_cast<std::uint64_t>((now - origin) / period_);
+                stats_.ticks_skipped += cur - next_tick_;
+                next_tick_ = cur;
+            }
+        }
+        return Status::kOK;
+        #else
+        return Status::kPreconditionFail;
+        #endif
+    }
+
+    const WorkerStats& ParallelExecutor::worker_stats(std::size_t w) const noexcept{
+        return workers_[w].st;
+    }
+
+    std::uint64_t ParallelExecutor::overruns(std::size_t id) const noexcept{
+        return slots_[id].overruns;
+    }
+
+} // namespace ictk::runtime
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ictk/core/time.hpp"
+
+#if defined(__linux__)
+    #include <time.h>
+    #include <errno.h>
+    #include <sched.h>
+    #include <pthread.h>
+#endif
+
+// // executor internals (not installed): monotonic clock, absolute sleep, thread placement
+namespace ictk::runtime::detail{
+
+    #if defined(__linux__)
+    inline t_ns mono_now() noexcept{
+        timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<t_ns>(ts.tv_sec) * 1'000'000'000 + static_cast<t_ns>(ts.tv_nsec);
+    }
+
+    // // absolute sleep: a late wake up does not shift the next deadline
+    inline void sleep_until(t_ns t) noexcept{
+        timespec ts{};
+        ts.tv_sec = static_cast<time_t>(t / 1'000'000'000);
+        ts.tv_nsec = static_cast<long>(t % 1'000'000'000);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR){}
+    }
+
+    // // best effort: no CAP_SYS_NICE / bad cpu -> keep running unpinned / SCHED_OTHER
+    inline void place_this_thread(int cpu, int priority) noexcept{
+        if (cpu >= 0){
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+        if (priority > 0){
+            sched_param sp{};
+            sp.sched_priority = priority;
+            pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+        }
+    }
+    #endif
+
+} // namespace ictk::runtime::detail
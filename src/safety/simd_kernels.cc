@@ -0,0 +1,524 @@
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "ictk/safety/simd_kernels.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && !defined(ICTK_SCALAR_FLOAT)
+    #define ICTK_SIMD_X86 1
+    #include <immintrin.h>
+#else
+    #define ICTK_SIMD_X86 0
+#endif
+
+/*
+Kernel tables for the staged safety stages (see ictk/safety/simd_kernels.hpp)
+    scalar_*: the per element reference, written as selects so every vector kernel can mirror it lane by lane
+    sse2_* / avx2_* / avx512_*: same selects on 2 / 4 / 8 double lanes, scalar_* for the tail
+        and for the whole call when n is below the lane count (no vector setup or horizontal max for 1..7 channels)
+    avx2_* / avx512_* end with an explicit vzeroupper before the scalar tail: GCC drops its own in the kernels that
+        realign the stack (jerk), and dirty upper halves then slow every later legacy SSE op (tail, PID law, libc)
+    default table: detected ISA capped at AVX2; AVX-512 only through select_isa (see kDefaultCap)
+    ISA code lives in functions with a target attribute -> the rest of the library keeps the baseline flags
+*/
+namespace ictk::safety::simd{
+    namespace{
+
+        // // reference steps (same compare order as Saturation::clamp_at, rate_limiter_scalar, JerkLimiter::step_at)
+        inline Scalar clamp_lohi(Scalar v, Scalar lo, Scalar hi, bool& hit) noexcept{
+            hit = (v < lo) || (v > hi);
+            const Scalar t = (v > hi) ? hi : v;
+            return (v < lo) ? lo : t;
+        }
+
+        inline Scalar abs_s(Scalar x) noexcept{
+            return x < Scalar(0) ? -x : x;
+        }
+
+        std::uint64_t scalar_sat(Scalar* u, const Scalar* lo, const Scalar* hi, std::size_t n) noexcept{
+            std::uint64_t hits = 0;
+            for (std::size_t i=0; i<n; ++i){
+                bool hit;
+                u[i] = clamp_lohi(u[i], lo[i], hi[i], hit);
+                hits += hit;
+            }
+            return hits;
+        }
+
+        std::uint64_t scalar_sat_uniform(Scalar* u, Scalar lo, Scalar hi, std::size_t n) noexcept{
+            std::uint64_t hits = 0;
+            for (std::size_t i=0; i<n; ++i){
+                bool hit;
+                u[i] = clamp_lohi(u[i], lo, hi, hit);
+                hits += hit;
+            }
+            return hits;
+        }
+
+        std::uint64_t scalar_rate(Scalar* u, Scalar* prev, const Scalar* step, std::size_t n, Scalar& last_mag) noexcept{
+            std::uint64_t hits = 0;
+            for (std::size_t i=0; i<n; ++i){
+                const Scalar v = u[i];
+                bool hit;
+                const Scalar c = clamp_lohi(v, prev[i] - step[i], prev[i] + step[i], hit);
+                if (hit){
+                    ++hits;
+                    const Scalar mag = abs_s(c - v);
+                    if (mag > last_mag) last_mag = mag;
+                }
+                prev[i] = c;
+                u[i] = c;
+            }
+            return hits;
+        }
+
+        std::uint64_t scalar_jerk(Scalar* u, Scalar* prev, Scalar* dprev, Scalar rstep, Scalar jstep, std::size_t n, Scalar& last_mag) noexcept{
+            std::uint64_t hits = 0;
+            for (std::size_t i=0; i<n; ++i){
+                const Scalar p = prev[i];
+                const Scalar lo_r = p - rstep, hi_r = p + rstep;
+                const Scalar v = u[i];
+                // // std::clamp(v, lo_r, hi_r)
+                const Scalar t = (hi_r < v) ? hi_r : v;
+                const Scalar u_rate = (v < lo_r) ? lo_r : t;
+
+                const Scalar du = u_rate - p;
+                bool hit;
+                const Scalar dc = clamp_lohi(du, dprev[i] - jstep, dprev[i] + jstep, hit);
+                const Scalar c = p + dc;
+                if (hit){
+                    ++hits;
+                    const Scalar mag = abs_s(dc - du);
+                    if (mag > last_mag) last_mag = mag;
+                }
+                dprev[i] = c - p;
+                prev[i] = c;
+                u[i] = c;
+            }
+            return hits;
+        }
+
+        constexpr Kernels kScalarTable{scalar_sat, scalar_sat_uniform, scalar_rate, scalar_jerk};
+
+#if ICTK_SIMD_X86
+        static_assert(std::is_same_v<Scalar, double>, "x86 kernels use double lanes");
+
+        // // ---- SSE2 (2 lanes): select = (m & a) | (~m & b) ----
+        __attribute__((target("sse2"))) inline __m128d sel2(__m128d m, __m128d a, __m128d b) noexcept{
+            return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+        }
+        __attribute__((target("sse2"))) inline __m128d abs2(__m128d x) noexcept{
+            return _mm_and_pd(x, _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffll)));
+        }
+        __attribute__((target("sse2"))) inline double hmax2(__m128d x) noexcept{
+            double l[2];
+            _mm_storeu_pd(l, x);
+            return l[0] > l[1] ? l[0] : l[1];
+        }
+        // // hit lanes are all ones (-1 as int64) -> subtracting counts them without leaving the vector unit
+        __attribute__((target("sse2"))) inline __m128i count2(__m128i acc, __m128d hit) noexcept{
+            return _mm_sub_epi64(acc, _mm_castpd_si128(hit));
+        }
+        __attribute__((target("sse2"))) inline std::uint64_t sum2(__m128i acc) noexcept{
+            std::uint64_t l[2];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(l), acc);
+            return l[0] + l[1];
+        }
+        // // v clamped to [lo, hi] (lo wins), hit mask
+        __attribute__((target("sse2"))) inline __m128d clamp2(__m128d v, __m128d lo, __m128d hi, __m128d& hit) noexcept{
+            const __m128d mlo = _mm_cmplt_pd(v, lo);
+            const __m128d mhi = _mm_cmpgt_pd(v, hi);
+            hit = _mm_or_pd(mlo, mhi);
+            return sel2(mlo, lo, sel2(mhi, hi, v));
+        }
+
+        __attribute__((target("sse2")))
+        std::uint64_t sse2_sat(Scalar* u, const Scalar* lo, const Scalar* hi, std::size_t n) noexcept{
+            if (n < 2) return scalar_sat(u, lo, hi, n);
+            std::uint64_t hits = 0;
+            std::size_t i = 0;
+            __m128i vhits = _mm_setzero_si128();
+            for (; i + 2 <= n; i += 2){
+                __m128d hit;
+                const __m128d c = clamp2(_mm_loadu_pd(u + i), _mm_loadu_pd(lo + i), _mm_loadu_pd(hi + i), hit);
+                _mm_storeu_pd(u + i, c);
+                vhits = count2(vhits, hit);
+            }
+            hits += sum2(vhits);
+            return hits + scalar_sat(u + i, lo + i, hi + i, n - i);
+        }
+
+        __attribute__((target("sse2")))
+        std::uint64_t sse2_sat_uniform(Scalar* u, Scalar lo, Scalar hi, std::size_t n) noexcept{
+            if (n < 2) return scalar_sat_uniform(u, lo, hi, n);
+            std::uint64_t hits = 0;
+            std::size_t i = 0;
+            __m128i vhits = _mm_setzero_si128();
+            const __m128d vlo = _mm_set1_pd(lo), vhi = _mm_set1_pd(hi);
+            for (; i + 2 <= n; i += 2){
+                __m128d hit;
+                const __m128d c = clamp2(_mm_loadu_pd(u + i), vlo, vhi, hit);
+                _mm_storeu_pd(u + i, c);
+                vhits = count2(vhits, hit);
+            }
+            hits += sum2(vhits);
+            return hits + scalar_sat_uniform(u + i, lo, hi, n - i);
+        }
+
+        __attribute__((target("sse2")))
+        std::uint64_t sse2_rate(Scalar* u, Scalar* prev, const Scalar* step, std::size_t n, Scalar& last_mag) noexcept{
+            if (n < 2) return scalar_rate(u, prev, step, n, last_mag);
+            std::uint64_t hits = 0;
+            std::size_t i = 0;
+            __m128i vhits = _mm_setzero_si128();
+            __m128d vmag = _mm_setzero_pd();
+            for (; i + 2 <= n; i += 2){
+                const __m128d v = _mm_loadu_pd(u + i);
+                const __m128d p = _mm_loadu_pd(prev + i);
+                const __m128d s = _mm_loadu_pd(step + i);
+                __m128d hit;
+                const __m128d c = clamp2(v, _mm_sub_pd(p, s), _mm_add_pd(p, s), hit);
+                vmag = _mm_max_pd(vmag, _mm_and_pd(hit, abs2(_mm_sub_pd(c, v))));
+                _mm_storeu_pd(prev + i, c);
+                _mm_storeu_pd(u + i, c);
+                vhits = count2(vhits, hit);
+            }
+            const double m = hmax2(vmag);
+            if (m > last_mag) last_mag = m;
+            hits += sum2(vhits);
+            return hits + scalar_rate(u + i, prev + i, step + i, n - i, last_mag);
+        }
+
+        __attribute__((target("sse2")))
+        std::uint64_t sse2_jerk(Scalar* u, Scalar* prev, Scalar* dprev, Scalar rstep, Scalar jstep, std::size_t n, Scalar& last_mag) noexcept{
+            if (n < 2) return scalar_jerk(u, prev, dprev, rstep, jstep, n, last_mag);
+            std::uint64_t hits = 0;
+            std::size_t i = 0;
+            __m128i vhits = _mm_setzero_si128();
+            const __m128d rs = _mm_set1_pd(rstep), js = _mm_set1_pd(jstep);
+            __m128d vmag = _mm_setzero_pd();
+            for (; i + 2 <= n; i += 2){
+                const __m128d p = _mm_loadu_pd(prev + i);
+                const __m128d dp = _mm_loadu_pd(dprev + i);
+                const __m128d v = _mm_loadu_pd(u + i);
+                const __m128d lo_r = _mm_sub_pd(p, rs), hi_r = _mm_add_pd(p, rs);
+                const __m128d u_rate = sel2(_mm_cmplt_pd(v, lo_r), lo_r, sel2(_mm_cmplt_pd(hi_r, v), hi_r, v));
+                const __m128d du = _mm_sub_pd(u_rate, p);
+                __m128d hit;
+                const __m128d dc = clamp2(du, _mm_sub_pd(dp, js), _mm_add_pd(dp, js), hit);
+                const __m128d c = _mm_add_pd(p, dc);
+                vmag = _mm_max_pd(vmag, _mm_and_pd(hit, abs2(_mm_sub_pd(dc, du))));
+                _mm_storeu_pd(dprev + i, _mm_sub_pd(c, p));
+                _mm_storeu_pd(prev + i, c);
+                _mm_storeu_pd(u + i, c);
+                vhits = count2(vhits, hit);
+            }
+            const double m = hmax2(vmag);
+            if (m > last_mag) last_mag = m;
+            hits += sum2(vhits);
+            return hits + scalar_jerk(u + i, prev + i, dprev + i, rstep, jstep, n - i, last_mag);
+        }
+
+        // // ---- AVX2 (4 lanes): blendv picks the second operand where the mask is set ----
+        __attribute__((target("avx2"))) inline __m256d abs4(__m256d x) noexcept{
+            return _mm256_and_pd(x, _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffll)));
+        }
+        __attribute__((target("avx2"))) inline double hmax4(__m256d x) noexcept{
+            double l[4];
+            _mm256_storeu_pd(l, x);
+            const double a = l[0] > l[1] ? l[0] : l[1];
+            const double b = l[2] > l[3] ? l[2] : l[3];
+            return a > b ? a : b;
+        }
+        __attribute__((target("avx2"))) inline __m256d clamp4(__m256d v, __m256d lo, __m256d hi, __m256d& hit) noexcept{
+            const __m256d mlo = _mm256_cmp_pd(v, lo, _CMP_LT_OQ);
+            const __m256d mhi = _mm256_cmp_pd(v, hi, _CMP_GT_OQ);
+            hit = _mm256_or_pd(mlo, mhi);
+            return _mm256_blendv_pd(_mm256_blendv_pd(v, hi, mhi), lo, mlo);
+        }
+        __attribute__((target("avx2"))) inline __m256i count4(__m256i acc, __m256d hit) noexcept{
+            return _mm256_sub_epi64(acc, _mm256_castpd_si256(hit));
+        }
+        __attribute__((target("avx2"))) inline std::uint64_t sum4(__m256i acc) noexcept{
+            std::uint64_t l[4];
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(l), acc);
+            return l[0] + l[1] + l[2] + l[3];
+        }
+
+        __attribute__((target("avx2")))
+        std::uint64_t avx2_sat(Scalar* u, const Scalar* lo, const Scalar* hi, std::size_t n) noexcept{
+            if (n < 4) return scalar_sat(u, lo, hi, n);
+            std::uint64_t hits = 0;
+            std::size_t i = 0;
+            __m256i vhits = _mm256_setzero_si256();
+            for (; i + 4 <= n; i += 4){
+                __m256d hit;
+                const __m256d c = clamp4(_mm256_loadu_pd(u + i), _mm256_loadu_pd(lo + i), _mm256_loadu_pd(hi + i), hit);
+                _mm256_storeu_pd(u + i, c);
+                vhits = count4(vhits, hit);
+            }
+            hits += sum4(vhits);
+            _mm256_zeroupper();
+            return hits + scalar_sat(u + i, lo + i, hi + i, n - i);
+        }
+
+        __attribute__((target("avx2")))
+        std::uint64_t avx2_sat_uniform(Scalar* u, Scalar lo, Scalar hi, std::size_t n) noexcept{
+            if (n < 4) return scalar_sat_uniform(u, lo, hi, n);
+            std::uint64_t hits = 0;
+            std::size_t i = 0;
+            __m256i vhits = _mm256_setzero_si256();
+            const __m256d vlo = _mm256_set1_pd(lo), vhi = _mm256_set1_pd(hi);
+            for (; i + 4 <= n; i += 4){
+                __m256d hit;
+                const __m256d c = clamp4(_mm256_loadu_pd(u + i), vlo, vhi, hit);
+                _mm256_storeu_pd(u + i, c);
+                vhits = count4(vhits, hit);
+            }
+            hits += sum4(vhits);
+            _mm256_zeroupper();
+            return hits + scalar_sat_uniform(u + i, lo, hi, n - i);
+        }
+
+        __attribute__((target("avx2")))
+        std::uint64_t avx2_rate(Scalar* u, Scalar* prev, const Scalar* step, std::size_t n, Scalar& last_mag) noexcept{
+            if (n < 4) return scalar_rate(u, prev, step, n, last_mag);
+            std::uint64_t hits = 0;
+            std::size_t i = 0;
+            __m256i vhits = _mm256_setzero_si256();
+            __m256d vmag = _mm256_setzero_pd();
+            for (; i + 4 <= n; i += 4){
+                const __m256d v = _mm256_loadu_pd(u + i);
+                const __m256d p = _mm256_loadu_pd(prev + i);
+                const __m256d s = _mm256_loadu_pd(step + i);
+                __m256d hit;
+                const __m256d c = clamp4(v, _mm256_sub_pd(p, s), _mm256_add_pd(p, s), hit);
+                vmag = _mm256_max_pd(vmag, _mm256_and_pd(hit, abs4(_mm256_sub_pd(c, v))));
+                _mm256_storeu_pd(prev + i, c);
+                _mm256_storeu_pd(u + i, c);
+                vhits = count4(vhits, hit);
+            }
+            const double m = hmax4(vmag);
+            if (m > last_mag) last_mag = m;
+            hits += sum4(vhits);
+            _mm256_zeroupper();
+            return hits + scalar_rate(u + i, prev + i, step + i, n - i, last_mag);
+        }
+
+        __attribute__((target("avx2")))
+        std::uint64_t avx2_jerk(Scalar* u, Scalar* prev, Scalar* dprev, Scalar rstep, Scalar jstep, std::size_t n, Scalar& last_mag) noexcept{
+            if (n < 4) return scalar_jerk(u, prev, dprev, rstep, jstep, n, last_mag);
+            std::uint64_t hits = 0;
+            std::size_t i = 0;
+            __m256i vhits = _mm256_setzero_si256();
+            const __m256d rs = _mm256_set1_pd(rstep), js = _mm256_set1_pd(jstep);
+            __m256d vmag = _mm256_setzero_pd();
+            for (; i + 4 <= n; i += 4){
+                const __m256d p = _mm256_loadu_pd(prev + i);
+                const __m256d dp = _mm256_loadu_pd(dprev + i);
+                const __m256d v = _mm256_loadu_pd(u + i);
+                const __m256d lo_r = _mm256_sub_pd(p, rs), hi_r = _mm256_add_pd(p, rs);
+                const __m256d t = _mm256_blendv_pd(v, hi_r, _mm256_cmp_pd(hi_r, v, _CMP_LT_OQ));
+                const __m256d u_rate = _mm256_blendv_pd(t, lo_r, _mm256_cmp_pd(v, lo_r, _CMP_LT_OQ));
+                const __m256d du = _mm256_sub_pd(u_rate, p);
+                __m256d hit;
+                const __m256d dc = clamp4(du, _mm256_sub_pd(dp, js), _mm256_add_pd(dp, js), hit);
+                const __m256d c = _mm256_add_pd(p, dc);
+                vmag = _mm256_max_pd(vmag, _mm256_and_pd(hit, abs4(_mm256_sub_pd(dc, du))));
+                _mm256_storeu_pd(dprev + i, _mm256_sub_pd(c, p));
+                _mm256_storeu_pd(prev + i, c);
+                _mm256_storeu_pd(u + i, c);
+                vhits = count4(vhits, hit);
+            }
+            const double m = hmax4(vmag);
+            if (m > last_mag) last_mag = m;
+            hits += sum4(vhits);
+            _mm256_zeroupper();
+            return hits + scalar_jerk(u + i, prev + i, dprev + i, rstep, jstep, n - i, last_mag);
+        }
+
+        // // ---- AVX-512F (8 lanes): compare into __mmask8, mask_blend picks the second operand where set ----
+        __attribute__((target("avx512f,popcnt"))) inline __m512d clamp8(__m512d v, __m512d lo, __m512d hi, __mmask8& hit) noexcept{
+            const __mmask8 mlo = _mm512_cmp_pd_mask(v, lo, _CMP_LT_OQ);
+            const __mmask8 mhi = _mm512_cmp_pd_mask(v, hi, _CMP_GT_OQ);
+            hit = static_cast<__mmask8>(mlo | mhi);
+            return _mm512_mask_blend_pd(mlo, _mm512_mask_blend_pd(mhi, v, hi), lo);
+        }
+        __attribute__((target("avx512f,popcnt"))) inline __m512d abs8(__m512d x) noexcept{
+            return _mm512_castsi512_pd(_mm512_and_epi64(_mm512_castpd_si512(x), _mm512_set1_epi64(0x7fffffffffffffffll)));
+        }
+        __attribute__((target("avx512f,popcnt"))) inline double hmax8(__m512d x) noexcept{
+            double l[8];
+            _mm512_storeu_pd(l, x);
+            double m = l[0];
+            for (int k=1; k<8; ++k) m = l[k] > m ? l[k] : m;
+            return m;
+        }
+        __attribute__((target("avx512f,popcnt"))) inline std::uint64_t count8(__mmask8 m) noexcept{
+            return static_cast<std::uint64_t>(std::popcount(static_cast<unsigned>(m)));
+        }
+
+        __attribute__((target("avx512f,popcnt")))
+        std::uint64_t avx512_sat(Scalar* u, const Scalar* lo, const Scalar* hi, std::size_t n) noexcept{
+            if (n < 8) return scalar_sat(u, lo, hi, n);
+            std::uint64_t hits = 0;
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8){
+                __mmask8 hit;
+                const __m512d c = clamp8(_mm512_loadu_pd(u + i), _mm512_loadu_pd(lo + i), _mm512_loadu_pd(hi + i), hit);
+                _mm512_storeu_pd(u + i, c);
+                hits += count8(hit);
+            }
+            _mm256_zeroupper();
+            return hits + scalar_sat(u + i, lo + i, hi + i, n - i);
+        }
+
+        __attribute__((target("avx512f,popcnt")))
+        std::uint64_t avx512_sat_uniform(Scalar* u, Scalar lo, Scalar hi, std::size_t n) noexcept{
+            if (n < 8) return scalar_sat_uniform(u, lo, hi, n);
+            std::uint64_t hits = 0;
+            std::size_t i = 0;
+            const __m512d vlo = _mm512_set1_pd(lo), vhi = _mm512_set1_pd(hi);
+            for (; i + 8 <= n; i += 8){
+                __mmask8 hit;
+                const __m512d c = clamp8(_mm512_loadu_pd(u + i), vlo, vhi, hit);
+                _mm512_storeu_pd(u + i, c);
+                hits += count8(hit);
+            }
+            _mm256_zeroupper();
+            return hits + scalar_sat_uniform(u + i, lo, hi, n - i);
+        }
+
+        __attribute__((target("avx512f,popcnt")))
+        std::uint64_t avx512_rate(Scalar* u, Scalar* prev, const Scalar* step, std::size_t n, Scalar& last_mag) noexcept{
+            if (n < 8) return scalar_rate(u, prev, step, n, last_mag);
+            std::uint64_t hits = 0;
+            std::size_t i = 0;
+            __m512d vmag = _mm512_setzero_pd();
+            for (; i + 8 <= n; i += 8){
+                const __m512d v = _mm512_loadu_pd(u + i);
+                const __m512d p = _mm512_loadu_pd(prev + i);
+                const __m512d s = _mm512_loadu_pd(step + i);
+                __mmask8 hit;
+                const __m512d c = clamp8(v, _mm512_sub_pd(p, s), _mm512_add_pd(p, s), hit);
+                vmag = _mm512_mask_max_pd(vmag, hit, vmag, abs8(_mm512_sub_pd(c, v)));
+                _mm512_storeu_pd(prev + i, c);
+                _mm512_storeu_pd(u + i, c);
+                hits += count8(hit);
+            }
+            const double m = hmax8(vmag);
+            if (m > last_mag) last_mag = m;
+            _mm256_zeroupper();
+            return hits + scalar_rate(u + i, prev + i, step + i, n - i, last_mag);
+        }
+
+        __attribute__((target("avx512f,popcnt")))
+        std::uint64_t avx512_jerk(Scalar* u, Scalar* prev, Scalar* dprev, Scalar rstep, Scalar jstep, std::size_t n, Scalar& last_mag) noexcept{
+            if (n < 8) return scalar_jerk(u, prev, dprev, rstep, jstep, n, last_mag);
+            std::uint64_t hits = 0;
+            std::size_t i = 0;
+            const __m512d rs = _mm512_set1_pd(rstep), js = _mm512_set1_pd(jstep);
+            __m512d vmag = _mm512_setzero_pd();
+            for (; i + 8 <= n; i += 8){
+                const __m512d p = _mm512_loadu_pd(prev + i);
+                const __m512d dp = _mm512_loadu_pd(dprev + i);
+                const __m512d v = _mm512_loadu_pd(u + i);
+                const __m512d lo_r = _mm512_sub_pd(p, rs), hi_r = _mm512_add_pd(p, rs);
+                const __m512d t = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(hi_r, v, _CMP_LT_OQ), v, hi_r);
+                const __m512d u_rate = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(v, lo_r, _CMP_LT_OQ), t, lo_r);
+                const __m512d du = _mm512_sub_pd(u_rate, p);
+                __mmask8 hit;
+                const __m512d dc = clamp8(du, _mm512_sub_pd(dp, js), _mm512_add_pd(dp, js), hit);
+                const __m512d c = _mm512_add_pd(p, dc);
+                vmag = _mm512_mask_max_pd(vmag, hit, vmag, abs8(_mm512_sub_pd(dc, du)));
+                _mm512_storeu_pd(dprev + i, _mm512_sub_pd(c, p));
+                _mm512_storeu_pd(prev + i, c);
+                _mm512_storeu_pd(u + i, c);
+                hits += count8(hit);
+            }
+            const double m = hmax8(vmag);
+            if (m > last_mag) last_mag = m;
+            _mm256_zeroupper();
+            return hits + scalar_jerk(u + i, prev + i, dprev + i, rstep, jstep, n - i, last_mag);
+        }
+
+        constexpr Kernels kSse2Table{sse2_sat, sse2_sat_uniform, sse2_rate, sse2_jerk};
+        constexpr Kernels kAvx2Table{avx2_sat, avx2_sat_uniform, avx2_rate, avx2_jerk};
+        constexpr Kernels kAvx512Table{avx512_sat, avx512_sat_uniform, avx512_rate, avx512_jerk};
+#endif
+
+        const Kernels& table_for(Isa isa) noexcept{
+            switch (isa){
+#if ICTK_SIMD_X86
+                case Isa::kAvx512: return kAvx512Table;
+                case Isa::kAvx2: return kAvx2Table;
+                case Isa::kSse2: return kSse2Table;
+#endif
+                default: return kScalarTable;
+            }
+        }
+
+        Isa detect() noexcept{
+#if ICTK_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return Isa::kAvx512;
+            if (__builtin_cpu_supports("avx2")) return Isa::kAvx2;
+            if (__builtin_cpu_supports("sse2")) return Isa::kSse2;
+#endif
+            return Isa::kScalar;
+        }
+
+        // // AVX-512 measured no faster than AVX2 on control sized vectors and its state switch costs ~0.3 us per
+        // // tick on some parts (bench_pid_vs_baseline 1 ... --sat --rate --jerk) -> opt in with select_isa
+        constexpr Isa kDefaultCap = Isa::kAvx2;
+
+        std::atomic<const Kernels*> g_active{nullptr};
+        std::atomic<Isa> g_active_isa{Isa::kScalar};
+
+    } // namespace
+
+    Isa detected_isa() noexcept{
+        static const Isa isa = detect();
+        return isa;
+    }
+
+    Isa default_isa() noexcept{
+        const Isa d = detected_isa();
+        return static_cast<std::uint8_t>(d) > static_cast<std::uint8_t>(kDefaultCap) ? kDefaultCap : d;
+    }
+
+    Isa active_isa() noexcept{
+        (void)kernels();
+        return g_active_isa.load(std::memory_order_relaxed);
+    }
+
+    bool select_isa(Isa isa) noexcept{
+        if (static_cast<std::uint8_t>(isa) > static_cast<std::uint8_t>(detected_isa())) return false;
+        g_active_isa.store(isa, std::memory_order_relaxed);
+        g_active.store(&table_for(isa), std::memory_order_release);
+        return true;
+    }
+
+    const Kernels& kernels() noexcept{
+        const Kernels* k = g_active.load(std::memory_order_acquire);
+        if (!k){
+            const Isa isa = default_isa();
+            g_active_isa.store(isa, std::memory_order_relaxed);
+            k = &table_for(isa);
+            g_active.store(k, std::memory_order_release);
+        }
+        return *k;
+    }
+
+    const char* isa_name(Isa isa) noexcept{
+        switch (isa){
+            case Isa::kAvx512: return "avx512";
+            case Isa::kAvx2: return "avx2";
+            case Isa::kSse2: return "sse2";
+            default: return "scalar";
+        }
+    }
+
+} // namespace ictk::safety::simd
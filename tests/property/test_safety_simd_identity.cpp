@@ -0,0 +1,122 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/safety/saturation.hpp"
+#include "ictk/safety/rate_limit.hpp"
+#include "ictk/safety/jerk_limit.hpp"
+#include "ictk/safety/simd_kernels.hpp"
+
+using namespace ictk;
+using namespace ictk::safety;
+
+/*
+Property: apply() on every ISA this CPU supports == the per element reference (clamp_at / step_at)
+    bit-identical u, hits and last_clip_mag over many ticks, odd sizes (vector body + scalar tail), NaN and ±inf inputs
+*/
+
+static std::uint64_t lcg(std::uint64_t& s){
+    s = s * 6364136223846793005ull + 1442695040888963407ull;
+    return s >> 11;
+}
+
+static Scalar sample(std::uint64_t& s){
+    const std::uint64_t k = lcg(s);
+    switch (k % 64){
+        case 0: return std::numeric_limits<Scalar>::quiet_NaN();
+        case 1: return std::numeric_limits<Scalar>::infinity();
+        case 2: return -std::numeric_limits<Scalar>::infinity();
+        default: return static_cast<Scalar>(static_cast<double>(lcg(s)) * 0x1.0p-53) * Scalar(4) - Scalar(2);
+    }
+}
+
+static bool same(const std::vector<Scalar>& a, const std::vector<Scalar>& b){
+    return std::memcmp(a.data(), b.data(), a.size() * sizeof(Scalar)) == 0;
+}
+
+static bool same_bits(Scalar a, Scalar b){
+    return std::memcmp(&a, &b, sizeof(Scalar)) == 0;
+}
+
+// 0 on success, else a distinct failure code
+static int run_size(std::size_t n, int base){
+    const dt_ns dt = 1'000'000;
+    std::vector<std::byte> mem(1 << 16);
+    MemoryArena arena(mem.data(), mem.size());
+
+    std::vector<Scalar> lo(n), hi(n), rmax(n);
+    std::uint64_t seed = 17 + n;
+    for (std::size_t i=0; i<n; ++i){
+        lo[i] = -0.5 - 0.01 * Scalar(i);
+        hi[i] = 0.5 + 0.01 * Scalar(i);
+        rmax[i] = (i % 7 == 6) ? std::numeric_limits<Scalar>::infinity() : 50.0 + Scalar(i);
+    }
+
+    Saturation sat(lo, hi), sat_u(Scalar(-0.7), Scalar(0.6));
+    RateLimiter rl(rmax, dt, arena, n), rl_ref(rmax, dt, arena, n);
+    RateLimiter rlu(Scalar(80.0), dt, arena, n), rlu_ref(Scalar(80.0), dt, arena, n);
+    JerkLimiter jl(100.0, 20.0, dt, arena, n), jl_ref(100.0, 20.0, dt, arena, n);
+    if (!rl.valid() || !rl_ref.valid() || !rlu.valid() || !jl.valid() || !jl_ref.valid()) return base + 1;
+
+    std::vector<Scalar> in(n), a(n), b(n);
+    std::uint64_t total_rate = 0, total_jerk = 0;
+    for (int k=0; k<400; ++k){
+        for (auto& v : in) v = sample(seed);
+
+        // // saturation, per channel and uniform
+        a = in; b = in;
+        std::uint64_t hits = 0;
+        const SatReport rep = sat.apply(a);
+        for (std::size_t i=0; i<n; ++i){ const Clip c = sat.clamp_at(i, b[i]); b[i] = c.val; hits += c.hit; }
+        if (!same(a, b) || rep.hits != hits) return base + 2;
+
+        a = in; b = in; hits = 0;
+        const SatReport rep_u = sat_u.apply(a);
+        for (std::size_t i=0; i<n; ++i){ const Clip c = sat_u.clamp_at(i, b[i]); b[i] = c.val; hits += c.hit; }
+        if (!same(a, b) || rep_u.hits != hits) return base + 3;
+
+        // // NaN passes the limiters untouched and would stick in prev/dprev -> ±inf and finite only from here on
+        for (auto& v : in) if (std::isnan(v)) v = Scalar(0);
+
+        // // rate, per channel and uniform
+        a = in; b = in; hits = 0;
+        const std::uint64_t rh = rl.apply(a);
+        rl_ref.begin_tick();
+        for (std::size_t i=0; i<n; ++i){ const Clip c = rl_ref.step_at(i, b[i]); b[i] = c.val; hits += c.hit; }
+        if (!same(a, b) || rh != hits || !same_bits(rl.last_clip_mag(), rl_ref.last_clip_mag())) return base + 4;
+
+        a = in; b = in; hits = 0;
+        const std::uint64_t rhu = rlu.apply(a);
+        rlu_ref.begin_tick();
+        for (std::size_t i=0; i<n; ++i){ const Clip c = rlu_ref.step_at(i, b[i]); b[i] = c.val; hits += c.hit; }
+        if (!same(a, b) || rhu != hits || !same_bits(rlu.last_clip_mag(), rlu_ref.last_clip_mag())) return base + 5;
+
+        // // jerk
+        a = in; b = in; hits = 0;
+        const std::uint64_t jh = jl.apply(a);
+        jl_ref.begin_tick();
+        for (std::size_t i=0; i<n; ++i){ const Clip c = jl_ref.step_at(i, b[i]); b[i] = c.val; hits += c.hit; }
+        if (!same(a, b) || jh != hits || !same_bits(jl.last_clip_mag(), jl_ref.last_clip_mag())) return base + 6;
+        total_rate += rh;
+        total_jerk += jh;
+    }
+    if (total_rate == 0 || total_jerk == 0) return base + 7;
+    return 0;
+}
+
+int main(){
+    using simd::Isa;
+    const Isa best = simd::detected_isa();
+    for (int i = 0; i <= static_cast<int>(best); ++i){
+        if (!simd::select_isa(static_cast<Isa>(i))) return 1;
+        if (simd::active_isa() != static_cast<Isa>(i)) return 2;
+        for (std::size_t n : {1u, 2u, 3u, 7u, 8u, 9u, 17u, 64u, 67u}){
+            if (int rc = run_size(n, 10 * (i + 1))) return rc;
+        }
+    }
+    if (static_cast<int>(best) < 3 && simd::select_isa(Isa::kAvx512)) return 3;
+    return 0;
+}
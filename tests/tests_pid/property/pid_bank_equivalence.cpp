@@ -0,0 +1,193 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include "ictk/all.hpp"
+#include "ictk/control/pid/pid.hpp"
+#include "ictk/control/pid/pid_bank.hpp"
+
+using namespace ictk;
+using namespace ictk::control::pid;
+
+/*
+Property: PIDBank loop i == SISO PIDCore i
+    per loop gains, filters, limits, AW modes and schedules differ
+    same inputs -> bit-identical u and per loop health every tick (incl. deadline misses)
+    and the bank == one n channel PIDCore configured with the same spans (same filter coefficients per channel)
+*/
+
+static Scalar lcg(std::uint64_t& s){
+    s = s * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<Scalar>(static_cast<double>(s >> 11) * 0x1.0p-53) * Scalar(4) - Scalar(2);
+}
+
+static bool same_bits(double a, double b){
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+static bool same_health(const ControllerHealth& a, const ControllerHealth& b){
+    return a.deadline_miss_count == b.deadline_miss_count
+        && same_bits(a.saturation_pct, b.saturation_pct)
+        && a.rate_limit_hits == b.rate_limit_hits
+        && a.jerk_limit_hits == b.jerk_limit_hits
+        && a.fallback_active == b.fallback_active
+        && same_bits(a.aw_term_mag, b.aw_term_mag)
+        && same_bits(a.last_clamp_mag, b.last_clamp_mag)
+        && same_bits(a.last_rate_clip_mag, b.last_rate_clip_mag)
+        && same_bits(a.last_jerk_clip_mag, b.last_jerk_clip_mag)
+        && a.sat_hit_mask == b.sat_hit_mask
+        && a.rate_hit_mask == b.rate_hit_mask
+        && a.jerk_hit_mask == b.jerk_hit_mask;
+}
+
+// 0 on success, else a distinct failure code
+static int run_case(bool sat, bool rate, bool jerk, int base){
+    constexpr std::size_t n = 37;   // not a multiple of any vector width
+    const dt_ns dt = 1'000'000;
+    const Scalar inf = std::numeric_limits<Scalar>::infinity();
+
+    std::vector<Scalar> Kp(n), Ki(n), Kd(n), beta(n), tf(n), bias(n), Kt(n);
+    std::vector<Scalar> umin(n), umax(n), du(n), ddu(n);
+    std::vector<safety::AWMode> aw(n);
+    for (std::size_t i=0; i<n; ++i){
+        const Scalar s = Scalar(i);
+        Kp[i] = 2.0 + 0.25 * s;
+        Ki[i] = (i % 4 == 3) ? 0.0 : 1.0 + 0.1 * s;
+        Kd[i] = (i % 3 == 0) ? 0.0 : 0.02 * s;
+        beta[i] = (i % 2) ? 1.0 : 0.6;
+        tf[i] = (i % 5 == 4) ? 0.0 : 0.005 + 0.001 * s;
+        bias[i] = 0.01 * s;
+        Kt[i] = 0.1 + 0.02 * s;
+        umin[i] = (i % 11 == 10) ? -inf : -0.4 - 0.05 * s;
+        umax[i] = (i % 11 == 10) ?  inf :  0.4 + 0.05 * s;
+        du[i] = (i % 13 == 12) ? inf : 15.0 + 2.0 * s;
+        ddu[i] = 8.0 + 0.5 * s;
+        aw[i] = static_cast<safety::AWMode>(i % 3);
+    }
+
+    // every fifth loop is scheduled on its own measurement
+    static const Scalar bp[]{-1.0, 0.0, 1.0};
+    static const Scalar kp_tab[]{1.0, 3.0, 2.0}, ki_tab[]{0.5, 1.5, 1.0}, kd_tab[]{0.0, 0.05, 0.02};
+    static const Scalar beta_tab[]{1.0, 0.8, 0.5}, gamma_tab[]{0.0, 0.0, 0.0};
+    std::vector<ScheduleConfig> sched(n);
+    for (std::size_t i=0; i<n; i+=5) sched[i] = ScheduleConfig{bp, kp_tab, ki_tab, kd_tab, beta_tab, gamma_tab};
+
+    std::vector<std::byte> bank_mem(1 << 16), core_mem(1 << 18);
+    MemoryArena bank_arena(bank_mem.data(), bank_mem.size()), core_arena(core_mem.data(), core_mem.size());
+
+    PIDBankConfig bc{};
+    bc.Kp = Kp; bc.Ki = Ki; bc.Kd = Kd; bc.beta = beta; bc.tau_f = tf; bc.u_ff_bias = bias;
+    bc.aw_mode = aw; bc.Kt = Kt; bc.sched = sched;
+    if (sat){ bc.umin = umin; bc.umax = umax; }
+    if (rate) bc.du_max = du;
+    if (jerk){ bc.du_max = du; bc.ddu_max = ddu; }
+
+    PIDBank bank;
+    if (bank.init(n, dt, bank_arena) != Status::kOK) return base + 1;
+    if (bank.configure(bc) != Status::kOK) return base + 2;
+    if (bank.start() != Status::kOK) return base + 3;
+
+    std::vector<PIDCore> cores(n);
+    const Dims d{ .ny=1, .nu=1, .nx=0 };
+    for (std::size_t i=0; i<n; ++i){
+        PIDConfig c{};
+        c.Kp = {&Kp[i], 1}; c.Ki = {&Ki[i], 1}; c.Kd = {&Kd[i], 1};
+        c.beta = {&beta[i], 1}; c.tau_f = {&tf[i], 1}; c.u_ff_bias = {&bias[i], 1};
+        c.aw_mode = aw[i]; c.Kt = Kt[i]; c.sched = sched[i];
+        if (sat){ c.umin = {&umin[i], 1}; c.umax = {&umax[i], 1}; }
+        if (rate) c.du_max = {&du[i], 1};
+        if (jerk){ c.du_max = {&du[i], 1}; c.ddu_max = {&ddu[i], 1}; }
+        if (cores[i].init(d, dt, core_arena, {}) != Status::kOK) return base + 1;
+        if (cores[i].configure(c) != Status::kOK) return base + 2;
+        if (cores[i].start() != Status::kOK) return base + 3;
+    }
+
+    std::vector<Scalar> y(n, 0), r(n, 0), u(n, 0);
+    Scalar uc = 0;
+    std::uint64_t seed = 7;
+    t_ns t = 0;
+    std::uint64_t sat_hits = 0, rate_hits = 0, jerk_hits = 0;
+    for (int k=0; k<4000; ++k){
+        if (k % 200 == 0) for (auto& v : r) v = lcg(seed);
+        for (std::size_t i=0; i<n; ++i) y[i] = Scalar(0.2) * lcg(seed);
+
+        t += (k == 1500) ? 3 * dt : dt;  // one late tick -> deadline accounting
+        if (bank.update_all(t, y, r, u) != Status::kOK) return base + 4;
+
+        for (std::size_t i=0; i<n; ++i){
+            PlantState ps{ .y=std::span<const Scalar>(&y[i], 1), .xhat={}, .t=t, .valid_bits=1ull };
+            Setpoint sp{ .r=std::span<const Scalar>(&r[i], 1), .preview_horizon_len=0 };
+            Result res{ .u=std::span<Scalar>(&uc, 1), .health={} };
+            if (cores[i].update({ps, sp}, res) != Status::kOK) return base + 5;
+
+            if (std::memcmp(&uc, &u[i], sizeof(Scalar)) != 0) return base + 6;
+            if (!same_health(res.health, bank.health(i))) return base + 7;
+        }
+
+        const BankHealth bh = bank.summary();
+        sat_hits += bh.sat_loops;
+        rate_hits += bh.rate_limit_hits;
+        jerk_hits += bh.jerk_limit_hits;
+    }
+
+    if (bank.summary().deadline_miss_count != 2) return base + 8;
+    if ((sat && sat_hits == 0) || (rate && rate_hits == 0) || (jerk && jerk_hits == 0)) return base + 9;
+    return 0;
+}
+
+// // the bank against one multi channel PIDCore on the same config spans: tau_f only for channel 0 and N for the rest
+// // (no broadcast for either), per channel saturation + rate; u must match bit for bit
+static int run_multi(int base){
+    constexpr std::size_t n = 3;
+    const dt_ns dt = 1'000'000;
+
+    const Scalar Kp[]{2.0, 1.5, 3.0}, Ki[]{1.0, 0.5, 2.0}, Kd[]{0.05, 0.02, 0.1}, beta[]{0.7, 1.0, 0.5};
+    const Scalar tf[]{0.004}, N[]{100.0, 50.0, 200.0};
+    const Scalar umin[]{-0.5, -0.4, -0.6}, umax[]{0.5, 0.4, 0.6}, du[]{20.0, 15.0, 25.0};
+    const safety::AWMode aw[]{safety::AWMode::kBackCalc};
+    const Scalar Kt[]{0.2};
+
+    std::vector<std::byte> bank_mem(1 << 14), core_mem(1 << 16);
+    MemoryArena bank_arena(bank_mem.data(), bank_mem.size()), core_arena(core_mem.data(), core_mem.size());
+
+    PIDBankConfig bc{};
+    bc.Kp = Kp; bc.Ki = Ki; bc.Kd = Kd; bc.beta = beta; bc.tau_f = tf; bc.N = N;
+    bc.umin = umin; bc.umax = umax; bc.du_max = du; bc.aw_mode = aw; bc.Kt = Kt;
+    PIDBank bank;
+    if (bank.init(n, dt, bank_arena) != Status::kOK || bank.configure(bc) != Status::kOK || bank.start() != Status::kOK) return base + 1;
+
+    PIDConfig c{};
+    c.Kp = Kp; c.Ki = Ki; c.Kd = Kd; c.beta = beta; c.tau_f = tf; c.N = N;
+    c.umin = umin; c.umax = umax; c.du_max = du; c.aw_mode = aw[0]; c.Kt = Kt[0];
+    PIDCore core;
+    const Dims d{ .ny=n, .nu=n, .nx=0 };
+    if (core.init(d, dt, core_arena, {}) != Status::kOK || core.configure(c) != Status::kOK || core.start() != Status::kOK) return base + 2;
+
+    std::vector<Scalar> y(n, 0), r(n, 0), u(n, 0), uc(n, 0);
+    std::uint64_t seed = 11;
+    t_ns t = 0;
+    for (int k=0; k<2000; ++k){
+        if (k % 100 == 0) for (auto& v : r) v = lcg(seed);
+        for (auto& v : y) v = Scalar(0.2) * lcg(seed);
+        t += dt;
+        if (bank.update_all(t, y, r, u) != Status::kOK) return base + 3;
+
+        PlantState ps{ .y=y, .xhat={}, .t=t, .valid_bits=(1ull << n) - 1 };
+        Setpoint sp{ .r=r, .preview_horizon_len=0 };
+        Result res{ .u=uc, .health={} };
+        if (core.update({ps, sp}, res) != Status::kOK) return base + 4;
+        if (std::memcmp(uc.data(), u.data(), n * sizeof(Scalar)) != 0) return base + 5;
+    }
+    return 0;
+}
+
+int main(){
+    if (int rc = run_case(true, true, true, 10)) return rc;
+    if (int rc = run_case(true, false, false, 20)) return rc;
+    if (int rc = run_case(false, true, false, 30)) return rc;
+    if (int rc = run_case(false, false, false, 40)) return rc;
+    if (int rc = run_multi(50)) return rc;
+    return 0;
+}
@@ -0,0 +1,205 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include "ictk/all.hpp"
+#include "ictk/control/pid/pid.hpp"
+#include "ictk/control/pid/pid_fixed.hpp"
+
+using namespace ictk;
+using namespace ictk::control::pid;
+
+/*
+Property: FixedPIDCore<N> == PIDCore with the same PIDConfig
+    scenarios of the PID property tests (rate/jerk bound, schedule, AW modes after safety, bumpless, invalid bits,
+    deadline misses, hooks) at N = 1, 4, 64 -> bit-identical u, status and health every tick
+    plus: zero arena bytes, constexpr validate(), float instantiation
+*/
+
+// // compile-time config check
+namespace {
+    constexpr Scalar kKp[]{1.0, 2.0}, kBeta[]{0.5}, kBadBeta[]{1.5}, kGamma[]{0.1}, kLim[]{1.0}, kThree[]{1.0, 2.0, 3.0};
+    constexpr std::span<const Scalar> kNone{};
+
+    constexpr PIDConfig cfg(std::span<const Scalar> kp, std::span<const Scalar> beta, std::span<const Scalar> gamma,
+                            std::span<const Scalar> umin, std::span<const Scalar> umax, std::span<const Scalar> du){
+        PIDConfig c{};
+        c.Kp = kp; c.beta = beta; c.gamma = gamma; c.umin = umin; c.umax = umax; c.du_max = du;
+        return c;
+    }
+
+    static_assert(FixedPIDCore<2>::validate(cfg(kKp, kBeta, kNone, kNone, kNone, kNone)) == Status::kOK);
+    static_assert(FixedPIDCore<2>::validate(cfg(kKp, kNone, kNone, kLim, kLim, kLim)) == Status::kOK);
+    static_assert(FixedPIDCore<2>::validate(cfg(kThree, kNone, kNone, kNone, kNone, kNone)) == Status::kInvalidArg);
+    static_assert(FixedPIDCore<2>::validate(cfg(kKp, kBadBeta, kNone, kNone, kNone, kNone)) == Status::kInvalidArg);
+    static_assert(FixedPIDCore<2>::validate(cfg(kKp, kNone, kGamma, kNone, kNone, kNone)) == Status::kInvalidArg);
+    static_assert(FixedPIDCore<2>::validate(cfg(kKp, kNone, kNone, kLim, kNone, kNone)) == Status::kInvalidArg);
+    static_assert(FixedPIDCore<64>::kValidMask == ~0ull && FixedPIDCore<3>::kValidMask == 0x7ull);
+}
+
+static Scalar lcg(std::uint64_t& s){
+    s = s * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<Scalar>(static_cast<double>(s >> 11) * 0x1.0p-53) * Scalar(4) - Scalar(2);
+}
+
+static bool same_bits(double a, double b){
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+static bool same_health(const ControllerHealth& a, const ControllerHealth& b){
+    return a.deadline_miss_count == b.deadline_miss_count
+        && same_bits(a.saturation_pct, b.saturation_pct)
+        && a.rate_limit_hits == b.rate_limit_hits
+        && a.jerk_limit_hits == b.jerk_limit_hits
+        && a.fallback_active == b.fallback_active
+        && same_bits(a.aw_term_mag, b.aw_term_mag)
+        && same_bits(a.last_clamp_mag, b.last_clamp_mag)
+        && same_bits(a.last_rate_clip_mag, b.last_rate_clip_mag)
+        && same_bits(a.last_jerk_clip_mag, b.last_jerk_clip_mag)
+        && a.sat_hit_mask == b.sat_hit_mask
+        && a.rate_hit_mask == b.rate_hit_mask
+        && a.jerk_hit_mask == b.jerk_hit_mask;
+}
+
+static void pre_clamp_scale(std::span<Scalar> u, void*) noexcept{
+    for (auto& v : u) v = Scalar(1.25) * v;
+}
+
+// // scenario flags
+enum : unsigned {
+    kSat = 1u << 0, kRate = 1u << 1, kJerk = 1u << 2, kSched = 1u << 3,
+    kHooks = 1u << 4, kDropValid = 1u << 5, kBumpless = 1u << 6, kWatchdog = 1u << 7
+};
+
+// // 0 on success, else a distinct failure code
+template <std::size_t N>
+static int run_case(unsigned f, safety::AWMode aw, int base){
+    const dt_ns dt = 1'000'000;
+    const Scalar inf = std::numeric_limits<Scalar>::infinity();
+
+    std::vector<Scalar> Kp(N), Ki(N), Kd(N), beta(N), tf(N), bias(N), umin(N), umax(N), du(N);
+    for (std::size_t i=0; i<N; ++i){
+        const Scalar s = Scalar(i);
+        Kp[i] = 2.0 + 0.25 * s;
+        Ki[i] = (i % 4 == 3) ? 0.0 : 1.0 + 0.1 * s;
+        Kd[i] = (i % 3 == 0) ? 0.05 : 0.02 * s;
+        beta[i] = (i % 2) ? 1.0 : 0.6;
+        tf[i] = (i % 5 == 4) ? 0.0 : 0.005 + 0.001 * s;
+        bias[i] = 0.01 * s;
+        umin[i] = (i % 11 == 10) ? -inf : -0.4 - 0.05 * s;
+        umax[i] = (i % 11 == 10) ?  inf :  0.4 + 0.05 * s;
+        du[i] = 15.0 + 2.0 * s;
+    }
+    static const Scalar ddu[]{40.0};
+    static const Scalar bp[]{-1.0, 0.0, 1.0};
+    static const Scalar kp_tab[]{1.0, 3.0, 2.0}, ki_tab[]{0.5, 1.5, 1.0}, kd_tab[]{0.0, 0.05, 0.02};
+    static const Scalar beta_tab[]{1.0, 0.8, 0.5}, gamma_tab[]{0.0, 0.0, 0.0};
+
+    PIDConfig c{};
+    c.Kp = Kp; c.Ki = Ki; c.Kd = Kd; c.beta = beta; c.tau_f = tf; c.u_ff_bias = bias;
+    c.aw_mode = aw; c.Kt = 0.3;
+    if ((f & kSat)){ c.umin = umin; c.umax = umax; }
+    if ((f & kRate) || (f & kJerk)) c.du_max = du;
+    if ((f & kJerk)) c.ddu_max = ddu;
+    if ((f & kSched)) c.sched = ScheduleConfig{bp, kp_tab, ki_tab, kd_tab, beta_tab, gamma_tab};
+    if ((f & kWatchdog)){ c.miss_threshold = 2; c.watchdog_slack = 0; }
+
+    const Hooks h = (f & kHooks) ? Hooks{ .pre_clamp=pre_clamp_scale } : Hooks{};
+    const Dims d{ .ny=N, .nu=N, .nx=0 };
+
+    std::vector<std::byte> mem(1 << 16);
+    MemoryArena arena(mem.data(), mem.size());
+
+    PIDCore ref;
+    if (ref.init(d, dt, arena, h) != Status::kOK) return base + 1;
+    if (ref.configure(c) != Status::kOK) return base + 2;
+    if (ref.start() != Status::kOK) return base + 3;
+
+    // // state lives in the object
+    const std::size_t used = arena.used();
+    FixedPIDCore<N> fx;
+    if (fx.init(d, dt, arena, h) != Status::kOK) return base + 1;
+    if (fx.configure(c) != Status::kOK) return base + 2;
+    if (fx.start() != Status::kOK) return base + 3;
+    if (arena.used() != used) return base + 8;
+
+    std::vector<Scalar> y(N, 0), r(N, 0), ua(N, 0), ub(N, 0);
+    std::uint64_t seed = 3 + N;
+    t_ns t = 0;
+    std::uint64_t hits = 0;
+    for (int k=0; k<3000; ++k){
+        if (k % 150 == 0) for (auto& v : r) v = lcg(seed);
+        for (auto& v : y) v = Scalar(0.3) * lcg(seed);
+        t += (k == 900 || k == 901 || k == 902) ? 3 * dt : dt;
+
+        if ((f & kBumpless) && k == 1200){
+            std::vector<Scalar> hold(N, Scalar(0.1));
+            ref.align_bumpless(hold, r, y);
+            fx.align_bumpless(hold, r, y);
+        }
+
+        const std::uint64_t vb = ((f & kDropValid) && k % 97 == 5) ? ~(1ull << (k % N)) : ~0ull;
+        PlantState ps{ .y=y, .xhat={}, .t=t, .valid_bits=vb };
+        Setpoint sp{ .r=r, .preview_horizon_len=0 };
+        Result a{ .u=ua, .health={} }, b{ .u=ub, .health={} };
+        const Status sa = ref.update({ps, sp}, a);
+        const Status sb = fx.update({ps, sp}, b);
+        if (sa != sb) return base + 4;
+        if (sa != Status::kOK) continue;
+
+        if (std::memcmp(ua.data(), ub.data(), N * sizeof(Scalar)) != 0) return base + 5;
+        if (!same_health(a.health, b.health)) return base + 6;
+        hits += b.health.rate_limit_hits + b.health.jerk_limit_hits + b.health.sat_hit_mask;
+    }
+    if (((f & kSat) || (f & kRate) || (f & kJerk)) && hits == 0) return base + 7;
+    return 0;
+}
+
+// // T = float: same structure, bounds still hold
+static int run_float(int base){
+    constexpr std::size_t N = 4;
+    const dt_ns dt = 1'000'000;
+    static const Scalar Kp[]{50.0}, Ki[]{1.0}, du[]{5.0};
+    PIDConfig c{};
+    c.Kp = Kp; c.Ki = Ki; c.du_max = du;
+
+    std::byte mem[64];
+    MemoryArena arena(mem, sizeof(mem));
+    FixedPIDCore<N, float> fx;
+    if (fx.init({ .ny=N, .nu=N, .nx=0 }, dt, arena) != Status::kOK) return base + 1;
+    if (fx.configure(c) != Status::kOK) return base + 2;
+    if (fx.start() != Status::kOK) return base + 3;
+
+    std::vector<Scalar> y(N, 0), r(N, 10.0), u(N, 0), u_prev(N, 0);
+    t_ns t = 0;
+    const Scalar bound = du[0] * 1e-3 * (1.0 + 1e-5);
+    for (int k=0; k<200; ++k){
+        t += dt;
+        PlantState ps{ .y=y, .xhat={}, .t=t, .valid_bits=~0ull };
+        Setpoint sp{ .r=r, .preview_horizon_len=0 };
+        Result res{ .u=u, .health={} };
+        if (fx.update({ps, sp}, res) != Status::kOK) return base + 4;
+        for (std::size_t i=0; i<N; ++i){
+            if (!std::isfinite(u[i]) || std::fabs(u[i] - u_prev[i]) > bound) return base + 5;
+            u_prev[i] = u[i];
+        }
+        if (res.health.rate_limit_hits != N) return base + 6;
+    }
+    return 0;
+}
+
+int main(){
+    using safety::AWMode;
+    if (int rc = run_case<1>(kRate, AWMode::kBackCalc, 10)) return rc;
+    if (int rc = run_case<1>(kRate | kJerk, AWMode::kBackCalc, 20)) return rc;
+    if (int rc = run_case<1>(kSched, AWMode::kBackCalc, 30)) return rc;
+    if (int rc = run_case<1>(kSat | kBumpless, AWMode::kBackCalc, 40)) return rc;
+    if (int rc = run_case<4>(kSat | kRate | kJerk, AWMode::kBackCalc, 50)) return rc;
+    if (int rc = run_case<4>(kSat | kDropValid, AWMode::kConditional, 60)) return rc;
+    if (int rc = run_case<4>(kSat | kJerk | kWatchdog, AWMode::kOff, 70)) return rc;
+    if (int rc = run_case<64>(kSat | kRate | kSched | kHooks | kBumpless, AWMode::kBackCalc, 80)) return rc;
+    if (int rc = run_float(90)) return rc;
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include <bit>
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include "ictk/all.hpp"
+#include "ictk/control/pid/pid.hpp"
+
+using namespace ictk;
+using namespace ictk::control::pid;
+
+/*
+Property: SafetyChainMode::kFused is a drop-in for kStaged
+    same config, same inputs -> byte-identical u and ControllerHealth every tick
+    sat mask popcount == saturation hits
+*/
+
+// deterministic input stream
+static Scalar lcg(std::uint64_t& s){
+    s = s * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<Scalar>(static_cast<double>(s >> 11) * 0x1.0p-53) * Scalar(4) - Scalar(2);
+}
+
+// field wise, bit exact (struct padding is not compared)
+static bool same_bits(double a, double b){
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+static bool same_health(const ControllerHealth& a, const ControllerHealth& b){
+    return a.deadline_miss_count == b.deadline_miss_count
+        && same_bits(a.saturation_pct, b.saturation_pct)
+        && a.rate_limit_hits == b.rate_limit_hits
+        && a.jerk_limit_hits == b.jerk_limit_hits
+        && a.fallback_active == b.fallback_active
+        && a.novelty_flag == b.novelty_flag
+        && same_bits(a.aw_term_mag, b.aw_term_mag)
+        && same_bits(a.last_clamp_mag, b.last_clamp_mag)
+        && same_bits(a.last_rate_clip_mag, b.last_rate_clip_mag)
+        && same_bits(a.last_jerk_clip_mag, b.last_jerk_clip_mag)
+        && a.sat_hit_mask == b.sat_hit_mask
+        && a.rate_hit_mask == b.rate_hit_mask
+        && a.jerk_hit_mask == b.jerk_hit_mask;
+}
+
+int main(){
+    constexpr std::size_t nu = 8;
+    Dims d{ .ny=nu, .nu=nu, .nx=0 };
+    dt_ns dt = 1'000'000;
+
+    alignas(64) std::byte buf_a[8192], buf_b[8192];
+    MemoryArena arena_a(buf_a, sizeof(buf_a)), arena_b(buf_b, sizeof(buf_b));
+
+    std::vector<Scalar> Kp(nu), Ki(nu, 2.0), Kd(nu, 0.05), tf(nu, 0.01);
+    std::vector<Scalar> umin(nu), umax(nu), du(nu);
+    for (std::size_t i=0; i<nu; ++i){
+        Kp[i] = 5.0 + Scalar(i);
+        umin[i] = -0.5 - 0.1 * Scalar(i);
+        umax[i] =  0.5 + 0.1 * Scalar(i);
+        du[i] = 20.0 + 5.0 * Scalar(i);
+    }
+    static Scalar ddu[]{10.0};
+
+    PIDConfig c{};
+    c.Kp = {Kp.data(), nu};
+    c.Ki = {Ki.data(), nu};
+    c.Kd = {Kd.data(), nu};
+    c.tau_f = {tf.data(), nu};
+    c.umin = {umin.data(), nu};
+    c.umax = {umax.data(), nu};
+    c.du_max = {du.data(), nu};
+    c.ddu_max = {ddu, 1};
+    c.Kt = 0.3;
+
+    PIDCore staged, fused;
+    if (staged.init(d, dt, arena_a, {}) != Status::kOK || fused.init(d, dt, arena_b, {}) != Status::kOK) return 1;
+    if (staged.configure(c) != Status::kOK || fused.configure(c) != Status::kOK) return 2;
+    fused.set_safety_chain(SafetyChainMode::kFused);
+    if (staged.start() != Status::kOK || fused.start() != Status::kOK) return 3;
+
+    std::vector<Scalar> y(nu, 0), r(nu, 0), ua(nu, 0), ub(nu, 0);
+    Result ra{ .u=std::span<Scalar>(ua.data(), nu), .health={} };
+    Result rb{ .u=std::span<Scalar>(ub.data(), nu), .health={} };
+    PlantState ps{ .y=std::span<const Scalar>(y.data(), nu), .xhat={}, .t=0, .valid_bits=~0ull };
+    Setpoint sp{ .r=std::span<const Scalar>(r.data(), nu), .preview_horizon_len=0 };
+
+    std::uint64_t seed = 42;
+    std::uint64_t sat_hits = 0, rate_hits = 0, jerk_hits = 0;
+    for (int k=0; k<5000; ++k){
+        // step setpoints every 250 ticks, noisy measurement
+        if (k % 250 == 0) for (auto& v : r) v = lcg(seed);
+        for (std::size_t i=0; i<nu; ++i) y[i] = Scalar(0.1) * lcg(seed);
+
+        ps.t += dt;
+        if (staged.update({ps, sp}, ra) != Status::kOK) return 4;
+        if (fused.update({ps, sp}, rb) != Status::kOK) return 5;
+
+        if (std::memcmp(ua.data(), ub.data(), nu * sizeof(Scalar)) != 0) return 6;
+        if (!same_health(ra.health, rb.health)) return 7;
+
+        const double pct = 100.0 * double(std::popcount(rb.health.sat_hit_mask)) / double(nu);
+        if (pct != rb.health.saturation_pct) return 8;
+
+        sat_hits += static_cast<std::uint64_t>(std::popcount(rb.health.sat_hit_mask));
+        rate_hits += rb.health.rate_limit_hits;
+        jerk_hits += rb.health.jerk_limit_hits;
+    }
+
+    // every stage must have been exercised
+    if (sat_hits == 0 || rate_hits == 0 || jerk_hits == 0) return 9;
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include "ictk/all.hpp"
+#include "ictk/control/pid/pid.hpp"
+#include "ictk/control/pid/static_pid.hpp"
+
+using namespace ictk;
+using namespace ictk::control::pid;
+
+/*
+Property: StaticPIDCore<Stages...> == PIDCore with the same limits
+    direct, through StaticControllerAdapter (IController&), and with compile-time hooks vs runtime hooks
+    same inputs -> bit-identical u and health every tick (incl. deadline misses)
+*/
+
+// // stage lists out of the dynamic chain's order do not compile (StaticControllerBase static_asserts this)
+static_assert(detail::canonical_stages<>());
+static_assert(detail::canonical_stages<safety::Saturation, safety::JerkLimiter>());
+static_assert(detail::canonical_stages<safety::Saturation, safety::RateLimiter, safety::JerkLimiter>());
+static_assert(!detail::canonical_stages<safety::RateLimiter, safety::Saturation>());
+static_assert(!detail::canonical_stages<safety::Saturation, safety::Saturation>());
+
+static Scalar lcg(std::uint64_t& s){
+    s = s * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<Scalar>(static_cast<double>(s >> 11) * 0x1.0p-53) * Scalar(4) - Scalar(2);
+}
+
+static bool same_bits(double a, double b){
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+static bool same_health(const ControllerHealth& a, const ControllerHealth& b){
+    return a.deadline_miss_count == b.deadline_miss_count
+        && same_bits(a.saturation_pct, b.saturation_pct)
+        && a.rate_limit_hits == b.rate_limit_hits
+        && a.jerk_limit_hits == b.jerk_limit_hits
+        && a.fallback_active == b.fallback_active
+        && same_bits(a.aw_term_mag, b.aw_term_mag)
+        && same_bits(a.last_clamp_mag, b.last_clamp_mag)
+        && same_bits(a.last_rate_clip_mag, b.last_rate_clip_mag)
+        && same_bits(a.last_jerk_clip_mag, b.last_jerk_clip_mag)
+        && a.sat_hit_mask == b.sat_hit_mask
+        && a.rate_hit_mask == b.rate_hit_mask
+        && a.jerk_hit_mask == b.jerk_hit_mask;
+}
+
+// // runtime hooks and their compile-time twin
+static void rt_pre_clamp(std::span<Scalar> u, void*) noexcept{
+    for (auto& v : u) v = Scalar(1.5) * v;
+}
+static void rt_post_arb(std::span<const Scalar> u_pre, std::span<Scalar> u, void*) noexcept{
+    for (std::size_t i=0; i<u.size(); ++i) u[i] = u[i] + Scalar(0.01) * u_pre[i];
+}
+struct ScaleHooks{
+    void pre_clamp(std::span<Scalar> u) noexcept{ rt_pre_clamp(u, nullptr); }
+    void post_arbitrate(std::span<const Scalar> u_pre, std::span<Scalar> u) noexcept{ rt_post_arb(u_pre, u, nullptr); }
+};
+
+constexpr std::size_t kN = 5;
+constexpr dt_ns kDt = 1'000'000;
+
+struct Cfg{
+    Scalar Kp[kN]{2.0, 1.0, 3.0, 0.5, 4.0}, Ki[kN]{1.0, 0.0, 2.0, 0.5, 1.5}, Kd[kN]{0.05, 0.0, 0.02, 0.1, 0.0};
+    Scalar beta[kN]{1.0, 0.6, 1.0, 0.8, 1.0}, tf[kN]{0.01, 0.0, 0.005, 0.02, 0.01};
+    Scalar umin[kN]{-0.5, -0.4, -0.6, -0.3, -0.7}, umax[kN]{0.5, 0.4, 0.6, 0.3, 0.7};
+    Scalar du[kN]{20.0, 15.0, 25.0, 10.0, 30.0}, ddu[1]{400.0};
+
+    PIDConfig make(bool sat, bool rate, bool jerk) const{
+        PIDConfig c{};
+        c.Kp = Kp; c.Ki = Ki; c.Kd = Kd; c.beta = beta; c.tau_f = tf;
+        c.aw_mode = safety::AWMode::kBackCalc; c.Kt = 0.2;
+        if (sat){ c.umin = umin; c.umax = umax; }
+        if (rate || jerk) c.du_max = du;
+        if (jerk) c.ddu_max = ddu;
+        return c;
+    }
+};
+
+// // drives ref (PIDCore) and dut side by side; 0 on success, else a distinct failure code
+template <class Tick>
+static int drive(IController& ref, Tick&& dut, int base){
+    std::vector<Scalar> y(kN, 0), r(kN, 0), u_ref(kN, 0), u_dut(kN, 0);
+    std::uint64_t seed = 11;
+    t_ns t = 0;
+    for (int k=0; k<3000; ++k){
+        if (k % 150 == 0) for (auto& v : r) v = lcg(seed);
+        for (auto& v : y) v = Scalar(0.2) * lcg(seed);
+        t += (k == 1000) ? 4 * kDt : kDt;
+
+        PlantState ps{ .y=y, .xhat={}, .t=t, .valid_bits=~0ull };
+        Setpoint sp{ .r=r, .preview_horizon_len=0 };
+        Result a{ .u=u_ref, .health={} }, b{ .u=u_dut, .health={} };
+        if (ref.update({ps, sp}, a) != Status::kOK) return base + 4;
+        if (dut({ps, sp}, b) != Status::kOK) return base + 5;
+
+        if (std::memcmp(u_ref.data(), u_dut.data(), kN * sizeof(Scalar)) != 0) return base + 6;
+        if (!same_health(a.health, b.health)) return base + 7;
+        if (k > 1000 && b.health.deadline_miss_count != 3) return base + 8;
+    }
+    return 0;
+}
+
+template <class C>
+static int run_case(bool sat, bool rate, bool jerk, const Hooks& rt_hooks, int base){
+    std::vector<std::byte> mem(1 << 16);
+    MemoryArena arena(mem.data(), mem.size());
+    const Dims d{ .ny=kN, .nu=kN, .nx=0 };
+    const Cfg cfg{};
+    const PIDConfig pc = cfg.make(sat, rate, jerk);
+
+    // // one fresh reference per run (reset() keeps limiter state)
+    PIDCore ref, ref2;
+    for (PIDCore* p : {&ref, &ref2}){
+        if (p->init(d, kDt, arena, rt_hooks) != Status::kOK) return base + 1;
+        if (p->configure(pc) != Status::kOK) return base + 2;
+        if (p->start() != Status::kOK) return base + 3;
+    }
+
+    // // direct
+    C dut;
+    if (dut.init(d, kDt, arena) != Status::kOK) return base + 1;
+    if (dut.configure(pc) != Status::kOK) return base + 2;
+    if (dut.start() != Status::kOK) return base + 3;
+    if (int rc = drive(ref, [&](const UpdateContext& c, Result& o){ return dut.update(c, o); }, base)) return rc;
+
+    // // through the adapter
+    StaticControllerAdapter<C> ad;
+    IController& ic = ad;
+    if (ic.init(d, kDt, arena) != Status::kOK) return base + 1;
+    if (ad.get().configure(pc) != Status::kOK) return base + 2;
+    if (ic.start() != Status::kOK) return base + 3;
+    if (ic.init(d, kDt, arena, Hooks{ .pre_clamp=rt_pre_clamp }) != Status::kInvalidArg) return base + 9;
+    return drive(ref2, [&](const UpdateContext& c, Result& o){ return ic.update(c, o); }, base);
+}
+
+int main(){
+    using safety::Saturation;
+    using safety::RateLimiter;
+    using safety::JerkLimiter;
+    const Hooks rt{ .pre_clamp=rt_pre_clamp, .post_arbitrate=rt_post_arb };
+
+    if (int rc = run_case<StaticPIDCore<Saturation, RateLimiter, JerkLimiter>>(true, true, true, {}, 10)) return rc;
+    if (int rc = run_case<StaticPIDCore<Saturation>>(true, false, false, {}, 20)) return rc;
+    if (int rc = run_case<StaticPIDCore<RateLimiter>>(false, true, false, {}, 30)) return rc;
+    if (int rc = run_case<StaticPIDCore<>>(false, false, false, {}, 40)) return rc;
+    if (int rc = run_case<BasicStaticPIDCore<ScaleHooks, Saturation, RateLimiter, JerkLimiter>>(true, true, true, rt, 50)) return rc;
+
+    // // config and stage list must agree; start() refuses an unconfigured stage
+    std::vector<std::byte> mem(1 << 14);
+    MemoryArena arena(mem.data(), mem.size());
+    const Dims d{ .ny=kN, .nu=kN, .nx=0 };
+    const Cfg cfg{};
+    StaticPIDCore<Saturation, RateLimiter> p;
+    if (p.init(d, kDt, arena) != Status::kOK) return 61;
+    if (p.configure(cfg.make(true, false, false)) != Status::kInvalidArg) return 62;
+    if (p.configure(cfg.make(true, true, true)) != Status::kInvalidArg) return 63;
+    if (p.start() != Status::kNotReady) return 64;
+    if (p.configure(cfg.make(true, true, false)) != Status::kOK) return 65;
+    if (p.start() != Status::kOK) return 66;
+    return 0;
+}
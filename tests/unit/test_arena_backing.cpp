@@ -0,0 +1,81 @@
+// tests/unit/test_arena_backing.cpp
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "ictk/core/status.hpp"
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/core/arena_plan.hpp"
+#include "ictk/core/arena_backing.hpp"
+#include "ictk/control/pid/pid.hpp"
+
+using namespace ictk;
+using namespace ictk::control::pid;
+
+int main(){
+    constexpr dt_ns kDt = 1'000'000;
+
+    // Case 1: default request (hugepages, lock, prefault) -> whatever the host grants, never a failure
+    {
+        static const Scalar Kp = 1.0, Ki = 0.5, lo = -1.0, hi = 1.0, du = 10.0;
+        PIDConfig c{};
+        c.Kp = {&Kp, 1}; c.Ki = {&Ki, 1}; c.umin = {&lo, 1}; c.umax = {&hi, 1}; c.du_max = {&du, 1};
+        const ArenaPlan p = plan_controller<PIDCore>(Dims{1, 1, 0}, kDt, c);
+        constexpr std::size_t kLoops = 4096;
+
+        ArenaBacking back;
+        BackingOptions o{};
+        o.bytes = packed_bytes(p, kLoops);
+        if (back.acquire(o) != Status::kOK) return 1;
+        const BackingInfo& info = back.info();
+        if (!back.data() || info.kind == BackingKind::kNone) return 2;
+        if (reinterpret_cast<std::uintptr_t>(back.data()) % 64 != 0) return 3;
+        if (back.size() < o.bytes || !info.prefaulted || info.page_size == 0) return 4;
+        if (info.kind == BackingKind::kHugeTLB && back.size() % (std::size_t{2} << 20) != 0) return 5;
+
+        MemoryArena a = back.arena();
+        std::vector<PIDCore> loops(kLoops);
+        for (auto& l : loops){
+            if (l.init(Dims{1, 1, 0}, kDt, a, {}) != Status::kOK || l.configure(c) != Status::kOK) return 6;
+        }
+        if (a.misses() != 0) return 7;
+
+        back.release();
+        if (back.data() || back.size() != 0 || back.info().kind != BackingKind::kNone) return 8;
+    }
+
+    // Case 2: base pages on request, rounded to the page size
+    {
+        ArenaBacking back;
+        BackingOptions o{};
+        o.bytes = 10000;
+        o.hugepages = false;
+        o.lock = false;
+        if (back.acquire(o) != Status::kOK) return 9;
+#if defined(__linux__)
+        if (back.info().kind != BackingKind::kPages) return 10;
+        if (back.size() % back.info().page_size != 0 || back.size() < o.bytes) return 11;
+#endif
+        if (back.info().locked || back.info().numa_node != -1) return 12;
+    }
+
+    // Case 3: refused steps -> reported, or kPreconditionFail when strict
+    {
+        ArenaBacking back;
+        BackingOptions o{};
+        o.bytes = 1 << 16;
+        o.numa_node = 4000;            // no such node
+        if (back.acquire(o) != Status::kOK) return 13;
+        if (back.info().numa_node != -1) return 14;
+
+        o.strict = true;
+        if (back.acquire(o) != Status::kPreconditionFail) return 15;
+        if (back.data() || back.size() != 0) return 16;
+
+        o = BackingOptions{};
+        if (back.acquire(o) != Status::kInvalidArg) return 17;
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+// tests/unit/test_arena_plan.cpp
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "ictk/core/status.hpp"
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/core/arena_plan.hpp"
+#include "ictk/control/pid/pid.hpp"
+#include "ictk/control/pid/pid_bank.hpp"
+#include "ictk/control/pid/pid_fixed.hpp"
+
+using namespace ictk;
+using namespace ictk::control::pid;
+
+namespace{
+
+    constexpr dt_ns kDt = 1'000'000;
+    constexpr std::size_t kNu = 3;
+
+    const std::array<Scalar, kNu> Kp{1.0, 2.0, 3.0};
+    const std::array<Scalar, kNu> lo{-1.0, -1.0, -1.0}, hi{1.0, 1.0, 1.0}, du{10.0, 10.0, 10.0}, safe{0.0, 0.0, 0.0};
+    const Scalar Ki = 0.5, Kd = 0.1, ddu = 100.0;
+
+    // // every stage that allocates: rate, jerk, fallback
+    PIDConfig full_config(){
+        PIDConfig c{};
+        c.Kp = Kp; c.Ki = {&Ki, 1}; c.Kd = {&Kd, 1};
+        c.umin = lo; c.umax = hi;
+        c.du_max = du; c.ddu_max = {&ddu, 1};
+        c.safe_u = safe; c.fb_ramp_rate = 1.0;
+        return c;
+    }
+
+    Status build(PIDCore& c, MemoryArena& a, const PIDConfig& cfg){
+        if (Status st = c.init(Dims{kNu, kNu, 0}, kDt, a, {}); st != Status::kOK) return st;
+        return c.configure(cfg);
+    }
+
+} // namespace
+
+int main(){
+    alignas(64) static std::byte buf[1 << 16];
+    const PIDConfig cfg = full_config();
+
+    // Case 1: the plan is exact -> fits in plan.bytes, fails one byte short, same used()
+    const ArenaPlan p = plan_controller<PIDCore>(Dims{kNu, kNu, 0}, kDt, cfg);
+    if (p.status != Status::kOK) return 1;
+    if (p.bytes == 0 || p.align != alignof(Scalar)) return 2;
+    {
+        MemoryArena a(buf, p.bytes);
+        PIDCore c;
+        if (build(c, a, cfg) != Status::kOK) return 3;
+        if (a.used() != p.bytes || a.misses() != 0 || a.allocations() != p.blocks) return 4;
+        if (c.start() != Status::kOK) return 5;
+    }
+    {
+        MemoryArena a(buf, p.bytes - 1);
+        PIDCore c;
+        if (build(c, a, cfg) == Status::kOK && a.misses() == 0) return 6;
+    }
+
+    // // a tiny first guess only costs retries
+    const ArenaPlan q = plan_arena([&](MemoryArena& a){ PIDCore c; return build(c, a, cfg); }, 16);
+    if (q.status != Status::kOK || q.bytes != p.bytes || q.blocks != p.blocks) return 7;
+
+    // // setup errors come back as they are
+    const ArenaPlan bad = plan_controller<PIDCore>(Dims{kNu, kNu + 1, 0}, kDt, cfg);
+    if (bad.status != Status::kInvalidArg) return 8;
+
+    // // FixedPIDCore keeps its state inline
+    const ArenaPlan f = plan_controller<FixedPIDCore<kNu>>(Dims{kNu, kNu, 0}, kDt, cfg);
+    if (f.status != Status::kOK || f.bytes != 0 || packed_bytes(f, 100) != 0) return 9;
+
+    // Case 2: one PIDBank + 200 PIDCores packed back to back in one planned region
+    {
+        PIDBankConfig bc{};
+        bc.Kp = Kp; bc.umin = lo; bc.umax = hi;
+        const ArenaPlan pb = plan_arena([&](MemoryArena& a){
+            PIDBank b;
+            if (Status st = b.init(kNu, kDt, a); st != Status::kOK) return st;
+            return b.configure(bc);
+        });
+        if (pb.status != Status::kOK || pb.align != 64) return 10;
+
+        ArenaPlanner plan;
+        plan.add(pb);
+        plan.add(p, 200);
+        if (plan.items() != 201 || plan.align() != 64) return 11;
+        if (plan.bytes() < pb.bytes + packed_bytes(p, 200)) return 12;
+
+        std::vector<std::byte> region(plan.bytes() + 2 * plan.align());
+        auto base = reinterpret_cast<std::uintptr_t>(region.data());
+        base = (base + plan.align() - 1) & ~(static_cast<std::uintptr_t>(plan.align()) - 1u);
+        MemoryArena a(reinterpret_cast<void*>(base), plan.bytes());
+
+        std::vector<ArenaBlock> map(8192);
+        a.set_map(map.data(), map.size());
+
+        PIDBank bank;
+        a.set_owner(1000);
+        if (bank.init(kNu, kDt, a) != Status::kOK || bank.configure(bc) != Status::kOK) return 13;
+        std::vector<PIDCore> loops(200);
+        for (std::size_t i = 0; i < loops.size(); ++i){
+            a.set_owner(static_cast<std::uint32_t>(i));
+            if (build(loops[i], a, cfg) != Status::kOK) return 14;
+        }
+        if (a.misses() != 0 || a.used() > plan.bytes()) return 15;
+
+        // // the map covers [0, used) without gaps or overlaps, every block has its owner and a name
+        const auto m = a.map();
+        if (m.size() != a.allocations() || a.map_dropped() != 0) return 16;
+        std::size_t end = 0;
+        for (const ArenaBlock& b : m){
+            if (b.offset != end + b.pad || b.offset % b.align != 0) return 17;
+            if (!b.label) return 18;
+            end = b.offset + b.bytes;
+        }
+        if (end != a.used()) return 19;
+        if (m.front().owner != 1000 || m.back().owner != 199) return 20;
+        if (std::strcmp(m.back().label, "fallback.u") != 0) return 21;
+
+        // // a full map counts what it could not record
+        std::array<ArenaBlock, 2> small{};
+        MemoryArena b2(buf, sizeof(buf));
+        b2.set_map(small.data(), small.size());
+        PIDCore c;
+        if (build(c, b2, cfg) != Status::kOK) return 22;
+        if (b2.map().size() != 2 || b2.map_dropped() != b2.allocations() - 2) return 23;
+        if (std::strcmp(b2.map()[0].label, "ctl.pre") != 0) return 24;
+    }
+
+    return 0;
+}
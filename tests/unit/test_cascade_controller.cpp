@@ -0,0 +1,247 @@
+// tests/unit/test_cascade_controller.cpp
+#include <bit>
+#include <cmath>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "ictk/core/status.hpp"
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/control/cascade.hpp"
+#include "ictk/control/pid/pid.hpp"
+#include "ictk/control/pid/pid_fixed.hpp"
+#include "util/alloc_interposer.hpp"
+
+using namespace ictk;
+using namespace ictk::control;
+using namespace ictk::control::pid;
+
+namespace{
+
+    constexpr dt_ns kDt = 1'000'000;
+
+    // // outer: position PI -> speed setpoint; inner: speed PI -> force, |u| <= umax
+    Status make_pair(PIDCore& outer, PIDCore& inner, std::uint32_t ratio, Scalar inner_umax, MemoryArena& a){
+        static const Scalar Kp_o = 4.0, Ki_o = 0.02, Kp_i = 2.0, Ki_i = 0.05, zero = 0.0;
+        static Scalar umin_i = 0, umax_i = 0;
+        umin_i = -inner_umax;
+        umax_i = inner_umax;
+
+        const Dims d{1, 1, 0};
+        if (Status st = outer.init(d, kDt * ratio, a, {}); st != Status::kOK) return st;
+        if (Status st = inner.init(d, kDt, a, {}); st != Status::kOK) return st;
+
+        PIDConfig co{};
+        co.Kp = {&Kp_o, 1}; co.Ki = {&Ki_o, 1}; co.Kd = {&zero, 1};
+        co.Kt = 0.5;
+        if (Status st = outer.configure(co); st != Status::kOK) return st;
+
+        PIDConfig ci{};
+        ci.Kp = {&Kp_i, 1}; ci.Ki = {&Ki_i, 1}; ci.Kd = {&zero, 1};
+        ci.umin = {&umin_i, 1}; ci.umax = {&umax_i, 1};
+        ci.Kt = 0.5;
+        return inner.configure(ci);
+    }
+
+    // // double integrator plant: v += b u, x += v dt
+    struct Plant{
+        Scalar x{0}, v{0};
+        void step(Scalar u){
+            v += Scalar(0.05) * u;
+            x += v * Scalar(0.001);
+        }
+    };
+
+    // // inner loop that only records what it was handed
+    class Probe final : public IController{
+        public:
+            [[nodiscard]] Status init(const Dims&, dt_ns, MemoryArena&, const Hooks& = {}) noexcept override{ return Status::kOK; }
+            [[nodiscard]] Status start() noexcept override{ return Status::kOK; }
+            [[nodiscard]] Status stop() noexcept override{ return Status::kOK; }
+            [[nodiscard]] Status reset() noexcept override{ return Status::kOK; }
+            [[nodiscard]] Status update(const UpdateContext& ctx, Result& out) noexcept override{
+                r_seen = ctx.sp.r.data();
+                y_seen = ctx.plant.y.data();
+                u_seen = out.u.data();
+                out.health = {};
+                return Status::kOK;
+            }
+            CommandMode mode() const noexcept override{ return CommandMode::Shadow; }
+            const Scalar* r_seen{nullptr};
+            const Scalar* y_seen{nullptr};
+            const Scalar* u_seen{nullptr};
+    };
+
+    // // outer command after a long stall: the plant does not move, the inner loop sits at its limit
+    double run_stalled(bool track, int& rc){
+        alignas(64) static std::byte buf[1 << 14];
+        MemoryArena arena(buf, sizeof(buf));
+        PIDCore outer, inner;
+        static const Scalar Kp_o = 1.0, Ki_o = 2.0, Kp_i = 2.0, zero = 0.0, lo = -0.05, hi = 0.05;
+
+        const Dims d{1, 1, 0};
+        PIDConfig co{};
+        co.Kp = {&Kp_o, 1}; co.Ki = {&Ki_o, 1}; co.Kd = {&zero, 1};
+        co.Kt = 0.02;
+        PIDConfig ci{};
+        ci.Kp = {&Kp_i, 1}; ci.Ki = {&zero, 1}; ci.Kd = {&zero, 1};
+        ci.umin = {&lo, 1}; ci.umax = {&hi, 1};
+        if (outer.init(d, kDt, arena, {}) != Status::kOK || outer.configure(co) != Status::kOK){ rc = 40; return 0; }
+        if (inner.init(d, kDt, arena, {}) != Status::kOK || inner.configure(ci) != Status::kOK){ rc = 40; return 0; }
+
+        CascadeController c;
+        if (c.init(Dims{2, 1, 0}, kDt, arena) != Status::kOK){ rc = 41; return 0; }
+        CascadeConfig cc{};
+        cc.outer = &outer; cc.inner = &inner;
+        cc.outer_dims = Dims{1, 1, 0}; cc.inner_dims = Dims{1, 1, 0};
+        if (track) cc.track = track_of(outer);
+        if (c.configure(cc) != Status::kOK || c.start() != Status::kOK){ rc = 42; return 0; }
+
+        std::array<Scalar, 2> y{};
+        std::array<Scalar, 1> r{1.0}, u{};
+        UpdateContext ctx{};
+        ctx.plant.y = y;
+        ctx.sp.r = r;
+        Result out{};
+        out.u = u;
+
+        for (int k = 0; k < 3000; ++k){
+            ctx.plant.t = static_cast<t_ns>(k) * kDt;
+            if (c.update(ctx, out) != Status::kOK){ rc = 43; return 0; }
+            if (out.health.sat_hit_mask != 1ull){ rc = 44; return 0; }
+        }
+        return std::abs(static_cast<double>(c.inner_setpoint()[0]));
+    }
+
+} // namespace
+
+int main(){
+    alignas(64) static std::byte buf[1 << 15];
+
+    // Case 1: same numbers as the hand wired pair (tracking off), inner at 1x and 4x the outer rate
+    for (std::uint32_t ratio : {1u, 4u}){
+        MemoryArena arena(buf, sizeof(buf));
+        PIDCore o_ref, i_ref, o, i;
+        if (make_pair(o_ref, i_ref, ratio, 0.8, arena) != Status::kOK) return 1;
+        if (make_pair(o, i, ratio, 0.8, arena) != Status::kOK) return 1;
+        if (o_ref.start() != Status::kOK || i_ref.start() != Status::kOK) return 2;
+
+        CascadeController c;
+        if (c.init(Dims{2, 1, 0}, kDt, arena) != Status::kOK) return 3;
+        CascadeConfig cc{};
+        cc.outer = &o; cc.inner = &i;
+        cc.outer_dims = Dims{1, 1, 0}; cc.inner_dims = Dims{1, 1, 0};
+        cc.ratio = ratio;
+        if (c.configure(cc) != Status::kOK) return 4;
+        if (c.start() != Status::kOK) return 5;
+
+        Plant p_ref, p;
+        std::array<Scalar, 1> r{1.0};
+        std::array<Scalar, 1> yo{}, yi{}, v_ref{}, u_ref{};
+        std::array<Scalar, 2> y{};
+        std::array<Scalar, 1> u{};
+
+        ictk_test::reset_alloc_stats();
+        for (int k = 0; k < 2000; ++k){
+            const t_ns t = static_cast<t_ns>(k) * kDt;
+
+            // // reference: copies between the loops by hand
+            yo[0] = p_ref.x;
+            yi[0] = p_ref.v;
+            if (k % static_cast<int>(ratio) == 0){
+                UpdateContext oc{};
+                oc.plant.y = yo; oc.plant.t = t; oc.sp.r = r;
+                Result orr{};
+                orr.u = v_ref;
+                if (o_ref.update(oc, orr) != Status::kOK) return 6;
+            }
+            UpdateContext ic{};
+            ic.plant.y = yi; ic.plant.t = t; ic.sp.r = v_ref;
+            Result irr{};
+            irr.u = u_ref;
+            if (i_ref.update(ic, irr) != Status::kOK) return 7;
+            p_ref.step(u_ref[0]);
+
+            // // cascade
+            y = {p.x, p.v};
+            UpdateContext ctx{};
+            ctx.plant.y = y; ctx.plant.t = t; ctx.sp.r = r;
+            Result out{};
+            out.u = u;
+            if (c.update(ctx, out) != Status::kOK) return 8;
+            p.step(u[0]);
+
+            if (std::bit_cast<std::uint64_t>(static_cast<double>(u[0])) != std::bit_cast<std::uint64_t>(static_cast<double>(u_ref[0]))) return 9;
+            if (out.health.deadline_miss_count != 0) return 10;
+        }
+        if (ictk_test::new_count() || ictk_test::new_aligned_count()) return 11;
+    }
+
+    // Case 2: zero copy -> the inner loop reads the outer command and the caller's y/u in place
+    {
+        MemoryArena arena(buf, sizeof(buf));
+        PIDCore outer;
+        Probe inner;
+        static const Scalar one = 1.0;
+        if (outer.init(Dims{2, 2, 0}, kDt, arena, {}) != Status::kOK) return 12;
+        PIDConfig co{};
+        co.Kp = {&one, 1};
+        if (outer.configure(co) != Status::kOK) return 12;
+
+        CascadeController c;
+        if (c.init(Dims{4, 3, 0}, kDt, arena) != Status::kOK) return 13;
+        CascadeConfig cc{};
+        cc.outer = &outer; cc.inner = &inner;
+        cc.outer_dims = Dims{2, 2, 0}; cc.inner_dims = Dims{2, 3, 0};
+        if (c.configure(cc) != Status::kOK) return 14;
+        Result idle{};
+        if (c.update(UpdateContext{}, idle) != Status::kNotReady) return 15;
+        if (c.start() != Status::kOK) return 16;
+
+        std::array<Scalar, 4> y{0.1, 0.2, 0.3, 0.4};
+        std::array<Scalar, 2> r{1.0, 2.0};
+        std::array<Scalar, 3> u{};
+        UpdateContext ctx{};
+        ctx.plant.y = y; ctx.sp.r = r;
+        Result out{};
+        out.u = u;
+        if (c.update(ctx, out) != Status::kOK) return 17;
+        if (inner.r_seen != c.inner_setpoint().data()) return 18;
+        if (inner.y_seen != y.data() + 2 || inner.u_seen != u.data()) return 19;
+        if (c.inner_setpoint()[0] != Scalar(0.9) || c.inner_setpoint()[1] != Scalar(1.8)) return 20;
+        if (c.mode() != CommandMode::Shadow) return 21;
+
+        // // wrong caller shapes
+        ctx.sp.r = std::span<const Scalar>(r.data(), 1);
+        if (c.update(ctx, out) != Status::kInvalidArg) return 22;
+
+        // // inconsistent config: inner.ny must be outer.nu; tracking needs inner.nu == inner.ny
+        CascadeController bad;
+        if (bad.init(Dims{5, 3, 0}, kDt, arena) != Status::kOK) return 23;
+        cc.inner_dims = Dims{3, 3, 0};
+        if (bad.configure(cc) != Status::kInvalidArg) return 24;
+        cc.inner_dims = Dims{2, 3, 0};
+        cc.track = track_of(outer);
+        if (c.configure(cc) != Status::kInvalidArg) return 25;
+    }
+
+    // Case 3: inner saturation fed back -> the outer integrator stops winding up
+    {
+        int rc = 0;
+        const double free_cmd = run_stalled(false, rc);
+        if (rc) return rc;
+        const double track_cmd = run_stalled(true, rc);
+        if (rc) return rc;
+        // // free: 1 + 2 * 3 s * 1 = 7; tracked: settles near Ki dt e / Kt = 0.1
+        if (!(free_cmd > 6.0 && track_cmd < 0.5)) return 26;
+    }
+
+    // // every PIDLaw based core (and FixedPIDCore) plugs in as a tracked outer loop
+    {
+        FixedPIDCore<1> f;
+        const CascadeTrack t = track_of(f);
+        if (!t.fn || t.user != &f) return 27;
+    }
+
+    return 0;
+}
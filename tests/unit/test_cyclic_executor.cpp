@@ -0,0 +1,229 @@
+// tests/unit/test_cyclic_executor.cpp
+#include <array>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "ictk/core/status.hpp"
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/runtime/cyclic_executor.hpp"
+#include "util/alloc_interposer.hpp"
+
+using namespace ictk;
+using namespace ictk::runtime;
+
+namespace{
+
+    // // records release spacing; optionally burns time to force overruns or fails like ControllerBase (health untouched)
+    class Probe final : public IController{
+        public:
+            [[nodiscard]] Status init(const Dims& d, dt_ns dt, MemoryArena&, const Hooks& = {}) noexcept override{
+                dims_ = d;
+                dt_ = dt;
+                return Status::kOK;
+            }
+            [[nodiscard]] Status start() noexcept override{ return Status::kOK; }
+            [[nodiscard]] Status stop() noexcept override{ return Status::kOK; }
+            [[nodiscard]] Status reset() noexcept override{ return Status::kOK; }
+
+            [[nodiscard]] Status update(const UpdateContext& ctx, Result& out) noexcept override{
+                if (last_t >= 0 && ctx.plant.t - last_t != dt_) ++gaps;
+                if (first_t < 0) first_t = ctx.plant.t;
+                last_t = ctx.plant.t;
+                ++ticks;
+                if (busy_ns > 0){
+                    const auto t0 = std::chrono::steady_clock::now();
+                    while (std::chrono::steady_clock::now() - t0 < std::chrono::nanoseconds(busy_ns)){}
+                }
+                if (fail) return Status::kDeadlineMiss;
+                out.u[0] = static_cast<Scalar>(ticks);
+                out.health = {};
+                out.health.deadline_miss_count = gaps;
+                return Status::kOK;
+            }
+            CommandMode mode() const noexcept override{ return CommandMode::Primary; }
+
+            Dims dims_{};
+            dt_ns dt_{0};
+            t_ns first_t{-1}, last_t{-1};
+            std::uint64_t ticks{0}, gaps{0};
+            dt_ns busy_ns{0};
+            bool fail{false};
+    };
+
+    struct Loop{
+        Probe ctl{};
+        std::array<Scalar, 1> y{}, r{}, u{};
+        UpdateContext ctx{};
+        Result out{};
+        std::uint64_t actuated{0};
+
+        void bind(dt_ns period, MemoryArena& a){
+            (void)ctl.init(Dims{1, 1, 0}, period, a);
+            ctx.plant.y = y;
+            ctx.sp.r = r;
+            out.u = u;
+        }
+    };
+
+    void count_actuate(const Result&, Status, void* user){
+        ++static_cast<Loop*>(user)->actuated;
+    }
+
+    CyclicTask task_for(Loop& l, dt_ns period, dt_ns wcet = 0){
+        CyclicTask t{};
+        t.ctl = &l.ctl;
+        t.period = period;
+        t.ctx = &l.ctx;
+        t.out = &l.out;
+        t.actuate = &count_actuate;
+        t.user = &l;
+        t.wcet_ns = wcet;
+        return t;
+    }
+
+} // namespace
+
+int main(){
+    constexpr dt_ns kMs = 1'000'000;
+    alignas(64) static std::byte buf[1 << 16];
+
+    // Case 1: mixed rates -> minor = gcd, major = lcm, exact spacing, every release actuated
+    {
+        MemoryArena arena(buf, sizeof(buf));
+        CyclicExecutor ex;
+        if (ex.init(8, arena) != Status::kOK) return 1;
+
+        std::vector<Loop> loops(3);
+        const dt_ns periods[3]{kMs, 10 * kMs, 100 * kMs};
+        for (std::size_t i = 0; i < 3; ++i){
+            loops[i].bind(periods[i], arena);
+            if (ex.add(task_for(loops[i], periods[i])) != Status::kOK) return 2;
+        }
+        if (ex.build() != Status::kOK) return 3;
+        if (ex.stats().minor_ns != kMs || ex.stats().major_ns != 100 * kMs || ex.stats().frames != 100) return 4;
+
+        // // no allocation on the tick path
+        ictk_test::reset_alloc_stats();
+        for (int k = 0; k < 300; ++k) if (ex.step() != Status::kOK) return 5;
+        if (ictk_test::new_count() || ictk_test::new_aligned_count()) return 6;
+
+        for (std::size_t i = 0; i < 3; ++i){
+            const Loop& l = loops[i];
+            const std::uint64_t expect = 300u / static_cast<std::uint64_t>(periods[i] / kMs);
+            if (l.ctl.ticks != expect || l.actuated != expect) return 7;
+            if (l.ctl.gaps != 0) return 8;
+            if (ex.task_stats(i).releases != expect || ex.task_stats(i).overruns != 0) return 9;
+            // // first release = phase
+            if (l.ctl.first_t != static_cast<t_ns>(ex.task_stats(i).phase) * kMs) return 10;
+        }
+    }
+
+    // Case 2: staggering spreads ten 10 ms loops over the ten 1 ms frames
+    {
+        MemoryArena arena(buf, sizeof(buf));
+        CyclicExecutor ex, flat;
+        if (ex.init(16, arena) != Status::kOK || flat.init(16, arena) != Status::kOK) return 11;
+
+        std::vector<Loop> loops(11);
+        loops[0].bind(kMs, arena);
+        if (ex.add(task_for(loops[0], kMs, 50'000)) != Status::kOK) return 12;
+        if (flat.add(task_for(loops[0], kMs, 50'000)) != Status::kOK) return 12;
+        for (std::size_t i = 1; i < 11; ++i){
+            loops[i].bind(10 * kMs, arena);
+            if (ex.add(task_for(loops[i], 10 * kMs, 100'000)) != Status::kOK) return 13;
+            if (flat.add(task_for(loops[i], 10 * kMs, 100'000)) != Status::kOK) return 13;
+        }
+        if (ex.build() != Status::kOK || flat.build(false) != Status::kOK) return 14;
+
+        if (ex.stats().max_frame_load != 150'000) return 15;
+        if (flat.stats().max_frame_load != 1'050'000) return 16;
+        for (std::uint32_t f = 0; f < ex.stats().frames; ++f){
+            if (ex.frame_load(f) != 150'000) return 17;
+        }
+    }
+
+    // Case 3: argument and lifecycle errors
+    {
+        MemoryArena arena(buf, sizeof(buf));
+        CyclicExecutor ex;
+        Loop l;
+        l.bind(kMs, arena);
+        if (ex.add(task_for(l, kMs)) != Status::kPreconditionFail) return 18;
+        if (ex.init(2, arena) != Status::kOK) return 19;
+        if (ex.step() != Status::kNotReady) return 20;
+        if (ex.build() != Status::kNotReady) return 21;
+        if (ex.add(task_for(l, 0)) != Status::kInvalidArg) return 22;
+        CyclicTask no_ctx = task_for(l, kMs);
+        no_ctx.ctx = nullptr;
+        if (ex.add(no_ctx) != Status::kInvalidArg) return 23;
+
+        // // coprime periods blow the major cycle up -> rejected
+        if (ex.add(task_for(l, 65'537)) != Status::kOK) return 24;
+        if (ex.add(task_for(l, 65'539)) != Status::kOK) return 25;
+        if (ex.add(task_for(l, kMs)) != Status::kNoMem) return 26;
+        if (ex.build() != Status::kInvalidArg) return 27;
+    }
+
+#if defined(__linux__)
+    // Case 4: clocked run; a loop that takes 3 frames overruns, the skipped frames show up as gaps
+    {
+        MemoryArena arena(buf, sizeof(buf));
+        CyclicExecutor ex;
+        if (ex.init(2, arena) != Status::kOK) return 28;
+
+        std::vector<Loop> loops(2);
+        loops[0].bind(kMs, arena);
+        loops[1].bind(2 * kMs, arena);
+        loops[1].ctl.busy_ns = 3 * kMs;
+        if (ex.add(task_for(loops[0], kMs)) != Status::kOK) return 29;
+        if (ex.add(task_for(loops[1], 2 * kMs)) != Status::kOK) return 29;
+        if (ex.build() != Status::kOK) return 30;
+
+        if (ex.run(20) != Status::kOK) return 31;
+        if (ex.stats().frames_run != 20) return 32;
+        if (ex.stats().frames_skipped == 0) return 33;
+        if (ex.task_stats(1).overruns == 0) return 34;
+        if (loops[1].out.health.deadline_miss_count < ex.task_stats(1).overruns) return 35;
+        if (loops[0].ctl.gaps == 0) return 36;
+        if (ex.stats().worst_frame_ns < 3 * kMs) return 37;
+        if (loops[1].out.update_ns < 3 * kMs || loops[0].out.update_ns <= 0) return 51;
+    }
+
+    // Case 5: executor thread
+    {
+        MemoryArena arena(buf, sizeof(buf));
+        CyclicExecutor ex;
+        if (ex.init(1, arena) != Status::kOK) return 38;
+        Loop l;
+        l.bind(kMs, arena);
+        if (ex.add(task_for(l, kMs)) != Status::kOK) return 39;
+        if (ex.build() != Status::kOK) return 40;
+        if (ex.start(RtOptions{0, 0}) != Status::kOK) return 41;
+        if (ex.start() != Status::kPreconditionFail) return 42;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        if (ex.stop() != Status::kOK) return 43;
+        if (ex.running() || l.ctl.ticks == 0 || l.actuated != l.ctl.ticks) return 44;
+    }
+
+    // Case 6: a late controller that fails -> its unrefreshed health gets no overruns added (counted once, as errors)
+    {
+        MemoryArena arena(buf, sizeof(buf));
+        CyclicExecutor ex;
+        if (ex.init(1, arena) != Status::kOK) return 45;
+        Loop l;
+        l.bind(kMs, arena);
+        l.ctl.busy_ns = 2 * kMs;
+        l.ctl.fail = true;
+        if (ex.add(task_for(l, kMs)) != Status::kOK) return 46;
+        if (ex.build() != Status::kOK) return 47;
+        if (ex.run(10) != Status::kOK) return 48;
+        const auto& ts = ex.task_stats(0);
+        if (ts.overruns == 0 || ts.errors != ts.releases) return 49;
+        if (l.out.health.deadline_miss_count != 0) return 50;
+    }
+#endif
+
+    return 0;
+}
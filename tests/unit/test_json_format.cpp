@@ -0,0 +1,82 @@
+// tests/unit/test_json_format.cpp
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <string_view>
+
+#include "ictk/io/json_format.hpp"
+#include "util/alloc_interposer.hpp"
+
+using namespace ictk;
+
+namespace{
+
+    std::string_view real(char* buf, double v){
+        return {buf, static_cast<std::size_t>(jsonfmt::put_real(buf, v) - buf)};
+    }
+
+    // // text -> the same bits
+    bool round_trips(double v){
+        char buf[jsonfmt::kMaxReal];
+        const std::string_view s = real(buf, v);
+        if (s.size() > jsonfmt::kMaxReal) return false;
+        double back = 0.0;
+        const auto r = std::from_chars(s.data(), s.data() + s.size(), back);
+        if (r.ec != std::errc{} || r.ptr != s.data() + s.size()) return false;
+        return std::bit_cast<std::uint64_t>(back) == std::bit_cast<std::uint64_t>(v == 0.0 ? 0.0 : v);
+    }
+
+} // namespace
+
+int main(){
+    char buf[64];
+
+    // Case 1: shortest text for the usual values, no "%.9g" truncation
+    if (real(buf, 0.1) != "0.1") return 1;
+    if (real(buf, 1.0) != "1") return 1;
+    if (real(buf, 0.30000000000000004) != "0.30000000000000004") return 2;
+    if (real(buf, 123456789.123456789) != "123456789.12345679") return 2;
+    if (real(buf, -0.0) != "0") return 3;
+    if (real(buf, std::numeric_limits<double>::quiet_NaN()) != "null") return 4;
+    if (real(buf, -std::numeric_limits<double>::infinity()) != "null") return 4;
+
+    // Case 2: every double round trips, the worst case fits kMaxReal, no allocation
+    for (double v : {std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+                     std::numeric_limits<double>::min(), std::numeric_limits<double>::denorm_min(),
+                     -2.2250738585072014e-308, 1e21, 1e-7}){
+        if (!round_trips(v)) return 5;
+    }
+    std::mt19937_64 rng(42);
+    ictk_test::reset_alloc_stats();
+    for (int i = 0; i < 200000; ++i){
+        const double v = std::bit_cast<double>(rng());
+        if (std::isfinite(v) && !round_trips(v)) return 6;
+    }
+    if (ictk_test::new_count() != 0) return 7;
+
+    // Case 3: integers, extremes
+    std::string s;
+    jsonfmt::append_u64(s, std::numeric_limits<std::uint64_t>::max());
+    s += ',';
+    jsonfmt::append_i64(s, std::numeric_limits<std::int64_t>::min());
+    s += ',';
+    jsonfmt::append_u64(s, 0);
+    if (s != "18446744073709551615,-9223372036854775808,0") return 8;
+
+    // Case 4: deterministic -> same value, same bytes
+    {
+        char a[jsonfmt::kMaxReal], b[jsonfmt::kMaxReal];
+        for (int i = 0; i < 1000; ++i){
+            const double v = 1.0 / (i + 3);
+            if (real(a, v) != real(b, v)) return 9;
+        }
+    }
+
+    if (std::string_view(buf, static_cast<std::size_t>(jsonfmt::put_bool(buf, true) - buf)) != "true") return 10;
+    return 0;
+}
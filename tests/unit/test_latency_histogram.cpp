@@ -0,0 +1,93 @@
+// tests/unit/test_latency_histogram.cpp
+#include <cmath>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "ictk/io/latency_histogram.hpp"
+#include "util/alloc_interposer.hpp"
+
+using namespace ictk;
+
+namespace{
+
+    // // exact order statistic with the same rank rule as quantile(): ceil(q * n)
+    std::uint64_t exact(const std::vector<std::uint64_t>& sorted, double q){
+        auto rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(sorted.size())));
+        if (rank == 0) rank = 1;
+        return sorted[rank - 1];
+    }
+
+    bool within(std::uint64_t got, std::uint64_t want, double rel){
+        const double d = std::abs(static_cast<double>(got) - static_cast<double>(want));
+        return d <= rel * static_cast<double>(want) + 1.0;
+    }
+
+} // namespace
+
+int main(){
+    using H = LatencyHistogram;
+
+    // Case 1: layout -> contiguous buckets, every value maps into [lowest_of, highest_of], width <= 1/128 of the edge
+    if (H::kBuckets > 4096) return 1;
+    for (std::size_t i = 1; i < H::kBuckets; ++i){
+        if (H::lowest_of(i) != H::highest_of(i - 1) + 1) return 2;
+        if (H::index_of(H::lowest_of(i)) != i || H::index_of(H::highest_of(i)) != i) return 2;
+        const double w = static_cast<double>(H::highest_of(i) - H::lowest_of(i) + 1);
+        if (i >= 256 && w > static_cast<double>(H::lowest_of(i)) / 128.0) return 3;
+    }
+    if (H::index_of(H::kHighestNs) != H::kBuckets - 1) return 4;
+
+    // Case 2: ~1 % quantiles over 10 ns .. 10 s against the sorted samples; record() never allocates
+    static H h;
+    std::vector<std::uint64_t> xs;
+    xs.reserve(200000);
+    std::mt19937_64 rng(7);
+    std::lognormal_distribution<double> lat(std::log(20'000.0), 1.5);   // ~20 us median, long tail
+    for (int i = 0; i < 200000; ++i){
+        const double v = std::clamp(lat(rng), 10.0, 1e10);
+        xs.push_back(static_cast<std::uint64_t>(v));
+    }
+    ictk_test::reset_alloc_stats();
+    for (std::uint64_t v : xs) h.record(v);
+    if (ictk_test::new_count() || ictk_test::new_aligned_count()) return 5;
+
+    std::vector<std::uint64_t> sorted = xs;
+    std::sort(sorted.begin(), sorted.end());
+    for (double q : {0.001, 0.1, 0.5, 0.9, 0.95, 0.99, 0.999, 0.9999}){
+        if (!within(h.quantile(q), exact(sorted, q), 0.01)) return 6;
+    }
+    if (h.count() != xs.size() || h.min() != sorted.front() || h.max() != sorted.back()) return 7;
+    if (h.quantile(1.0) != h.max() || h.quantile(0.0) != h.min()) return 7;
+
+    // Case 3: merge of per thread halves == one histogram of everything
+    {
+        static H a, b;
+        for (std::size_t i = 0; i < xs.size(); ++i) (i % 2 ? a : b).record(xs[i]);
+        a.merge(b);
+        if (a.count() != h.count() || a.min() != h.min() || a.max() != h.max() || a.mean() != h.mean()) return 8;
+        for (std::size_t i = 0; i < H::kBuckets; ++i){
+            if (a.bucket(i) != h.bucket(i)) return 9;
+        }
+    }
+
+    // Case 4: above the range -> last bucket + saturated(), max stays exact; reset() empties
+    {
+        static H s;
+        s.record(1000);
+        s.record(3 * H::kHighestNs);
+        if (s.saturated() != 1 || s.max() != 3 * H::kHighestNs) return 10;
+        if (s.quantile(0.99) != 3 * H::kHighestNs) return 10;
+        s.reset();
+        if (s.count() != 0 || s.quantile(0.5) != 0 || s.max() != 0 || s.min() != 0) return 11;
+    }
+
+    // Case 5: small values are exact
+    {
+        static H e;
+        for (std::uint64_t v = 0; v < 256; ++v) e.record(v);
+        if (e.quantile(0.5) != 127 || e.quantile(0.99) != 253) return 12;
+    }
+    return 0;
+}
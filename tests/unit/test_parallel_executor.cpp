@@ -0,0 +1,242 @@
+// tests/unit/test_parallel_executor.cpp
+#include <bit>
+#include <cmath>
+#include <array>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "ictk/core/status.hpp"
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/control/pid/pid.hpp"
+#include "ictk/runtime/parallel_executor.hpp"
+
+using namespace ictk;
+using namespace ictk::runtime;
+using namespace ictk::control::pid;
+
+namespace{
+
+    constexpr dt_ns kDt = 1'000'000;
+    constexpr std::size_t kLoops = 1500;
+    constexpr int kTicks = 200;
+
+    // // one loop: controller + I/O + a running hash of every command it produced
+    struct Loop{
+        PIDCore ctl{};
+        std::size_t idx{0};
+        Scalar y{0}, r{1}, u{0};
+        UpdateContext ctx{};
+        Result out{};
+        std::uint64_t hash{0};
+        std::uint64_t misses{0};
+    };
+
+    void sense(UpdateContext& ctx, void* user){
+        auto* l = static_cast<Loop*>(user);
+        const double t = static_cast<double>(ctx.plant.t) * 1e-9;
+        l->y = static_cast<Scalar>(std::sin(40.0 * t + static_cast<double>(l->idx)));
+        l->r = static_cast<Scalar>(0.5 + 0.001 * static_cast<double>(l->idx % 97));
+    }
+
+    void actuate(const Result& out, Status st, void* user){
+        auto* l = static_cast<Loop*>(user);
+        const auto bits = std::bit_cast<std::uint64_t>(static_cast<double>(out.u[0]));
+        l->hash = std::rotl(l->hash, 7) ^ bits ^ static_cast<std::uint64_t>(st);
+        l->misses = out.health.deadline_miss_count;
+    }
+
+    bool setup(Loop& l, std::size_t i, MemoryArena& a){
+        static const Scalar Kd = 0.05, tf = 0.01, umin = -0.8, umax = 0.8, du = 50.0;
+        static std::array<Scalar, kLoops> Kp{}, Ki{};
+        Kp[i] = static_cast<Scalar>(1.0 + 0.002 * static_cast<double>(i));
+        Ki[i] = static_cast<Scalar>(0.3 + 0.001 * static_cast<double>(i % 13));
+
+        PIDConfig c{};
+        c.Kp = {&Kp[i], 1}; c.Ki = {&Ki[i], 1}; c.Kd = {&Kd, 1}; c.tau_f = {&tf, 1};
+        c.umin = {&umin, 1}; c.umax = {&umax, 1}; c.du_max = {&du, 1};
+
+        l.idx = i;
+        if (l.ctl.init(Dims{1, 1, 0}, kDt, a, {}) != Status::kOK) return false;
+        if (l.ctl.configure(c) != Status::kOK) return false;
+        if (l.ctl.start() != Status::kOK) return false;
+        l.ctx.plant.y = std::span<const Scalar>(&l.y, 1);
+        l.ctx.plant.valid_bits = 1ull;
+        l.ctx.sp.r = std::span<const Scalar>(&l.r, 1);
+        l.out.u = std::span<Scalar>(&l.u, 1);
+        return true;
+    }
+
+    CyclicTask task_for(Loop& l){
+        CyclicTask t{};
+        t.ctl = &l.ctl;
+        t.ctx = &l.ctx;
+        t.out = &l.out;
+        t.sense = &sense;
+        t.actuate = &actuate;
+        t.user = &l;
+        return t;
+    }
+
+    // // sleeps inside update() -> its worker falls behind and the others must steal
+    class Sleeper final : public IController{
+        public:
+            [[nodiscard]] Status init(const Dims&, dt_ns, MemoryArena&, const Hooks& = {}) noexcept override{ return Status::kOK; }
+            [[nodiscard]] Status start() noexcept override{ return Status::kOK; }
+            [[nodiscard]] Status stop() noexcept override{ return Status::kOK; }
+            [[nodiscard]] Status reset() noexcept override{ return Status::kOK; }
+            [[nodiscard]] Status update(const UpdateContext&, Result& out) noexcept override{
+                std::this_thread::sleep_for(std::chrono::microseconds(sleep_us));
+                out.health = {};
+                return Status::kOK;
+            }
+            CommandMode mode() const noexcept override{ return CommandMode::Primary; }
+            int sleep_us{0};
+    };
+
+} // namespace
+
+int main(){
+    // // reference: every loop on this thread, plain update() calls
+    std::vector<std::unique_ptr<Loop>> ref;
+    std::vector<std::byte> ref_mem(kLoops * 1024 + 4096);
+    MemoryArena ref_arena(ref_mem.data(), ref_mem.size());
+    for (std::size_t i = 0; i < kLoops; ++i){
+        ref.push_back(std::make_unique<Loop>());
+        if (!setup(*ref.back(), i, ref_arena)) return 1;
+    }
+    for (int k = 0; k < kTicks; ++k){
+        for (auto& l : ref){
+            l->ctx.plant.t = static_cast<t_ns>(k) * kDt;
+            sense(l->ctx, l.get());
+            const Status st = l->ctl.update(l->ctx, l->out);
+            actuate(l->out, st, l.get());
+        }
+    }
+
+    // Case 1: same bits for 1 worker and for 4 workers with small shards
+    for (std::size_t workers : {std::size_t{1}, std::size_t{4}}){
+        std::vector<std::vector<std::byte>> mem(workers, std::vector<std::byte>(kLoops * 1024 / workers + 8192));
+        std::vector<std::unique_ptr<MemoryArena>> arenas;
+        std::vector<MemoryArena*> arena_ptrs;
+        for (auto& m : mem){
+            arenas.push_back(std::make_unique<MemoryArena>(m.data(), m.size()));
+            arena_ptrs.push_back(arenas.back().get());
+        }
+        std::vector<std::byte> tab(kLoops * 128 + 8192);
+        MemoryArena tab_arena(tab.data(), tab.size());
+
+        ParallelOptions opts{};
+        opts.workers = workers;
+        opts.shard_tasks = 16;
+
+        ParallelExecutor ex;
+        if (ex.init(kDt, kLoops, opts, tab_arena, arena_ptrs) != Status::kOK) return 2;
+
+        std::vector<std::unique_ptr<Loop>> loops;
+        for (std::size_t i = 0; i < kLoops; ++i){
+            loops.push_back(std::make_unique<Loop>());
+            if (!setup(*loops.back(), i, ex.arena_for(ex.next_id()))) return 3;
+            if (ex.add(task_for(*loops.back())) != Status::kOK) return 4;
+        }
+        if (ex.build() != Status::kOK) return 5;
+        if (workers > 1 && ex.tick() != Status::kNotReady) return 6;
+        if (ex.start() != Status::kOK) return 7;
+        for (int k = 0; k < kTicks; ++k) if (ex.tick() != Status::kOK) return 8;
+        if (ex.stop() != Status::kOK) return 9;
+
+        for (std::size_t i = 0; i < kLoops; ++i){
+            if (loops[i]->hash != ref[i]->hash) return 10;
+            if (std::bit_cast<std::uint64_t>(static_cast<double>(loops[i]->u)) != std::bit_cast<std::uint64_t>(static_cast<double>(ref[i]->u))) return 11;
+            if (loops[i]->misses != 0) return 12;
+        }
+
+        std::uint64_t tasks = 0;
+        for (std::size_t w = 0; w < workers; ++w){
+            if (ex.worker_stats(w).ticks != static_cast<std::uint64_t>(kTicks)) return 13;
+            tasks += ex.worker_stats(w).tasks_run;
+        }
+        if (tasks != static_cast<std::uint64_t>(kLoops) * kTicks) return 14;
+        if (ex.stats().ticks != static_cast<std::uint64_t>(kTicks)) return 15;
+    }
+
+    // Case 2: worker 1's loops sleep -> the other workers steal its shards
+    {
+        constexpr std::size_t W = 3, N = 24;
+        std::array<std::array<std::byte, 1024>, W> mem{};
+        std::array<std::unique_ptr<MemoryArena>, W> arenas;
+        std::array<MemoryArena*, W> arena_ptrs{};
+        for (std::size_t w = 0; w < W; ++w){
+            arenas[w] = std::make_unique<MemoryArena>(mem[w].data(), mem[w].size());
+            arena_ptrs[w] = arenas[w].get();
+        }
+        std::array<std::byte, 8192> tab{};
+        MemoryArena tab_arena(tab.data(), tab.size());
+
+        ParallelOptions opts{};
+        opts.workers = W;
+        opts.shard_tasks = 1;
+
+        ParallelExecutor ex;
+        if (ex.init(kDt, N, opts, tab_arena, arena_ptrs) != Status::kOK) return 16;
+
+        std::array<Sleeper, N> ctl{};
+        std::array<std::array<Scalar, 1>, N> y{}, u{};
+        std::array<UpdateContext, N> ctx{};
+        std::array<Result, N> out{};
+        for (std::size_t i = 0; i < N; ++i){
+            ctl[i].sleep_us = (i % W == 1) ? 1000 : 0;
+            ctx[i].plant.y = y[i];
+            out[i].u = u[i];
+            CyclicTask t{};
+            t.ctl = &ctl[i];
+            t.ctx = &ctx[i];
+            t.out = &out[i];
+            if (ex.add(t) != Status::kOK) return 17;
+        }
+        if (ex.build() != Status::kOK) return 18;
+        if (ex.stats().shards != N) return 19;
+        if (ex.start() != Status::kOK) return 20;
+        for (int k = 0; k < 3; ++k) if (ex.tick() != Status::kOK) return 21;
+        if (ex.stop() != Status::kOK) return 22;
+
+        std::uint64_t steals = 0, shards = 0;
+        for (std::size_t w = 0; w < W; ++w){
+            steals += ex.worker_stats(w).steals;
+            shards += ex.worker_stats(w).shards_run;
+        }
+        if (shards != 3 * N) return 23;
+        if (steals == 0) return 24;
+        if (ex.worker_stats(1).utilization(kDt) <= 0.0) return 25;
+    }
+
+    // Case 3: argument errors
+    {
+        std::array<std::byte, 4096> tab{};
+        MemoryArena tab_arena(tab.data(), tab.size());
+        MemoryArena* none[1]{nullptr};
+        ParallelOptions opts{};
+        ParallelExecutor ex;
+        if (ex.init(kDt, 4, opts, tab_arena, std::span<MemoryArena* const>(none, 1)) != Status::kInvalidArg) return 26;
+        opts.workers = 2;
+        MemoryArena* one[1]{&tab_arena};
+        if (ex.init(kDt, 4, opts, tab_arena, std::span<MemoryArena* const>(one, 1)) != Status::kInvalidArg) return 27;
+        opts.workers = 1;
+        if (ex.init(kDt, 4, opts, tab_arena, std::span<MemoryArena* const>(one, 1)) != Status::kOK) return 28;
+        if (ex.build() != Status::kNotReady) return 29;
+        Sleeper s;
+        Scalar y[1]{}, u[1]{};
+        UpdateContext c{};
+        c.plant.y = y;
+        Result o{};
+        o.u = u;
+        CyclicTask t{};
+        t.ctl = &s; t.ctx = &c; t.out = &o; t.period = 2 * kDt;
+        if (ex.add(t) != Status::kInvalidArg) return 30;
+    }
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+// tests/unit/test_stage_timing.cpp
+// // built with ICTK_STAGE_TIMING=1 on this target only (ControllerBase is header only, the ictk lib does not include it)
+#include <array>
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+
+#include "ictk/core/status.hpp"
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/core/stage_timing.hpp"
+#include "ictk/control/pid/pid.hpp"
+#include "util/alloc_interposer.hpp"
+
+#if !ICTK_STAGE_TIMING
+    #error "test_stage_timing needs ICTK_STAGE_TIMING=1"
+#endif
+
+using namespace ictk;
+using namespace ictk::control::pid;
+
+namespace{
+
+    constexpr dt_ns kDt = 1'000'000;
+    constexpr std::size_t kNu = 2;
+    constexpr std::uint64_t kTicks = 2000;
+
+    const std::array<Scalar, kNu> Kp{2.0, 3.0}, lo{-1.0, -1.0}, hi{1.0, 1.0}, du{5.0, 5.0};
+    const Scalar Ki = 1.0, ddu = 200.0;
+
+    PIDConfig config(){
+        PIDConfig c{};
+        c.Kp = Kp; c.Ki = {&Ki, 1};
+        c.umin = lo; c.umax = hi;
+        c.du_max = du; c.ddu_max = {&ddu, 1};
+        return c;
+    }
+
+    struct Loop{
+        std::array<Scalar, kNu> y{0.0, 0.0}, r{1.0, -1.0}, u{0.0, 0.0};
+        UpdateContext ctx{};
+        Result out{};
+        t_ns t{0};
+
+        Status tick(PIDCore& c) noexcept{
+            ctx.plant.y = y;
+            ctx.plant.t = t;
+            ctx.plant.valid_bits = 0b11;
+            ctx.sp.r = r;
+            out.u = u;
+            const Status st = c.update(ctx, out);
+            for (std::size_t i = 0; i < kNu; ++i) y[i] += Scalar(0.05) * (u[i] - y[i]);
+            t += kDt;
+            return st;
+        }
+    };
+
+    // // count / min / max / sum / histogram agree with each other
+    bool consistent(const StageSnapshot& s, std::uint64_t count){
+        if (s.count != count) return false;
+        if (count == 0) return s.sum == 0 && s.max == 0;
+        std::uint64_t h = 0;
+        for (std::uint64_t b : s.hist) h += b;
+        if (h != count) return false;
+        if (s.min > s.max || s.sum < s.max) return false;
+        const std::uint64_t p50 = s.quantile(0.5), p99 = s.quantile(0.99);
+        return p50 <= p99 && p99 <= s.max;
+    }
+
+} // namespace
+
+int main(){
+    alignas(64) static std::byte buf[1 << 14];
+    MemoryArena arena(buf, sizeof(buf));
+    PIDCore c;
+    if (c.init(Dims{kNu, kNu, 0}, kDt, arena, {}) != Status::kOK) return 1;
+    if (c.configure(config()) != Status::kOK) return 1;
+    if (c.start() != Status::kOK) return 1;
+
+    static StageTimes times;
+    Loop L;
+
+    // Case 1: staged chain -> every stage but kFused once per tick, no allocation on the way
+    c.set_stage_timing(&times);
+    ictk_test::reset_alloc_stats();
+    for (std::uint64_t k = 0; k < kTicks; ++k){
+        if (L.tick(c) != Status::kOK) return 2;
+    }
+    if (ictk_test::new_count() || ictk_test::new_aligned_count()) return 3;
+
+    for (Stage s : {Stage::kCore, Stage::kPreClamp, Stage::kSaturation, Stage::kRate, Stage::kJerk,
+                    Stage::kAntiWindup, Stage::kPostArbitrate, Stage::kTotal}){
+        if (!consistent(times.read(s), kTicks)) return 4;
+    }
+    if (!consistent(times.read(Stage::kFused), 0)) return 5;
+
+    // // total spans every stage of the same tick
+    {
+        const StageSnapshot tot = times.read(Stage::kTotal);
+        std::uint64_t parts = 0;
+        for (Stage s : {Stage::kCore, Stage::kSaturation, Stage::kRate, Stage::kJerk, Stage::kAntiWindup}) parts += times.read(s).sum;
+        if (tot.sum < parts) return 6;
+    }
+
+    // Case 2: fused chain -> kFused replaces the three staged sweeps
+    times.clear();
+    c.set_safety_chain(SafetyChainMode::kFused);
+    for (std::uint64_t k = 0; k < kTicks; ++k){
+        if (L.tick(c) != Status::kOK) return 7;
+    }
+    if (!consistent(times.read(Stage::kFused), kTicks)) return 8;
+    if (!consistent(times.read(Stage::kCore), kTicks)) return 8;
+    for (Stage s : {Stage::kSaturation, Stage::kRate, Stage::kJerk}){
+        if (times.read(s).count != 0) return 9;
+    }
+
+    // Case 3: detached -> nothing recorded
+    c.set_stage_timing(nullptr);
+    for (std::uint64_t k = 0; k < 100; ++k){
+        if (L.tick(c) != Status::kOK) return 10;
+    }
+    if (times.read(Stage::kTotal).count != kTicks) return 11;
+
+    // Case 4: a reader thread polls while the loop ticks -> counts never go backwards, no lock on either side
+    times.clear();
+    c.set_stage_timing(&times);
+    std::atomic<bool> done{false};
+    std::atomic<int> bad{0};
+    std::thread reader([&]{
+        std::uint64_t last = 0;
+        while (!done.load(std::memory_order_acquire)){
+            const StageSnapshot s = times.read(Stage::kTotal);
+            if (s.count < last) bad.store(1, std::memory_order_relaxed);
+            last = s.count;
+        }
+    });
+    for (std::uint64_t k = 0; k < kTicks; ++k){
+        if (L.tick(c) != Status::kOK){ done.store(true); reader.join(); return 12; }
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+    if (bad.load() != 0) return 13;
+    if (!consistent(times.read(Stage::kTotal), kTicks)) return 14;
+
+    // // clock sanity: monotonic, positive rate
+    if (stage_clock_per_ns() <= 0.0) return 15;
+    return 0;
+}
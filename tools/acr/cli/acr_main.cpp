@@ -0,0 +1,76 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+
+#include "ictk/tools/acr/ingest.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk::tools::acr;
+
+// // Single stderr print flags
+static void usage(){
+    std::fprintf(
+        stderr,
+        "acr [--out <report.json>] [--stream-buffer-kb 8192] [--threads N] [--cache <file>] [--asset-id <str>] [--controller-id <str>] "
+        "[--allow-buildinfo-conflict] <segment|dir>...\n"
+        "segments: .jsonl (RecorderJsonl); a directory adds its .jsonl files in name order\n"
+    );
+}
+
+int main(int argc, char** argv){
+    IngestConfig cfg;
+    const char* out = nullptr;
+
+    for (int i = 1; i < argc; i++){
+        if (!std::strcmp(argv[i], "--out") && i+1<argc) out = argv[++i];
+        else if (!std::strcmp(argv[i], "--stream-buffer-kb") && i+1<argc){
+            const long kb = std::atol(argv[++i]);
+            if (kb > 0) cfg.stream_buffer_bytes = static_cast<std::size_t>(kb) * 1024u;
+        }
+        else if (!std::strcmp(argv[i], "--threads") && i+1<argc){
+            const long t = std::atol(argv[++i]);
+            if (t > 0) cfg.threads = static_cast<std::size_t>(t);
+        }
+        else if (!std::strcmp(argv[i], "--cache") && i+1<argc) cfg.cache_path = argv[++i];
+        else if (!std::strcmp(argv[i], "--asset-id") && i+1<argc) cfg.asset_id_filter = argv[++i];
+        else if (!std::strcmp(argv[i], "--controller-id") && i+1<argc) cfg.controller_id_filter = argv[++i];
+        else if (!std::strcmp(argv[i], "--allow-buildinfo-conflict")) cfg.fail_on_buildinfo_conflict = false;
+        else if (argv[i][0] == '-'){
+            usage();
+            return 2;
+        }
+        else if (fs::is_directory(argv[i])){
+            // name order: recorder segment names carry the UTC open time
+            std::vector<fs::path> seg;
+            std::error_code ec;
+            for (const auto& e : fs::directory_iterator(argv[i], ec)){
+                if (e.path().extension() == ".jsonl") seg.push_back(e.path());
+            }
+            std::sort(seg.begin(), seg.end());
+            cfg.mcap_paths.insert(cfg.mcap_paths.end(), seg.begin(), seg.end());
+        }
+        else cfg.mcap_paths.emplace_back(argv[i]);
+    }
+    if (cfg.mcap_paths.empty()){
+        usage();
+        return 2;
+    }
+
+    Report rep;
+    const ExitCode rc = ingest(cfg, rep);
+    const std::string j = to_json(rep);
+
+    std::FILE* f = out ? std::fopen(out, "wb") : stdout;
+    if (!f){
+        std::fprintf(stderr, "acr: cannot write '%s'\n", out);
+        return to_int(ExitCode::kOpenFail);
+    }
+    std::fwrite(j.data(), 1, j.size(), f);
+    std::fputc('\n', f);
+    if (out) std::fclose(f);
+    return to_int(rc);
+}
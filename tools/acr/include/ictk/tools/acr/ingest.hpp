@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+
+#include "ictk/tools/acr/report.hpp"
+#include "ictk/tools/acr/exit_codes.hpp"
+#include "ictk/tools/acr/ingest_config.hpp"
+
+namespace ictk::tools::acr{
+    /// @brief stream every segment of cfg.mcap_paths into rep (per file entries, merged counts, buildinfo)
+    ///     segments are hashed + parsed on cfg.threads workers and reduced in path order -> rep does not depend on it
+    /// @param cfg inputs, filters, the stream window (stream_buffer_bytes) and the worker count (threads)
+    /// @param rep filled as far as the audit got, also on failure
+    /// @return kOk, or the first failure (open / stream / missing fields / hash mismatch / buildinfo conflict)
+    [[nodiscard]] ExitCode ingest(const IngestConfig& cfg, Report& rep);
+
+    /// @brief deterministic JSON: fixed key order, shortest round trip numbers
+    [[nodiscard]] std::string to_json(const Report& rep);
+
+} // namespace ictk::tools::acr
@@ -24,7 +24,7 @@ namespace ictk::tools::acr{
     /// @brief Configuration options: settings -> tells how ACR reads and checks data
     struct IngestConfig{
         // // Inputs
-        // list of MCAP log files to ingest
+        // list of evidence segments to ingest: .mcap (MCAP builds) or .jsonl (RecorderJsonl)
         std::vector<std::filesystem::path> mcap_paths;
 
         /// (optional -> can run without these)
@@ -63,9 +63,16 @@ namespace ictk::tools::acr{
         // soft cap on how many rows to keep in memory
         std::size_t max_rows_hint{0};
 
-        // size of memory I/O (8MB)
+        // size of memory I/O (8MB): bytes of a segment mapped / buffered at once, bounds a reader's memory
         std::size_t stream_buffer_bytes{8u * 1024u * 1024u};
 
+        // segments hashed + parsed at once (one window each); 0 -> one per hardware thread
+        std::size_t threads{0};
+
+        // per segment result cache: a segment whose path, size, mtime (and sidecar payload hash) are unchanged since the
+        // last run is not read again -> a re-audit of a growing directory scans only the new segments
+        std::optional<std::filesystem::path> cache_path;
+
         // reserve space for future
         std::uint32_t _reserved0{0};
     };
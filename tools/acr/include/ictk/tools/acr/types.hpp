@@ -17,6 +17,11 @@ namespace ictk::tools::acr{
         UNKNOWN = 244
     };
 
+    // // CanonicalRow::flags
+    inline constexpr std::uint32_t kRowFallback = 1u << 0;    // health: fallback_active
+    inline constexpr std::uint32_t kRowNovelty  = 1u << 1;    // health: novelty_flag
+    inline constexpr std::uint32_t kRowHealth   = 1u << 2;    // a health record was paired with the tick
+
     // // Per tick canonical row 
     struct CanonicalRow{
         // MCAP timestamp
@@ -0,0 +1,171 @@
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <system_error>
+
+#include "cache.hpp"
+
+#if !defined(_WIN32)
+    #include <sys/stat.h>
+#endif
+
+namespace ictk::tools::acr::cache{
+
+    namespace{
+        constexpr char kMagic[8] = {'I', 'C', 'T', 'K', 'A', 'C', 'R', 'C'};
+        constexpr std::uint32_t kFormat = 2;
+
+        // // writer: scalars as their bytes, strings as u64 length + bytes
+        struct Put{
+            std::string& o;
+
+            template <class T>
+            void operator()(const T& v){
+                static_assert(std::is_trivially_copyable_v<T>);
+                o.append(reinterpret_cast<const char*>(&v), sizeof(T));
+            }
+
+            void operator()(const std::string& v){
+                (*this)(static_cast<std::uint64_t>(v.size()));
+                o.append(v);
+            }
+        };
+
+        // // reader: bounds checked; a short or malformed file leaves ok false and the cache unused
+        struct Get{
+            const char* p;
+            const char* e;
+            bool ok{true};
+
+            template <class T>
+            void operator()(T& v){
+                static_assert(std::is_trivially_copyable_v<T>);
+                if (!ok || static_cast<std::size_t>(e - p) < sizeof(T)){
+                    ok = false;
+                    return;
+                }
+                std::memcpy(&v, p, sizeof(T));
+                p += sizeof(T);
+            }
+
+            void operator()(std::string& v){
+                std::uint64_t n = 0;
+                (*this)(n);
+                if (!ok || static_cast<std::uint64_t>(e - p) < n){
+                    ok = false;
+                    return;
+                }
+                v.assign(p, static_cast<std::size_t>(n));
+                p += n;
+            }
+        };
+
+        /// @brief every persisted field of a scan, in file order; the same walk writes and reads
+        template <class Io, class Scan>
+        void fields(Io& io, Scan& s){
+            io(s.key);
+
+            auto& fe = s.fe;
+            io(fe.path); io(fe.size_bytes); io(fe.messages_total); io(fe.tick); io(fe.health); io(fe.kpi);
+            io(fe.first_t_ns); io(fe.last_t_ns); io(fe.payload_blake3); io(fe.schema_ok);
+
+            auto& in = s.info;
+            io(in.lines); io(in.bad_lines); io(in.tick); io(in.health); io(in.kpi); io(in.other);
+            io(in.first_t_ns); io(in.last_t_ns);
+            io(in.has_y0); io(in.has_r0); io(in.has_u_pre0); io(in.has_u_post0); io(in.has_meta); io(in.has_buildinfo);
+            io(in.dt_ns); io(in.tick_decimation);
+            io(in.ictk_version); io(in.git_sha); io(in.controller_id); io(in.asset_id); io(in.clock);
+
+            s.tl.visit_state(io);
+            io(s.warning);
+        }
+    } // namespace
+
+    bool key(const std::filesystem::path& p, FileKey& k) noexcept{
+        k = FileKey{};
+        #if !defined(_WIN32)
+            struct stat st{};
+            if (::stat(p.c_str(), &st) != 0) return false;
+            k.size = static_cast<std::uint64_t>(st.st_size);
+            k.inode = static_cast<std::uint64_t>(st.st_ino);
+            #if defined(__APPLE__)
+                k.mtime_ns = static_cast<std::int64_t>(st.st_mtimespec.tv_sec) * 1000000000LL + st.st_mtimespec.tv_nsec;
+                k.ctime_ns = static_cast<std::int64_t>(st.st_ctimespec.tv_sec) * 1000000000LL + st.st_ctimespec.tv_nsec;
+            #else
+                k.mtime_ns = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+                k.ctime_ns = static_cast<std::int64_t>(st.st_ctim.tv_sec) * 1000000000LL + st.st_ctim.tv_nsec;
+            #endif
+        #else
+            std::error_code ec;
+            const auto sz = std::filesystem::file_size(p, ec);
+            if (ec) return false;
+            const auto mt = std::filesystem::last_write_time(p, ec);
+            if (ec) return false;
+            k.size = static_cast<std::uint64_t>(sz);
+            k.mtime_ns = static_cast<std::int64_t>(mt.time_since_epoch().count());
+        #endif
+        return true;
+    }
+
+    std::unordered_map<std::string, SegmentScan> load(const std::filesystem::path& p, std::string_view fingerprint){
+        std::unordered_map<std::string, SegmentScan> m;
+        std::string b;
+        if (std::FILE* f = std::fopen(p.string().c_str(), "rb")){
+            char buf[1 << 16];
+            for (std::size_t k; (k = std::fread(buf, 1, sizeof(buf), f)) > 0;) b.append(buf, k);
+            std::fclose(f);
+        }
+        if (b.size() < sizeof(kMagic) || std::memcmp(b.data(), kMagic, sizeof(kMagic)) != 0) return m;
+
+        Get g{b.data() + sizeof(kMagic), b.data() + b.size()};
+        std::uint32_t format = 0;
+        std::string fp;
+        std::uint64_t count = 0;
+        g(format); g(fp); g(count);
+        if (!g.ok || format != kFormat || fp != fingerprint) return m;
+
+        for (std::uint64_t i = 0; i < count; ++i){
+            SegmentScan s{};
+            fields(g, s);
+            std::uint64_t ngaps = 0;
+            g(ngaps);
+            if (!g.ok || ngaps > static_cast<std::uint64_t>(g.e - g.p) / sizeof(GapSpan)) return {};
+            s.tl.gaps().resize(static_cast<std::size_t>(ngaps));
+            for (GapSpan& gs : s.tl.gaps()) g(gs);
+            if (!g.ok) return {};
+            std::string path = s.fe.path;
+            m.insert_or_assign(std::move(path), std::move(s));
+        }
+        return m;
+    }
+
+    bool save(const std::filesystem::path& p, std::string_view fingerprint, const std::vector<SegmentScan>& scans){
+        std::string b;
+        Put w{b};
+        b.append(kMagic, sizeof(kMagic));
+        w(kFormat);
+        w(std::string(fingerprint));
+
+        std::uint64_t count = 0;
+        for (const SegmentScan& s : scans) count += is_ok(s.status) && !s.fe.path.empty();
+        w(count);
+        for (const SegmentScan& s : scans){
+            if (!is_ok(s.status) || s.fe.path.empty()) continue;
+            fields(w, s);
+            w(static_cast<std::uint64_t>(s.tl.gaps().size()));
+            for (const GapSpan& gs : s.tl.gaps()) w(gs);
+        }
+
+        // // temp + rename: a concurrent or later reader never sees half a cache
+        std::filesystem::path tmp = p;
+        tmp += ".tmp";
+        std::FILE* f = std::fopen(tmp.string().c_str(), "wb");
+        if (!f) return false;
+        const bool ok = std::fwrite(b.data(), 1, b.size(), f) == b.size();
+        if (std::fclose(f) != 0 || !ok) return false;
+        std::error_code ec;
+        std::filesystem::rename(tmp, p, ec);
+        return !ec;
+    }
+
+} // namespace ictk::tools::acr::cache
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+
+#include "merge.hpp"
+#include "io/jsonl_reader.hpp"
+
+#include "ictk/tools/acr/report.hpp"
+#include "ictk/tools/acr/exit_codes.hpp"
+
+/*
+Per segment result cache (IngestConfig::cache_path)
+    one entry per segment that scanned clean: its FileEntry, SegmentInfo, Timeline (counts, spans, boundary rows) and warning
+    key: path + size + mtime + ctime + inode -> a rewrite in place with the mtime put back still changes ctime;
+        with hashing on, a hit is also hashed again (no parse) and must give the payload hash kept for it
+    the whole file is dropped when the settings that shape a scan changed (fingerprint: ACR build, hashing, time range)
+    binary, host byte order, written to <cache>.tmp then renamed over -> a reader sees the old cache or the new one
+*/
+namespace ictk::tools::acr{
+
+    /// @brief cache key of a segment besides its path (times in ns, 0 where the host has no such field)
+    struct FileKey{
+        std::uint64_t size{0};
+        std::int64_t mtime_ns{0};
+        std::int64_t ctime_ns{0};
+        std::uint64_t inode{0};
+
+        bool operator==(const FileKey&) const noexcept = default;
+    };
+
+    /// @brief one segment as its worker left it (or as the cache kept it)
+    struct SegmentScan{
+        ExitCode status{ExitCode::kOk};
+        FileKey key{};
+
+        FileEntry fe{};
+        jsonl::SegmentInfo info{};
+        Timeline tl{};
+        std::string warning;
+    };
+
+    namespace cache{
+        /// @brief size, mtime, ctime and inode of p; false when p cannot be stat'ed
+        [[nodiscard]] bool key(const std::filesystem::path& p, FileKey& k) noexcept;
+
+        /// @brief entries of the cache at p by segment path; empty when missing, unreadable or made under another fingerprint
+        [[nodiscard]] std::unordered_map<std::string, SegmentScan> load(const std::filesystem::path& p, std::string_view fingerprint);
+
+        /// @brief every clean scan of scans -> the cache at p (replaced whole); false when it could not be written
+        bool save(const std::filesystem::path& p, std::string_view fingerprint, const std::vector<SegmentScan>& scans);
+    } // namespace cache
+
+} // namespace ictk::tools::acr
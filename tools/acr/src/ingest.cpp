@@ -0,0 +1,343 @@
+#include <atomic>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <algorithm>
+
+#include "ictk/tools/acr/ingest.hpp"
+#include "ictk/tools/acr/version.hpp"
+
+#include "hash.hpp"
+#include "cache.hpp"
+#include "merge.hpp"
+#include "io/jsonl_reader.hpp"
+#include "io/sidecar_semantics.hpp"
+
+/*
+Ingest: segments scanned on cfg.threads workers, reduced in cfg.mcap_paths order
+    worker: claims the next segment index and streams it through jsonl::Reader (one window of stream_buffer_bytes);
+        the same window feeds the payload hasher (per_file_hash_verify, BLAKE3 builds) -> one read per segment;
+        the rows go through the segment's own Timeline; results go into the worker's own SegmentScan -> no shared state, no locks
+    reduce (calling thread, after the join): walks the scans by index -> identity carried across rotations, filters,
+        MergedEntry, the first buildinfo and conflicts with it; the first failing segment ends the report as a serial run would
+    timeline (merge.hpp): segments grouped by overlapping [min t, max t], groups in time order
+        one segment (rotation: the usual case) -> its worker's Timeline is spliced on, nothing is read again
+        overlapping segments -> k-way merge of the group by (t_ns, file_idx, seq), the only second read
+    cache (cfg.cache_path, cache.hpp): segments unchanged since the last run (path, size, mtime, ctime, inode) take their
+        scan from the cache; with hashing on they are hashed again first, and a mismatch means a full scan
+        every clean scan is written back before the reduce -> a re-run parses the new segments only, same report
+    -> the report, and its JSON, is the same for any thread count
+    .mcap -> needs the MCAP reader (ICTK_ACR_MCAP builds)
+*/
+namespace ictk::tools::acr{
+
+    namespace{
+        #if ICTK_ACR_MCAP
+            constexpr bool kBlake3 = true;
+        #else
+            constexpr bool kBlake3 = false;     // // hash.cpp stubs: no digest to report
+        #endif
+
+        inline std::int64_t tick_step(std::int64_t dt_ns, std::uint32_t tick_decimation) noexcept{
+            return dt_ns * static_cast<std::int64_t>(std::max<std::uint32_t>(tick_decimation, 1));
+        }
+
+        const char* clock_name(ClockDomain c) noexcept{
+            switch (c){
+            case ClockDomain::MONO: return "MONO";
+            case ClockDomain::WALL: return "WALL";
+            default: return "UNKNOWN";
+            }
+        }
+
+        /// @brief value of field differs from the first segment -> listed once per field, values in first seen order
+        void conflict(Report& rep, const char* field, const std::string& first, const std::string& v){
+            if (v == first) return;
+            for (auto& c : rep.buildinfo_conflicts){
+                if (c.field != field) continue;
+                if (std::find(c.values.begin(), c.values.end(), v) == c.values.end()) c.values.push_back(v);
+                return;
+            }
+            rep.buildinfo_conflicts.push_back(Report::Conflict{field, {first, v}});
+        }
+
+        /// @brief buildinfo / time_anchor are written once per recorder run, not per rotated segment -> a segment
+        ///     without them carries the identity of the one before
+        void inherit(const jsonl::SegmentInfo& prev, jsonl::SegmentInfo& in){
+            if (!in.has_buildinfo && prev.has_buildinfo){
+                in.has_buildinfo = true;
+                in.tick_decimation = prev.tick_decimation;
+                in.controller_id = prev.controller_id;
+                in.asset_id = prev.asset_id;
+            }
+            if (in.clock == ClockDomain::UNKNOWN) in.clock = prev.clock;
+            if (in.ictk_version.empty()) in.ictk_version = prev.ictk_version;
+        }
+
+        /// @brief verdict of <sidecar_dir or the segment's dir>/<stem>.sidecar.json on the payload hash; null without a sidecar
+        std::optional<bool> sidecar_verdict(const IngestConfig& cfg, const std::filesystem::path& p, const std::string& hex){
+            std::filesystem::path sc = cfg.sidecar_dir ? *cfg.sidecar_dir / p.filename() : p;
+            sc.replace_extension(".sidecar.json");
+            std::error_code ec;
+            if (!std::filesystem::exists(sc, ec)) return std::nullopt;
+            const auto sd = sidecar::parse_sidecar(sc);
+            return sd && sidecar::ieq_hex(sd->payload_hex, hex);
+        }
+
+        /// @brief settings that shape a scan; a cache made under others is not used
+        std::string fingerprint(const IngestConfig& cfg){
+            std::string fp = std::string(kVersionStr) + " " + kGitSha;
+            fp += kBlake3 && cfg.per_file_hash_verify ? " blake3" : " nohash";
+            if (cfg.time_range_ns) fp += " range " + std::to_string(cfg.time_range_ns->first) + " " + std::to_string(cfg.time_range_ns->second);
+            return fp;
+        }
+
+        /// @brief worker side: one read of the segment feeds both the hasher and the parser; rows are counted as they
+        ///     stream, never stored. Without BLAKE3 in the build (no MCAP) no hash is claimed: empty, payload_hash_ok null
+        void scan(const IngestConfig& cfg, std::size_t i, SegmentScan& s){
+            const auto& p = cfg.mcap_paths[i];
+            s.fe.path = p.string();
+            if (p.extension() != ".jsonl"){
+                s.warning = s.fe.path + ": no reader for this format in this build";
+                s.status = ExitCode::kOpenFail;
+                return;
+            }
+
+            // // cache key first: a segment growing while it is read keys as the older, shorter file -> rescanned next run
+            if (cfg.cache_path) (void)cache::key(p, s.key);
+
+            jsonl::Reader rd;
+            if (const ExitCode st = rd.open(p, cfg.stream_buffer_bytes, static_cast<std::uint16_t>(i)); !is_ok(st)){
+                s.warning = s.fe.path + ": open failed";
+                s.status = st;
+                return;
+            }
+            s.fe.size_bytes = rd.size_bytes();
+            hash::Blake3 h;
+            const bool hashing = kBlake3 && cfg.per_file_hash_verify;
+            if (hashing) rd.hash_into(&h);
+
+            CanonicalRow row{};
+            Timeline::Stream st{};
+            while (rd.next(row)){
+                if (cfg.time_range_ns && (row.t_ns < cfg.time_range_ns->first || row.t_ns > cfg.time_range_ns->second)) continue;
+                if (s.fe.tick++ == 0){
+                    s.fe.first_t_ns = row.t_ns;
+                    s.tl.set_step(tick_step(rd.info().dt_ns, rd.info().tick_decimation));    // // meta line is parsed by now
+                }
+                s.fe.last_t_ns = row.t_ns;
+                if (row.flags & kRowHealth) ++s.fe.health;
+                s.tl.push(row.t_ns, row.file_idx, st);
+            }
+            if (!is_ok(rd.status())){
+                s.warning = s.fe.path + ": record longer than the stream buffer or read failed";
+                s.status = rd.status();
+                return;
+            }
+
+            if (hashing){
+                const auto d = h.digest();
+                s.fe.payload_blake3 = hash::to_hex({d.data(), d.size()});
+                s.fe.payload_hash_ok = sidecar_verdict(cfg, p, s.fe.payload_blake3);
+            }
+
+            s.info = rd.info();
+            s.fe.kpi = s.info.kpi;
+            s.fe.messages_total = s.info.lines - s.info.bad_lines;
+            s.fe.schema_ok = s.info.bad_lines == 0 && s.info.has_meta;
+            if (s.info.bad_lines) s.warning = s.fe.path + ": " + std::to_string(s.info.bad_lines) + " records did not parse";
+        }
+    } // namespace
+
+    ExitCode ingest(const IngestConfig& cfg, Report& rep){
+        rep = Report{};
+        rep.manifest.acr_version = kVersionStr;
+        rep.manifest.git_sha = kGitSha;
+        rep.manifest.schema_id = "ictk.metrics";
+
+        const std::size_t n = cfg.mcap_paths.size();
+        if (n == 0){
+            rep.warnings.push_back("no segments given");
+            return ExitCode::kOpenFail;
+        }
+        if (n > std::numeric_limits<std::uint16_t>::max()){
+            rep.warnings.push_back("more segments than CanonicalRow::file_idx can address");
+            return ExitCode::kOpenFail;
+        }
+
+        // // cache hits: same path and FileKey; with hashing on they still go to the pool, to be hashed again (no parse)
+        std::vector<SegmentScan> scans(n);
+        std::vector<std::size_t> todo;
+        std::vector<char> recheck(n, 0);
+        todo.reserve(n);
+        const bool hashing = kBlake3 && cfg.per_file_hash_verify;
+        const std::string fp = cfg.cache_path ? fingerprint(cfg) : std::string{};
+        if (cfg.cache_path){
+            auto cached = cache::load(*cfg.cache_path, fp);
+            for (std::size_t i = 0; i < n; ++i){
+                const auto& p = cfg.mcap_paths[i];
+                const auto it = cached.find(p.string());
+                FileKey k{};
+                if (it == cached.end() || !cache::key(p, k) || !(k == it->second.key)){
+                    todo.push_back(i);
+                    continue;
+                }
+                scans[i] = std::move(it->second);
+                if (hashing){
+                    recheck[i] = 1;
+                    todo.push_back(i);
+                }
+            }
+        }else{
+            for (std::size_t i = 0; i < n; ++i) todo.push_back(i);
+        }
+
+        // // pool over the rest: each worker takes the next one; past the lowest failure nothing is scanned (the report ends there)
+        //      a cached segment whose bytes no longer give the kept payload hash is scanned from scratch
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> failed{n};
+        const auto work = [&]{
+            for (std::size_t w = next.fetch_add(1, std::memory_order_relaxed); w < todo.size(); w = next.fetch_add(1, std::memory_order_relaxed)){
+                const std::size_t i = todo[w];
+                if (i > failed.load(std::memory_order_relaxed)) continue;
+                if (recheck[i]){
+                    const auto& p = cfg.mcap_paths[i];
+                    const auto d = hash::blake3_256_file(p.string().c_str(), cfg.stream_buffer_bytes);
+                    if (hash::to_hex({d.data(), d.size()}) == scans[i].fe.payload_blake3){
+                        scans[i].fe.payload_hash_ok = sidecar_verdict(cfg, p, scans[i].fe.payload_blake3);
+                        continue;
+                    }
+                    scans[i] = SegmentScan{};
+                }
+                scan(cfg, i, scans[i]);
+                if (is_ok(scans[i].status)) continue;
+                std::size_t f = failed.load(std::memory_order_relaxed);
+                while (i < f && !failed.compare_exchange_weak(f, i, std::memory_order_relaxed)){}
+            }
+        };
+
+        std::size_t threads = cfg.threads ? cfg.threads : std::max(1u, std::thread::hardware_concurrency());
+        threads = std::min(threads, std::max<std::size_t>(todo.size(), 1));
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (std::size_t t = 1; t < threads; ++t) pool.emplace_back(work);
+        work();
+        for (auto& t : pool) t.join();
+
+        if (cfg.cache_path && !todo.empty() && !cache::save(*cfg.cache_path, fp, scans)){
+            rep.warnings.push_back(cfg.cache_path->string() + ": cache not written");
+        }
+
+        // // reduce in path order -> same report for any thread count
+        bool have_first = false;
+        jsonl::SegmentInfo first{}, in{};
+        std::vector<std::size_t> kept;      // // segments past the filters, path order
+
+        for (std::size_t i = 0; i < n; ++i){
+            SegmentScan& s = scans[i];
+            if (!is_ok(s.status)){
+                rep.warnings.push_back(std::move(s.warning));
+                return s.status;
+            }
+
+            const jsonl::SegmentInfo prev = std::move(in);
+            in = std::move(s.info);
+            inherit(prev, in);
+            if ((cfg.asset_id_filter && in.asset_id != *cfg.asset_id_filter)
+                || (cfg.controller_id_filter && in.controller_id != *cfg.controller_id_filter)) continue;
+            if (!s.warning.empty()) rep.warnings.push_back(std::move(s.warning));
+
+            // // buildinfo: the first segment is the reference, the rest must agree
+            if (!have_first){
+                have_first = true;
+                first = in;
+                rep.buildinfo.dt_ns = in.dt_ns;
+                rep.buildinfo.tick_decimation = in.tick_decimation;
+                rep.buildinfo.controller_id = in.controller_id;
+                rep.buildinfo.asset_id = in.asset_id;
+                rep.buildinfo.clock_domain = clock_name(in.clock);
+                rep.buildinfo.dt_source = in.has_buildinfo ? "buildinfo" : "meta";
+                rep.manifest.ictk_version = in.ictk_version;
+            }else{
+                conflict(rep, "dt_ns", std::to_string(first.dt_ns), std::to_string(in.dt_ns));
+                conflict(rep, "tick_decimation", std::to_string(first.tick_decimation), std::to_string(in.tick_decimation));
+                conflict(rep, "controller_id", first.controller_id, in.controller_id);
+                conflict(rep, "asset_id", first.asset_id, in.asset_id);
+                conflict(rep, "clock_domain", clock_name(first.clock), clock_name(in.clock));
+                if (first.clock != in.clock) rep.anomalies.timebase_mixed = true;
+            }
+
+            rep.required_fields_present.y0 = rep.required_fields_present.y0 || in.has_y0;
+            rep.required_fields_present.r0 = rep.required_fields_present.r0 || in.has_r0;
+            rep.required_fields_present.u_pre0 = rep.required_fields_present.u_pre0 || in.has_u_pre0;
+            rep.required_fields_present.u_post0 = rep.required_fields_present.u_post0 || in.has_u_post0;
+
+            // // merged span over the segments that had ticks
+            FileEntry& fe = s.fe;
+            if (fe.tick){
+                if (rep.merged.tick == 0 || fe.first_t_ns < rep.merged.first_t_ns) rep.merged.first_t_ns = fe.first_t_ns;
+                if (rep.merged.tick == 0 || fe.last_t_ns > rep.merged.last_t_ns) rep.merged.last_t_ns = fe.last_t_ns;
+            }
+            rep.merged.tick += fe.tick;
+            rep.merged.health += fe.health;
+            rep.merged.kpi += fe.kpi;
+            if (fe.payload_hash_ok && !*fe.payload_hash_ok) rep.warnings.push_back(fe.path + ": payload hash does not match its sidecar");
+            rep.files.push_back(std::move(fe));
+            if (!s.tl.empty()) kept.push_back(i);
+        }
+
+        // // timeline: groups of overlapping segments in time order; a lone segment brings its worker's Timeline
+        std::sort(kept.begin(), kept.end(), [&](std::size_t a, std::size_t b){
+            const std::int64_t ta = scans[a].tl.min_t_ns(), tb = scans[b].tl.min_t_ns();
+            return ta != tb ? ta < tb : a < b;
+        });
+        Timeline tl(tick_step(rep.buildinfo.dt_ns, rep.buildinfo.tick_decimation));
+        std::vector<std::size_t> group;
+        for (std::size_t g = 0; g < kept.size();){
+            group.assign(1, kept[g]);
+            std::int64_t hi = scans[kept[g]].tl.max_t_ns();
+            for (++g; g < kept.size() && scans[kept[g]].tl.min_t_ns() <= hi; ++g){
+                group.push_back(kept[g]);
+                hi = std::max(hi, scans[kept[g]].tl.max_t_ns());
+            }
+
+            if (group.size() == 1){
+                tl.splice(std::move(scans[group[0]].tl));
+                continue;
+            }
+            Timeline merged(tick_step(rep.buildinfo.dt_ns, rep.buildinfo.tick_decimation));
+            if (const ExitCode st = merge(cfg, group, merged); !is_ok(st)){
+                rep.warnings.push_back("segments overlapping in time could not be merged");
+                return st;
+            }
+            tl.splice(std::move(merged));
+        }
+        rep.anomalies.non_monotonic_ticks = tl.counts().non_monotonic_ticks;
+        rep.anomalies.overlap_msgs = tl.counts().overlap_msgs;
+        rep.anomalies.ooo_msgs = tl.counts().ooo_msgs;
+        rep.anomalies.gaps_ns = tl.counts().gaps_ns;
+        rep.gaps = std::move(tl.gaps());
+
+        if (cfg.require_tick_decim_1 && rep.buildinfo.tick_decimation != 1){
+            rep.warnings.push_back("tick_decimation != 1: evidence does not hold every tick");
+        }
+
+        const auto& req = rep.required_fields_present;
+        if (!req.y0) rep.missing_fields.push_back("y0");
+        if (!req.u_pre0) rep.missing_fields.push_back("u_pre0");
+        if (!req.u_post0) rep.missing_fields.push_back("u_post0");
+        if (!req.r0) rep.missing_fields.push_back("r0");
+        if (!rep.missing_fields.empty()) return ExitCode::kMissingRequired;
+
+        for (const FileEntry& f : rep.files){
+            if (f.payload_hash_ok && !*f.payload_hash_ok) return ExitCode::kHashMismatch;
+        }
+
+        if (!rep.buildinfo_conflicts.empty() && cfg.fail_on_buildinfo_conflict) return ExitCode::kBuildInfoConflict;
+        return ExitCode::kOk;
+    }
+
+} // namespace ictk::tools::acr
@@ -0,0 +1,428 @@
+#include <bit>
+#include <new>
+#include <limits>
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+#include <system_error>
+
+#include "hash.hpp"
+#include "io/jsonl_reader.hpp"
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+namespace ictk::tools::acr::jsonl{
+
+    namespace{
+        // // the hasher runs this far ahead of the parse cursor -> its bytes are still in L2 when the parser gets there
+        constexpr std::uint64_t kHashStep = 256u << 10;
+
+        /// @brief first '\n' in [p, e), nullptr if none
+        inline const char* find_nl(const char* p, const char* e) noexcept{
+            #if defined(__SSE2__)
+                // 16 bytes per compare, the match mask -> offset of the first newline
+                const __m128i nl = _mm_set1_epi8('\n');
+                while (e - p >= 16){
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                    const int m = _mm_movemask_epi8(_mm_cmpeq_epi8(v, nl));
+                    if (m) return p + std::countr_zero(static_cast<unsigned>(m));
+                    p += 16;
+                }
+            #endif
+            if (p >= e) return nullptr;
+            return static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(e - p)));
+        }
+
+        inline std::size_t page_bytes() noexcept{
+            #if !defined(_WIN32)
+                const long pg = ::sysconf(_SC_PAGESIZE);
+                return pg > 0 ? static_cast<std::size_t>(pg) : 4096;
+            #else
+                return 4096;
+            #endif
+        }
+
+        inline bool starts_with(std::string_view s, std::string_view p) noexcept{
+            return s.size() >= p.size() && std::memcmp(s.data(), p.data(), p.size()) == 0;
+        }
+
+        /// @brief every member of the flat object body ('{' ... '}') -> f(key, raw value); arrays / objects go whole
+        /// @return false on malformed text
+        template <class F>
+        bool members(std::string_view body, F&& f) noexcept{
+            const char* p = body.data();
+            const char* const e = p + body.size();
+            if (p == e || *p != '{') return false;
+            ++p;
+
+            // skip a string starting at p ('"'), p -> past the closing quote
+            auto skip_str = [&]() noexcept{
+                for (++p; p < e && *p != '"'; ++p){
+                    if (*p == '\\') ++p;
+                }
+                if (p < e) ++p;
+            };
+
+            for (;;){
+                while (p < e && (*p == ' ' || *p == ',')) ++p;
+                if (p >= e) return false;
+                if (*p == '}') return true;
+                if (*p != '"') return false;
+
+                // keys are plain identifiers in evidence records, no escapes
+                const char* k = ++p;
+                while (p < e && *p != '"') ++p;
+                if (p >= e) return false;
+                const std::string_view key(k, static_cast<std::size_t>(p - k));
+                ++p;
+                while (p < e && *p == ' ') ++p;
+                if (p >= e || *p != ':') return false;
+                ++p;
+                while (p < e && *p == ' ') ++p;
+                if (p >= e) return false;
+
+                const char* v = p;
+                if (*p == '"'){
+                    skip_str();
+                }else if (*p == '[' || *p == '{'){
+                    int depth = 0;
+                    while (p < e){
+                        if (*p == '"'){
+                            skip_str();
+                            continue;
+                        }
+                        if (*p == '[' || *p == '{') ++depth;
+                        else if (*p == ']' || *p == '}') --depth;
+                        ++p;
+                        if (depth == 0) break;
+                    }
+                    if (depth != 0) return false;
+                }else{
+                    while (p < e && *p != ',' && *p != '}') ++p;
+                }
+                f(key, std::string_view(v, static_cast<std::size_t>(p - v)));
+            }
+        }
+
+        // // numbers: the whole token must parse; null (nan / inf from the recorder) -> NaN
+        inline bool to_f64(std::string_view v, double& out) noexcept{
+            if (v == "null"){
+                out = std::numeric_limits<double>::quiet_NaN();
+                return true;
+            }
+            const auto r = std::from_chars(v.data(), v.data() + v.size(), out);
+            return r.ec == std::errc() && r.ptr == v.data() + v.size();
+        }
+
+        template <class T>
+        inline bool to_int(std::string_view v, T& out) noexcept{
+            const auto r = std::from_chars(v.data(), v.data() + v.size(), out);
+            return r.ec == std::errc() && r.ptr == v.data() + v.size();
+        }
+
+        /// @brief quoted JSON string -> text (simple escapes; \u kept as written)
+        std::string unquote(std::string_view v){
+            std::string s;
+            if (v.size() < 2 || v.front() != '"' || v.back() != '"') return s;
+            v = v.substr(1, v.size() - 2);
+            s.reserve(v.size());
+            for (std::size_t i = 0; i < v.size(); ++i){
+                char c = v[i];
+                if (c == '\\' && i + 1 < v.size()){
+                    c = v[++i];
+                    switch (c){
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'u': s += "\\u"; continue;
+                    default: break;
+                    }
+                }
+                s.push_back(c);
+            }
+            return s;
+        }
+    } // namespace
+
+    Reader::~Reader(){
+        close_();
+    }
+
+    void Reader::close_() noexcept{
+        #if !defined(_WIN32)
+            if (win_ && !buf_) ::munmap(const_cast<char*>(win_), win_len_);
+            if (fd_ >= 0) ::close(fd_);
+        #endif
+        if (file_) std::fclose(file_);
+        delete[] buf_;
+        win_ = nullptr;
+        buf_ = nullptr;
+        file_ = nullptr;
+        fd_ = -1;
+    }
+
+    ExitCode Reader::open(const std::filesystem::path& p, std::size_t window_bytes, std::uint16_t file_idx){
+        close_();
+        info_ = SegmentInfo{};
+        status_ = ExitCode::kOk;
+        file_idx_ = file_idx;
+        win_off_ = 0;
+        win_len_ = 0;
+        cur_ = next_ = 0;
+        hash_ = nullptr;
+        hashed_ = 0;
+
+        const std::size_t pg = page_bytes();
+        window_ = std::max(2 * pg, (window_bytes + pg - 1) / pg * pg);
+
+        std::error_code ec;
+        const auto sz = std::filesystem::file_size(p, ec);
+        if (ec) return status_ = ExitCode::kOpenFail;
+        size_ = static_cast<std::uint64_t>(sz);
+
+        #if !defined(_WIN32)
+            fd_ = ::open(p.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd_ < 0) return status_ = ExitCode::kOpenFail;
+        #else
+            file_ = std::fopen(p.string().c_str(), "rb");
+            if (!file_) return status_ = ExitCode::kOpenFail;
+            buf_ = new (std::nothrow) char[window_];
+            if (!buf_) return status_ = ExitCode::kOOM;
+            win_ = buf_;
+        #endif
+        if (size_ && !slide_()) return status_ == ExitCode::kOk ? status_ = ExitCode::kOpenFail : status_;
+        return ExitCode::kOk;
+    }
+
+    /*
+    Next window: starts at the page holding the cursor (the record not finished in the last one)
+        mmap: unmap + map read only at that offset, MADV_SEQUENTIAL -> readahead, pages behind are dropped with the old map
+        buffer: move the unfinished bytes to the front, fill the rest
+    */
+    bool Reader::slide_(){
+        feed_(win_off_ + win_len_);     // // the rest of the old window, before it goes
+        #if !defined(_WIN32)
+            const std::uint64_t off = cur_ / page_bytes() * page_bytes();
+            if (win_ && off == win_off_){
+                status_ = ExitCode::kStreamCorrupt;   // // a record longer than the window
+                return false;
+            }
+            if (win_) ::munmap(const_cast<char*>(win_), win_len_);
+            win_ = nullptr;
+            const std::size_t len = static_cast<std::size_t>(std::min<std::uint64_t>(window_, size_ - off));
+            void* m = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd_, static_cast<off_t>(off));
+            if (m == MAP_FAILED){
+                status_ = ExitCode::kStreamCorrupt;
+                return false;
+            }
+            ::madvise(m, len, MADV_SEQUENTIAL);
+            win_ = static_cast<const char*>(m);
+            win_off_ = off;
+            win_len_ = len;
+        #else
+            const std::size_t keep = static_cast<std::size_t>(win_off_ + win_len_ - cur_);
+            if (win_len_ && keep == window_){
+                status_ = ExitCode::kStreamCorrupt;
+                return false;
+            }
+            std::memmove(buf_, buf_ + (cur_ - win_off_), keep);
+            const std::size_t want = static_cast<std::size_t>(std::min<std::uint64_t>(window_ - keep, size_ - cur_ - keep));
+            if (std::fread(buf_ + keep, 1, want, file_) != want){
+                status_ = ExitCode::kStreamCorrupt;
+                return false;
+            }
+            win_off_ = cur_;
+            win_len_ = keep + want;
+        #endif
+        return true;
+    }
+
+    /// @brief hash file bytes [hashed_, upto); upto never passes the window end, hashed_ never trails its start
+    void Reader::feed_(std::uint64_t upto) noexcept{
+        if (!hash_ || upto <= hashed_) return;
+        hash_->update(win_ + (hashed_ - win_off_), static_cast<std::size_t>(upto - hashed_));
+        hashed_ = upto;
+    }
+
+    /// @brief the line at the cursor without its '\n' (the cursor moves to next_ when the caller takes it)
+    bool Reader::line_(std::string_view& out){
+        for (;;){
+            if (hash_ && hashed_ < cur_ + kHashStep) feed_(std::min(cur_ + 2 * kHashStep, win_off_ + win_len_));
+            const char* b = win_ + (cur_ - win_off_);
+            const char* e = win_ + win_len_;
+            if (const char* nl = find_nl(b, e)){
+                out = std::string_view(b, static_cast<std::size_t>(nl - b));
+                next_ = cur_ + out.size() + 1;
+                if (!out.empty() && out.back() == '\r') out.remove_suffix(1);
+                return true;
+            }
+            if (win_off_ + win_len_ >= size_){
+                // // unterminated tail: a record cut by a crash, or a writer still going
+                feed_(size_);
+                if (b >= e) return false;
+                out = std::string_view(b, static_cast<std::size_t>(e - b));
+                next_ = size_;
+                return true;
+            }
+            if (!slide_()) return false;
+        }
+    }
+
+    /// @brief {"ch":"<name>","body":{...}} / {"meta":{...}} -> kind + the body object
+    Reader::Kind Reader::classify_(std::string_view line, std::string_view& body) noexcept{
+        constexpr std::string_view kCh = R"({"ch":")";
+        constexpr std::string_view kMetaKey = R"({"meta":)";
+        constexpr std::string_view kBody = R"("body":)";
+        if (line.empty() || line.back() != '}') return Kind::kBad;
+
+        if (starts_with(line, kMetaKey)){
+            body = line.substr(kMetaKey.size(), line.size() - kMetaKey.size() - 1);
+            return Kind::kMeta;
+        }
+        if (!starts_with(line, kCh)) return Kind::kBad;
+
+        const std::size_t q = line.find('"', kCh.size());
+        if (q == std::string_view::npos) return Kind::kBad;
+        const std::string_view ch = line.substr(kCh.size(), q - kCh.size());
+        const std::size_t b = line.find(kBody, q);
+        if (b == std::string_view::npos) return Kind::kBad;
+        body = line.substr(b + kBody.size(), line.size() - b - kBody.size() - 1);
+
+        if (ch == "/ictk/tick") return Kind::kTick;
+        if (ch == "/ictk/health") return Kind::kHealth;
+        if (ch == "/ictk/kpi_report") return Kind::kKpi;
+        if (ch == "/ictk/buildinfo") return Kind::kBuildInfo;
+        if (ch == "/ictk/time_anchor") return Kind::kTimeAnchor;
+        return Kind::kOther;
+    }
+
+    bool Reader::tick_(std::string_view body, CanonicalRow& row) noexcept{
+        row = CanonicalRow{};
+        row.file_idx = file_idx_;
+        bool ok = true, t = false;
+        const bool parsed = members(body, [&](std::string_view k, std::string_view v) noexcept{
+            if (k == "t_ns"){
+                ok = ok && to_int(v, row.t_ns);
+                t = true;
+            }else if (k == "seq"){
+                ok = ok && to_int(v, row.seq);
+            }else if (k == "y0"){
+                ok = ok && to_f64(v, row.y0);
+                info_.has_y0 = true;
+            }else if (k == "r0"){
+                ok = ok && to_f64(v, row.r0);
+                info_.has_r0 = true;
+            }else if (k == "u_pre0"){
+                ok = ok && to_f64(v, row.u_pre);
+                info_.has_u_pre0 = true;
+            }else if (k == "u_post0"){
+                ok = ok && to_f64(v, row.u_post);
+                info_.has_u_post0 = true;
+            }
+            // // vector channels / envelope arrays are not part of the canonical row
+        });
+        return parsed && ok && t;
+    }
+
+    bool Reader::health_(std::string_view body, CanonicalRow& row) noexcept{
+        bool ok = true, fallback = false, novelty = false;
+        const bool parsed = members(body, [&](std::string_view k, std::string_view v) noexcept{
+            if (k == "saturation_pct") ok = ok && to_f64(v, row.sat_pct);
+            else if (k == "fallback_active") fallback = v == "true";
+            else if (k == "novelty_flag") novelty = v == "true";
+            else if (k == "mode") ok = ok && to_int(v, row.mode);
+        });
+        if (!parsed || !ok) return false;
+        row.flags |= kRowHealth | (fallback ? kRowFallback : 0u) | (novelty ? kRowNovelty : 0u);
+        return true;
+    }
+
+    void Reader::cold_(Kind k, std::string_view body){
+        bool ok = true;
+        const bool parsed = members(body, [&](std::string_view key, std::string_view v){
+            if (key == "dt_ns"){
+                ok = ok && to_int(v, info_.dt_ns);
+            }else if (key == "tick_decimation"){
+                ok = ok && to_int(v, info_.tick_decimation);
+            }else if (key == "ictk_version"){
+                info_.ictk_version = unquote(v);
+            }else if (key == "git_sha"){
+                info_.git_sha = unquote(v);
+            }else if (key == "controller_id"){
+                info_.controller_id = unquote(v);
+            }else if (key == "asset_id"){
+                info_.asset_id = unquote(v);
+            }else if (key == "clock_domain"){
+                const std::string c = unquote(v);
+                info_.clock = c == "MONO" ? ClockDomain::MONO : c == "WALL" ? ClockDomain::WALL : ClockDomain::UNKNOWN;
+            }
+        });
+        if (!parsed || !ok){
+            ++info_.bad_lines;
+            return;
+        }
+        if (k == Kind::kMeta) info_.has_meta = true;
+        else if (k == Kind::kBuildInfo) info_.has_buildinfo = true;
+    }
+
+    bool Reader::next(CanonicalRow& row){
+        std::string_view line, body;
+        while (line_(line)){
+            cur_ = next_;
+            ++info_.lines;
+            if (line.empty()) continue;
+
+            const Kind k = classify_(line, body);
+            switch (k){
+            case Kind::kTick:
+                break;
+            case Kind::kHealth:
+                ++info_.health;   // // health without its tick (the tick line was bad)
+                continue;
+            case Kind::kKpi:
+                ++info_.kpi;
+                continue;
+            case Kind::kMeta:
+            case Kind::kBuildInfo:
+            case Kind::kTimeAnchor:
+                cold_(k, body);
+                continue;
+            case Kind::kOther:
+                ++info_.other;
+                continue;
+            case Kind::kBad:
+                ++info_.bad_lines;
+                continue;
+            }
+
+            if (!tick_(body, row)){
+                ++info_.bad_lines;
+                continue;
+            }
+            if (info_.tick++ == 0) info_.first_t_ns = row.t_ns;
+            info_.last_t_ns = row.t_ns;
+
+            // // the recorder writes the health record right after its tick; anything else stays for the next call
+            if (line_(line) && classify_(line, body) == Kind::kHealth){
+                cur_ = next_;
+                ++info_.lines;
+                ++info_.health;
+                if (!health_(body, row)) ++info_.bad_lines;
+            }
+            return true;
+        }
+        return false;
+    }
+
+} // namespace ictk::tools::acr::jsonl
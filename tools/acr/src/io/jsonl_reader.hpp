@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+#include "ictk/tools/acr/types.hpp"
+#include "ictk/tools/acr/exit_codes.hpp"
+
+/*
+Streaming reader for RecorderJsonl segments
+    the segment is mapped one window at a time (IngestConfig::stream_buffer_bytes, read only, MADV_SEQUENTIAL);
+        a record crossing the window end starts the next window -> memory stays one window whatever the file size
+        elsewhere: one buffer of the same size, refilled with fread
+    record boundaries: vectorized newline scan (SSE2 on x86, memchr elsewhere)
+    /ictk/tick + the /ictk/health record after it -> one CanonicalRow, numbers through std::from_chars,
+        no std::string per record; meta / buildinfo / time_anchor / kpi_report lines fill SegmentInfo on the way
+    payload hash (hash_into): the window being parsed also feeds the hasher, a step ahead of the cursor while the
+        bytes are still in cache -> hash + parse is one read of the file
+*/
+namespace ictk::tools::hash{
+    class Blake3;
+} // namespace ictk::tools::hash
+
+namespace ictk::tools::acr::jsonl{
+
+    /// @brief per segment counters and the cold records, complete once next() returned false
+    struct SegmentInfo{
+        // lines seen, lines that did not parse (a line cut by a crash included)
+        std::uint64_t lines{0};
+        std::uint64_t bad_lines{0};
+
+        // per channel
+        std::uint64_t tick{0};
+        std::uint64_t health{0};
+        std::uint64_t kpi{0};
+        std::uint64_t other{0};
+
+        // tick time span
+        std::int64_t first_t_ns{0};
+        std::int64_t last_t_ns{0};
+
+        // tick fields seen at least once
+        bool has_y0{false};
+        bool has_r0{false};
+        bool has_u_pre0{false};
+        bool has_u_post0{false};
+
+        // meta line / buildinfo / time_anchor
+        bool has_meta{false};
+        bool has_buildinfo{false};
+        std::int64_t dt_ns{0};
+        std::uint32_t tick_decimation{1};
+        std::string ictk_version;
+        std::string git_sha;
+        std::string controller_id;
+        std::string asset_id;
+        ClockDomain clock{ClockDomain::UNKNOWN};
+    };
+
+    class Reader{
+        public:
+            Reader() = default;
+            ~Reader();
+
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            /// @brief open a segment
+            /// @param p path to the .jsonl segment
+            /// @param window_bytes bytes mapped at once (rounded up to pages, two pages at least); a record must fit
+            /// @param file_idx written to CanonicalRow::file_idx
+            /// @return kOk, kOpenFail or kOOM
+            [[nodiscard]] ExitCode open(const std::filesystem::path& p, std::size_t window_bytes, std::uint16_t file_idx = 0);
+
+            /// @brief every byte of the segment, in file order, also goes to h (nullptr: none); call after open()
+            ///     the digest covers the whole file once next() returned false with status() kOk
+            void hash_into(hash::Blake3* h) noexcept{
+                hash_ = h;
+            }
+
+            /// @brief next tick with its health record folded in (flags & kRowHealth)
+            /// @return false at the end of the segment or on a stream error (status())
+            [[nodiscard]] bool next(CanonicalRow& row);
+
+            /// @brief kOk, or kStreamCorrupt when a record is longer than the window / a read failed
+            ExitCode status() const noexcept{
+                return status_;
+            }
+
+            const SegmentInfo& info() const noexcept{
+                return info_;
+            }
+
+            std::uint64_t size_bytes() const noexcept{
+                return size_;
+            }
+
+        private:
+            enum class Kind : std::uint8_t{kTick, kHealth, kKpi, kBuildInfo, kTimeAnchor, kMeta, kOther, kBad};
+
+            // // window over the file
+            bool line_(std::string_view& out);
+            bool slide_();
+            void feed_(std::uint64_t upto) noexcept;
+            void close_() noexcept;
+
+            // // records
+            static Kind classify_(std::string_view line, std::string_view& body) noexcept;
+            bool tick_(std::string_view body, CanonicalRow& row) noexcept;
+            static bool health_(std::string_view body, CanonicalRow& row) noexcept;
+            void cold_(Kind k, std::string_view body);
+
+            int fd_{-1};
+            std::uint64_t size_{0};
+            std::size_t window_{0};
+
+            // // bytes [win_off_, win_off_ + win_len_) of the file at win_
+            const char* win_{nullptr};
+            std::uint64_t win_off_{0};
+            std::size_t win_len_{0};
+            char* buf_{nullptr};            // // no mmap: the window buffer
+            std::FILE* file_{nullptr};
+
+            // // cursor and the end of the line handed out by line_()
+            std::uint64_t cur_{0};
+            std::uint64_t next_{0};
+
+            // // payload hasher and the file bytes it has seen
+            hash::Blake3* hash_{nullptr};
+            std::uint64_t hashed_{0};
+
+            std::uint16_t file_idx_{0};
+            ExitCode status_{ExitCode::kOk};
+            SegmentInfo info_{};
+    };
+
+} // namespace ictk::tools::acr::jsonl
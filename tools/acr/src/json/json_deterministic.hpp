@@ -1,12 +1,11 @@
 #pragma once
 
-#include <array>
-#include <cmath>
 #include <string>
 #include <cstdint>
-#include <charconv>
 #include <string_view>
 
+#include "ictk/io/json_format.hpp"
+
 namespace ictk::tools::acr::jsond{
     // // helpers
     inline void _hex2(std::string& out, unsigned v){
@@ -69,41 +68,18 @@ namespace ictk::tools::acr::jsond{
         out += "\":";
     }
 
-    // // numbers -> locale independent
+    // // numbers -> locale independent, shared with the recorder (ictk/io/json_format.hpp)
     inline void num(std::string& out, std::int64_t v){
-        // fixed stack buffer 
-        std::array<char, 24> buf{};
-
-        // write decimal v into buf
-        auto r = std::to_chars(buf.data(), buf.data() + buf.size(), v);
-        out.append(buf.data(), r.ptr);
+        jsonfmt::append_i64(out, v);
     }
 
     inline void unum(std::string& out, std::uint64_t v){
-        // fixed stack buffer 
-        std::array<char, 24> buf{};
-
-        // write decimal v into buf
-        auto r = std::to_chars(buf.data(), buf.data() + buf.size(), v);
-        out.append(buf.data(), r.ptr);
+        jsonfmt::append_u64(out, v);
     }
 
+    // shortest round trip; -0 -> 0, nan / inf -> null (JSON have no NAN)
     inline void real(std::string& out, double v){
-        // JSON have no NAN
-        if (!std::isfinite(v)){
-            out += "null";
-            return;
-        }
-
-        // Normalizes -0.0 to 0.0*
-        if (v == 0.0) v = 0.0;    
-        
-        // buffer
-        std::array<char, 64> buf{};
-
-        //                                                             // general picks fixed    // precision 17
-        auto r = std::to_chars(buf.data(), buf.data() + buf.size(), v, std::chars_format::general, 17);
-        out.append(buf.data(), r.ptr);
+        jsonfmt::append_real(out, v);
     }
 
     inline void boolean(std::string& out, bool b){
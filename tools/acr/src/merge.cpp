@@ -0,0 +1,143 @@
+#include <memory>
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+
+#include "merge.hpp"
+#include "io/jsonl_reader.hpp"
+
+namespace ictk::tools::acr{
+
+    void Timeline::missing_(std::int64_t from, std::int64_t to){
+        const std::int64_t d = to - from;
+        if (step_ <= 0 || d <= step_ + step_ / 2) return;
+        const std::uint64_t n = static_cast<std::uint64_t>((d + step_ / 2) / step_ - 1);
+        counts_.gaps_ns += static_cast<std::uint64_t>(d - step_);
+        gaps_.push_back(GapSpan{from, to, n, GapReason::Missing});
+        dup_ = kNone;
+    }
+
+    void Timeline::push(std::int64_t t, std::uint16_t file_idx, Stream& s){
+        // // per stream: a step back in the segment's own order
+        if (s.started && t < s.last_t_ns){
+            ++counts_.non_monotonic_ticks;
+            gaps_.push_back(GapSpan{s.last_t_ns, t, 0, GapReason::Backward});
+            dup_ = kNone;
+        }
+        s.started = true;
+        s.last_t_ns = t;
+
+        if (!started_){
+            started_ = true;
+            first_ = min_ = high_ = t;
+            high_file_ = file_idx;
+            return;
+        }
+        min_ = std::min(min_, t);
+
+        // // against the merged high water
+        if (t < high_){
+            ++counts_.ooo_msgs;
+            return;
+        }
+        if (t == high_){
+            if (file_idx == high_file_) ++counts_.non_monotonic_ticks;
+            else ++counts_.overlap_msgs;
+
+            // // one span per run of duplicates: overlapping segments repeat every tick, not just one
+            if (dup_ != kNone && t - gaps_[dup_].end_t_ns <= std::max<std::int64_t>(step_, 0)){
+                gaps_[dup_].end_t_ns = t;
+            }else{
+                dup_ = gaps_.size();
+                gaps_.push_back(GapSpan{t, t, 0, GapReason::Duplicate});
+            }
+            high_file_ = file_idx;
+            return;
+        }
+        missing_(high_, t);
+        high_ = t;
+        high_file_ = file_idx;
+    }
+
+    void Timeline::splice(Timeline&& later){
+        if (later.empty()) return;
+        if (!started_){
+            const std::int64_t step = step_;
+            *this = std::move(later);
+            step_ = step;
+            return;
+        }
+
+        missing_(high_, later.first_);
+        counts_.non_monotonic_ticks += later.counts_.non_monotonic_ticks;
+        counts_.overlap_msgs += later.counts_.overlap_msgs;
+        counts_.ooo_msgs += later.counts_.ooo_msgs;
+        counts_.gaps_ns += later.counts_.gaps_ns;
+
+        const std::size_t base = gaps_.size();
+        gaps_.insert(gaps_.end(), later.gaps_.begin(), later.gaps_.end());
+        dup_ = later.dup_ == kNone ? kNone : base + later.dup_;
+        min_ = std::min(min_, later.min_);
+        high_ = std::max(high_, later.high_);
+        high_file_ = later.high_file_;
+    }
+
+    ExitCode merge(const IngestConfig& cfg, const std::vector<std::size_t>& files, Timeline& tl){
+        struct Input{
+            jsonl::Reader rd;
+            CanonicalRow row{};
+            Timeline::Stream s{};
+        };
+
+        const std::size_t k = files.size();
+        const std::size_t window = std::max<std::size_t>(cfg.stream_buffer_bytes / std::max<std::size_t>(k, 1), 256u << 10);
+        std::unique_ptr<Input[]> in(new Input[k]);
+
+        // // pull the next row in the time range; false at the end of the stream (status() tells why)
+        auto pull = [&](Input& x){
+            while (x.rd.next(x.row)){
+                if (!cfg.time_range_ns || (x.row.t_ns >= cfg.time_range_ns->first && x.row.t_ns <= cfg.time_range_ns->second)) return true;
+            }
+            return false;
+        };
+
+        // // heap of the k heads: (t_ns, file_idx, seq) smallest on top
+        struct Head{
+            std::int64_t t_ns;
+            std::uint16_t file_idx;
+            std::uint64_t seq;
+            std::size_t j;
+        };
+        const auto later = [](const Head& a, const Head& b) noexcept{
+            return std::tie(a.t_ns, a.file_idx, a.seq) > std::tie(b.t_ns, b.file_idx, b.seq);
+        };
+        std::vector<Head> heap;
+        heap.reserve(k);
+
+        for (std::size_t j = 0; j < k; ++j){
+            const std::size_t i = files[j];
+            if (const ExitCode st = in[j].rd.open(cfg.mcap_paths[i], window, static_cast<std::uint16_t>(i)); !is_ok(st)) return st;
+            if (pull(in[j])) heap.push_back(Head{in[j].row.t_ns, in[j].row.file_idx, in[j].row.seq, j});
+            else if (!is_ok(in[j].rd.status())) return in[j].rd.status();
+        }
+        std::make_heap(heap.begin(), heap.end(), later);
+
+        while (!heap.empty()){
+            std::pop_heap(heap.begin(), heap.end(), later);
+            const std::size_t j = heap.back().j;
+            heap.pop_back();
+
+            Input& x = in[j];
+            tl.push(x.row.t_ns, x.row.file_idx, x.s);
+            if (pull(x)){
+                heap.push_back(Head{x.row.t_ns, x.row.file_idx, x.row.seq, j});
+                std::push_heap(heap.begin(), heap.end(), later);
+            }else if (!is_ok(x.rd.status())){
+                return x.rd.status();
+            }
+        }
+        return ExitCode::kOk;
+    }
+
+} // namespace ictk::tools::acr
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "ictk/tools/acr/report.hpp"
+#include "ictk/tools/acr/exit_codes.hpp"
+#include "ictk/tools/acr/ingest_config.hpp"
+
+/*
+Merged tick order: (t_ns, file_idx, seq) over every segment's row stream
+    Timeline: online classifier, O(1) state + one Stream per input; GapSpans are appended as they are found, rows never kept
+        stream step back (t < the stream's previous t)  -> non_monotonic_ticks, Backward span [prev, t]
+        t == the merged high water, same segment        -> non_monotonic_ticks, Duplicate span
+        t == the merged high water, other segment       -> overlap_msgs, Duplicate span (contiguous duplicates share one)
+        t <  the merged high water                      -> ooo_msgs
+        t -  the merged high water > 1.5 step           -> Missing span, round(delta / step) - 1 ticks, delta - step in gaps_ns
+    merge(): k readers (one window each) under a min heap of their heads -> O(k) memory for any span of time
+*/
+namespace ictk::tools::acr{
+
+    class Timeline{
+        public:
+            /// @brief one input stream's last row (backward steps are per stream)
+            struct Stream{
+                bool started{false};
+                std::int64_t last_t_ns{0};
+            };
+
+            /// @param step_ns tick period of the evidence (dt_ns * tick_decimation); 0 -> no missing tick check
+            explicit Timeline(std::int64_t step_ns = 0) noexcept : step_(step_ns){}
+
+            void set_step(std::int64_t step_ns) noexcept{
+                step_ = step_ns;
+            }
+
+            /// @brief next row in merged order, from stream s of segment file_idx
+            void push(std::int64_t t_ns, std::uint16_t file_idx, Stream& s);
+
+            /// @brief append a timeline of later rows (all of them above this one's high water, e.g. the next segment
+            ///     of a rotation): the step between the two is checked, counts and spans are taken over
+            void splice(Timeline&& later);
+
+            bool empty() const noexcept{
+                return !started_;
+            }
+
+            std::int64_t min_t_ns() const noexcept{
+                return min_;
+            }
+
+            std::int64_t max_t_ns() const noexcept{
+                return high_;
+            }
+
+            const Anomalies& counts() const noexcept{
+                return counts_;
+            }
+
+            std::vector<GapSpan>& gaps() noexcept{
+                return gaps_;
+            }
+
+            /// @brief every scalar of the state (boundary rows, open span, counts) -> v(member&); gaps() holds the rest
+            ///     used by the ACR cache: a reloaded Timeline splices exactly like the one that was saved
+            template <class V>
+            void visit_state(V&& v){
+                v(step_); v(started_); v(first_); v(min_); v(high_); v(high_file_); v(dup_);
+                v(counts_.non_monotonic_ticks); v(counts_.overlap_msgs); v(counts_.ooo_msgs); v(counts_.gaps_ns);
+            }
+
+            template <class V>
+            void visit_state(V&& v) const{
+                v(step_); v(started_); v(first_); v(min_); v(high_); v(high_file_); v(dup_);
+                v(counts_.non_monotonic_ticks); v(counts_.overlap_msgs); v(counts_.ooo_msgs); v(counts_.gaps_ns);
+            }
+
+            const std::vector<GapSpan>& gaps() const noexcept{
+                return gaps_;
+            }
+
+        private:
+            void missing_(std::int64_t from, std::int64_t to);
+
+            static constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+
+            std::int64_t step_{0};
+            bool started_{false};
+            std::int64_t first_{0};         // // first row pushed (the join point for splice)
+            std::int64_t min_{0};
+            std::int64_t high_{0};          // // high water of the merged order
+            std::uint16_t high_file_{0};
+            std::size_t dup_{kNone};        // // open Duplicate span (gaps_ index)
+
+            Anomalies counts_{};
+            std::vector<GapSpan> gaps_;
+    };
+
+    /// @brief k-way merge of cfg.mcap_paths[files...] by (t_ns, file_idx, seq), each row pushed into tl
+    ///     every reader gets stream_buffer_bytes / k of window (256 KiB at least); rows outside time_range_ns are skipped
+    /// @return kOk, or the first reader failure
+    [[nodiscard]] ExitCode merge(const IngestConfig& cfg, const std::vector<std::size_t>& files, Timeline& tl);
+
+} // namespace ictk::tools::acr
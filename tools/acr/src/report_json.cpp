@@ -0,0 +1,195 @@
+#include <string>
+#include <vector>
+
+#include "ictk/tools/acr/ingest.hpp"
+
+#include "json/json_deterministic.hpp"
+
+/*
+Report -> JSON: members in struct order, no whitespace, shortest round trip numbers (jsond)
+    same report -> same bytes, so reports can be hashed and diffed
+*/
+namespace ictk::tools::acr{
+
+    namespace{
+        using namespace jsond;
+
+        void kv(std::string& o, std::string_view k, std::string_view v){
+            key(o, k);
+            str(o, v);
+        }
+
+        void kv(std::string& o, std::string_view k, std::uint64_t v){
+            key(o, k);
+            unum(o, v);
+        }
+
+        void kv(std::string& o, std::string_view k, std::int64_t v){
+            key(o, k);
+            num(o, v);
+        }
+
+        void kv(std::string& o, std::string_view k, bool v){
+            key(o, k);
+            boolean(o, v);
+        }
+
+        void strings(std::string& o, std::string_view k, const std::vector<std::string>& v){
+            key(o, k);
+            array(o, [&]{
+                for (std::size_t i = 0; i < v.size(); ++i){
+                    if (i) comma(o);
+                    str(o, v[i]);
+                }
+            });
+        }
+
+        const char* gap_reason(GapReason r) noexcept{
+            switch (r){
+            case GapReason::Duplicate: return "duplicate";
+            case GapReason::Backward: return "backward";
+            case GapReason::Missing: return "missing";
+            default: return "unknown";
+            }
+        }
+    } // namespace
+
+    std::string to_json(const Report& r){
+        std::string o;
+        o.reserve(1024 + 256 * r.files.size());
+
+        object(o, [&]{
+            key(o, "manifest");
+            object(o, [&]{
+                kv(o, "acr_version", r.manifest.acr_version); comma(o);
+                kv(o, "ictk_version", r.manifest.ictk_version); comma(o);
+                kv(o, "git_sha", r.manifest.git_sha); comma(o);
+                kv(o, "schema_id", r.manifest.schema_id);
+            });
+            comma(o);
+
+            key(o, "files");
+            array(o, [&]{
+                for (std::size_t i = 0; i < r.files.size(); ++i){
+                    const FileEntry& f = r.files[i];
+                    if (i) comma(o);
+                    object(o, [&]{
+                        kv(o, "path", f.path); comma(o);
+                        kv(o, "size_bytes", f.size_bytes); comma(o);
+                        kv(o, "messages_total", f.messages_total); comma(o);
+                        kv(o, "tick", f.tick); comma(o);
+                        kv(o, "health", f.health); comma(o);
+                        kv(o, "kpi", f.kpi); comma(o);
+                        kv(o, "first_t_ns", f.first_t_ns); comma(o);
+                        kv(o, "last_t_ns", f.last_t_ns); comma(o);
+                        kv(o, "payload_blake3", f.payload_blake3); comma(o);
+                        key(o, "payload_hash_ok");
+                        if (f.payload_hash_ok) boolean(o, *f.payload_hash_ok);
+                        else null(o);
+                        comma(o);
+                        kv(o, "schema_ok", f.schema_ok);
+                    });
+                }
+            });
+            comma(o);
+
+            key(o, "merged");
+            object(o, [&]{
+                kv(o, "tick", r.merged.tick); comma(o);
+                kv(o, "health", r.merged.health); comma(o);
+                kv(o, "kpi", r.merged.kpi); comma(o);
+                kv(o, "first_t_ns", r.merged.first_t_ns); comma(o);
+                kv(o, "last_t_ns", r.merged.last_t_ns);
+            });
+            comma(o);
+
+            key(o, "anomalies");
+            object(o, [&]{
+                kv(o, "non_monotonic_ticks", r.anomalies.non_monotonic_ticks); comma(o);
+                kv(o, "overlap_msgs", r.anomalies.overlap_msgs); comma(o);
+                kv(o, "ooo_msgs", r.anomalies.ooo_msgs); comma(o);
+                kv(o, "gaps_ns", r.anomalies.gaps_ns); comma(o);
+                kv(o, "timebase_mixed", r.anomalies.timebase_mixed);
+            });
+            comma(o);
+
+            key(o, "buildinfo");
+            object(o, [&]{
+                kv(o, "dt_ns", r.buildinfo.dt_ns); comma(o);
+                kv(o, "tick_decimation", static_cast<std::uint64_t>(r.buildinfo.tick_decimation)); comma(o);
+                kv(o, "controller_id", r.buildinfo.controller_id); comma(o);
+                kv(o, "asset_id", r.buildinfo.asset_id); comma(o);
+                kv(o, "clock_domain", r.buildinfo.clock_domain); comma(o);
+                kv(o, "kernel_clocksource", r.buildinfo.kernel_clocksource); comma(o);
+                kv(o, "dt_source", r.buildinfo.dt_source); comma(o);
+                kv(o, "dt_p50_est_ns", r.buildinfo.dt_p50_est_ns); comma(o);
+                key(o, "dt_p95_over_p50");
+                real(o, r.buildinfo.dt_p95_over_p50);
+            });
+            comma(o);
+            kv(o, "unstable_dt", r.unstable_dt); comma(o);
+
+            key(o, "buildinfo_conflicts");
+            array(o, [&]{
+                for (std::size_t i = 0; i < r.buildinfo_conflicts.size(); ++i){
+                    if (i) comma(o);
+                    object(o, [&]{
+                        kv(o, "field", r.buildinfo_conflicts[i].field); comma(o);
+                        strings(o, "values", r.buildinfo_conflicts[i].values);
+                    });
+                }
+            });
+            comma(o);
+
+            key(o, "required_fields_present");
+            object(o, [&]{
+                kv(o, "y0", r.required_fields_present.y0); comma(o);
+                kv(o, "u_pre0", r.required_fields_present.u_pre0); comma(o);
+                kv(o, "u_post0", r.required_fields_present.u_post0); comma(o);
+                kv(o, "r0", r.required_fields_present.r0);
+            });
+            comma(o);
+            strings(o, "missing_fields", r.missing_fields); comma(o);
+
+            key(o, "schema");
+            object(o, [&]{
+                kv(o, "tick_root", r.schema.tick_root); comma(o);
+                kv(o, "health_root", r.schema.health_root); comma(o);
+                kv(o, "kpi_root", r.schema.kpi_root); comma(o);
+                strings(o, "bfbs_sidecar_sha256", r.schema.bfbs_sidecar_sha256); comma(o);
+                strings(o, "bfbs_mcap_snapshot", r.schema.bfbs_mcap_snapshot); comma(o);
+                strings(o, "bfbs_mismatch", r.schema.bfbs_mismatch);
+            });
+            comma(o);
+
+            kv(o, "notes", r.notes); comma(o);
+            strings(o, "warnings", r.warnings); comma(o);
+            kv(o, "monotonic_nudges", r.monotonic_nudges); comma(o);
+
+            key(o, "gaps");
+            array(o, [&]{
+                for (std::size_t i = 0; i < r.gaps.size(); ++i){
+                    const GapSpan& g = r.gaps[i];
+                    if (i) comma(o);
+                    object(o, [&]{
+                        kv(o, "start_t_ns", g.start_t_ns); comma(o);
+                        kv(o, "end_t_ns", g.end_t_ns); comma(o);
+                        kv(o, "missing_ticks", g.missing_ticks); comma(o);
+                        kv(o, "reason", std::string_view(gap_reason(g.reason)));
+                    });
+                }
+            });
+            comma(o);
+
+            key(o, "events_probe");
+            object(o, [&]{
+                kv(o, "present", r.events_probe.present); comma(o);
+                kv(o, "lines_total", r.events_probe.lines_total); comma(o);
+                kv(o, "lines_bad", r.events_probe.lines_bad); comma(o);
+                kv(o, "estop_true_count", r.events_probe.estop_true_count);
+            });
+        });
+        return o;
+    }
+
+} // namespace ictk::tools::acr
@@ -0,0 +1,105 @@
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <filesystem>
+
+#include "ictk/tools/acr/ingest.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk::tools;
+
+static constexpr std::int64_t kMs = 1000000;
+
+// // a RecorderJsonl segment with ticks [a, b) ms
+static void segment(const fs::path& p, int a, int b){
+    std::FILE* f = std::fopen(p.string().c_str(), "wb");
+    if (!f) return;
+    std::fprintf(f, "{\"meta\":{\"schema_backend\":\"jsonl\",\"dt_ns\":%lld,\"tick_decimation\":1}}\n", static_cast<long long>(kMs));
+    std::uint64_t seq = 0;
+    for (int t = a; t < b; ++t){
+        std::fprintf(f, "{\"ch\":\"/ictk/tick\",\"body\":{\"t_ns\":%lld,\"seq\":%llu,\"y0\":1,\"r0\":1,\"u_pre0\":0,\"u_post0\":0}}\n",
+            static_cast<long long>(t * kMs), static_cast<unsigned long long>(++seq));
+    }
+    std::fclose(f);
+}
+
+// // report JSON over paths, through the cache or not
+static std::string run(const std::vector<fs::path>& paths, const fs::path* cache, acr::ExitCode& rc,
+                       std::optional<std::pair<std::int64_t, std::int64_t>> range = std::nullopt, acr::Report* out = nullptr){
+    acr::IngestConfig cfg;
+    cfg.mcap_paths = paths;
+    cfg.time_range_ns = range;
+    if (cache) cfg.cache_path = *cache;
+    acr::Report rep;
+    rc = acr::ingest(cfg, rep);
+    std::string j = acr::to_json(rep);
+    if (out) *out = std::move(rep);
+    return j;
+}
+
+int main(){
+    const fs::path dir = "evidence_acr_cache";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const fs::path cache = dir / "acr.cache";
+
+    // // day 1: three rotated segments with a gap between the last two
+    std::vector<fs::path> seg = {dir / "s0.jsonl", dir / "s1.jsonl", dir / "s2.jsonl"};
+    segment(seg[0], 0, 100);
+    segment(seg[1], 100, 200);
+    segment(seg[2], 210, 300);
+
+    acr::ExitCode rc{};
+    const std::string day1 = run(seg, &cache, rc);
+    if (rc != acr::ExitCode::kOk || !fs::exists(cache)) return 1;
+    if (run(seg, nullptr, rc) != day1) return 2;
+
+    // Case 1: a new segment -> the cached three are stitched to it, same report as a full run
+    seg.push_back(dir / "s3.jsonl");
+    segment(seg[3], 300, 400);
+    const std::string day2 = run(seg, &cache, rc);
+    if (rc != acr::ExitCode::kOk || day2 != run(seg, nullptr, rc)) return 10;
+    if (day2 == day1 || day2.find(R"("tick":390,)") == std::string::npos) return 11;
+
+    // Case 2: overwritten in place at the same size, mtime put back -> ctime moved, so scanned again and the garbage is seen
+    {
+        const auto mt = fs::last_write_time(seg[1]);
+        const auto sz = fs::file_size(seg[1]);
+        if (std::FILE* f = std::fopen(seg[1].string().c_str(), "r+b")){
+            const std::string junk(static_cast<std::size_t>(sz), '#');
+            std::fwrite(junk.data(), 1, junk.size(), f);
+            std::fclose(f);
+        }
+        fs::last_write_time(seg[1], mt);
+        acr::Report rep;
+        acr::ExitCode fresh{};
+        const std::string j = run(seg, &cache, rc, std::nullopt, &rep);
+        if (j == day2 || j != run(seg, nullptr, fresh) || rc != fresh) return 20;
+        if (rep.files.size() != 4 || rep.files[1].schema_ok || rep.files[1].messages_total >= 100) return 21;
+        if (rc == acr::ExitCode::kOk) return 22;
+    }
+
+    // Case 3: a changed size (rewritten segment) -> scanned again
+    segment(seg[1], 100, 205);
+    {
+        const std::string j = run(seg, &cache, rc);
+        if (j != run(seg, nullptr, rc) || j == day2) return 30;
+    }
+
+    // Case 4: another time range -> the cache does not apply (its scans were cut by the old range)
+    {
+        const auto range = std::make_pair(std::int64_t{50} * kMs, std::int64_t{250} * kMs);
+        if (run(seg, &cache, rc, range) != run(seg, nullptr, rc, range)) return 40;
+    }
+
+    // Case 5: a damaged cache is ignored, then rewritten
+    fs::resize_file(cache, fs::file_size(cache) / 2);
+    {
+        const std::string j = run(seg, &cache, rc);
+        if (rc != acr::ExitCode::kOk || j != run(seg, nullptr, rc)) return 50;
+    }
+
+    fs::remove_all(dir);
+    return 0;
+}
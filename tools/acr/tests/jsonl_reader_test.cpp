@@ -0,0 +1,166 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <filesystem>
+
+#include "ictk/tools/recorder.hpp"
+#include "ictk/tools/acr/ingest.hpp"
+
+#include "hash.hpp"
+#include "io/jsonl_reader.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk::tools;
+
+static std::vector<fs::path> segments(const char* dir){
+    std::vector<fs::path> v;
+    for (auto& e : fs::directory_iterator(dir)){
+        if (e.path().extension() == ".jsonl") v.push_back(e.path());
+    }
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+// // every tick of one recorded segment, in order, with its health folded in; 0 or the failing check
+static int check_segment(const fs::path& p, std::size_t window, int n){
+    acr::jsonl::Reader rd;
+    if (rd.open(p, window, 3) != acr::ExitCode::kOk) return 1;
+    acr::CanonicalRow row{};
+    int i = 0;
+    while (rd.next(row)){
+        if (row.t_ns != 1000000LL * i || row.seq != static_cast<std::uint64_t>(i + 1) || row.file_idx != 3) return 2;
+        if (row.y0 != 0.25 * i || row.r0 != 1.0 / (i + 1) || row.u_pre != -0.1 * i || row.u_post != std::sqrt(static_cast<double>(i))) return 3;
+        if (!(row.flags & acr::kRowHealth) || row.sat_pct != 0.5 * (i % 7)) return 4;
+        if (((row.flags & acr::kRowFallback) != 0) != (i % 5 == 0) || row.mode != 2) return 5;
+        ++i;
+    }
+    if (rd.status() != acr::ExitCode::kOk || i != n) return 6;
+    const auto& in = rd.info();
+    if (in.tick != static_cast<std::uint64_t>(n) || in.health != in.tick || in.kpi != 1 || in.bad_lines != 0) return 7;
+    if (!in.has_meta || !in.has_buildinfo || in.dt_ns != 1000000 || in.asset_id != "cell\"7" || in.clock != acr::ClockDomain::MONO) return 8;
+    if (in.first_t_ns != 0 || in.last_t_ns != 1000000LL * (n - 1)) return 9;
+    return 0;
+}
+
+int main(){
+    const char* dir = "evidence_acr_jsonl";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    const int kTicks = 20000;
+    {
+        RecorderOptions opt;
+        opt.backend = RecorderOptions::Jsonl;
+        opt.out_dir = dir;
+        opt.dt_ns_hint = 1000000;
+        opt.asset_id = "cell\"7";
+        opt.fixed_mode = ictk::kShadow;
+        opt.io_buffer_kb = 64;
+        auto rec = Recorder::open(opt);
+        if (!rec) return 10;
+        rec->write_buildinfo();
+        rec->write_time_anchor(0, 0);
+        for (int i = 0; i < kTicks; ++i){
+            TickSample s{};
+            s.t = 1000000LL * i;
+            s.y0 = 0.25 * i;
+            s.r0 = 1.0 / (i + 1);
+            s.u_pre0 = -0.1 * i;
+            s.u_post0 = std::sqrt(static_cast<double>(i));
+            s.h.saturation_pct = 0.5 * (i % 7);
+            s.h.fallback_active = i % 5 == 0;
+            rec->write_tick(s);
+        }
+        rec->write_kpi({});
+        rec->flush();
+    }
+    auto seg = segments(dir);
+    if (seg.size() != 1) return 11;
+
+    // Case 1: windows of two pages (a remap every few dozen records) and one window over the whole file agree
+    if (const int rc = check_segment(seg[0], 1, kTicks); rc) return 20 + rc;
+    if (const int rc = check_segment(seg[0], 64u << 20, kTicks); rc) return 40 + rc;
+
+    // Case 2: a segment cut mid record (crash) -> the rows before it, the cut line counted bad
+    const fs::path cut = fs::path(dir) / "cut.jsonl";
+    {
+        std::string text;
+        if (std::FILE* f = std::fopen(seg[0].string().c_str(), "rb")){
+            char buf[1 << 14];
+            for (std::size_t n; (n = std::fread(buf, 1, sizeof(buf), f)) > 0;) text.append(buf, n);
+            std::fclose(f);
+        }
+        const std::size_t last = text.rfind("/ictk/tick");   // // inside the last tick record
+        if (last == std::string::npos) return 59;
+        fs::copy_file(seg[0], cut);
+        fs::resize_file(cut, last + 20);
+    }
+    {
+        acr::jsonl::Reader rd;
+        if (rd.open(cut, 8192) != acr::ExitCode::kOk) return 60;
+        acr::CanonicalRow row{};
+        std::uint64_t n = 0;
+        while (rd.next(row)) ++n;
+        if (rd.status() != acr::ExitCode::kOk || n != static_cast<std::uint64_t>(kTicks - 1) || rd.info().bad_lines != 1) return 61;
+    }
+
+    // Case 3: a record longer than the window is a stream error, not a silent skip
+    const fs::path big = fs::path(dir) / "big.jsonl";
+    if (std::FILE* f = std::fopen(big.string().c_str(), "wb")){
+        const std::string pad(3 * 4096 * 4, 'x');
+        std::fprintf(f, "{\"ch\":\"/ictk/other\",\"body\":{\"s\":\"%s\"}}\n", pad.c_str());
+        std::fclose(f);
+    }
+    {
+        acr::jsonl::Reader rd;
+        if (rd.open(big, 8192) != acr::ExitCode::kOk) return 70;
+        acr::CanonicalRow row{};
+        while (rd.next(row)){}
+        if (rd.status() != acr::ExitCode::kStreamCorrupt) return 71;
+    }
+
+    // Case 4: ingest -> report over two segments; the cut copy still parses, its bad line is a warning
+    {
+        acr::IngestConfig cfg;
+        cfg.mcap_paths = {seg[0], cut};
+        cfg.stream_buffer_bytes = 16384;
+        acr::Report rep;
+        if (acr::ingest(cfg, rep) != acr::ExitCode::kOk) return 80;
+        if (rep.files.size() != 2 || rep.files[0].tick != static_cast<std::uint64_t>(kTicks) || !rep.files[0].schema_ok || rep.files[1].schema_ok) return 81;
+        if (rep.merged.tick != rep.files[0].tick + rep.files[1].tick || rep.merged.last_t_ns != 1000000LL * (kTicks - 1)) return 82;
+        if (rep.buildinfo.asset_id != "cell\"7" || rep.buildinfo.dt_ns != 1000000 || rep.warnings.size() != 1) return 83;
+        const std::string j = acr::to_json(rep);
+        if (j.find(R"("asset_id":"cell\"7")") == std::string::npos || j != acr::to_json(rep)) return 84;
+
+        cfg.mcap_paths = {big};
+        if (acr::ingest(cfg, rep) != acr::ExitCode::kStreamCorrupt) return 85;
+    }
+
+    // Case 5: the parse pass feeds the hasher -> the same digest as reading the file for it, whatever the window
+    for (const fs::path& p : {seg[0], cut}){
+        const auto want = hash::blake3_256_file(p.string().c_str());
+        for (const std::size_t window : {std::size_t{1}, std::size_t{16384}, std::size_t{64u << 20}}){
+            acr::jsonl::Reader rd;
+            hash::Blake3 h;
+            if (rd.open(p, window) != acr::ExitCode::kOk) return 90;
+            rd.hash_into(&h);
+            acr::CanonicalRow row{};
+            while (rd.next(row)){}
+            if (rd.status() != acr::ExitCode::kOk || h.digest() != want) return 91;
+        }
+    }
+    {
+        acr::IngestConfig cfg;
+        cfg.mcap_paths = {seg[0]};
+        acr::Report rep;
+        if (acr::ingest(cfg, rep) != acr::ExitCode::kOk || rep.files.size() != 1 || rep.files[0].payload_hash_ok) return 92;
+        const auto want = hash::blake3_256_file(seg[0].string().c_str());
+        if (!rep.files[0].payload_blake3.empty() && rep.files[0].payload_blake3 != hash::to_hex({want.data(), want.size()})) return 93;
+    }
+
+    fs::remove_all(dir);
+    return 0;
+}
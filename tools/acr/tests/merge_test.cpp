@@ -0,0 +1,107 @@
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <filesystem>
+
+#include "ictk/tools/acr/ingest.hpp"
+
+#include "merge.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk::tools;
+
+static constexpr std::int64_t kMs = 1000000;
+
+// // a RecorderJsonl segment with ticks at the given milliseconds, in the given order
+static void segment(const fs::path& p, const std::vector<int>& ms){
+    std::FILE* f = std::fopen(p.string().c_str(), "wb");
+    if (!f) return;
+    std::fprintf(f, "{\"meta\":{\"schema_backend\":\"jsonl\",\"dt_ns\":%lld,\"tick_decimation\":1}}\n", static_cast<long long>(kMs));
+    std::uint64_t seq = 0;
+    for (const int t : ms){
+        std::fprintf(f, "{\"ch\":\"/ictk/tick\",\"body\":{\"t_ns\":%lld,\"seq\":%llu,\"y0\":1,\"r0\":1,\"u_pre0\":0,\"u_post0\":0}}\n",
+            static_cast<long long>(t * kMs), static_cast<unsigned long long>(++seq));
+    }
+    std::fclose(f);
+}
+
+static std::vector<int> range(int a, int b){
+    std::vector<int> v;
+    for (int t = a; t < b; ++t) v.push_back(t);
+    return v;
+}
+
+static bool span(const acr::GapSpan& g, int a, int b, std::uint64_t missing, acr::GapReason r){
+    return g.start_t_ns == a * kMs && g.end_t_ns == b * kMs && g.missing_ticks == missing && g.reason == r;
+}
+
+int main(){
+    const fs::path dir = "evidence_acr_merge";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    // // A: 5 ticks missing after 39, 60 twice, 80 -> 78; B: rotation right after A; C: 10 ticks missing after B;
+    // //    D: overlaps the last 10 ticks of C
+    std::vector<int> a = range(0, 40);
+    for (int t : range(45, 61)) a.push_back(t);
+    for (int t : range(60, 81)) a.push_back(t);
+    a.push_back(78);
+    for (int t : range(81, 100)) a.push_back(t);
+    segment(dir / "a.jsonl", a);
+    segment(dir / "b.jsonl", range(100, 150));
+    segment(dir / "c.jsonl", range(160, 200));
+    segment(dir / "d.jsonl", range(190, 210));
+
+    acr::IngestConfig cfg;
+    cfg.mcap_paths = {dir / "c.jsonl", dir / "a.jsonl", dir / "d.jsonl", dir / "b.jsonl"};    // // not in time order
+
+    // Case 1: counts and spans in merged order; C + D go through the k-way merge, A and B are spliced
+    std::string j1;
+    {
+        cfg.threads = 1;
+        acr::Report rep;
+        if (acr::ingest(cfg, rep) != acr::ExitCode::kOk) return 1;
+        const auto& an = rep.anomalies;
+        if (an.non_monotonic_ticks != 2 || an.overlap_msgs != 10 || an.ooo_msgs != 1 || an.gaps_ns != static_cast<std::uint64_t>(15 * kMs)) return 2;
+        if (rep.gaps.size() != 5) return 3;
+        if (!span(rep.gaps[0], 39, 45, 5, acr::GapReason::Missing) || !span(rep.gaps[1], 60, 60, 0, acr::GapReason::Duplicate)) return 4;
+        if (!span(rep.gaps[2], 80, 78, 0, acr::GapReason::Backward) || !span(rep.gaps[3], 149, 160, 10, acr::GapReason::Missing)) return 5;
+        if (!span(rep.gaps[4], 190, 199, 0, acr::GapReason::Duplicate)) return 6;
+        j1 = acr::to_json(rep);
+    }
+
+    // Case 2: same report for any worker count
+    {
+        cfg.threads = 4;
+        acr::Report rep;
+        if (acr::ingest(cfg, rep) != acr::ExitCode::kOk || acr::to_json(rep) != j1) return 10;
+    }
+
+    // Case 3: the time range applies to the timeline too
+    {
+        cfg.time_range_ns = std::make_pair(std::int64_t{0}, 120 * kMs);
+        acr::Report rep;
+        if (acr::ingest(cfg, rep) != acr::ExitCode::kOk) return 20;
+        if (rep.gaps.size() != 3 || rep.anomalies.gaps_ns != static_cast<std::uint64_t>(5 * kMs) || rep.anomalies.overlap_msgs != 0) return 21;
+        cfg.time_range_ns.reset();
+    }
+
+    // Case 4: merge() alone over interleaved segments -> one stream in (t_ns, file_idx) order, no anomaly
+    {
+        std::vector<int> even, odd;
+        for (int t = 0; t < 1000; ++t) (t % 2 ? odd : even).push_back(t);
+        segment(dir / "even.jsonl", even);
+        segment(dir / "odd.jsonl", odd);
+        acr::IngestConfig mc;
+        mc.mcap_paths = {dir / "odd.jsonl", dir / "even.jsonl"};
+        acr::Timeline tl(kMs);
+        if (acr::merge(mc, {0, 1}, tl) != acr::ExitCode::kOk) return 30;
+        const auto& c = tl.counts();
+        if (c.non_monotonic_ticks || c.overlap_msgs || c.ooo_msgs || c.gaps_ns || !tl.gaps().empty()) return 31;
+        if (tl.min_t_ns() != 0 || tl.max_t_ns() != 999 * kMs) return 32;
+    }
+
+    fs::remove_all(dir);
+    return 0;
+}
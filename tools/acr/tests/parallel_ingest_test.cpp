@@ -0,0 +1,83 @@
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <filesystem>
+
+#include "ictk/tools/recorder.hpp"
+#include "ictk/tools/acr/ingest.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk::tools;
+
+// // report JSON over paths with a given worker count; rc out
+static std::string run(std::vector<fs::path> paths, std::size_t threads, acr::ExitCode& rc){
+    acr::IngestConfig cfg;
+    cfg.mcap_paths = std::move(paths);
+    cfg.threads = threads;
+    cfg.stream_buffer_bytes = 64u << 10;
+    acr::Report rep;
+    rc = acr::ingest(cfg, rep);
+    return acr::to_json(rep);
+}
+
+int main(){
+    const char* dir = "evidence_acr_parallel";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    // // ~8 MB of ticks rotated at 1 MB -> several segments, only the first with buildinfo / time anchor
+    const int kTicks = 20000;
+    {
+        RecorderOptions opt;
+        opt.backend = RecorderOptions::Jsonl;
+        opt.out_dir = dir;
+        opt.dt_ns_hint = 1000000;
+        opt.asset_id = "cell7";
+        opt.segment_max_mb = 1;
+        opt.io_buffer_kb = 64;
+        auto rec = Recorder::open(opt);
+        if (!rec) return 1;
+        rec->write_buildinfo();
+        rec->write_time_anchor(0, 0);
+        for (int i = 0; i < kTicks; ++i){
+            TickSample s{};
+            s.t = 1000000LL * i;
+            s.y0 = 0.5 * i;
+            s.r0 = 1.0;
+            s.u_pre0 = 0.25 * i;
+            s.u_post0 = 0.25 * i;
+            rec->write_tick(s);
+            rec->rotate_if_needed();
+        }
+        rec->flush();
+    }
+
+    std::vector<fs::path> seg;
+    for (auto& e : fs::directory_iterator(dir)){
+        if (e.path().extension() == ".jsonl") seg.push_back(e.path());
+    }
+    std::sort(seg.begin(), seg.end());
+    if (seg.size() < 4) return 2;
+
+    // // Case 1: same bytes for any worker count (0 = hardware threads, more workers than segments)
+    acr::ExitCode rc{};
+    const std::string serial = run(seg, 1, rc);
+    if (rc != acr::ExitCode::kOk) return 10;
+    for (const std::size_t t : {std::size_t{2}, std::size_t{4}, std::size_t{0}, std::size_t{64}}){
+        if (run(seg, t, rc) != serial || rc != acr::ExitCode::kOk) return 11;
+    }
+    if (serial.find(R"("tick":20000,)") == std::string::npos) return 12;
+
+    // // Case 2: a failing segment in the middle -> the report ends there, the same way for every worker count
+    auto bad = seg;
+    bad.insert(bad.begin() + 2, fs::path(dir) / "missing.jsonl");
+    bad.insert(bad.begin() + 1, fs::path(dir) / "other.mcap");
+    const std::string serial_bad = run(bad, 1, rc);
+    if (rc != acr::ExitCode::kOpenFail) return 20;
+    for (const std::size_t t : {std::size_t{3}, std::size_t{8}}){
+        if (run(bad, t, rc) != serial_bad || rc != acr::ExitCode::kOpenFail) return 21;
+    }
+    if (serial_bad.find("other.mcap: no reader") == std::string::npos || serial_bad.find("missing.jsonl") != std::string::npos) return 22;
+    return 0;
+}
@@ -18,11 +18,11 @@ using namespace ictk::tools;
 static void usage(){
     std::fprintf(
         stderr,
-        "ictk_record --out <dir> --schema-dir <dir> --tick-decim N "
-        "--segment-max-mb 256 --fsync-policy {every_segment|every_n_mb} --fsync-n-mb 16 "
+        "ictk_record --out <dir> --schema-dir <dir> --backend {auto|jsonl|mcap|columnar} [--compress] --tick-decim N [--decim-mode {sample|envelope}] "
+        "--segment-max-mb 256 --fsync-policy {every_segment|every_n_mb} --fsync-n-mb 16 [--prealloc] [--writeback-kb 1024] [--direct-io] "
         "--dt-ns <n> --controller-id <str> --asset-id <str> "
         "--mode {primary|residual|shadow|cooperative} --stdin-csv\n"
-        "CSV (if --stdin-csv): t_ns,y0,r0,u_pre0,u_post0\n"
+        "CSV (if --stdin-csv): t_ns,y0,r0,u_pre0,u_post0[,lat_ns]\n"
     );
 }
 
@@ -67,14 +67,26 @@ int main(int argc, char** argv){
     const char* controller_id = "";
     const char* asset_id = "";
     const char* mode_str = "primary"; // default
+    const char* backend = "auto";
+    bool compress = false;
+    const char* decim_mode = "sample";
+    bool prealloc = false;
+    int writeback_kb = 1024;
+    bool direct_io = false;
 
     for (int i=1; i<argc; i++){
          if (!std::strcmp(argv[i], "--out") && i+1<argc) out_dir = argv[++i];
         else if (!std::strcmp(argv[i], "--schema-dir") && i+1<argc) schema_dir = argv[++i];
+        else if (!std::strcmp(argv[i], "--backend") && i+1<argc) backend = argv[++i];
+        else if (!std::strcmp(argv[i], "--compress")) compress = true;
         else if (!std::strcmp(argv[i], "--tick-decim") && i+1<argc) tick_decim = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--decim-mode") && i+1<argc) decim_mode = argv[++i];
         else if (!std::strcmp(argv[i], "--segment-max-mb") && i+1<argc) segment_mb = std::atoi(argv[++i]);
         else if (!std::strcmp(argv[i], "--fsync-policy") && i+1<argc) fsync_policy = argv[++i];
         else if (!std::strcmp(argv[i], "--fsync-n-mb") && i+1<argc) fsync_n_mb = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--prealloc")) prealloc = true;
+        else if (!std::strcmp(argv[i], "--writeback-kb") && i+1<argc) writeback_kb = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--direct-io")) direct_io = true;
         else if (!std::strcmp(argv[i], "--dt-ns") && i+1<argc) dt_ns_hint = std::atoll(argv[++i]);
         else if (!std::strcmp(argv[i], "--controller-id") && i+1<argc) controller_id = argv[++i];
         else if (!std::strcmp(argv[i], "--asset-id") && i+1<argc) asset_id = argv[++i];
@@ -107,10 +119,14 @@ int main(int argc, char** argv){
         : static_cast<std::size_t>(16);
 
     opt.tick_decimation = (tick_decim > 0) ? tick_decim : 1;
+    opt.decimation = std::strcmp(decim_mode, "envelope") == 0 ? RecorderOptions::Envelope : RecorderOptions::Sample;
     opt.fsync_policy = (
         std::strcmp(fsync_policy, "every_segment") == 0 ?
         RecorderOptions::EverySegment : RecorderOptions::EveryNMB
     );
+    opt.preallocate = prealloc;
+    opt.writeback_kb = writeback_kb > 0 ? static_cast<std::size_t>(writeback_kb) : 0;
+    opt.direct_io = direct_io;
     opt.dt_ns_hint = dt_ns_hint;
     opt.controller_id = controller_id;
     opt.asset_id = asset_id;
@@ -121,7 +137,13 @@ int main(int argc, char** argv){
     else if (!std::strcmp(mode_str, "shadow"))      opt.fixed_mode = ictk::kShadow;
     else if (!std::strcmp(mode_str, "cooperative")) opt.fixed_mode = ictk::kCooperative;
 
+    if      (!std::strcmp(backend, "jsonl"))    opt.backend = RecorderOptions::Jsonl;
+    else if (!std::strcmp(backend, "mcap"))     opt.backend = RecorderOptions::Mcap;
+    else if (!std::strcmp(backend, "columnar")) opt.backend = RecorderOptions::Columnar;
+    opt.compress = compress;
+
     auto rec = Recorder::open(opt);
+    if (!rec) return 1;
     rec->write_buildinfo();
 
     // compute anchor
@@ -137,13 +159,13 @@ int main(int argc, char** argv){
         while (std::fgets(line, sizeof(line), stdin)){
             line[strcspn(line, "\r\n")] = 0;
 
-            long long t_ns=0;
+            long long t_ns=0, lat_ns=0;
             double y0=0, r0=0, upre=0, upost=0;
             const int n = std::sscanf(
-                line, " %lld , %lf , %lf , %lf , %lf",
-                &t_ns, &y0, &r0, &upre, &upost
+                line, " %lld , %lf , %lf , %lf , %lf , %lld",
+                &t_ns, &y0, &r0, &upre, &upost, &lat_ns
             );
-            if (n != 5) continue;
+            if (n < 5) continue;
 
             TickSample s;
             s.t = t_ns;
@@ -151,6 +173,7 @@ int main(int argc, char** argv){
             s.r0 = r0;
             s.u_pre0 = upre;
             s.u_post0 = upost;
+            s.lat_ns = (n == 6) ? lat_ns : 0;    // optional column: measured update() latency
 
             s.h.deadline_miss_count = 0;
             s.h.saturation_pct = 0.0;
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "ictk/io/kpi.hpp"
+#include "ictk/io/spsc_ring.hpp"
+#include "ictk/core/memory_arena.hpp"
+#include "ictk/tools/recorder.hpp"
+
+/*
+AsyncRecorder: Recorder behind a lock free ring, for calling from the control loop
+    control thread: enqueue(sample) only -> copy into a preallocated slot, no allocation, no lock, no syscall;
+        ring full -> sample dropped and counted (KpiCounters::telemetry_drops), the loop never waits
+    vector ticks (rec.dims): each slot owns a fixed 2 ny + 2 nu + nx Scalar block next to the ring, sized at open;
+        enqueue(TickVector) memcpy's the spans into it, the writer hands the block to the backend's write_tick_vec
+    writer thread (start()): drains the ring in batches, formats through the backend (write_tick),
+        rotates / fsyncs segments; sleeps poll_ns when the ring is empty (the producer never wakes it)
+    everything else (buildinfo, time anchor, kpi, flush) is for non RT threads; it shares a mutex with the writer
+    stop() / the destructor drain what is left, then flush
+*/
+namespace ictk::tools{
+
+    struct AsyncRecorderOptions{
+        RecorderOptions rec{};
+        std::size_t capacity{8192};         // TickSample slots (rounded up to a power of two)
+        long long poll_ns{1'000'000};       // writer sleep when the ring is empty
+        int writer_cpu{-1};                 // pin the writer thread; -1 -> no pinning
+    };
+
+    class AsyncRecorder{
+        public:
+            // // ring + backend allocated here (start up), nothing later on the producer side
+            [[nodiscard]] static std::unique_ptr<AsyncRecorder> open(const AsyncRecorderOptions& opt);
+
+            ~AsyncRecorder();
+
+            AsyncRecorder(const AsyncRecorder&) = delete;
+            AsyncRecorder& operator=(const AsyncRecorder&) = delete;
+
+            // // RT side, wait free; false -> ring full, sample dropped
+            bool enqueue(const TickSample& s) noexcept{
+                if (channels_ == 0) return ring_.try_push(s);
+                return ring_.try_push(s, [&](std::size_t slot) noexcept{
+                    Scalar* d = vec_ + slot * channels_;
+                    std::memset(d, 0, channels_ * sizeof(Scalar));
+                    if (dims_.ny){
+                        d[0] = static_cast<Scalar>(s.y0);
+                        d[dims_.ny] = static_cast<Scalar>(s.r0);
+                    }
+                    if (dims_.nu){
+                        d[2 * dims_.ny] = static_cast<Scalar>(s.u_pre0);
+                        d[2 * dims_.ny + dims_.nu] = static_cast<Scalar>(s.u_post0);
+                    }
+                });
+            }
+
+            // // every channel: one memcpy per span into the slot's block (rec.dims wide, missing values -> 0)
+            bool enqueue(const TickVector& v) noexcept{
+                if (channels_ == 0) return ring_.try_push(channel0(v));
+                return ring_.try_push(channel0(v), [&](std::size_t slot) noexcept{
+                    Scalar* d = vec_ + slot * channels_;
+                    d = put_(d, v.y, dims_.ny);
+                    d = put_(d, v.r, dims_.ny);
+                    d = put_(d, v.u_pre, dims_.nu);
+                    d = put_(d, v.u_post, dims_.nu);
+                    (void)put_(d, v.xhat, dims_.nx);
+                });
+            }
+
+            // // writer thread
+            bool start();
+            void stop();
+
+            void write_buildinfo();
+            void write_time_anchor(std::int64_t epoch_mono_ns, std::int64_t epoch_utc_ns);
+
+            // // kpi.telemetry_drops is filled in from the ring
+            void write_kpi(const ictk::KpiCounters& kpi);
+
+            // // drain everything queued so far, then flush / fsync the backend
+            void flush();
+
+            std::uint64_t dropped() const noexcept{
+                return ring_.drops();
+            }
+            std::uint64_t written() const noexcept{
+                return written_.load(std::memory_order_relaxed);
+            }
+            std::size_t capacity() const noexcept{
+                return ring_.capacity();
+            }
+
+        private:
+            AsyncRecorder() = default;
+
+            static Scalar* put_(Scalar* d, std::span<const Scalar> src, std::size_t n) noexcept{
+                const std::size_t m = src.size() < n ? src.size() : n;
+                if (m) std::memcpy(d, src.data(), m * sizeof(Scalar));
+                if (m < n) std::memset(d + m, 0, (n - m) * sizeof(Scalar));
+                return d + n;
+            }
+
+            // // consumer side; caller holds mu_
+            std::size_t drain_();
+            void writer_main_();
+
+            std::unique_ptr<Recorder> rec_;
+            std::vector<std::byte> mem_;
+            std::unique_ptr<MemoryArena> arena_;
+            SpscRing<TickSample> ring_;
+            ictk::Dims dims_{};
+            std::size_t channels_{0};
+            Scalar* vec_{nullptr};          // // capacity() x channels_, slot i at vec_ + i * channels_
+
+            long long poll_ns_{1'000'000};
+            int cpu_{-1};
+
+            std::mutex mu_;
+            std::thread writer_;
+            std::atomic<bool> quit_{false};
+            std::atomic<std::uint64_t> written_{0};
+    };
+
+} // namespace ictk::tools
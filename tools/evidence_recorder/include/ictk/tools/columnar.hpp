@@ -0,0 +1,330 @@
+#pragma once
+
+#include <span>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/*
+Columnar evidence segment (.ictkcol): dependency free binary backend for Recorder + zero copy mmap reader
+    little endian, fixed width; every header / block starts on a 64 byte boundary (mmap base is page aligned
+        -> column spans are aligned for SIMD loads)
+
+    file:   FileHeader | block | block | ... | IndexEntry[n] | Footer
+    block:  BlockHeader (64) | payload (padded to 64), checksum = xxh64(payload) in the header
+    kTicks payload: one column per field, kTickCols columns of `rows` values each, column c at col_offset(c, rows)
+        (8 byte values, flags column = 1 byte per row, last)
+        vector channels (FileHeader ny / nu / nx > 0, Recorder::write_tick_vec): one more double column per channel
+        after the flags, channel k = column kTickCols + k, in the order y[ny] r[ny] u_pre[nu] u_post[nu] xhat[nx]
+    envelope segments (FileHeader env_window > 0, RecorderOptions::Envelope): one row per window of ticks; the columns
+        above hold the last value (health: max / OR over the window, lat_ns: max), then after the vector channels
+        env_n (i64 ticks in the window) and min, max, mean per signal (y0 r0 u_pre0 u_post0, then the vector channels)
+        encoding kTimeSeries: per column delta-of-delta / Gorilla XOR / run length streams instead (src/ts_codec.hpp);
+        the reader decodes them into the same column layout
+    footer: index of every block (offset, kind, rows, t range) + xxh64 of the index, written when the segment closes;
+        a segment cut short (crash, still open) has no footer -> the reader recovers the blocks by a forward scan
+*/
+namespace ictk::tools::columnar{
+
+    inline constexpr std::uint64_t kFileMagic   = 0x314C4F434B544349ull;   // "ICTKCOL1"
+    inline constexpr std::uint64_t kFooterMagic = 0x31444E454B544349ull;   // "ICTKEND1"
+    inline constexpr std::uint32_t kBlockMagic  = 0x314B4C42u;             // "BLK1"
+    inline constexpr std::uint32_t kVersion = 1;
+    inline constexpr std::size_t kAlign = 64;
+
+    enum class BlockKind : std::uint32_t{
+        kBuildInfo = 1,
+        kTimeAnchor = 2,
+        kTicks = 3,
+        kKpi = 4,
+    };
+
+    enum class BlockEncoding : std::uint32_t{
+        kRaw = 0,           // columns as laid out by col_offset(), zero copy
+        kTimeSeries = 1,    // kTicks only: compressed column streams, decoded through a TickScratch
+    };
+
+    // // kTicks column order; every column 8 bytes per row except kFlags (1 byte: bit0 fallback_active, bit1 novelty_flag)
+    enum TickCol : std::uint32_t{
+        kTNs, kLatNs,
+        kY0, kR0, kUPre0, kUPost0,
+        kDeadlineMiss, kSaturationPct, kRateHits, kJerkHits,
+        kAwTermMag, kLastClampMag, kLastRateClipMag, kLastJerkClipMag,
+        kSatHitMask, kRateHitMask, kJerkHitMask,
+        kFlags,
+        kTickCols
+    };
+
+    inline constexpr std::uint8_t kFlagFallback = 1u << 0;
+    inline constexpr std::uint8_t kFlagNovelty  = 1u << 1;
+
+    constexpr std::size_t pad_to(std::size_t n, std::size_t a) noexcept{
+        return (n + a - 1) / a * a;
+    }
+
+    // // upper bound on 2 * ny + 2 * nu + nx; keeps every offset computation far from overflow
+    inline constexpr std::uint32_t kMaxVecChannels = 1u << 16;
+
+    // // envelope signals ahead of the vector channels
+    inline constexpr std::uint32_t kEnvScalarSignals = 4;
+
+    // // byte offset of column c inside a kTicks payload of `rows` rows
+    // // (c >= kTickCols -> extra 8 byte column c - kTickCols: vector channels, then envelope;
+    // //  c == kTickCols + extra -> payload size before padding)
+    constexpr std::size_t col_offset(std::uint32_t c, std::size_t rows) noexcept{
+        return c <= kFlags ? static_cast<std::size_t>(c) * rows * 8u
+                           : static_cast<std::size_t>(kFlags) * rows * 8u + pad_to(rows, 8) + static_cast<std::size_t>(c - kTickCols) * rows * 8u;
+    }
+
+    constexpr std::size_t tick_payload_bytes(std::size_t rows, std::uint32_t extra = 0) noexcept{
+        return pad_to(col_offset(kTickCols + extra, rows), kAlign);
+    }
+
+    struct FileHeader{
+        std::uint64_t magic{kFileMagic};
+        std::uint32_t version{kVersion};
+        std::uint32_t header_bytes{64};
+        std::int64_t dt_ns{0};              // loop period hint at open (0 -> unknown)
+        std::uint32_t tick_decimation{1};
+        std::uint32_t mode{0};              // ictk::CommandMode of every tick in the segment
+        std::uint32_t block_rows{0};        // rows per full kTicks block
+        std::uint32_t ny{0};                // vector channels per row: y / r have ny, u_pre / u_post nu, xhat nx
+        std::uint32_t nu{0};
+        std::uint32_t nx{0};
+        std::uint32_t env_window{0};        // ticks per row of an envelope segment; 0 -> one row per recorded tick
+        std::uint32_t reserved0{0};
+        std::uint64_t reserved1{0};
+
+        std::uint32_t channels() const noexcept{
+            return 2u * ny + 2u * nu + nx;
+        }
+
+        std::uint32_t env_cols() const noexcept{
+            return env_window ? 1u + 3u * (kEnvScalarSignals + channels()) : 0u;
+        }
+
+        // // 8 byte columns after the flags
+        std::uint32_t extra_cols() const noexcept{
+            return channels() + env_cols();
+        }
+    };
+
+    struct BlockHeader{
+        std::uint32_t magic{kBlockMagic};
+        std::uint32_t kind{0};              // BlockKind
+        std::uint32_t rows{0};              // kTicks: rows, others: 1
+        std::uint32_t encoding{0};          // BlockEncoding
+        std::uint64_t payload_bytes{0};     // multiple of kAlign
+        std::int64_t t_first{0};            // kTicks: t_ns of the first / last row
+        std::int64_t t_last{0};
+        std::uint64_t seq_first{0};         // kTicks: seq of row 0, row i -> seq_first + i
+        std::uint64_t checksum{0};          // xxh64(payload, seed 0)
+        std::uint64_t reserved1{0};
+    };
+
+    struct IndexEntry{
+        std::uint64_t offset{0};            // BlockHeader offset in the file
+        std::uint32_t kind{0};
+        std::uint32_t rows{0};
+        std::int64_t t_first{0};
+        std::int64_t t_last{0};
+    };
+
+    struct Footer{
+        std::uint64_t index_offset{0};
+        std::uint64_t entries{0};
+        std::uint64_t index_checksum{0};    // xxh64 of the IndexEntry array
+        std::uint64_t tick_rows{0};
+        std::uint64_t reserved[3]{};
+        std::uint64_t magic{kFooterMagic};
+    };
+
+    // // kTimeAnchor payload
+    struct TimeAnchorRecord{
+        std::int64_t epoch_mono_ns{0};
+        std::int64_t epoch_utc_ns{0};
+    };
+
+    // // kKpi payload, same fields as the JSONL /ictk/kpi_report record
+    struct KpiRecord{
+        std::uint64_t updates{0};
+        std::uint64_t watchdog_trips{0};
+        std::uint64_t fallback_entries{0};
+        std::uint64_t limit_hits{0};
+        std::uint64_t telemetry_drops{0};
+        std::uint64_t lat_samples{0};
+        std::uint64_t health_gap_frames{0};
+        std::uint64_t reserved{0};
+        double iae{0.0};
+        double itae{0.0};
+        double tvu{0.0};
+        double p50_lat_us{0.0};
+        double p95_lat_us{0.0};
+        double p99_lat_us{0.0};
+        double p999_lat_us{0.0};
+        double max_lat_us{0.0};
+    };
+
+    static_assert(sizeof(FileHeader) == 64 && sizeof(BlockHeader) == 64 && sizeof(Footer) == 64, "fixed on-disk layout");
+    static_assert(sizeof(IndexEntry) == 32 && sizeof(TimeAnchorRecord) == 16 && sizeof(KpiRecord) == 128, "fixed on-disk layout");
+
+    // // kBuildInfo payload: u64 dt_ns, u32 tick_decimation, u32 count, then count x (u32 len, bytes) in this order
+    struct BuildInfoView{
+        std::string_view ictk_version;
+        std::string_view git_sha;
+        std::string_view compiler;
+        std::string_view flags;
+        std::string_view scalar_type;
+        std::string_view controller_id;
+        std::string_view asset_id;
+        std::uint64_t dt_ns{0};
+        std::uint32_t tick_decimation{0};
+    };
+
+    // // one kTicks block, straight out of the mapping
+    struct TickBlock{
+        std::uint64_t seq_first{0};
+        std::span<const std::int64_t> t_ns;
+        std::span<const std::int64_t> lat_ns;
+        std::span<const double> y0, r0, u_pre0, u_post0;
+        std::span<const std::uint64_t> deadline_miss_count;
+        std::span<const double> saturation_pct;
+        std::span<const std::uint64_t> rate_limit_hits, jerk_limit_hits;
+        std::span<const double> aw_term_mag, last_clamp_mag, last_rate_clip_mag, last_jerk_clip_mag;
+        std::span<const std::uint64_t> sat_hit_mask, rate_hit_mask, jerk_hit_mask;
+        std::span<const std::uint8_t> flags;
+
+        // // vector channels, channel-major: channel k = vec[k * rows() .. (k + 1) * rows())
+        std::uint32_t ny{0}, nu{0}, nx{0};
+        std::span<const double> vec;
+
+        // // envelope segments: ticks folded into each row, then min / max / mean per signal
+        // // (signal 0..3 = y0 r0 u_pre0 u_post0, 4 + k = vector channel k)
+        std::span<const std::int64_t> env_n;
+        std::span<const double> env;
+
+        std::size_t rows() const noexcept{
+            return t_ns.size();
+        }
+
+        std::span<const double> y(std::uint32_t i) const noexcept{
+            return chan_(i);
+        }
+        std::span<const double> r(std::uint32_t i) const noexcept{
+            return chan_(ny + i);
+        }
+        std::span<const double> u_pre(std::uint32_t i) const noexcept{
+            return chan_(2u * ny + i);
+        }
+        std::span<const double> u_post(std::uint32_t i) const noexcept{
+            return chan_(2u * ny + nu + i);
+        }
+        std::span<const double> xhat(std::uint32_t i) const noexcept{
+            return chan_(2u * ny + 2u * nu + i);
+        }
+
+        std::span<const double> env_min(std::uint32_t sig) const noexcept{
+            return col_(env, 3u * sig);
+        }
+        std::span<const double> env_max(std::uint32_t sig) const noexcept{
+            return col_(env, 3u * sig + 1u);
+        }
+        std::span<const double> env_mean(std::uint32_t sig) const noexcept{
+            return col_(env, 3u * sig + 2u);
+        }
+
+        private:
+            std::span<const double> chan_(std::uint32_t k) const noexcept{
+                return col_(vec, k);
+            }
+
+            std::span<const double> col_(std::span<const double> all, std::uint32_t k) const noexcept{
+                const std::size_t at = static_cast<std::size_t>(k) * rows();
+                if (at + rows() > all.size()) return {};
+                return all.subspan(at, rows());
+            }
+    };
+
+    // // decode target for kTimeSeries blocks; reused across calls, grows to the largest block once
+    struct TickScratch{
+        std::vector<std::byte> buf;
+    };
+
+    // xxHash64 (the block / index checksum)
+    std::uint64_t xxh64(const void* p, std::size_t n, std::uint64_t seed = 0) noexcept;
+
+    /*
+    Reader: read-only mapping of one segment, nothing is copied or parsed per row
+        open() checks the header, takes the footer index (or recovers it by a forward scan) and bounds checks every block
+        verify(): recompute the block checksums; a scan that needs integrity calls it once (memory bandwidth bound)
+    */
+    class Reader{
+        public:
+            // nullptr -> missing / not a columnar segment / bad header
+            [[nodiscard]] static std::unique_ptr<Reader> open(const std::string& path);
+
+            ~Reader();
+
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            const FileHeader& header() const noexcept{
+                return hdr_;
+            }
+
+            // true -> footer present and intact; false -> blocks recovered by a forward scan (segment was not closed)
+            bool indexed() const noexcept{
+                return indexed_;
+            }
+
+            std::span<const IndexEntry> index() const noexcept{
+                return index_;
+            }
+
+            std::uint64_t tick_rows() const noexcept{
+                return tick_rows_;
+            }
+
+            // index()[i] must be a kRaw kTicks block (spans into the mapping); anything else -> empty
+            TickBlock ticks(std::size_t i) const noexcept;
+
+            // any kTicks block: kRaw -> spans into the mapping, kTimeSeries -> decoded into s; empty -> corrupt block
+            TickBlock ticks(std::size_t i, TickScratch& s) const;
+
+            BlockEncoding encoding(std::size_t i) const noexcept;
+
+            // checksum of block i / of every block
+            bool verify(std::size_t i) const noexcept;
+            bool verify() const noexcept;
+
+            // last record of that kind in the segment; false / nullptr -> none
+            bool buildinfo(BuildInfoView& out) const noexcept;
+            const KpiRecord* kpi() const noexcept;
+            const TimeAnchorRecord* time_anchor() const noexcept;
+
+            std::span<const std::byte> bytes() const noexcept{
+                return {base_, size_};
+            }
+
+        private:
+            Reader() = default;
+
+            bool load_index_() noexcept;
+            void recover_index_();
+            const std::byte* payload_(std::size_t i) const noexcept;
+            const std::byte* last_(BlockKind k, std::size_t need) const noexcept;
+
+            const std::byte* base_{nullptr};
+            std::size_t size_{0};
+            bool mapped_{false};
+
+            FileHeader hdr_{};
+            bool indexed_{false};
+            std::vector<IndexEntry> index_;
+            std::uint64_t tick_rows_{0};
+    };
+
+} // namespace ictk::tools::columnar
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <span>
 #include <memory>
+#include <cstddef>
 #include <cstdint>
 
 #include "ictk/io/kpi.hpp"
@@ -20,6 +22,8 @@ namespace ictk::tools{
         r0 = reference
         u_pre0 = controller output before clamp
         u_post0 = after clamp
+        lat_ns = update() latency (0 -> not measured), e.g. Result::update_ns from CyclicExecutor / ParallelExecutor;
+            feeds the p50..max KPIs, every tick, decimated or not
         */
         t_ns t{};
         double y0{};
@@ -27,19 +31,77 @@ namespace ictk::tools{
         double u_pre0{};
         double u_post0{};
         ControllerHealth h{};
+        dt_ns lat_ns{0};
     };
-    
+
+    struct TickVector{
+        /*
+        full vector tick: spans over the controller's own buffers, nothing is copied until the recorder stores them
+        y, r = ny; u_pre, u_post = nu; xhat = nx (empty -> no observer)
+        recorded width is RecorderOptions::dims: longer spans are cut, shorter ones (and empty xhat) are recorded as 0
+        */
+        t_ns t{};
+        std::span<const Scalar> y;
+        std::span<const Scalar> r;
+        std::span<const Scalar> u_pre;
+        std::span<const Scalar> u_post;
+        std::span<const Scalar> xhat;
+        ControllerHealth h{};
+        dt_ns lat_ns{0};
+    };
+
+    // // channel 0 of a vector tick as the scalar record (KPIs, backends without vector support)
+    inline TickSample channel0(const TickVector& v) noexcept{
+        TickSample s{};
+        s.t = v.t;
+        s.y0 = v.y.empty() ? 0.0 : static_cast<double>(v.y[0]);
+        s.r0 = v.r.empty() ? 0.0 : static_cast<double>(v.r[0]);
+        s.u_pre0 = v.u_pre.empty() ? 0.0 : static_cast<double>(v.u_pre[0]);
+        s.u_post0 = v.u_post.empty() ? 0.0 : static_cast<double>(v.u_post[0]);
+        s.h = v.h;
+        s.lat_ns = v.lat_ns;
+        return s;
+    }
+
     struct RecorderOptions{
+        /*
+        Auto = MCAP when built with ICTK_RECORDER_BACKEND_MCAP, else JSONL
+        Columnar = binary column blocks + footer index (ictk/tools/columnar.hpp), no external deps
+        */
+        enum Backend{Auto, Jsonl, Mcap, Columnar} backend{Auto};
         const char* out_dir{"evidence"}; // output directory for logs
         const char* schema_dir{ICTK_FB_SCHEMA_DIR}; // FlatBuffer schema location
         std::size_t segment_max_mb{256};    // rotation size threshold
         std::size_t fsync_n_mb{16}; // between fsync calls
         int tick_decimation{1}; // every Nth tick (load reduction)
+        /*
+        tick_decimation > 1:
+        Sample = keep every Nth tick, drop the rest
+        Envelope = one record per window of N ticks: last value + min / max / mean of every signal,
+            health counters / magnitudes max-ed, hit masks + flags OR-ed, max latency
+        */
+        enum Decimation{Sample, Envelope} decimation{Sample};
         enum FsyncPolicy{EverySegment, EveryNMB} fsync_policy{EveryNMB}; // choose fsync on segment boundary or rolling
         long long dt_ns_hint{0};    // loop period hint
         const char* controller_id{""}; // eg: ictk_pid_v1 or ictk_mpc_v2
         const char* asset_id{""};   // id of assets
         ictk::CommandMode fixed_mode{ictk::kPrimary};
+        std::size_t io_buffer_kb{1024};     // JSONL / Columnar: output buffer size (page aligned, reused)
+        std::size_t io_buffers{4};          // JSONL / Columnar: buffers in flight to the flusher thread before write_tick waits
+        /*
+        JSONL / Columnar segment I/O (Linux; elsewhere plain buffered writes):
+        preallocate = reserve segment_max_mb of blocks when a segment opens (fallocate), released past the data at close;
+            opt-in: a crash skips that close, and the reserved blocks stay allocated past EOF
+        writeback_kb = start the write-out of every N KiB written (sync_file_range) and wait for the window before,
+            so dirty pages stay bounded and fsync / rotation only flush the last window; 0 -> page cache decides
+        direct_io = O_DIRECT segment files from the page aligned buffers (buffered where the filesystem refuses it)
+        */
+        bool preallocate{false};
+        std::size_t writeback_kb{1024};
+        bool direct_io{false};
+        std::size_t block_rows{4096};       // Columnar: ticks per column block (64 .. 1M)
+        bool compress{false};               // Columnar: tick blocks through the time-series codec (delta-of-delta / XOR / run length)
+        ictk::Dims dims{};                  // vector channels per tick (write_tick_vec); all 0 -> channel 0 only
     };
     
     class Recorder{
@@ -58,6 +120,11 @@ namespace ictk::tools{
             // core per cycle evidence 
             virtual void write_tick(const TickSample& s) = 0;
 
+            // every channel (opt.dims wide) as packed arrays; default: channel 0 through write_tick
+            virtual void write_tick_vec(const TickVector& v){
+                write_tick(channel0(v));
+            }
+
             // dumps aggregated KPI counters
             virtual void write_kpi(const ictk::KpiCounters& kpi) = 0;
 
@@ -66,5 +133,10 @@ namespace ictk::tools{
 
             // force fsync
             virtual void flush() = 0;
+
+            // ticks lost because no segment could be opened (the backend stops retrying after the first failure)
+            virtual std::uint64_t dropped_ticks() const noexcept{
+                return 0;
+            }
     };
 } // namespace ictk::tools
\ No newline at end of file
@@ -234,7 +234,16 @@ struct Tick FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_Y0 = 8,
     VT_R0 = 10,
     VT_U_PRE0 = 12,
-    VT_U_POST0 = 14
+    VT_U_POST0 = 14,
+    VT_Y = 16,
+    VT_R = 18,
+    VT_U_PRE = 20,
+    VT_U_POST = 22,
+    VT_XHAT = 24,
+    VT_ENV_N = 26,
+    VT_ENV_MIN = 28,
+    VT_ENV_MAX = 30,
+    VT_ENV_MEAN = 32
   };
   uint64_t seq() const {
     return GetField<uint64_t>(VT_SEQ, 0);
@@ -254,6 +263,33 @@ struct Tick FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   double u_post0() const {
     return GetField<double>(VT_U_POST0, 0.0);
   }
+  const flatbuffers::Vector<double> *y() const {
+    return GetPointer<const flatbuffers::Vector<double> *>(VT_Y);
+  }
+  const flatbuffers::Vector<double> *r() const {
+    return GetPointer<const flatbuffers::Vector<double> *>(VT_R);
+  }
+  const flatbuffers::Vector<double> *u_pre() const {
+    return GetPointer<const flatbuffers::Vector<double> *>(VT_U_PRE);
+  }
+  const flatbuffers::Vector<double> *u_post() const {
+    return GetPointer<const flatbuffers::Vector<double> *>(VT_U_POST);
+  }
+  const flatbuffers::Vector<double> *xhat() const {
+    return GetPointer<const flatbuffers::Vector<double> *>(VT_XHAT);
+  }
+  uint64_t env_n() const {
+    return GetField<uint64_t>(VT_ENV_N, 0);
+  }
+  const flatbuffers::Vector<double> *env_min() const {
+    return GetPointer<const flatbuffers::Vector<double> *>(VT_ENV_MIN);
+  }
+  const flatbuffers::Vector<double> *env_max() const {
+    return GetPointer<const flatbuffers::Vector<double> *>(VT_ENV_MAX);
+  }
+  const flatbuffers::Vector<double> *env_mean() const {
+    return GetPointer<const flatbuffers::Vector<double> *>(VT_ENV_MEAN);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint64_t>(verifier, VT_SEQ, 8) &&
@@ -262,6 +298,23 @@ struct Tick FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyField<double>(verifier, VT_R0, 8) &&
            VerifyField<double>(verifier, VT_U_PRE0, 8) &&
            VerifyField<double>(verifier, VT_U_POST0, 8) &&
+           VerifyOffset(verifier, VT_Y) &&
+           verifier.VerifyVector(y()) &&
+           VerifyOffset(verifier, VT_R) &&
+           verifier.VerifyVector(r()) &&
+           VerifyOffset(verifier, VT_U_PRE) &&
+           verifier.VerifyVector(u_pre()) &&
+           VerifyOffset(verifier, VT_U_POST) &&
+           verifier.VerifyVector(u_post()) &&
+           VerifyOffset(verifier, VT_XHAT) &&
+           verifier.VerifyVector(xhat()) &&
+           VerifyField<uint64_t>(verifier, VT_ENV_N, 8) &&
+           VerifyOffset(verifier, VT_ENV_MIN) &&
+           verifier.VerifyVector(env_min()) &&
+           VerifyOffset(verifier, VT_ENV_MAX) &&
+           verifier.VerifyVector(env_max()) &&
+           VerifyOffset(verifier, VT_ENV_MEAN) &&
+           verifier.VerifyVector(env_mean()) &&
            verifier.EndTable();
   }
 };
@@ -288,6 +341,33 @@ struct TickBuilder {
   void add_u_post0(double u_post0) {
     fbb_.AddElement<double>(Tick::VT_U_POST0, u_post0, 0.0);
   }
+  void add_y(flatbuffers::Offset<flatbuffers::Vector<double>> y) {
+    fbb_.AddOffset(Tick::VT_Y, y);
+  }
+  void add_r(flatbuffers::Offset<flatbuffers::Vector<double>> r) {
+    fbb_.AddOffset(Tick::VT_R, r);
+  }
+  void add_u_pre(flatbuffers::Offset<flatbuffers::Vector<double>> u_pre) {
+    fbb_.AddOffset(Tick::VT_U_PRE, u_pre);
+  }
+  void add_u_post(flatbuffers::Offset<flatbuffers::Vector<double>> u_post) {
+    fbb_.AddOffset(Tick::VT_U_POST, u_post);
+  }
+  void add_xhat(flatbuffers::Offset<flatbuffers::Vector<double>> xhat) {
+    fbb_.AddOffset(Tick::VT_XHAT, xhat);
+  }
+  void add_env_n(uint64_t env_n) {
+    fbb_.AddElement<uint64_t>(Tick::VT_ENV_N, env_n, 0);
+  }
+  void add_env_min(flatbuffers::Offset<flatbuffers::Vector<double>> env_min) {
+    fbb_.AddOffset(Tick::VT_ENV_MIN, env_min);
+  }
+  void add_env_max(flatbuffers::Offset<flatbuffers::Vector<double>> env_max) {
+    fbb_.AddOffset(Tick::VT_ENV_MAX, env_max);
+  }
+  void add_env_mean(flatbuffers::Offset<flatbuffers::Vector<double>> env_mean) {
+    fbb_.AddOffset(Tick::VT_ENV_MEAN, env_mean);
+  }
   explicit TickBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -306,17 +386,79 @@ inline flatbuffers::Offset<Tick> CreateTick(
     double y0 = 0.0,
     double r0 = 0.0,
     double u_pre0 = 0.0,
-    double u_post0 = 0.0) {
+    double u_post0 = 0.0,
+    flatbuffers::Offset<flatbuffers::Vector<double>> y = 0,
+    flatbuffers::Offset<flatbuffers::Vector<double>> r = 0,
+    flatbuffers::Offset<flatbuffers::Vector<double>> u_pre = 0,
+    flatbuffers::Offset<flatbuffers::Vector<double>> u_post = 0,
+    flatbuffers::Offset<flatbuffers::Vector<double>> xhat = 0,
+    uint64_t env_n = 0,
+    flatbuffers::Offset<flatbuffers::Vector<double>> env_min = 0,
+    flatbuffers::Offset<flatbuffers::Vector<double>> env_max = 0,
+    flatbuffers::Offset<flatbuffers::Vector<double>> env_mean = 0) {
   TickBuilder builder_(_fbb);
+  builder_.add_env_n(env_n);
   builder_.add_u_post0(u_post0);
   builder_.add_u_pre0(u_pre0);
   builder_.add_r0(r0);
   builder_.add_y0(y0);
   builder_.add_t_ns(t_ns);
   builder_.add_seq(seq);
+  builder_.add_env_mean(env_mean);
+  builder_.add_env_max(env_max);
+  builder_.add_env_min(env_min);
+  builder_.add_xhat(xhat);
+  builder_.add_u_post(u_post);
+  builder_.add_u_pre(u_pre);
+  builder_.add_r(r);
+  builder_.add_y(y);
   return builder_.Finish();
 }
 
+inline flatbuffers::Offset<Tick> CreateTickDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint64_t seq = 0,
+    uint64_t t_ns = 0,
+    double y0 = 0.0,
+    double r0 = 0.0,
+    double u_pre0 = 0.0,
+    double u_post0 = 0.0,
+    const std::vector<double> *y = nullptr,
+    const std::vector<double> *r = nullptr,
+    const std::vector<double> *u_pre = nullptr,
+    const std::vector<double> *u_post = nullptr,
+    const std::vector<double> *xhat = nullptr,
+    uint64_t env_n = 0,
+    const std::vector<double> *env_min = nullptr,
+    const std::vector<double> *env_max = nullptr,
+    const std::vector<double> *env_mean = nullptr) {
+  auto y__ = y ? _fbb.CreateVector<double>(*y) : 0;
+  auto r__ = r ? _fbb.CreateVector<double>(*r) : 0;
+  auto u_pre__ = u_pre ? _fbb.CreateVector<double>(*u_pre) : 0;
+  auto u_post__ = u_post ? _fbb.CreateVector<double>(*u_post) : 0;
+  auto xhat__ = xhat ? _fbb.CreateVector<double>(*xhat) : 0;
+  auto env_min__ = env_min ? _fbb.CreateVector<double>(*env_min) : 0;
+  auto env_max__ = env_max ? _fbb.CreateVector<double>(*env_max) : 0;
+  auto env_mean__ = env_mean ? _fbb.CreateVector<double>(*env_mean) : 0;
+  return ictk::metrics::CreateTick(
+      _fbb,
+      seq,
+      t_ns,
+      y0,
+      r0,
+      u_pre0,
+      u_post0,
+      y__,
+      r__,
+      u_pre__,
+      u_post__,
+      xhat__,
+      env_n,
+      env_min__,
+      env_max__,
+      env_mean__);
+}
+
 struct Health FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef HealthBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
@@ -471,7 +613,10 @@ struct Kpi FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_P50_LAT_US = 18,
     VT_P95_LAT_US = 20,
     VT_P99_LAT_US = 22,
-    VT_HEALTH_GAP_FRAMES = 24
+    VT_HEALTH_GAP_FRAMES = 24,
+    VT_P999_LAT_US = 26,
+    VT_MAX_LAT_US = 28,
+    VT_LAT_SAMPLES = 30
   };
   uint64_t updates() const {
     return GetField<uint64_t>(VT_UPDATES, 0);
@@ -506,6 +651,15 @@ struct Kpi FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   uint64_t health_gap_frames() const {
     return GetField<uint64_t>(VT_HEALTH_GAP_FRAMES, 0);
   }
+  double p999_lat_us() const {
+    return GetField<double>(VT_P999_LAT_US, 0.0);
+  }
+  double max_lat_us() const {
+    return GetField<double>(VT_MAX_LAT_US, 0.0);
+  }
+  uint64_t lat_samples() const {
+    return GetField<uint64_t>(VT_LAT_SAMPLES, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint64_t>(verifier, VT_UPDATES, 8) &&
@@ -519,6 +673,9 @@ struct Kpi FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyField<double>(verifier, VT_P95_LAT_US, 8) &&
            VerifyField<double>(verifier, VT_P99_LAT_US, 8) &&
            VerifyField<uint64_t>(verifier, VT_HEALTH_GAP_FRAMES, 8) &&
+           VerifyField<double>(verifier, VT_P999_LAT_US, 8) &&
+           VerifyField<double>(verifier, VT_MAX_LAT_US, 8) &&
+           VerifyField<uint64_t>(verifier, VT_LAT_SAMPLES, 8) &&
            verifier.EndTable();
   }
 };
@@ -560,6 +717,15 @@ struct KpiBuilder {
   void add_health_gap_frames(uint64_t health_gap_frames) {
     fbb_.AddElement<uint64_t>(Kpi::VT_HEALTH_GAP_FRAMES, health_gap_frames, 0);
   }
+  void add_p999_lat_us(double p999_lat_us) {
+    fbb_.AddElement<double>(Kpi::VT_P999_LAT_US, p999_lat_us, 0.0);
+  }
+  void add_max_lat_us(double max_lat_us) {
+    fbb_.AddElement<double>(Kpi::VT_MAX_LAT_US, max_lat_us, 0.0);
+  }
+  void add_lat_samples(uint64_t lat_samples) {
+    fbb_.AddElement<uint64_t>(Kpi::VT_LAT_SAMPLES, lat_samples, 0);
+  }
   explicit KpiBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -583,8 +749,14 @@ inline flatbuffers::Offset<Kpi> CreateKpi(
     double p50_lat_us = 0.0,
     double p95_lat_us = 0.0,
     double p99_lat_us = 0.0,
-    uint64_t health_gap_frames = 0) {
+    uint64_t health_gap_frames = 0,
+    double p999_lat_us = 0.0,
+    double max_lat_us = 0.0,
+    uint64_t lat_samples = 0) {
   KpiBuilder builder_(_fbb);
+  builder_.add_lat_samples(lat_samples);
+  builder_.add_max_lat_us(max_lat_us);
+  builder_.add_p999_lat_us(p999_lat_us);
   builder_.add_health_gap_frames(health_gap_frames);
   builder_.add_p99_lat_us(p99_lat_us);
   builder_.add_p95_lat_us(p95_lat_us);
@@ -0,0 +1,154 @@
+#include <bit>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <utility>
+
+#include "ictk/tools/async_recorder.hpp"
+
+#if defined(__linux__)
+    #include <sched.h>
+    #include <pthread.h>
+#endif
+
+/*
+goal: move formatting and file I/O off the control thread
+    producer: SpscRing::try_push (ictk/io/spsc_ring.hpp)
+    consumer: this writer thread, batches of kBatch samples -> Recorder::write_tick -> rotate_if_needed
+        vector ticks are read in place from the ring (consume_n) -> Recorder::write_tick_vec, no second copy
+*/
+
+namespace ictk::tools{
+
+    namespace{
+        constexpr std::size_t kBatch = 256;
+    } // namespace
+
+    std::unique_ptr<AsyncRecorder> AsyncRecorder::open(const AsyncRecorderOptions& opt){
+        // // backend first: no AsyncRecorder (whose dtor flushes rec_) exists without one
+        std::unique_ptr<Recorder> rec = Recorder::open(opt.rec);
+        if (!rec) return nullptr;
+        std::unique_ptr<AsyncRecorder> a(new AsyncRecorder());
+        a->rec_ = std::move(rec);
+
+        // // ring slots + per slot vector blocks + cache line slack, allocated once
+        const std::size_t cap = opt.capacity ? opt.capacity : 1;
+        a->dims_ = opt.rec.dims;
+        a->channels_ = 2 * a->dims_.ny + 2 * a->dims_.nu + a->dims_.nx;
+        const std::size_t vec_bytes = std::bit_ceil(cap) * a->channels_ * sizeof(Scalar);
+        a->mem_.resize(std::bit_ceil(cap) * sizeof(TickSample) + vec_bytes + 192);
+        a->arena_ = std::make_unique<MemoryArena>(a->mem_.data(), a->mem_.size());
+        if (a->ring_.init(cap, *a->arena_) != Status::kOK) return nullptr;
+        if (a->channels_){
+            a->vec_ = static_cast<Scalar*>(a->arena_->allocate(vec_bytes, 64, "async.vec"));
+            if (!a->vec_) return nullptr;
+        }
+
+        a->poll_ns_ = opt.poll_ns > 0 ? opt.poll_ns : 1'000'000;
+        a->cpu_ = opt.writer_cpu;
+        return a;
+    }
+
+    AsyncRecorder::~AsyncRecorder(){
+        stop();
+        flush();
+    }
+
+    bool AsyncRecorder::start(){
+        if (writer_.joinable()) return false;
+        quit_.store(false, std::memory_order_relaxed);
+        writer_ = std::thread([this]{ writer_main_(); });
+        return true;
+    }
+
+    void AsyncRecorder::stop(){
+        if (!writer_.joinable()) return;
+        quit_.store(true, std::memory_order_relaxed);
+        writer_.join();
+        std::lock_guard<std::mutex> lk(mu_);
+        (void)drain_();
+    }
+
+    void AsyncRecorder::write_buildinfo(){
+        std::lock_guard<std::mutex> lk(mu_);
+        rec_->write_buildinfo();
+    }
+
+    void AsyncRecorder::write_time_anchor(std::int64_t epoch_mono_ns, std::int64_t epoch_utc_ns){
+        std::lock_guard<std::mutex> lk(mu_);
+        rec_->write_time_anchor(epoch_mono_ns, epoch_utc_ns);
+    }
+
+    void AsyncRecorder::write_kpi(const ictk::KpiCounters& kpi){
+        std::lock_guard<std::mutex> lk(mu_);
+        (void)drain_();
+        ictk::KpiCounters k = kpi;
+        k.telemetry_drops = ring_.drops();
+        rec_->write_kpi(k);
+    }
+
+    void AsyncRecorder::flush(){
+        std::lock_guard<std::mutex> lk(mu_);
+        (void)drain_();
+        rec_->flush();
+    }
+
+    std::size_t AsyncRecorder::drain_(){
+        std::size_t total = 0;
+        if (channels_){
+            const std::size_t ny = dims_.ny, nu = dims_.nu, nx = dims_.nx;
+            for (;;){
+                const std::size_t n = ring_.consume_n(kBatch, [&](const TickSample& s, std::size_t slot){
+                    const Scalar* d = vec_ + slot * channels_;
+                    TickVector v{};
+                    v.t = s.t;
+                    v.y = {d, ny};
+                    v.r = {d + ny, ny};
+                    v.u_pre = {d + 2 * ny, nu};
+                    v.u_post = {d + 2 * ny + nu, nu};
+                    v.xhat = {d + 2 * ny + 2 * nu, nx};
+                    v.h = s.h;
+                    v.lat_ns = s.lat_ns;
+                    rec_->write_tick_vec(v);
+                });
+                if (n == 0) break;
+                rec_->rotate_if_needed();
+                total += n;
+            }
+            written_.fetch_add(total, std::memory_order_relaxed);
+            return total;
+        }
+
+        std::array<TickSample, kBatch> batch{};
+        for (;;){
+            const std::size_t n = ring_.pop_n(batch.data(), batch.size());
+            if (n == 0) break;
+            for (std::size_t i = 0; i < n; ++i) rec_->write_tick(batch[i]);
+            rec_->rotate_if_needed();
+            total += n;
+        }
+        written_.fetch_add(total, std::memory_order_relaxed);
+        return total;
+    }
+
+    void AsyncRecorder::writer_main_(){
+        #if defined(__linux__)
+            if (cpu_ >= 0){
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu_, &set);
+                pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            }
+        #endif
+
+        while (!quit_.load(std::memory_order_relaxed)){
+            std::size_t n = 0;
+            {
+                std::lock_guard<std::mutex> lk(mu_);
+                n = drain_();
+            }
+            if (n == 0) std::this_thread::sleep_for(std::chrono::nanoseconds(poll_ns_));
+        }
+    }
+
+} // namespace ictk::tools
@@ -0,0 +1,347 @@
+#include <bit>
+#include <new>
+#include <cstdio>
+#include <cstring>
+
+#include "ictk/tools/columnar.hpp"
+
+#include "ts_codec.hpp"   // kTimeSeries blocks
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+/*
+Columnar segment reader + xxh64
+    POSIX: the segment is mmap'd read only (MADV_SEQUENTIAL), spans point into the mapping
+    elsewhere: read into one 64 byte aligned buffer, same spans
+*/
+namespace ictk::tools::columnar{
+
+    static_assert(std::endian::native == std::endian::little, "columnar segments are little endian; no byte swapping reader");
+
+    namespace{
+        constexpr std::uint64_t P1 = 11400714785074694791ull;
+        constexpr std::uint64_t P2 = 14029467366897019727ull;
+        constexpr std::uint64_t P3 = 1609587929392839161ull;
+        constexpr std::uint64_t P4 = 9650029242287828579ull;
+        constexpr std::uint64_t P5 = 2870177450012600261ull;
+
+        inline std::uint64_t rd64(const unsigned char* p) noexcept{
+            std::uint64_t v;
+            std::memcpy(&v, p, 8);
+            return v;
+        }
+
+        inline std::uint32_t rd32(const unsigned char* p) noexcept{
+            std::uint32_t v;
+            std::memcpy(&v, p, 4);
+            return v;
+        }
+
+        inline std::uint64_t round(std::uint64_t acc, std::uint64_t in) noexcept{
+            acc += in * P2;
+            acc = std::rotl(acc, 31);
+            return acc * P1;
+        }
+
+        inline std::uint64_t merge(std::uint64_t acc, std::uint64_t v) noexcept{
+            acc ^= round(0, v);
+            return acc * P1 + P4;
+        }
+
+        template <class T>
+        const T* at(const std::byte* p) noexcept{
+            return reinterpret_cast<const T*>(p);
+        }
+
+        // // payload large enough for what the header claims
+        bool sane(const BlockHeader& bh, std::uint32_t extra) noexcept{
+            if (bh.kind != static_cast<std::uint32_t>(BlockKind::kTicks)) return bh.encoding == 0;
+            switch (static_cast<BlockEncoding>(bh.encoding)){
+                case BlockEncoding::kRaw:        return bh.payload_bytes >= tick_payload_bytes(bh.rows, extra);
+                case BlockEncoding::kTimeSeries: return bh.payload_bytes >= tsc::dir_bytes(extra);
+            }
+            return false;
+        }
+
+        // // spans over a raw column layout of n rows
+        TickBlock columns(const std::byte* p, std::size_t n, std::uint64_t seq_first, const FileHeader& h) noexcept{
+            TickBlock t;
+            t.seq_first = seq_first;
+            t.t_ns = {at<std::int64_t>(p + col_offset(kTNs, n)), n};
+            t.lat_ns = {at<std::int64_t>(p + col_offset(kLatNs, n)), n};
+            t.y0 = {at<double>(p + col_offset(kY0, n)), n};
+            t.r0 = {at<double>(p + col_offset(kR0, n)), n};
+            t.u_pre0 = {at<double>(p + col_offset(kUPre0, n)), n};
+            t.u_post0 = {at<double>(p + col_offset(kUPost0, n)), n};
+            t.deadline_miss_count = {at<std::uint64_t>(p + col_offset(kDeadlineMiss, n)), n};
+            t.saturation_pct = {at<double>(p + col_offset(kSaturationPct, n)), n};
+            t.rate_limit_hits = {at<std::uint64_t>(p + col_offset(kRateHits, n)), n};
+            t.jerk_limit_hits = {at<std::uint64_t>(p + col_offset(kJerkHits, n)), n};
+            t.aw_term_mag = {at<double>(p + col_offset(kAwTermMag, n)), n};
+            t.last_clamp_mag = {at<double>(p + col_offset(kLastClampMag, n)), n};
+            t.last_rate_clip_mag = {at<double>(p + col_offset(kLastRateClipMag, n)), n};
+            t.last_jerk_clip_mag = {at<double>(p + col_offset(kLastJerkClipMag, n)), n};
+            t.sat_hit_mask = {at<std::uint64_t>(p + col_offset(kSatHitMask, n)), n};
+            t.rate_hit_mask = {at<std::uint64_t>(p + col_offset(kRateHitMask, n)), n};
+            t.jerk_hit_mask = {at<std::uint64_t>(p + col_offset(kJerkHitMask, n)), n};
+            t.flags = {at<std::uint8_t>(p + col_offset(kFlags, n)), n};
+            t.ny = h.ny;
+            t.nu = h.nu;
+            t.nx = h.nx;
+            t.vec = {at<double>(p + col_offset(kTickCols, n)), n * h.channels()};
+            if (h.env_window){
+                t.env_n = {at<std::int64_t>(p + col_offset(kTickCols + h.channels(), n)), n};
+                t.env = {at<double>(p + col_offset(kTickCols + h.channels() + 1u, n)), n * (h.env_cols() - 1u)};
+            }
+            return t;
+        }
+    } // namespace
+
+    std::uint64_t xxh64(const void* data, std::size_t n, std::uint64_t seed) noexcept{
+        const auto* p = static_cast<const unsigned char*>(data);
+        const unsigned char* const end = p + n;
+        std::uint64_t h;
+
+        if (n >= 32){
+            std::uint64_t v1 = seed + P1 + P2, v2 = seed + P2, v3 = seed, v4 = seed - P1;
+            const unsigned char* const limit = end - 32;
+            do{
+                v1 = round(v1, rd64(p));
+                v2 = round(v2, rd64(p + 8));
+                v3 = round(v3, rd64(p + 16));
+                v4 = round(v4, rd64(p + 24));
+                p += 32;
+            }while (p <= limit);
+            h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+            h = merge(h, v1);
+            h = merge(h, v2);
+            h = merge(h, v3);
+            h = merge(h, v4);
+        }else{
+            h = seed + P5;
+        }
+        h += static_cast<std::uint64_t>(n);
+
+        for (; p + 8 <= end; p += 8){
+            h ^= round(0, rd64(p));
+            h = std::rotl(h, 27) * P1 + P4;
+        }
+        if (p + 4 <= end){
+            h ^= static_cast<std::uint64_t>(rd32(p)) * P1;
+            h = std::rotl(h, 23) * P2 + P3;
+            p += 4;
+        }
+        for (; p < end; ++p){
+            h ^= static_cast<std::uint64_t>(*p) * P5;
+            h = std::rotl(h, 11) * P1;
+        }
+
+        h ^= h >> 33;
+        h *= P2;
+        h ^= h >> 29;
+        h *= P3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    Reader::~Reader(){
+        if (!base_) return;
+        #if !defined(_WIN32)
+            if (mapped_){
+                ::munmap(const_cast<std::byte*>(base_), size_);
+                return;
+            }
+        #endif
+        ::operator delete(const_cast<std::byte*>(base_), std::align_val_t{kAlign});
+    }
+
+    std::unique_ptr<Reader> Reader::open(const std::string& path){
+        std::unique_ptr<Reader> r(new Reader());
+
+        #if !defined(_WIN32)
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return nullptr;
+            struct stat st{};
+            if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(FileHeader))){
+                ::close(fd);
+                return nullptr;
+            }
+            r->size_ = static_cast<std::size_t>(st.st_size);
+            void* m = ::mmap(nullptr, r->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);   // // the mapping keeps the file
+            if (m == MAP_FAILED) return nullptr;
+            ::madvise(m, r->size_, MADV_SEQUENTIAL);
+            r->base_ = static_cast<const std::byte*>(m);
+            r->mapped_ = true;
+        #else
+            std::FILE* f = std::fopen(path.c_str(), "rb");
+            if (!f) return nullptr;
+            std::fseek(f, 0, SEEK_END);
+            const long sz = std::ftell(f);
+            std::fseek(f, 0, SEEK_SET);
+            if (sz < static_cast<long>(sizeof(FileHeader))){
+                std::fclose(f);
+                return nullptr;
+            }
+            r->size_ = static_cast<std::size_t>(sz);
+            auto* b = static_cast<std::byte*>(::operator new(r->size_, std::align_val_t{kAlign}, std::nothrow));
+            if (!b){
+                std::fclose(f);
+                return nullptr;
+            }
+            r->base_ = b;
+            const std::size_t got = std::fread(b, 1, r->size_, f);
+            std::fclose(f);
+            if (got != r->size_) return nullptr;
+        #endif
+
+        std::memcpy(&r->hdr_, r->base_, sizeof(FileHeader));
+        if (r->hdr_.magic != kFileMagic || r->hdr_.version != kVersion || r->hdr_.header_bytes != sizeof(FileHeader)) return nullptr;
+        if (r->hdr_.ny > kMaxVecChannels || r->hdr_.nu > kMaxVecChannels || r->hdr_.nx > kMaxVecChannels) return nullptr;
+        if (r->hdr_.channels() > kMaxVecChannels) return nullptr;
+
+        r->indexed_ = r->load_index_();
+        if (!r->indexed_) r->recover_index_();
+
+        for (const IndexEntry& e : r->index_){
+            if (e.kind == static_cast<std::uint32_t>(BlockKind::kTicks)) r->tick_rows_ += e.rows;
+        }
+        return r;
+    }
+
+    // // footer -> index; every entry must point at a block header that agrees with it and fits
+    bool Reader::load_index_() noexcept{
+        if (size_ < sizeof(FileHeader) + sizeof(Footer)) return false;
+        Footer ft;
+        std::memcpy(&ft, base_ + size_ - sizeof(Footer), sizeof(Footer));
+        if (ft.magic != kFooterMagic) return false;
+
+        const std::size_t body = size_ - sizeof(Footer);
+        if (ft.index_offset < sizeof(FileHeader) || ft.index_offset > body) return false;
+        if (ft.entries > (body - ft.index_offset) / sizeof(IndexEntry)) return false;
+        if (ft.index_offset + ft.entries * sizeof(IndexEntry) != body) return false;
+        if (xxh64(base_ + ft.index_offset, ft.entries * sizeof(IndexEntry)) != ft.index_checksum) return false;
+
+        index_.resize(static_cast<std::size_t>(ft.entries));
+        if (ft.entries) std::memcpy(index_.data(), base_ + ft.index_offset, index_.size() * sizeof(IndexEntry));
+
+        for (const IndexEntry& e : index_){
+            if (e.offset % kAlign != 0 || e.offset < sizeof(FileHeader) || e.offset + sizeof(BlockHeader) > ft.index_offset) return false;
+            BlockHeader bh;
+            std::memcpy(&bh, base_ + e.offset, sizeof(bh));
+            if (bh.magic != kBlockMagic || bh.kind != e.kind || bh.rows != e.rows) return false;
+            if (bh.payload_bytes > ft.index_offset - e.offset - sizeof(BlockHeader)) return false;
+            if (!sane(bh, hdr_.extra_cols())) return false;
+        }
+        return true;
+    }
+
+    // // no (usable) footer: walk the block headers from the top, stop at the first one that is torn or does not fit
+    void Reader::recover_index_(){
+        index_.clear();
+        std::size_t off = sizeof(FileHeader);
+        while (off + sizeof(BlockHeader) <= size_){
+            BlockHeader bh;
+            std::memcpy(&bh, base_ + off, sizeof(bh));
+            if (bh.magic != kBlockMagic || bh.payload_bytes % kAlign != 0) break;
+            if (bh.payload_bytes > size_ - off - sizeof(BlockHeader)) break;
+            if (!sane(bh, hdr_.extra_cols())) break;
+            index_.push_back(IndexEntry{off, bh.kind, bh.rows, bh.t_first, bh.t_last});
+            off += sizeof(BlockHeader) + static_cast<std::size_t>(bh.payload_bytes);
+        }
+    }
+
+    const std::byte* Reader::payload_(std::size_t i) const noexcept{
+        return base_ + index_[i].offset + sizeof(BlockHeader);
+    }
+
+    BlockEncoding Reader::encoding(std::size_t i) const noexcept{
+        if (i >= index_.size()) return BlockEncoding::kRaw;
+        return static_cast<BlockEncoding>(at<BlockHeader>(base_ + index_[i].offset)->encoding);
+    }
+
+    TickBlock Reader::ticks(std::size_t i) const noexcept{
+        if (i >= index_.size() || index_[i].kind != static_cast<std::uint32_t>(BlockKind::kTicks)) return {};
+        const BlockHeader* bh = at<BlockHeader>(base_ + index_[i].offset);
+        if (bh->encoding != static_cast<std::uint32_t>(BlockEncoding::kRaw)) return {};
+        return columns(payload_(i), index_[i].rows, bh->seq_first, hdr_);
+    }
+
+    TickBlock Reader::ticks(std::size_t i, TickScratch& s) const{
+        if (encoding(i) == BlockEncoding::kRaw) return ticks(i);
+        if (index_[i].kind != static_cast<std::uint32_t>(BlockKind::kTicks)) return {};
+        const BlockHeader* bh = at<BlockHeader>(base_ + index_[i].offset);
+        const std::size_t n = index_[i].rows;
+        const std::uint32_t ch = hdr_.extra_cols();
+        if (s.buf.size() < tick_payload_bytes(n, ch)) s.buf.resize(tick_payload_bytes(n, ch));
+        if (!tsc::decode_ticks(reinterpret_cast<const std::uint8_t*>(payload_(i)), static_cast<std::size_t>(bh->payload_bytes), n, s.buf.data(), ch)) return {};
+        return columns(s.buf.data(), n, bh->seq_first, hdr_);
+    }
+
+    bool Reader::verify(std::size_t i) const noexcept{
+        if (i >= index_.size()) return false;
+        const BlockHeader* bh = at<BlockHeader>(base_ + index_[i].offset);
+        return xxh64(payload_(i), static_cast<std::size_t>(bh->payload_bytes)) == bh->checksum;
+    }
+
+    bool Reader::verify() const noexcept{
+        for (std::size_t i = 0; i < index_.size(); ++i){
+            if (!verify(i)) return false;
+        }
+        return true;
+    }
+
+    // // payload of the last block of kind k, if it holds at least `need` bytes
+    const std::byte* Reader::last_(BlockKind k, std::size_t need) const noexcept{
+        for (std::size_t i = index_.size(); i-- > 0;){
+            if (index_[i].kind != static_cast<std::uint32_t>(k)) continue;
+            const BlockHeader* bh = at<BlockHeader>(base_ + index_[i].offset);
+            return bh->payload_bytes >= need ? payload_(i) : nullptr;
+        }
+        return nullptr;
+    }
+
+    const KpiRecord* Reader::kpi() const noexcept{
+        return at<KpiRecord>(last_(BlockKind::kKpi, sizeof(KpiRecord)));
+    }
+
+    const TimeAnchorRecord* Reader::time_anchor() const noexcept{
+        return at<TimeAnchorRecord>(last_(BlockKind::kTimeAnchor, sizeof(TimeAnchorRecord)));
+    }
+
+    bool Reader::buildinfo(BuildInfoView& out) const noexcept{
+        for (std::size_t i = index_.size(); i-- > 0;){
+            if (index_[i].kind != static_cast<std::uint32_t>(BlockKind::kBuildInfo)) continue;
+            const BlockHeader* bh = at<BlockHeader>(base_ + index_[i].offset);
+            const std::byte* p = payload_(i);
+            const std::size_t len = static_cast<std::size_t>(bh->payload_bytes);
+            if (len < 16) return false;
+
+            std::uint32_t count = 0;
+            std::memcpy(&out.dt_ns, p, 8);
+            std::memcpy(&out.tick_decimation, p + 8, 4);
+            std::memcpy(&count, p + 12, 4);
+
+            std::string_view* fields[] = {&out.ictk_version, &out.git_sha, &out.compiler, &out.flags,
+                                          &out.scalar_type, &out.controller_id, &out.asset_id};
+            std::size_t off = 16;
+            for (std::uint32_t k = 0; k < count && k < 7u; ++k){
+                std::uint32_t n = 0;
+                if (off + 4 > len) return false;
+                std::memcpy(&n, p + off, 4);
+                off += 4;
+                if (n > len - off) return false;
+                *fields[k] = {at<char>(p + off), n};
+                off += n;
+            }
+            return count >= 7u;
+        }
+        return false;
+    }
+
+} // namespace ictk::tools::columnar
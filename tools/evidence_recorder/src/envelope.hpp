@@ -0,0 +1,184 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include "ictk/core/types.hpp"
+#include "ictk/core/health.hpp"
+#include "ictk/tools/recorder.hpp"
+
+/*
+Envelope: windowed aggregation behind RecorderOptions::Envelope decimation
+    per window of N ticks, for every signal (y0 r0 u_pre0 u_post0, then the dims vector channels in
+        y r u_pre u_post xhat order): min, max, mean and last
+    health: counters / magnitudes / saturation -> max over the window, hit masks + flags -> OR
+    t = last tick of the window, lat_ns = max
+    NaN is sticky: one NaN anywhere in the window -> that signal's min / max (and the health magnitude) are NaN,
+        a non-finite spike is never averaged or compared away
+    add() is O(signals) with fixed arrays sized once in init(); nothing allocates per tick
+*/
+namespace ictk::tools::detail{
+
+    class Envelope{
+        public:
+            static constexpr std::size_t kScalarSignals = 4;
+
+            // // window ticks per record, vector channels as RecorderOptions::dims
+            void init(std::size_t window, const ictk::Dims& d){
+                window_ = window > 1 ? window : 1;
+                dims_ = d;
+                channels_ = 2 * d.ny + 2 * d.nu + d.nx;
+                const std::size_t n = kScalarSignals + channels_;
+                min_.assign(n, 0.0);
+                max_.assign(n, 0.0);
+                sum_.assign(n, 0.0);
+                last_.assign(channels_, Scalar{0});
+                n_ = 0;
+            }
+
+            // // v == nullptr -> vector channel 0 from s, the rest 0 (as a scalar write_tick on a vector recorder)
+            void add(const TickSample& s, const TickVector* v) noexcept{
+                const bool first = n_++ == 0;
+                put_(0, s.y0, first);
+                put_(1, s.r0, first);
+                put_(2, s.u_pre0, first);
+                put_(3, s.u_post0, first);
+
+                if (channels_){
+                    std::size_t k = 0;
+                    if (v){
+                        k = chan_(k, v->y, dims_.ny, first);
+                        k = chan_(k, v->r, dims_.ny, first);
+                        k = chan_(k, v->u_pre, dims_.nu, first);
+                        k = chan_(k, v->u_post, dims_.nu, first);
+                        (void)chan_(k, v->xhat, dims_.nx, first);
+                    }else{
+                        const Scalar y = static_cast<Scalar>(s.y0), r = static_cast<Scalar>(s.r0);
+                        const Scalar u_pre = static_cast<Scalar>(s.u_pre0), u_post = static_cast<Scalar>(s.u_post0);
+                        k = chan_(k, {&y, 1}, dims_.ny, first);
+                        k = chan_(k, {&r, 1}, dims_.ny, first);
+                        k = chan_(k, {&u_pre, 1}, dims_.nu, first);
+                        k = chan_(k, {&u_post, 1}, dims_.nu, first);
+                        (void)chan_(k, {}, dims_.nx, first);
+                    }
+                }
+
+                const ControllerHealth& h = s.h;
+                if (first){
+                    head_ = s;
+                    return;
+                }
+                head_.t = s.t;
+                head_.y0 = s.y0;
+                head_.r0 = s.r0;
+                head_.u_pre0 = s.u_pre0;
+                head_.u_post0 = s.u_post0;
+                head_.lat_ns = std::max(head_.lat_ns, s.lat_ns);
+
+                ControllerHealth& a = head_.h;
+                a.deadline_miss_count = std::max(a.deadline_miss_count, h.deadline_miss_count);
+                a.saturation_pct = peak_(a.saturation_pct, h.saturation_pct);
+                a.rate_limit_hits = std::max(a.rate_limit_hits, h.rate_limit_hits);
+                a.jerk_limit_hits = std::max(a.jerk_limit_hits, h.jerk_limit_hits);
+                a.fallback_active = a.fallback_active || h.fallback_active;
+                a.novelty_flag = a.novelty_flag || h.novelty_flag;
+                a.aw_term_mag = peak_(a.aw_term_mag, h.aw_term_mag);
+                a.last_clamp_mag = peak_(a.last_clamp_mag, h.last_clamp_mag);
+                a.last_rate_clip_mag = peak_(a.last_rate_clip_mag, h.last_rate_clip_mag);
+                a.last_jerk_clip_mag = peak_(a.last_jerk_clip_mag, h.last_jerk_clip_mag);
+                a.sat_hit_mask |= h.sat_hit_mask;
+                a.rate_hit_mask |= h.rate_hit_mask;
+                a.jerk_hit_mask |= h.jerk_hit_mask;
+            }
+
+            bool full() const noexcept{
+                return n_ >= window_;
+            }
+
+            bool empty() const noexcept{
+                return n_ == 0;
+            }
+
+            // // start the next window (the arrays are overwritten by the first add())
+            void reset() noexcept{
+                n_ = 0;
+            }
+
+            std::size_t count() const noexcept{
+                return n_;
+            }
+
+            std::size_t signals() const noexcept{
+                return min_.size();
+            }
+
+            // // last values, aggregated health, window end time, max latency
+            const TickSample& head() const noexcept{
+                return head_;
+            }
+
+            // // last value of every vector channel; t / h / lat_ns as head()
+            TickVector last_vec() const noexcept{
+                TickVector v{};
+                v.t = head_.t;
+                const Scalar* p = last_.data();
+                v.y = {p, dims_.ny};
+                v.r = {p + dims_.ny, dims_.ny};
+                v.u_pre = {p + 2 * dims_.ny, dims_.nu};
+                v.u_post = {p + 2 * dims_.ny + dims_.nu, dims_.nu};
+                v.xhat = {p + 2 * dims_.ny + 2 * dims_.nu, dims_.nx};
+                v.h = head_.h;
+                v.lat_ns = head_.lat_ns;
+                return v;
+            }
+
+            double min(std::size_t k) const noexcept{
+                return min_[k];
+            }
+            double max(std::size_t k) const noexcept{
+                return max_[k];
+            }
+            double mean(std::size_t k) const noexcept{
+                return n_ ? sum_[k] / static_cast<double>(n_) : 0.0;
+            }
+
+        private:
+            void put_(std::size_t k, double x, bool first) noexcept{
+                if (first){
+                    min_[k] = max_[k] = sum_[k] = x;
+                    return;
+                }
+                const bool nan = x != x;
+                min_[k] = x < min_[k] || nan ? x : min_[k];
+                max_[k] = x > max_[k] || nan ? x : max_[k];
+                sum_[k] += x;
+            }
+
+            // // max that keeps a NaN from either side (std::max drops it when it is the second argument)
+            static double peak_(double a, double b) noexcept{
+                return b > a || b != b ? b : a;
+            }
+
+            std::size_t chan_(std::size_t k, std::span<const Scalar> src, std::size_t n, bool first) noexcept{
+                for (std::size_t i = 0; i < n; ++i, ++k){
+                    const Scalar x = i < src.size() ? src[i] : Scalar{0};
+                    last_[k] = x;
+                    put_(kScalarSignals + k, static_cast<double>(x), first);
+                }
+                return k;
+            }
+
+            std::size_t window_{1};
+            ictk::Dims dims_{};
+            std::size_t channels_{0};
+            std::size_t n_{0};
+
+            TickSample head_{};
+            std::vector<double> min_, max_, sum_;
+            std::vector<Scalar> last_;
+    };
+
+} // namespace ictk::tools::detail
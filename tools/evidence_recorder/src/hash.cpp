@@ -26,20 +26,34 @@ namespace ictk::tools::hash{
         return out;
     }
 
-    // Stream BLAKE3 -> 64KiB chunking -> checks read error
-    std::array<std::uint8_t, 32> blake3_256_file(const char* path){
+    // Stream BLAKE3 -> chunk_bytes per fread -> checks read error
+    std::array<std::uint8_t, 32> blake3_256_file(const char* path, size_t chunk_bytes){
         std::FILE* f = std::fopen(path, "rb");
         if (!f) return {};
-        blake3_hasher h;
-        blake3_hasher_init(&h);
-        std::vector<unsigned char> buf(1<<16);
+        Blake3 h;
+        std::vector<unsigned char> buf(chunk_bytes ? chunk_bytes : 1 << 16);
         size_t n = 0;
         while((n=fread(buf.data(), 1, buf.size(), f)) > 0){
-            blake3_hasher_update(&h, buf.data(), n); 
+            h.update(buf.data(), n); 
         }
         std::fclose(f);
+        return h.digest();
+    }
+
+    static_assert(sizeof(blake3_hasher) <= 2048 && alignof(blake3_hasher) <= 8, "Blake3::state_ too small for blake3_hasher");
+
+    Blake3::Blake3() noexcept{
+        blake3_hasher_init(reinterpret_cast<blake3_hasher*>(state_));
+    }
+
+    void Blake3::update(const void* data, size_t len) noexcept{
+        blake3_hasher_update(reinterpret_cast<blake3_hasher*>(state_), data, len);
+    }
+
+    // finalize does not consume the state -> digest() may be taken more than once
+    std::array<std::uint8_t, 32> Blake3::digest() const noexcept{
         std::array<std::uint8_t, 32> out{};
-        blake3_hasher_finalize(&h, out.data(), out.size());
+        blake3_hasher_finalize(reinterpret_cast<const blake3_hasher*>(state_), out.data(), out.size());
         return out;
     }
     #else
@@ -47,7 +61,12 @@ namespace ictk::tools::hash{
         std::array<std::uint8_t, 32> blake3_256(const void*, size_t){
             return{};
         }
-        std::array<std::uint8_t, 32> blake3_256_file(const char*){
+        std::array<std::uint8_t, 32> blake3_256_file(const char*, size_t){
+            return {};
+        }
+        Blake3::Blake3() noexcept : state_{}{}
+        void Blake3::update(const void*, size_t) noexcept{}
+        std::array<std::uint8_t, 32> Blake3::digest() const noexcept{
             return {};
         }
     #endif
@@ -12,7 +12,21 @@ namespace ictk::tools::hash{
     //API for BLAKE3 -> 32 byte digest -> data, len for memory, *_file for streaming a file
     // // BLAKE3-256
     std::array<std::uint8_t, 32> blake3_256(const void* data, size_t len);
-    std::array<std::uint8_t, 32> blake3_256_file(const char * path);
+    std::array<std::uint8_t, 32> blake3_256_file(const char * path, size_t chunk_bytes = 1 << 16);
+
+    // // Incremental BLAKE3-256: fed with bytes already in memory for another reason (a parse window, a write)
+    // //   -> the payload hash rides along the pass that reads or writes the file, no second read
+    // //   without BLAKE3 in the build (no MCAP backend): update() is a no op, digest() is all zero
+    class Blake3{
+        public:
+            Blake3() noexcept;
+            void update(const void* data, size_t len) noexcept;
+            std::array<std::uint8_t, 32> digest() const noexcept;
+
+        private:
+            // blake3_hasher (~1.9 KB), opaque here so blake3.h stays out of the header
+            alignas(8) unsigned char state_[2048];
+    };
 
     // Self contained SHA-256 
     // // SHA-256 (portable, for BFBS digest)
@@ -16,11 +16,18 @@ namespace ictk::tools::detail{
         health_written_since_last_tick = false;
     }
 
+    void KpiAcc::on_latency_ns(std::int64_t ns) noexcept{
+        if (ns <= 0) return;
+        lat.record(static_cast<std::uint64_t>(ns));
+    }
+
     void KpiAcc::on_latency_us(double s) noexcept{
         if (!std::isfinite(s) || s < 0.0) return;
-        lat_us[lat_head] = s;
-        lat_head = (lat_head + 1) % kLatCap;
-        if (lat_count < kLatCap) ++lat_count;
+        lat.record(static_cast<std::uint64_t>(std::llround(std::min(s * 1e3, 1e18))));
+    }
+
+    void KpiAcc::merge_latency(const LatencyHistogram& h) noexcept{
+        lat.merge(h);
     }
 
     void KpiAcc::on_health_written() noexcept{
@@ -32,37 +39,13 @@ namespace ictk::tools::detail{
     }
 
     void KpiAcc::finalize_latency_percentiles() noexcept{
-        // Guard
-        if (lat_count == 0){
-            p50_lat_us = p95_lat_us = p99_lat_us = 0.0;
-            return;
-        }
-
-        // copy to local buffer and partial sort; probably O(n log n) worst case with cap = 2048
-        double buf[kLatCap];
-        const std::size_t n = lat_count;
-
-        // Reconstruct linear order from ring 
-        const std::size_t start = (lat_count == kLatCap) ? lat_head : 0;
-
-        for (std::size_t i=0; i<n; ++i){
-            const std::size_t idx = (start + i) % kLatCap;
-            buf[i] = lat_us[idx];
-        }
-
-        std::sort(buf, buf + n);
-
-        auto quant = [&](double p)->double{
-            const double pos = p * static_cast<double>(n - 1);
-            const std::size_t lo = static_cast<std::size_t>(pos);
-            const std::size_t hi = std::min<std::size_t>(lo + 1, n - 1);
-            const double frac = pos - static_cast<double>(lo);
-            return buf[lo] + (buf[hi] - buf[lo]) * frac;
-        };
-
-        p50_lat_us = quant(0.50);
-        p95_lat_us = quant(0.95);
-        p99_lat_us = quant(0.99);
+        // // histogram quantiles: O(buckets), no copy, no sort; 0 when nothing was measured
+        auto us = [](std::uint64_t ns){ return static_cast<double>(ns) * 1e-3; };
+        p50_lat_us = us(lat.quantile(0.50));
+        p95_lat_us = us(lat.quantile(0.95));
+        p99_lat_us = us(lat.quantile(0.99));
+        p999_lat_us = us(lat.quantile(0.999));
+        max_lat_us = us(lat.max());
     }
 
     void KpiAcc::reset() noexcept{
@@ -70,9 +53,8 @@ namespace ictk::tools::detail{
         last_u = 0.0;
         have_u = false;
 
-        lat_count = 0;
-        lat_head = 0;
-        p50_lat_us = p95_lat_us = p99_lat_us = 0.0;
+        lat.reset();
+        p50_lat_us = p95_lat_us = p99_lat_us = p999_lat_us = max_lat_us = 0.0;
 
         health_gap_frames = 0;
         health_written_since_last_tick = false;
@@ -3,6 +3,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "ictk/io/latency_histogram.hpp"
+
 namespace ictk::tools::detail{
     struct KpiAcc{
         // // Running sums
@@ -12,18 +14,11 @@ namespace ictk::tools::detail{
         double last_u{0.0};
         bool have_u{false};
 
-        // Latency reservoir 
-        static constexpr std::size_t kLatCap = 2048;
-        double lat_us[kLatCap]; // ring buffer
-
-        // total seen 
-        std::size_t lat_count{0};
-
-        // next write index
-        std::size_t lat_head{0};
+        // // Latency: every sample since reset(), fixed memory (ictk/io/latency_histogram.hpp)
+        LatencyHistogram lat{};
 
         // // Derived percentiles 
-        double p50_lat_us{0.0}, p95_lat_us{0.0}, p99_lat_us{0.0};
+        double p50_lat_us{0.0}, p95_lat_us{0.0}, p99_lat_us{0.0}, p999_lat_us{0.0}, max_lat_us{0.0};
 
         // // Health tracking
         std::uint64_t health_gap_frames{0};
@@ -32,16 +27,22 @@ namespace ictk::tools::detail{
         // tick update
         void on_tick(double t_s, double r0, double y0, double u_post0) noexcept;
 
-        // record a latency sample in ms
+        // record a latency sample (ns, as measured around update()); <= 0 -> not measured
+        void on_latency_ns(std::int64_t ns) noexcept;
+
+        // record a latency sample in us
         void on_latency_us(double s) noexcept;
 
+        // fold in latencies recorded elsewhere (other thread / segment)
+        void merge_latency(const LatencyHistogram& h) noexcept;
+
         // signal health record was written
         void on_health_written() noexcept;
 
         // final current tick
         void on_tick_commit() noexcept;
 
-        // compute percentiles from reservoir
+        // compute percentiles from the histogram
         void finalize_latency_percentiles() noexcept;
 
         // reset accum
@@ -0,0 +1,529 @@
+#include <new>
+#include <span>
+#include <atomic>
+#include <utility>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+
+#include "ictk/io/kpi.hpp"
+#include "ictk/core/health.hpp"
+#include "ictk/tools/recorder.hpp"
+#include "ictk/tools/columnar.hpp"   // on-disk layout, shared with the reader
+
+#include "kpi_calc.hpp"         // KPI accum
+#include "segment_writer.hpp"   // buffered segment output + background flusher
+#include "env_buildinfo.hpp"    // BuildInfoPack
+#include "ts_codec.hpp"         // kTimeSeries tick blocks
+#include "envelope.hpp"         // envelope decimation windows
+
+#ifndef GIT_SHA
+#define GIT_SHA "unknown"
+#endif
+
+/*
+goal: columnar binary backend for Recorder (layout: ictk/tools/columnar.hpp)
+    ticks are staged column-major in a block sized buffer (one store per field, no formatting);
+        a full block gets its checksum and goes to the SegmentWriter as header + payload
+    vector ticks (opt.dims): one more column per channel, one store per value; a scalar write_tick fills channel 0
+    envelope decimation: ticks fold into detail::Envelope, a full window (or flush / kpi / rotation) stages one row
+    compress: the staged columns go through the time-series codec instead (delta-of-delta / XOR / run length),
+        straight from the staging stride into a preallocated buffer
+    buildinfo / time anchor / kpi: one small block each
+    rotation / fsync policy as JSONL; closing a segment appends the footer index
+    staging + index capacity are allocated once in the ctor
+*/
+
+namespace fs = std::filesystem;
+namespace ictk::tools{
+
+    namespace col = columnar;
+
+    class RecorderColumnar final : public Recorder{
+        public:
+            explicit RecorderColumnar(const RecorderOptions& opt)
+                : out_dir_(opt.out_dir ? opt.out_dir : "evidence"),
+                  controller_id_(opt.controller_id ? opt.controller_id : ""),
+                  asset_id_(opt.asset_id ? opt.asset_id : ""),
+                  segment_max_mb_(opt.segment_max_mb),
+                  fsync_n_mb_(opt.fsync_n_mb),
+                  every_segment_(opt.fsync_policy == RecorderOptions::EverySegment),
+                  tick_decimation_(opt.tick_decimation),
+                  mode_(opt.fixed_mode),
+                  block_rows_(std::clamp<std::size_t>(opt.block_rows, 64, 1u << 20)),
+                  compress_(opt.compress),
+                  dt_ns_hint_(opt.dt_ns_hint){
+
+                std::error_code ec;
+                fs::create_directories(out_dir_, ec);
+
+                if (opt.dims.ny > col::kMaxVecChannels || opt.dims.nu > col::kMaxVecChannels || opt.dims.nx > col::kMaxVecChannels
+                    || 2 * opt.dims.ny + 2 * opt.dims.nu + opt.dims.nx > col::kMaxVecChannels){
+                    std::fprintf(stderr, "ictk_recorder: too many vector channels, recording channel 0 only\n");
+                }else{
+                    ny_ = static_cast<std::uint32_t>(opt.dims.ny);
+                    nu_ = static_cast<std::uint32_t>(opt.dims.nu);
+                    nx_ = static_cast<std::uint32_t>(opt.dims.nx);
+                }
+                channels_ = 2u * ny_ + 2u * nu_ + nx_;
+
+                envelope_ = opt.decimation == RecorderOptions::Envelope && tick_decimation_ > 1;
+                extra_ = channels_;
+                if (envelope_){
+                    env_.init(static_cast<std::size_t>(tick_decimation_), ictk::Dims{ny_, nu_, nx_});
+                    extra_ += 1u + 3u * (col::kEnvScalarSignals + channels_);
+                }
+
+                // // staging: kTickCols + extra_ columns of block_rows_ each, 64 byte aligned like the payload on disk
+                stage_bytes_ = col::tick_payload_bytes(block_rows_, extra_);
+                stage_ = static_cast<std::byte*>(::operator new(stage_bytes_, std::align_val_t{col::kAlign}, std::nothrow));
+                index_.reserve(kIndexReserve);
+                if (compress_){
+                    enc_bytes_ = col::pad_to(col::tsc::encoded_bound(block_rows_, extra_), col::kAlign);
+                    enc_ = static_cast<std::uint8_t*>(::operator new(enc_bytes_, std::align_val_t{col::kAlign}, std::nothrow));
+                    if (!enc_){
+                        ::operator delete(stage_, std::align_val_t{col::kAlign});
+                        stage_ = nullptr;
+                    }
+                }
+
+                if (!stage_ || !out_.start(opt.io_buffer_kb * 1024ull, opt.io_buffers, detail::seg_io(opt))){
+                    std::fprintf(stderr, "ictk_recorder: failed to allocate columnar buffers\n");
+                    failed_ = true;
+                }
+            }
+
+            ~RecorderColumnar() override{
+                close_current_();
+                out_.wait_idle();
+                if (stage_) ::operator delete(stage_, std::align_val_t{col::kAlign});
+                if (enc_) ::operator delete(enc_, std::align_val_t{col::kAlign});
+            }
+
+            void write_buildinfo() override{
+                ensure_open_();
+                const auto bi = detail::make_buildinfo(
+                    static_cast<std::uint64_t>(dt_ns_hint_ > 0 ? dt_ns_hint_ : 0),
+                    controller_id_.c_str(),
+                    asset_id_.c_str(),
+                    static_cast<std::uint32_t>(tick_decimation_)
+                );
+
+                // // u64 dt_ns, u32 tick_decimation, u32 count, count x (u32 len, bytes)
+                const std::string* fields[] = {&bi.ictk_version, &bi.git_sha, &bi.compiler, &bi.flags,
+                                               &bi.scalar_type, &bi.controller_id, &bi.asset_id};
+                std::string body;
+                body.reserve(512);
+                put_pod_(body, bi.dt_ns);
+                put_pod_(body, static_cast<std::uint32_t>(bi.tick_decimation));
+                put_pod_(body, static_cast<std::uint32_t>(std::size(fields)));
+                for (const std::string* f : fields){
+                    put_pod_(body, static_cast<std::uint32_t>(f->size()));
+                    body += *f;
+                }
+                write_block_(col::BlockKind::kBuildInfo, std::move(body));
+            }
+
+            void write_time_anchor(std::int64_t epoch_mono_ns, std::int64_t epoch_utc_ns) override{
+                ensure_open_();
+                const col::TimeAnchorRecord a{epoch_mono_ns, epoch_utc_ns};
+                write_block_(col::BlockKind::kTimeAnchor, a);
+            }
+
+            void write_tick(const TickSample& s) override{
+                if (channels_ == 0){
+                    tick_(s, nullptr);
+                    return;
+                }
+                const Scalar y = static_cast<Scalar>(s.y0), r = static_cast<Scalar>(s.r0);
+                const Scalar u_pre = static_cast<Scalar>(s.u_pre0), u_post = static_cast<Scalar>(s.u_post0);
+                TickVector v{};
+                v.y = {&y, 1};
+                v.r = {&r, 1};
+                v.u_pre = {&u_pre, 1};
+                v.u_post = {&u_post, 1};
+                tick_(s, &v);
+            }
+
+            void write_tick_vec(const TickVector& v) override{
+                tick_(channel0(v), &v);
+            }
+
+            std::uint64_t dropped_ticks() const noexcept override{
+                return dropped_;
+            }
+
+            void write_kpi(const ictk::KpiCounters& k) override{
+                ensure_open_();
+                emit_env_();
+                emit_ticks_();   // // the report follows every tick it covers
+                acc_.finalize_latency_percentiles();
+
+                col::KpiRecord r{};
+                r.updates = k.updates;
+                r.watchdog_trips = k.watchdog_trips;
+                r.fallback_entries = k.fallback_entries;
+                r.limit_hits = k.limit_hits;
+                r.telemetry_drops = k.telemetry_drops;
+                r.lat_samples = acc_.lat.count();
+                r.health_gap_frames = acc_.health_gap_frames;
+                r.iae = acc_.iae;
+                r.itae = acc_.itae;
+                r.tvu = acc_.tvu;
+                r.p50_lat_us = acc_.p50_lat_us;
+                r.p95_lat_us = acc_.p95_lat_us;
+                r.p99_lat_us = acc_.p99_lat_us;
+                r.p999_lat_us = acc_.p999_lat_us;
+                r.max_lat_us = acc_.max_lat_us;
+                write_block_(col::BlockKind::kKpi, r);
+            }
+
+            // // as JSONL: rotate past segment_max_mb, else rolling fsync every fsync_n_mb (queued, caller does not wait)
+            void rotate_if_needed() override{
+                if (!out_.is_open()) return;
+                const std::size_t max_bytes = segment_max_mb_ * 1024ull * 1024ull;
+                if (written_bytes_ >= max_bytes){
+                    close_current_();
+                    open_new_file_();
+                } else if (!every_segment_){
+                    const std::size_t nbyte = fsync_n_mb_ * 1024ull * 1024ull;
+                    if ((written_bytes_ - last_fsync_mark_) >= nbyte){
+                        out_.sync_async();
+                        last_fsync_mark_ = written_bytes_;
+                    }
+                }
+            }
+
+            // // barrier: the staged rows go out as a short block, then fsync and wait
+            void flush() override{
+                if (!out_.is_open()) return;
+                emit_env_();
+                emit_ticks_();
+                out_.sync_async();
+                out_.wait_idle();
+            }
+
+        private:
+            static constexpr std::size_t kIndexReserve = 4096;
+
+            // // one tick row; v -> vector channels too (channels_ > 0)
+            void tick_(const TickSample& s, const TickVector* v){
+                ensure_open_();
+                if (failed_){
+                    ++dropped_;
+                    return;
+                }
+
+                // // latency KPIs see every tick, decimation only thins the records
+                acc_.on_latency_ns(s.lat_ns);
+
+                // // envelope: every tick goes into the KPIs and the window, one row per full window
+                if (envelope_){
+                    kpi_tick_(s);
+                    env_.add(s, v);
+                    acc_.on_health_written();
+                    acc_.on_tick_commit();
+                    if (env_.full()) emit_env_();
+                    return;
+                }
+
+                if (decim_skip_()) return;
+                kpi_tick_(s);
+                row_(s, v);
+                acc_.on_health_written();
+                acc_.on_tick_commit();
+            }
+
+            void kpi_tick_(const TickSample& s){
+                if (first_t_ < 0) first_t_ = s.t;
+                const double t_s = static_cast<double>(s.t - first_t_) * 1e-9;
+
+                if (dt_ns_hint_ == 0 && prev_t_ >= 0){
+                    const long long d = static_cast<long long>(s.t - prev_t_);
+                    if (d > 0) dt_ns_hint_ = d;
+                }
+                prev_t_ = s.t;
+
+                acc_.on_tick(t_s, s.r0, s.y0, s.u_post0);
+            }
+
+            // // window so far -> one row: last values + max / OR health, then env_n and min / max / mean per signal
+            void emit_env_(){
+                if (env_.empty()) return;
+                const TickVector last = env_.last_vec();
+                row_(env_.head(), channels_ ? &last : nullptr);
+                env_.reset();
+            }
+
+            void row_(const TickSample& s, const TickVector* v){
+                // // one store per column; rows_ < block_rows_ here (no segment -> KPIs only, as JSONL)
+                if (out_.is_open()){
+                    const std::size_t r = rows_++;
+                    if (r == 0){
+                        seq_first_ = seq_ + 1;
+                        t_first_ = s.t;
+                    }
+                    ++seq_;
+                    t_last_ = s.t;
+
+                    col_<std::int64_t>(col::kTNs)[r] = s.t;
+                    col_<std::int64_t>(col::kLatNs)[r] = s.lat_ns;
+                    col_<double>(col::kY0)[r] = s.y0;
+                    col_<double>(col::kR0)[r] = s.r0;
+                    col_<double>(col::kUPre0)[r] = s.u_pre0;
+                    col_<double>(col::kUPost0)[r] = s.u_post0;
+                    col_<std::uint64_t>(col::kDeadlineMiss)[r] = s.h.deadline_miss_count;
+                    col_<double>(col::kSaturationPct)[r] = s.h.saturation_pct;
+                    col_<std::uint64_t>(col::kRateHits)[r] = s.h.rate_limit_hits;
+                    col_<std::uint64_t>(col::kJerkHits)[r] = s.h.jerk_limit_hits;
+                    col_<double>(col::kAwTermMag)[r] = s.h.aw_term_mag;
+                    col_<double>(col::kLastClampMag)[r] = s.h.last_clamp_mag;
+                    col_<double>(col::kLastRateClipMag)[r] = s.h.last_rate_clip_mag;
+                    col_<double>(col::kLastJerkClipMag)[r] = s.h.last_jerk_clip_mag;
+                    col_<std::uint64_t>(col::kSatHitMask)[r] = s.h.sat_hit_mask;
+                    col_<std::uint64_t>(col::kRateHitMask)[r] = s.h.rate_hit_mask;
+                    col_<std::uint64_t>(col::kJerkHitMask)[r] = s.h.jerk_hit_mask;
+                    col_<std::uint8_t>(col::kFlags)[r] = static_cast<std::uint8_t>(
+                        (s.h.fallback_active ? col::kFlagFallback : 0u) | (s.h.novelty_flag ? col::kFlagNovelty : 0u));
+                    if (v){
+                        double* d = col_<double>(col::kTickCols) + r;
+                        d = stage_chan_(d, v->y, ny_);
+                        d = stage_chan_(d, v->r, ny_);
+                        d = stage_chan_(d, v->u_pre, nu_);
+                        d = stage_chan_(d, v->u_post, nu_);
+                        (void)stage_chan_(d, v->xhat, nx_);
+                    }
+                    if (envelope_){
+                        col_<std::int64_t>(col::kTickCols + channels_)[r] = static_cast<std::int64_t>(env_.count());
+                        double* d = col_<double>(col::kTickCols + channels_ + 1u) + r;
+                        for (std::size_t k = 0; k < env_.signals(); ++k){
+                            *d = env_.min(k);
+                            d += block_rows_;
+                            *d = env_.max(k);
+                            d += block_rows_;
+                            *d = env_.mean(k);
+                            d += block_rows_;
+                        }
+                    }
+                    if (rows_ == block_rows_) emit_ticks_();
+                }
+            }
+            // // n channels of one row, column stride block_rows_; missing values -> 0
+            double* stage_chan_(double* d, std::span<const Scalar> src, std::uint32_t n) noexcept{
+                const std::size_t m = std::min<std::size_t>(src.size(), n);
+                for (std::size_t i = 0; i < m; ++i, d += block_rows_) *d = static_cast<double>(src[i]);
+                for (std::size_t i = m; i < n; ++i, d += block_rows_) *d = 0.0;
+                return d;
+            }
+
+            template <class T>
+            T* col_(std::uint32_t c) noexcept{
+                return reinterpret_cast<T*>(stage_ + col::col_offset(c, block_rows_));
+            }
+
+            template <class T>
+            static void put_pod_(std::string& s, const T& v){
+                s.append(reinterpret_cast<const char*>(&v), sizeof(T));
+            }
+
+            static std::string make_filename_(const std::string& dir){
+                static std::atomic<std::uint64_t> seq{0};
+                const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                const std::uint64_t s = seq.fetch_add(1, std::memory_order_relaxed);
+                return (fs::path(dir) / ("ictk_" + std::string(GIT_SHA) + "_" + std::to_string(ns) + "_" + std::to_string(s) + ".ictkcol")).string();
+            }
+
+            // // a failed open is latched: no retry (and no stderr line) per tick, the ticks are counted instead
+            void ensure_open_(){
+                if (out_.is_open() || failed_) return;
+                open_new_file_();
+            }
+
+            void open_new_file_(){
+                current_path_ = make_filename_(out_dir_);
+                written_bytes_ = 0;
+                last_fsync_mark_ = 0;
+                index_.clear();
+                tick_rows_ = 0;
+
+                if (failed_ || !out_.open(current_path_)){
+                    if (!failed_) std::fprintf(stderr, "ictk_recorder: failed to open '%s', recording stopped\n", current_path_.c_str());
+                    failed_ = true;
+                    return;
+                }
+
+                col::FileHeader h{};
+                h.dt_ns = dt_ns_hint_;
+                h.tick_decimation = static_cast<std::uint32_t>(tick_decimation_ > 0 ? tick_decimation_ : 1);
+                h.mode = static_cast<std::uint32_t>(mode_);
+                h.block_rows = static_cast<std::uint32_t>(block_rows_);
+                h.ny = ny_;
+                h.nu = nu_;
+                h.nx = nx_;
+                h.env_window = envelope_ ? static_cast<std::uint32_t>(tick_decimation_) : 0u;
+                put_raw_(&h, sizeof(h));
+
+                seq_ = 0;   // // reset per segment, as JSONL
+            }
+
+            // // staged rows -> one kTicks block; a short raw block is compacted to its own row count first
+            void emit_ticks_(){
+                if (rows_ == 0 || !out_.is_open()) return;
+                const std::size_t n = rows_;
+
+                col::BlockHeader bh{};
+                bh.kind = static_cast<std::uint32_t>(col::BlockKind::kTicks);
+                bh.rows = static_cast<std::uint32_t>(n);
+                bh.t_first = t_first_;
+                bh.t_last = t_last_;
+                bh.seq_first = seq_first_;
+
+                if (compress_){
+                    const std::size_t used = col::tsc::encode_ticks(stage_, block_rows_, n, enc_, extra_);
+                    const std::size_t bytes = col::pad_to(used, col::kAlign);
+                    std::memset(enc_ + used, 0, bytes - used);
+                    bh.encoding = static_cast<std::uint32_t>(col::BlockEncoding::kTimeSeries);
+                    bh.payload_bytes = bytes;
+                    bh.checksum = col::xxh64(enc_, bytes);
+                    put_block_(bh, reinterpret_cast<const std::byte*>(enc_), bytes);
+                    tick_rows_ += n;
+                    rows_ = 0;
+                    return;
+                }
+
+                const std::uint32_t cols = col::kTickCols + extra_;
+                if (n < block_rows_){
+                    for (std::uint32_t c = 1; c < cols; ++c){
+                        const std::size_t w = c == col::kFlags ? 1u : 8u;
+                        std::memmove(stage_ + col::col_offset(c, n), stage_ + col::col_offset(c, block_rows_), n * w);
+                    }
+                }
+                // // zero the flags padding and the block tail (the checksum covers them)
+                const std::size_t flags_end = col::col_offset(col::kFlags, n) + n;
+                const std::size_t cols_end = col::col_offset(cols, n);
+                const std::size_t bytes = col::tick_payload_bytes(n, extra_);
+                std::memset(stage_ + flags_end, 0, col::col_offset(col::kTickCols, n) - flags_end);
+                std::memset(stage_ + cols_end, 0, bytes - cols_end);
+
+                bh.payload_bytes = bytes;
+                bh.checksum = col::xxh64(stage_, bytes);
+                put_block_(bh, stage_, bytes);
+
+                tick_rows_ += n;
+                rows_ = 0;
+            }
+
+            // // cold record -> one block, payload zero padded to kAlign (the checksum covers the padding)
+            void write_block_(col::BlockKind k, std::string body){
+                if (!out_.is_open()) return;
+                emit_ticks_();   // // keep file order == time order
+                body.resize(col::pad_to(body.size(), col::kAlign), '\0');
+
+                col::BlockHeader bh{};
+                bh.kind = static_cast<std::uint32_t>(k);
+                bh.rows = 1;
+                bh.payload_bytes = body.size();
+                bh.t_first = bh.t_last = prev_t_ < 0 ? 0 : prev_t_;
+                bh.checksum = col::xxh64(body.data(), body.size());
+                put_block_(bh, reinterpret_cast<const std::byte*>(body.data()), body.size());
+            }
+
+            template <class T>
+            void write_block_(col::BlockKind k, const T& rec){
+                std::string body;
+                put_pod_(body, rec);
+                write_block_(k, std::move(body));
+            }
+
+            // // header + payload, index entry at the header's offset
+            void put_block_(const col::BlockHeader& bh, const std::byte* payload, std::size_t bytes){
+                index_.push_back(col::IndexEntry{written_bytes_, bh.kind, bh.rows, bh.t_first, bh.t_last});
+                put_raw_(&bh, sizeof(bh));
+                put_raw_(payload, bytes);
+            }
+
+            void put_raw_(const void* p, std::size_t n){
+                out_.write(static_cast<const char*>(p), n);
+                written_bytes_ += n;
+            }
+
+            // // pending rows, footer index, then fsync + close on the flusher
+            void close_current_(){
+                if (!out_.is_open()) return;
+                emit_env_();
+                emit_ticks_();
+
+                col::Footer ft{};
+                ft.index_offset = written_bytes_;
+                ft.entries = index_.size();
+                ft.index_checksum = col::xxh64(index_.data(), index_.size() * sizeof(col::IndexEntry));
+                ft.tick_rows = tick_rows_;
+                put_raw_(index_.data(), index_.size() * sizeof(col::IndexEntry));
+                put_raw_(&ft, sizeof(ft));
+
+                out_.close_async();
+            }
+
+            bool decim_skip_(){
+                if (tick_decimation_ <= 1) return false;
+                return (tick_index_++ % static_cast<std::uint64_t>(tick_decimation_)) != 0;
+            }
+
+        private:
+            std::string out_dir_;
+            std::string controller_id_;
+            std::string asset_id_;
+            std::size_t segment_max_mb_{256};
+            std::size_t fsync_n_mb_{16};
+            bool every_segment_{false};
+            int tick_decimation_{1};
+            ictk::CommandMode mode_{ictk::kPrimary};
+            std::size_t block_rows_{4096};
+            bool compress_{false};
+            std::uint32_t ny_{0}, nu_{0}, nx_{0};
+            std::uint32_t channels_{0};     // // 2 ny + 2 nu + nx vector columns after the flags
+            std::uint32_t extra_{0};        // // channels_ + envelope columns
+            bool envelope_{false};
+            detail::Envelope env_{};
+
+            detail::SegmentWriter out_;
+            std::string current_path_{};
+            bool failed_{false};            // // buffers or a segment could not be had; latched
+            std::uint64_t dropped_{0};      // // ticks lost to failed_
+
+            // // tick staging (column-major, block_rows_ stride)
+            std::byte* stage_{nullptr};
+            std::size_t stage_bytes_{0};
+            std::uint8_t* enc_{nullptr};    // // compress: encoded block, encoded_bound(block_rows_)
+            std::size_t enc_bytes_{0};
+            std::size_t rows_{0};
+            std::uint64_t seq_first_{0};
+            std::int64_t t_first_{0};
+            std::int64_t t_last_{0};
+
+            // // current segment
+            std::vector<col::IndexEntry> index_;
+            std::uint64_t tick_rows_{0};
+            std::size_t written_bytes_{0};
+            std::size_t last_fsync_mark_{0};
+
+            long long dt_ns_hint_{0};
+            long long prev_t_{-1};
+            long long first_t_{-1};
+
+            std::uint64_t seq_{0};
+            std::uint64_t tick_index_{0};
+
+            detail::KpiAcc acc_{};
+    };
+
+    std::unique_ptr<Recorder> make_columnar_recorder(const RecorderOptions& opt){
+        return std::unique_ptr<Recorder>(new RecorderColumnar(opt));
+    }
+
+} // namespace ictk::tools
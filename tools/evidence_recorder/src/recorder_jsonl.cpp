@@ -6,27 +6,22 @@
 #include <chrono>   // for time util
 #include <cstdlib>  // for size_t
 #include <cstring>  // for string ops
+#include <span>     // vector tick channels
+#include <algorithm>
 #include <filesystem>   // for file handling 
 #include <string_view>  // for now owning string slice
 
 #include "ictk/io/kpi.hpp"          // for KpiCounters struct
+#include "ictk/io/json_format.hpp"  // to_chars numbers, shared with ACR
 #include "ictk/version.hpp"         // Version strings
 #include "ictk/core/time.hpp"       // time type
 #include "ictk/core/health.hpp"     // controller health fields
 #include "ictk/tools/recorder.hpp"  // Recorder interface and options
 
 #include "kpi_calc.hpp"         // for KPI accum
+#include "segment_writer.hpp"   // buffered segment output + background flusher
 #include "env_buildinfo.hpp"    // for BuilInfoPack
-
-// // for windows
-#if defined(_WIN32)
-    #include <io.h>     // _commit
-#else
-    #include <fcntl.h>
-    #include <unistd.h>     // fsync
-    #include <sys/stat.h>
-    #include <sys/types.h>
-#endif
+#include "envelope.hpp"         // envelope decimation windows
 
 // Default value
 #ifndef GIT_SHA
@@ -39,6 +34,9 @@ Writes BuildInfo, per-tick Tick + Health and KPI
 Rotates files bu size
 Periodically fsync.
 tracks per segment seq
+Envelope decimation: tick_decimation windows fold into detail::Envelope, one tick + health pair per window
+Output: detail::SegmentWriter -> tick + health are formatted straight into page aligned buffers,
+    a flusher thread writes them (pwritev) and runs the fsyncs; rotation / rolling fsync only queue work
 */
 
 namespace fs = std::filesystem;
@@ -46,6 +44,7 @@ namespace ictk::tools{
     #if ICTK_RECORDER_BACKEND_MCAP
         std::unique_ptr<Recorder> make_mcap_recorder(const RecorderOptions& opt);
     #endif
+    std::unique_ptr<Recorder> make_columnar_recorder(const RecorderOptions& opt);
     // // Helper functions
 
     /*
@@ -117,11 +116,35 @@ namespace ictk::tools{
                 dt_ns_hint_ = opt.dt_ns_hint;
                 std::error_code ec;
                 fs::create_directories(cfg_.out_dir, ec);
+
+                // vector channels: every tick carries them as packed arrays
+                if (opt.dims.ny > kMaxVecChannels || opt.dims.nu > kMaxVecChannels || opt.dims.nx > kMaxVecChannels
+                    || 2 * opt.dims.ny + 2 * opt.dims.nu + opt.dims.nx > kMaxVecChannels){
+                    std::fprintf(stderr, "ictk_recorder: too many vector channels, recording channel 0 only\n");
+                }else{
+                    dims_ = opt.dims;
+                }
+                const std::size_t channels = 2 * dims_.ny + 2 * dims_.nu + dims_.nx;
+                max_tick_bytes_ = kMaxTickBytes + channels * (jsonfmt::kMaxReal + 1) + 64;
+
+                // envelope decimation: one record per window, min / max / mean arrays on top
+                envelope_ = opt.decimation == RecorderOptions::Envelope && cfg_.tick_decimation > 1;
+                if (envelope_){
+                    env_.init(static_cast<std::size_t>(cfg_.tick_decimation), dims_);
+                    max_tick_bytes_ += 3 * env_.signals() * (jsonfmt::kMaxReal + 1) + 64 + jsonfmt::kMaxU64;
+                }
+
+                // output buffers + flusher, once; a buffer holds a few worst case ticks at least
+                const std::size_t buf_bytes = std::max<std::size_t>(opt.io_buffer_kb * 1024ull, 4 * max_tick_bytes_);
+                if (!out_.start(buf_bytes, opt.io_buffers, detail::seg_io(opt))){
+                    std::fprintf(stderr, "ictk_recorder: failed to allocate output buffers\n");
+                }
             }
 
-            // // Flushes and Fsyncs then close the file
+            // // Flushes and Fsyncs then close the file; waits for the flusher
             ~RecorderJsonl() override{
                 close_current_();
+                out_.wait_idle();
             }
 
             /*
@@ -149,10 +172,10 @@ namespace ictk::tools{
                 line += R"("compiler":")"       + jesc(bi.compiler)           + R"(",)";
                 line += R"("flags":")"          + jesc(bi.flags)              + R"(",)";
                 line += R"("scalar_type":")"    + jesc(bi.scalar_type)        + R"(",)";
-                line += R"("dt_ns":)"           + std::to_string(bi.dt_ns)    + ",";
+                line += R"("dt_ns":)"           + to_u64_(bi.dt_ns)    + ",";
                 line += R"("controller_id":")"  + jesc(bi.controller_id)      + R"(",)";
                 line += R"("asset_id":")"       + jesc(bi.asset_id)           + R"(",)";
-                line += R"("tick_decimation":)" + std::to_string(static_cast<unsigned>(bi.tick_decimation));
+                line += R"("tick_decimation":)" + to_u64_(bi.tick_decimation);
                 line += R"(}})";
 
                 write_line_(line);
@@ -166,98 +189,36 @@ namespace ictk::tools{
                 std::string line;
                 line.reserve(192);
                 line += R"({"ch":"/ictk/time_anchor","body":{"clock_domain":"MONO","epoch_mono_ns":)";
-                line += std::to_string(static_cast<unsigned long long>(epoch_mono_ns));
+                line += to_u64_(static_cast<std::uint64_t>(epoch_mono_ns));
                 line += R"(,"epoch_utc_ns":)";
-                line += std::to_string(static_cast<unsigned long long>(epoch_utc_ns));
+                line += to_u64_(static_cast<std::uint64_t>(epoch_utc_ns));
                 line += R"(}})";
                 write_line_(line);
             }
 
             void write_tick(const TickSample& s) override{
-                // open -> apply decimation -> skips N-1 ticks by modulo counter
-                ensure_open_();
-                if (decim_skip_(s.t)) return;
-
-                // define t=0 as first tick
-                if (first_t_ < 0) first_t_ = s.t;
-                // conv ns to sec
-                const double t_s = static_cast<double>(s.t - first_t_) * 1e-9;
-
-                // infer loop period once from first positive delta
-                if (dt_ns_hint_ == 0 && prev_t_ >= 0){
-                    const long long d = static_cast<long long>(s.t - prev_t_);
-                    if (d > 0) dt_ns_hint_ = d;
-                }
-                prev_t_ = s.t;
-
-                // update KPI accum
-                acc_.on_tick(t_s, s.r0, s.y0, s.u_post0);
-
-                std::string tick;
-                tick.reserve(192);
-
-                // Write tick record
-                tick += R"({"ch":"/ictk/tick","body":{"seq":)";
-                tick += std::to_string(static_cast<unsigned long long>(++seq_));
-                tick += R"(,"t_ns":)";
-                tick += std::to_string(static_cast<unsigned long long>(s.t));
-                tick += R"(,"y0":)";         tick += to_fix_(s.y0);
-                tick += R"(,"r0":)";         tick += to_fix_(s.r0);
-                tick += R"(,"u_pre0":)";     tick += to_fix_(s.u_pre0);
-                tick += R"(,"u_post0":)";    tick += to_fix_(s.u_post0);
-                tick += R"(}})";
-                write_line_(tick);
-
-                std::string h;
-                h.reserve(320);
-                h += R"({"ch":"/ictk/health","body":{)";
-                h += R"("deadline_miss_count":)" + std::to_string(static_cast<unsigned long long>(s.h.deadline_miss_count)) + ",";
-                h += R"("saturation_pct":)"     + to_fix_(s.h.saturation_pct) + ",";
-                h += R"("rate_hits":)"          + std::to_string(static_cast<unsigned long long>(s.h.rate_limit_hits)) + ",";
-                h += R"("jerk_hits":)"          + std::to_string(static_cast<unsigned long long>(s.h.jerk_limit_hits)) + ",";
-
-                h += R"("fallback_active":)";
-                h += (s.h.fallback_active ? "true" : "false");
-                h += ",";
-
-                h += R"("novelty_flag":)";
-                h += (s.h.novelty_flag ? "true" : "false");
-                h += ",";
-
-                h += R"("aw_term_mag":)"        + to_fix_(s.h.aw_term_mag) + ",";
-                h += R"("last_clamp_mag":)"     + to_fix_(s.h.last_clamp_mag) + ",";
-                h += R"("last_rate_clip_mag":)" + to_fix_(s.h.last_rate_clip_mag) + ",";
-                h += R"("last_jerk_clip_mag":)" + to_fix_(s.h.last_jerk_clip_mag) + ",";
-                h += R"("mode":)";
-                switch (cfg_.fixed_mode)
-                {
-                case ictk::CommandMode::Primary:
-                    h += "0";
-                    break;
-                
-                case ictk::CommandMode::Residual:
-                    h += "1";
-                    break;
-                case ictk::CommandMode::Shadow:
-                    h += "2";
-                    break;
-                case ictk::CommandMode::Cooperative:
-                    h += "3";
-                    break;
-                default:
-                    h += "0";
-                    break;
+                if (dims_.ny + dims_.nu + dims_.nx == 0){
+                    tick_(s, nullptr);
+                    return;
                 }
-                h+= R"(}})";
-                write_line_(h);
+                // // same arrays as write_tick_vec, channel 0 only
+                const Scalar y = static_cast<Scalar>(s.y0), r = static_cast<Scalar>(s.r0);
+                const Scalar u_pre = static_cast<Scalar>(s.u_pre0), u_post = static_cast<Scalar>(s.u_post0);
+                TickVector v{};
+                v.y = {&y, 1};
+                v.r = {&r, 1};
+                v.u_pre = {&u_pre, 1};
+                v.u_post = {&u_post, 1};
+                tick_(s, &v);
+            }
 
-                // health mark true and increment 
-                acc_.on_health_written();
-                acc_.on_tick_commit();
+            void write_tick_vec(const TickVector& v) override{
+                tick_(channel0(v), &v);
             }
 
             void write_kpi(const ictk::KpiCounters& k) override{
                 ensure_open_();
+                emit_env_();
 
                 // // Compute latency 
                 acc_.finalize_latency_percentiles();
@@ -267,17 +228,21 @@ namespace ictk::tools{
 
                 // // Update KPIs
                 line += R"({"ch":"/ictk/kpi_report","body":{)";
-                line += R"("updates":)"           + std::to_string(static_cast<unsigned long long>(k.updates)) + ",";
-                line += R"("watchdog_trips":)"    + std::to_string(static_cast<unsigned long long>(k.watchdog_trips)) + ",";
-                line += R"("fallback_entries":)"  + std::to_string(static_cast<unsigned long long>(k.fallback_entries)) + ",";
-                line += R"("limit_hits":)"        + std::to_string(static_cast<unsigned long long>(k.limit_hits)) + ",";
+                line += R"("updates":)"           + to_u64_(k.updates) + ",";
+                line += R"("watchdog_trips":)"    + to_u64_(k.watchdog_trips) + ",";
+                line += R"("fallback_entries":)"  + to_u64_(k.fallback_entries) + ",";
+                line += R"("limit_hits":)"        + to_u64_(k.limit_hits) + ",";
+                line += R"("telemetry_drops":)"   + to_u64_(k.telemetry_drops) + ",";
                 line += R"("iae":)"               + to_fix_(acc_.iae) + ",";
                 line += R"("itae":)"              + to_fix_(acc_.itae) + ",";
                 line += R"("tvu":)"               + to_fix_(acc_.tvu) + ",";
                 line += R"("p50_lat_us":)"        + to_fix_(acc_.p50_lat_us) + ",";
                 line += R"("p95_lat_us":)"        + to_fix_(acc_.p95_lat_us) + ",";
                 line += R"("p99_lat_us":)"        + to_fix_(acc_.p99_lat_us) + ",";
-                line += R"("health_gap_frames":)" + std::to_string(static_cast<unsigned long long>(acc_.health_gap_frames));
+                line += R"("p999_lat_us":)"       + to_fix_(acc_.p999_lat_us) + ",";
+                line += R"("max_lat_us":)"        + to_fix_(acc_.max_lat_us) + ",";
+                line += R"("lat_samples":)"       + to_u64_(acc_.lat.count()) + ",";
+                line += R"("health_gap_frames":)" + to_u64_(acc_.health_gap_frames);
                 line += R"(}})";
                 write_line_(line);
             }
@@ -287,33 +252,25 @@ namespace ictk::tools{
             If not rotates, do rolling fsync every N MiB to bound loss on crash
             */
             void rotate_if_needed() override{
-                if (!fp_) return;
+                if (!out_.is_open()) return;
                 const std::size_t max_bytes = cfg_.segment_max_mb * 1024ull * 1024ull;
                 if (written_bytes_ >= max_bytes){
                     rotate_segment_();
                 } else if (cfg_.fsync_policy == FsyncPolicy::EveryNMB){
                     const std::size_t nbyte = cfg_.fsync_n_mb * 1024ull * 1024ull;
                     if ((written_bytes_ - last_fsync_mark_) >= nbyte){
-                        ::fflush(fp_);
-                        #if defined(_WIN32)
-                            _commit(_fileno(fp_));
-                        #else
-                            ::fsync(fileno(fp_));
-                        #endif
+                        out_.sync_async();  // // queued behind the data, the caller does not wait
                         last_fsync_mark_ = written_bytes_;
                     }
                 }
             }
 
-            // flush 
+            // flush -> barrier: everything written so far is on disk when this returns
             void flush() override{
-                if (!fp_) return;
-                ::fflush(fp_);
-                #if defined(_WIN32)
-                    _commit(_fileno(fp_));
-                #else
-                    ::fsync(fileno(fp_));
-                #endif
+                if (!out_.is_open()) return;
+                emit_env_();
+                out_.sync_async();
+                out_.wait_idle();
             }
 
         private:
@@ -333,13 +290,177 @@ namespace ictk::tools{
                 ictk::CommandMode fixed_mode{ictk::kPrimary};
             };
 
-            // append a newline stream to file
+            // // worst case tick + health pair (literals + 4 integers + 9 doubles), reserved up front
+            static constexpr std::size_t kMaxTickBytes = 512 + 4 * jsonfmt::kMaxU64 + 9 * jsonfmt::kMaxReal;
+            static constexpr std::size_t kMaxVecChannels = 1u << 16;
+
+            // // one tick + health pair; v -> packed channel arrays in the tick body (dims_)
+            void tick_(const TickSample& s, const TickVector* v){
+                // open -> apply decimation -> skips N-1 ticks by modulo counter
+                ensure_open_();
+
+                // // latency KPIs see every tick, decimation only thins the records
+                acc_.on_latency_ns(s.lat_ns);
+
+                // // envelope: every tick goes into the KPIs and the window, one record per full window
+                if (envelope_){
+                    kpi_tick_(s);
+                    env_.add(s, v);
+                    acc_.on_health_written();
+                    acc_.on_tick_commit();
+                    if (env_.full()) emit_env_();
+                    return;
+                }
+
+                if (decim_skip_(s.t)) return;
+                kpi_tick_(s);
+                record_(s, v);
+
+                // health mark true and increment 
+                acc_.on_health_written();
+                acc_.on_tick_commit();
+            }
+
+            // // window so far -> one tick + health pair: last values, max / OR health, "env" min / max / mean arrays
+            void emit_env_(){
+                if (env_.empty()) return;
+                const TickVector last = env_.last_vec();
+                record_(env_.head(), (dims_.ny + dims_.nu + dims_.nx) ? &last : nullptr);
+                env_.reset();
+            }
+
+            void kpi_tick_(const TickSample& s){
+                // define t=0 as first tick
+                if (first_t_ < 0) first_t_ = s.t;
+                // conv ns to sec
+                const double t_s = static_cast<double>(s.t - first_t_) * 1e-9;
+
+                // infer loop period once from first positive delta
+                if (dt_ns_hint_ == 0 && prev_t_ >= 0){
+                    const long long d = static_cast<long long>(s.t - prev_t_);
+                    if (d > 0) dt_ns_hint_ = d;
+                }
+                prev_t_ = s.t;
+
+                // update KPI accum
+                acc_.on_tick(t_s, s.r0, s.y0, s.u_post0);
+            }
+
+            void record_(const TickSample& s, const TickVector* v){
+                // // tick + health straight into the segment buffer: bounded size, no allocation
+                if (out_.is_open()){
+                    char* const p0 = out_.reserve(max_tick_bytes_);
+                    char* p = p0;
+
+                    // Write tick record
+                    p = put_(p, R"({"ch":"/ictk/tick","body":{"seq":)");
+                    p = put_u64_(p, ++seq_);
+                    p = put_(p, R"(,"t_ns":)");
+                    p = put_u64_(p, static_cast<std::uint64_t>(s.t));
+                    p = put_(p, R"(,"y0":)");         p = put_fix_(p, s.y0);
+                    p = put_(p, R"(,"r0":)");         p = put_fix_(p, s.r0);
+                    p = put_(p, R"(,"u_pre0":)");     p = put_fix_(p, s.u_pre0);
+                    p = put_(p, R"(,"u_post0":)");    p = put_fix_(p, s.u_post0);
+                    if (v){
+                        p = put_arr_(p, R"(,"y":[)", v->y, dims_.ny);
+                        p = put_arr_(p, R"(,"r":[)", v->r, dims_.ny);
+                        p = put_arr_(p, R"(,"u_pre":[)", v->u_pre, dims_.nu);
+                        p = put_arr_(p, R"(,"u_post":[)", v->u_post, dims_.nu);
+                        if (dims_.nx) p = put_arr_(p, R"(,"xhat":[)", v->xhat, dims_.nx);
+                    }
+                    if (envelope_){
+                        p = put_(p, R"(,"env":{"n":)");
+                        p = put_u64_(p, env_.count());
+                        p = put_(p, R"(,"min":[)");
+                        for (std::size_t k = 0; k < env_.signals(); ++k){
+                            if (k) *p++ = ',';
+                            p = put_fix_(p, env_.min(k));
+                        }
+                        p = put_(p, R"(],"max":[)");
+                        for (std::size_t k = 0; k < env_.signals(); ++k){
+                            if (k) *p++ = ',';
+                            p = put_fix_(p, env_.max(k));
+                        }
+                        p = put_(p, R"(],"mean":[)");
+                        for (std::size_t k = 0; k < env_.signals(); ++k){
+                            if (k) *p++ = ',';
+                            p = put_fix_(p, env_.mean(k));
+                        }
+                        p = put_(p, "]}");
+                    }
+                    p = put_(p, "}}\n");
+
+                    p = put_(p, R"({"ch":"/ictk/health","body":{)");
+                    p = put_(p, R"("deadline_miss_count":)"); p = put_u64_(p, s.h.deadline_miss_count);
+                    p = put_(p, R"(,"saturation_pct":)");     p = put_fix_(p, s.h.saturation_pct);
+                    p = put_(p, R"(,"rate_hits":)");          p = put_u64_(p, s.h.rate_limit_hits);
+                    p = put_(p, R"(,"jerk_hits":)");          p = put_u64_(p, s.h.jerk_limit_hits);
+                    p = put_(p, R"(,"fallback_active":)");    p = jsonfmt::put_bool(p, s.h.fallback_active);
+                    p = put_(p, R"(,"novelty_flag":)");       p = jsonfmt::put_bool(p, s.h.novelty_flag);
+                    p = put_(p, R"(,"aw_term_mag":)");        p = put_fix_(p, s.h.aw_term_mag);
+                    p = put_(p, R"(,"last_clamp_mag":)");     p = put_fix_(p, s.h.last_clamp_mag);
+                    p = put_(p, R"(,"last_rate_clip_mag":)"); p = put_fix_(p, s.h.last_rate_clip_mag);
+                    p = put_(p, R"(,"last_jerk_clip_mag":)"); p = put_fix_(p, s.h.last_jerk_clip_mag);
+                    p = put_(p, R"(,"mode":)");
+                    switch (cfg_.fixed_mode)
+                    {
+                    case ictk::CommandMode::Primary:
+                        *p++ = '0';
+                        break;
+                    
+                    case ictk::CommandMode::Residual:
+                        *p++ = '1';
+                        break;
+                    case ictk::CommandMode::Shadow:
+                        *p++ = '2';
+                        break;
+                    case ictk::CommandMode::Cooperative:
+                        *p++ = '3';
+                        break;
+                    default:
+                        *p++ = '0';
+                        break;
+                    }
+                    p = put_(p, "}}\n");
+
+                    const auto n = static_cast<std::size_t>(p - p0);
+                    out_.commit(n);
+                    written_bytes_ += n;
+                }
+            }
+
+            // // "key":[v0,v1,...] with n values, missing -> 0
+            static char* put_arr_(char* p, std::string_view key, std::span<const Scalar> v, std::size_t n) noexcept{
+                p = put_(p, key);
+                for (std::size_t i = 0; i < n; ++i){
+                    if (i) *p++ = ',';
+                    p = put_fix_(p, i < v.size() ? static_cast<double>(v[i]) : 0.0);
+                }
+                *p++ = ']';
+                return p;
+            }
+
+            // append a line + newline to the segment (cold records: meta, buildinfo, anchors, kpi)
             void write_line_(const std::string &line){
-                /// @todo Check for short writes -> under disk errors
-                if (!fp_) return;
-                const std::string out = line + "\n";
-                const size_t n = std::fwrite(out.data(), 1, out.size(), fp_);
-                written_bytes_ += n;    // update byte counter
+                /// @todo Check for short writes -> under disk errors (SegmentWriter::io_errors)
+                if (!out_.is_open()) return;
+                out_.write(line.data(), line.size());
+                out_.write("\n", 1);
+                written_bytes_ += line.size() + 1;    // update byte counter
+            }
+
+            static char* put_(char* p, std::string_view v) noexcept{
+                std::memcpy(p, v.data(), v.size());
+                return p + v.size();
+            }
+
+            static char* put_u64_(char* p, std::uint64_t v) noexcept{
+                return jsonfmt::put_u64(p, v);
+            }
+
+            // same digits as to_fix_
+            static char* put_fix_(char* p, double v) noexcept{
+                return jsonfmt::put_real(p, v);
             }
 
             // to generate unique file name with prefix if defined GIT_SHA + time
@@ -351,18 +472,17 @@ namespace ictk::tools{
             }
 
             void ensure_open_(){
-                if (fp_) return;
+                if (out_.is_open()) return;
                 open_new_file_();
             }
 
             // Open new seg then write a meta line first
             void open_new_file_(){
                 current_path_ = make_filename_(cfg_.out_dir);
-                fp_ = std::fopen(current_path_.c_str(), "wb");
                 written_bytes_ = 0;
                 last_fsync_mark_ = 0;
 
-                if (!fp_){
+                if (!out_.open(current_path_)){
                     // // no evidence -> no audit
                     std::fprintf(stderr, "ictk_recorder: failed to open '%s'\n", current_path_.c_str());
                     return;
@@ -371,7 +491,9 @@ namespace ictk::tools{
                 std::string meta;
                 meta.reserve(256);
                 meta += R"({"meta":{"schema_backend":"jsonl","dt_ns":)";
-                meta += std::to_string(static_cast<long long>(dt_ns_hint_));
+                meta += to_i64_(dt_ns_hint_);
+                // // tick period of every segment, rotated ones included (buildinfo is written once per run)
+                meta += R"(,"tick_decimation":)" + to_u64_(static_cast<std::uint64_t>(std::max(cfg_.tick_decimation, 1)));
                 meta += R"(,"ictk_version":")" + std::string(ictk::kVersionStr) + R"(",)";
                 meta += R"("git_sha":")" + std::string(GIT_SHA) + R"(","schema_registry_snapshot":[]}})";
                 write_line_(meta);
@@ -379,16 +501,11 @@ namespace ictk::tools{
                 seq_ = 0; // reset per seg
             }
 
+            // fsync + close are queued on the flusher; the next segment opens right away
             void close_current_(){
-                if (!fp_) return;
-                ::fflush(fp_);
-                #if defined(_WIN32)
-                    _commit(_fileno(fp_));
-                #else
-                    ::fsync(fileno(fp_));
-                #endif
-                std::fclose(fp_);
-                fp_ = nullptr;
+                if (!out_.is_open()) return;
+                emit_env_();
+                out_.close_async();
             }
 
             void rotate_segment_(){
@@ -396,11 +513,20 @@ namespace ictk::tools{
                 open_new_file_();
             }
 
-            // floor formatting
+            // shortest round trip text (jsonfmt::put_real), cold records
             static inline std::string to_fix_(double v){
-                char buf[64];
-                std::snprintf(buf, sizeof(buf), "%.9g", v);
-                return std::string(buf);
+                char buf[jsonfmt::kMaxReal];
+                return std::string(buf, jsonfmt::put_real(buf, v));
+            }
+
+            static inline std::string to_u64_(std::uint64_t v){
+                char buf[jsonfmt::kMaxU64];
+                return std::string(buf, jsonfmt::put_u64(buf, v));
+            }
+
+            static inline std::string to_i64_(std::int64_t v){
+                char buf[jsonfmt::kMaxI64];
+                return std::string(buf, jsonfmt::put_i64(buf, v));
             }
 
             // wite only Nth tick
@@ -412,7 +538,7 @@ namespace ictk::tools{
             
         private:
             RecorderConfig cfg_;        // params
-            std::FILE* fp_{nullptr};    // seg handle
+            detail::SegmentWriter out_; // seg output (buffers + flusher thread)
             std::string current_path_{};// active path
 
             // for rotating and rolling fsync
@@ -429,11 +555,32 @@ namespace ictk::tools{
             std::uint64_t seq_{0};
             std::uint64_t tick_index_{0};
 
+            ictk::Dims dims_{};                 // vector channels per tick (opt.dims)
+            bool envelope_{false};              // tick_decimation windows -> detail::Envelope records
+            detail::Envelope env_{};
+            std::size_t max_tick_bytes_{kMaxTickBytes};
+
             detail::KpiAcc acc_{};
     };
 
     // // Factory
     std::unique_ptr<Recorder> Recorder::open(const RecorderOptions& opt){
+        switch (opt.backend){
+            case RecorderOptions::Jsonl:
+                return std::unique_ptr<Recorder>(new RecorderJsonl(opt));
+            case RecorderOptions::Columnar:
+                return make_columnar_recorder(opt);
+            case RecorderOptions::Mcap:
+                #if ICTK_RECORDER_BACKEND_MCAP
+                    return make_mcap_recorder(opt);
+                #else
+                    std::fprintf(stderr, "ictk_recorder: MCAP backend not built (ICTK_RECORDER_BACKEND_MCAP=OFF)\n");
+                    return nullptr;
+                #endif
+            case RecorderOptions::Auto:
+            default:
+                break;
+        }
         #if ICTK_RECORDER_BACKEND_MCAP
             return make_mcap_recorder(opt);
         #else
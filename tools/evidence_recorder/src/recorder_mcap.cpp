@@ -1,4 +1,5 @@
 #include <atomic>
+#include <span>
 #include <vector>
 #include <chrono>
 #include <cstdio>
@@ -10,6 +11,7 @@
 #include <string_view>
 
 #include "kpi_calc.hpp"         // Kpi accum 
+#include "envelope.hpp"         // envelope decimation windows
 #include "env_buildinfo.hpp"    // build BuildIinfo struct from flags
 
 #include "ictk/io/kpi.hpp"
@@ -177,6 +179,39 @@ namespace ictk::tools{
                 return ictk::metrics::Mode::Primary;
             }
         } // fb_mode
+
+        /*
+        MCAP output sink: every byte the writer emits goes to the file and through BLAKE3 on its way
+            -> the sidecar payload hash is ready at close, the segment is never read back
+        */
+        class HashingFileSink final : public mcap::IWritable{
+            public:
+                mcap::Status open(std::string_view path){
+                    hash_ = hash::Blake3{};
+                    return file_.open(path);
+                }
+
+                void handleWrite(const std::byte* data, uint64_t size) override{
+                    hash_.update(data, static_cast<std::size_t>(size));
+                    file_.handleWrite(data, size);
+                }
+
+                void end() override{
+                    file_.end();
+                }
+
+                uint64_t size() const override{
+                    return file_.size();
+                }
+
+                std::array<std::uint8_t, 32> digest() const noexcept{
+                    return hash_.digest();
+                }
+
+            private:
+                mcap::FileWriter file_;
+                hash::Blake3 hash_;
+        }; // class HashingFileSink
         
         class RecorderMcap final : public Recorder{
             public:                                      // zero init cfg and pre alloc FlatBufferBuilder with 1KB
@@ -198,6 +233,18 @@ namespace ictk::tools{
                     std::error_code ec;
                     fs::create_directories(cfg_.out_dir, ec);
 
+                    // vector channels: every tick carries them as packed [double] fields
+                    if (opt.dims.ny > kMaxVecChannels || opt.dims.nu > kMaxVecChannels || opt.dims.nx > kMaxVecChannels
+                        || 2 * opt.dims.ny + 2 * opt.dims.nu + opt.dims.nx > kMaxVecChannels){
+                        std::fprintf(stderr, "ictk_mcap: too many vector channels, recording channel 0 only\n");
+                    }else{
+                        dims_ = opt.dims;
+                    }
+
+                    // envelope decimation: one Tick per window, env_min / env_max / env_mean on top
+                    envelope_ = opt.decimation == RecorderOptions::Envelope && cfg_.tick_decimation > 1;
+                    if (envelope_) env_.init(static_cast<std::size_t>(cfg_.tick_decimation), dims_);
+
                     // // Write mcap header once
                     open_new_file_();
                     register_schemas_channels_();
@@ -306,12 +353,157 @@ namespace ictk::tools{
                 
                 // // emit Tick and Health, updates KPIs, rotate if needed
                 void write_tick(const TickSample& s) override{
-                    // Guard -> Decimation gate -> only every Nth tick passes
+                    if (dims_.ny + dims_.nu + dims_.nx == 0){
+                        tick_(s, nullptr);
+                        return;
+                    }
+                    // // same vectors as write_tick_vec, channel 0 only
+                    const Scalar y = static_cast<Scalar>(s.y0), r = static_cast<Scalar>(s.r0);
+                    const Scalar u_pre = static_cast<Scalar>(s.u_pre0), u_post = static_cast<Scalar>(s.u_post0);
+                    TickVector v{};
+                    v.y = {&y, 1};
+                    v.r = {&r, 1};
+                    v.u_pre = {&u_pre, 1};
+                    v.u_post = {&u_post, 1};
+                    tick_(s, &v);
+                } // void write_tick
+
+                void write_tick_vec(const TickVector& v) override{
+                    tick_(channel0(v), &v);
+                } // void write_tick_vec
+
+                // // Emit KPI summary
+                void write_kpi(const ictk::KpiCounters& k) override{
+                    // partial window first, so the report covers every recorded tick
+                    emit_env_();
+
+                    // pick timestamp -> prefer last tick (prev_t)
+                    const uint64_t t = prev_t_ >= 0 ? static_cast<uint64_t>(prev_t_) : static_cast<uint64_t>(mono_anchor_ns_);
+
+                    // reuse buffer 
+                    builder_.Reset();
+
+                    // compute p50/p95/p99/p99.9/max 
+                    acc_.finalize_latency_percentiles();
+
+                    //  Serialize KPI
+                    auto kp = ictk::metrics::CreateKpi(
+                        builder_,
+
+                        static_cast<uint64_t> (k.updates),
+                        static_cast<uint64_t> (k.watchdog_trips),
+                        static_cast<uint64_t> (k.fallback_entries),
+                        static_cast<uint64_t> (k.limit_hits),
+
+                        acc_.iae, acc_.itae, acc_.tvu,
+                        acc_.p50_lat_us, acc_.p95_lat_us, acc_.p99_lat_us,
+
+                        static_cast<uint64_t> (acc_.health_gap_frames),
+                        acc_.p999_lat_us, acc_.max_lat_us,
+                        static_cast<uint64_t> (acc_.lat.count())
+                    );
+
+                    // finish the buffer
+                    builder_.Finish(kp);
+
+                    // for /ictk/kpi_report 
+                    mcap::Message msg;
+                    msg.channelId = ch_kpi_;
+                    msg.sequence = static_cast<uint32_t>(seq_++);
+                    msg.logTime = t;
+                    msg.publishTime = t;
+
+                    // copy flat buffer into MCAP message 
+                    auto buf = builder_.Release();
+                    msg.data     = reinterpret_cast<const std::byte*>(buf.data());
+                    msg.dataSize = buf.size();
+                    (void)writer_.write(msg);  // Status is [[nodiscard]]
+
+                } // void write_kpi
+                
+                // seg roll and periodic fsync
+                void rotate_if_needed() override{
+                    // conv MB limit to bytes
+                    const std::size_t max_bytes = cfg_.segment_max_mb * 1024ull * 1024ull;
+
+                    // bytes handed to the file so far: counted by the writer's sink, no stat() per tick
+                    const mcap::IWritable* sink = writer_.dataSink();
+                    const std::size_t sz = sink ? static_cast<std::size_t>(sink->size()) : 0;
+
+                    // Hard rotate when size threshold reached
+                    if (sz >= max_bytes){
+                        rotate_segment_(); 
+                        return; 
+                    }
+
+                    // rolling -> if policy is every N MB
+                    if (!cfg_.fsync_every_segment) {
+                        const std::size_t nbytes = cfg_.fsync_n_mb * 1024ull * 1024ull;
+                        if ((sz - last_fsync_mark_) >= nbytes){ 
+                            flush(); 
+                            last_fsync_mark_ = sz; 
+                        }
+                    }
+                } // void rotate_if_needed
+
+                void flush() override{
+                    /*
+                    no op with header only writer, apart from the open envelope window
+                    */
+                    emit_env_();
+                } // void flush
+
+            private:
+                // // vector channels above this are refused (channel 0 only), as in JSONL
+                static constexpr std::size_t kMaxVecChannels = 1u << 16;
+
+                // // decimation gate, then one Tick + Health pair; v -> packed channel vectors (dims_)
+                void tick_(const TickSample& s, const TickVector* v){
+                    // latency KPIs see every tick, decimation only thins the records
+                    acc_.on_latency_ns(s.lat_ns);
+
+                    // // envelope: every tick goes into the KPIs and the window, one record per full window
+                    if (envelope_){
+                        kpi_tick_(s, s.t);
+                        env_.add(s, v);
+                        if (env_.full()){
+                            emit_env_();
+                            rotate_if_needed();
+                        }
+                        return;
+                    }
+
                     if (cfg_.tick_decimation > 1 && (tick_index_++ % cfg_.tick_decimation) != 0) return;
+                    record_(s, v);
+                    kpi_tick_(s, prev_t_);
 
+                    // check segment size and fsync policy
+                    rotate_if_needed();
+                } // void tick_
+
+                // // window so far -> one Tick + Health pair: last values, max / OR health, env_* vectors
+                void emit_env_(){
+                    if (env_.empty()) return;
+                    const TickVector last = env_.last_vec();
+                    record_(env_.head(), (dims_.ny + dims_.nu + dims_.nx) ? &last : nullptr);
+                    env_.reset();
+                } // void emit_env_
+
+                // // KPI accum from r/y/u at t (ns), relative to the first tick of the segment
+                void kpi_tick_(const TickSample& s, long long t){
                     // capture start time once for relative time KPI integration
-                    if (first_t_ < 0) first_t_ = s.t;
+                    if (first_t_ < 0) first_t_ = t;
+
+                    // compute absolute seconds since start of ITAE
+                    const double t_s = static_cast<double>(t - first_t_) / 1e9;
+                    acc_.on_tick(t_s, s.r0, s.y0, s.u_post0);
+
+                    // mark health record was written, commit tick
+                    acc_.on_health_written();
+                    acc_.on_tick_commit();
+                } // void kpi_tick_
 
+                void record_(const TickSample& s, const TickVector* v){
                     // enforce strictly increaing timestamps for MCAP 
                     if (prev_t_ >= 0 && s.t <= prev_t_) prev_t_ += 1;
                     else prev_t_ = s.t;
@@ -322,6 +514,29 @@ namespace ictk::tools{
                     // // Tick -> reuse FlatBufferBuilder buffer -> Zero alloc
                     builder_.Reset();
 
+                    // packed channel vectors go in before the table (absent without dims_)
+                    flatbuffers::Offset<flatbuffers::Vector<double>> y, r, u_pre, u_post, xhat;
+                    if (v){
+                        y = put_vec_(v->y, dims_.ny);
+                        r = put_vec_(v->r, dims_.ny);
+                        u_pre = put_vec_(v->u_pre, dims_.nu);
+                        u_post = put_vec_(v->u_post, dims_.nu);
+                        if (dims_.nx) xhat = put_vec_(v->xhat, dims_.nx);
+                    }
+
+                    // envelope window: min / max / mean of every signal, same order as JSONL "env"
+                    flatbuffers::Offset<flatbuffers::Vector<double>> env_min, env_max, env_mean;
+                    if (envelope_){
+                        const std::size_t n = env_.signals();
+                        double* p = nullptr;
+                        env_min = builder_.CreateUninitializedVector(n, &p);
+                        for (std::size_t k = 0; k < n; ++k) p[k] = flatbuffers::EndianScalar(env_.min(k));
+                        env_max = builder_.CreateUninitializedVector(n, &p);
+                        for (std::size_t k = 0; k < n; ++k) p[k] = flatbuffers::EndianScalar(env_.max(k));
+                        env_mean = builder_.CreateUninitializedVector(n, &p);
+                        for (std::size_t k = 0; k < n; ++k) p[k] = flatbuffers::EndianScalar(env_.mean(k));
+                    }
+
                     // Serialize tick per schema
                     auto tk = ictk::metrics::CreateTick(
                         builder_,
@@ -330,7 +545,10 @@ namespace ictk::tools{
                         s.y0,
                         s.r0,
                         s.u_pre0,
-                        s.u_post0
+                        s.u_post0,
+                        y, r, u_pre, u_post, xhat,
+                        static_cast<uint64_t>(envelope_ ? env_.count() : 0),
+                        env_min, env_max, env_mean
                     );
                     // Finish -> prepare buffer
                     builder_.Finish(tk);
@@ -384,99 +602,18 @@ namespace ictk::tools{
                     msg.data = reinterpret_cast<const std::byte*>(buf2.data());
                     msg.dataSize = buf2.size();
                     (void)writer_.write(msg);  // Status is [[nodiscard]]
-
-                    // compute absolute seconds since start of ITAE
-                    const double t_s = static_cast<double>(t - static_cast<uint64_t>(first_t_)) / 1e9;
-
-                    // update KPI accum from r/y/u
-                    acc_.on_tick(t_s, s.r0, s.y0, s.u_post0);
-
-                    // mark health record was written
-                    acc_.on_health_written();
-
-                    // commit tick
-                    acc_.on_tick_commit();
-
-                    // check segment size and fsync policy
-                    rotate_if_needed();
-                } // void write_tick
-
-                // // Emit KPI summary
-                void write_kpi(const ictk::KpiCounters& k) override{
-                    // pick timestamp -> prefer last tick (prev_t)
-                    const uint64_t t = prev_t_ >= 0 ? static_cast<uint64_t>(prev_t_) : static_cast<uint64_t>(mono_anchor_ns_);
-
-                    // reuse buffer 
-                    builder_.Reset();
-
-                    // compute p50/p95/p99 
-                    acc_.finalize_latency_percentiles();
-
-                    //  Serialize KPI
-                    auto kp = ictk::metrics::CreateKpi(
-                        builder_,
-
-                        static_cast<uint64_t> (k.updates),
-                        static_cast<uint64_t> (k.watchdog_trips),
-                        static_cast<uint64_t> (k.fallback_entries),
-                        static_cast<uint64_t> (k.limit_hits),
-
-                        acc_.iae, acc_.itae, acc_.tvu,
-                        acc_.p50_lat_us, acc_.p95_lat_us, acc_.p99_lat_us,
-
-                        static_cast<uint64_t> (acc_.health_gap_frames)
-                    );
-
-                    // finish the buffer
-                    builder_.Finish(kp);
-
-                    // for /ictk/kpi_report 
-                    mcap::Message msg;
-                    msg.channelId = ch_kpi_;
-                    msg.sequence = static_cast<uint32_t>(seq_++);
-                    msg.logTime = t;
-                    msg.publishTime = t;
-
-                    // copy flat buffer into MCAP message 
-                    auto buf = builder_.Release();
-                    msg.data     = reinterpret_cast<const std::byte*>(buf.data());
-                    msg.dataSize = buf.size();
-                    (void)writer_.write(msg);  // Status is [[nodiscard]]
-
-                } // void write_kpi
-                
-                // seg roll and periodic fsync
-                void rotate_if_needed() override{
-                    // conv MB limit to bytes
-                    const std::size_t max_bytes = cfg_.segment_max_mb * 1024ull * 1024ull;
-
-                    // get current file size without exceptions
-                    std::error_code ec;
-                    const auto sz = fs::file_size(mcap_path_, ec);
-
-                    // Hard rotate when size threshold reached
-                    if (!ec && sz >= max_bytes){
-                        rotate_segment_(); 
-                        return; 
+                } // void record_
+
+                // // n doubles straight into the builder: longer spans are cut, shorter ones padded with 0
+                flatbuffers::Offset<flatbuffers::Vector<double>> put_vec_(std::span<const Scalar> src, std::size_t n){
+                    double* p = nullptr;
+                    const auto off = builder_.CreateUninitializedVector(n, &p);
+                    for (std::size_t i = 0; i < n; ++i){
+                        p[i] = flatbuffers::EndianScalar(i < src.size() ? static_cast<double>(src[i]) : 0.0);
                     }
+                    return off;
+                } // put_vec_
 
-                    // rolling -> if policy is every N MB
-                    if (!cfg_.fsync_every_segment) {
-                        const std::size_t nbytes = cfg_.fsync_n_mb * 1024ull * 1024ull;
-                        if (!ec && (sz - last_fsync_mark_) >= nbytes){ 
-                            flush(); 
-                            last_fsync_mark_ = sz; 
-                        }
-                    }
-                } // void rotate_if_needed
-
-                void flush() override{
-                    /*
-                    no op with header only writer
-                    */
-                } // void flush
-
-            private:
                 // configs -> runtime knobs copied from RecorderOptions at construction 
                 struct RecorderConfig{
                     std::string out_dir;                // file destination
@@ -519,12 +656,14 @@ namespace ictk::tools{
                     mcap::McapWriterOptions wopt("");
                     wopt.noStatistics = true; 
 
-                    auto st = writer_.open(mcap_path_.string(), wopt);
+                    // file behind the hashing sink -> the payload hash is computed as the bytes are written
+                    auto st = sink_.open(mcap_path_.string());
 
                     if (!st.ok()){
                         std::fprintf(stderr,"ictk_mcap: open failed: %s\n", st.message.c_str());
                         std::abort();
                     }
+                    writer_.open(sink_, wopt);
 
                     // reset rotation fsync 
                     last_fsync_mark_ = 0;
@@ -533,12 +672,14 @@ namespace ictk::tools{
                 }// void open_new_file_
 
                 void close_current_(){
+                    // open envelope window goes into this segment
+                    emit_env_();
 
                     //  close file
                     writer_.close();
                 
-                    // compute payload BLAKE3-256 over the final MCAP file and SHA 256 over the schema bfbs
-                    const auto blake = hash::blake3_256_file(mcap_path_.string().c_str());
+                    // payload BLAKE3-256 taken by the sink while writing (no read back), SHA 256 over the schema bfbs
+                    const auto blake = sink_.digest();
                     const auto blake_hex = hash::to_hex({blake.data(), blake.size()});
                     const auto bfbs_sha = hash::sha256_file((fs::path(cfg_.schema_dir)/"ictk_metrics.bfbs").string().c_str());
 
@@ -637,9 +778,17 @@ namespace ictk::tools{
                 uint64_t tick_seq_{0};          // Sequence counter for tick message 
                 uint64_t tick_index_{0};        // raw counter for all incoming ticks before decimation
 
-                // writer object 
+                // writer object and the file sink it writes through (hashing on the way)
+                HashingFileSink sink_;
                 mcap::McapWriter writer_;
 
+                // vector channels per tick (opt.dims)
+                ictk::Dims dims_{};
+
+                // tick_decimation windows -> detail::Envelope records
+                bool envelope_{false};
+                detail::Envelope env_{};
+
                 flatbuffers::FlatBufferBuilder builder_;
                 detail::KpiAcc acc_{};
 
@@ -0,0 +1,352 @@
+#include <new>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+
+#include "segment_writer.hpp"
+
+#if defined(_WIN32)
+    #include <io.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/uio.h>
+    #include <sys/stat.h>
+#endif
+
+namespace ictk::tools::detail{
+
+    #if defined(_WIN32)
+        struct iovec{
+            void* iov_base;
+            std::size_t iov_len;
+        };
+    #endif
+
+    namespace{
+        constexpr std::size_t kMaxIov = 64;     // buffers coalesced into one pwritev
+        constexpr std::size_t kCtlJobs = 64;    // room for queued syncs / closes on top of the buffers
+
+        // // whole iov at off, retrying short writes; false -> I/O error
+        bool write_all(int fd, struct iovec* iov, std::size_t cnt, std::uint64_t off){
+            #if defined(_WIN32)
+                for (std::size_t i = 0; i < cnt; ++i){
+                    if (_lseeki64(fd, static_cast<__int64>(off), SEEK_SET) < 0) return false;
+                    const char* p = static_cast<const char*>(iov[i].iov_base);
+                    std::size_t left = iov[i].iov_len;
+                    while (left){
+                        const int r = _write(fd, p, static_cast<unsigned>(std::min<std::size_t>(left, 1u << 30)));
+                        if (r <= 0) return false;
+                        p += r; left -= static_cast<std::size_t>(r); off += static_cast<std::uint64_t>(r);
+                    }
+                }
+                return true;
+            #else
+                while (cnt){
+                    const ssize_t r = ::pwritev(fd, iov, static_cast<int>(cnt), static_cast<off_t>(off));
+                    if (r < 0){
+                        if (errno == EINTR) continue;
+                        return false;
+                    }
+                    off += static_cast<std::uint64_t>(r);
+                    auto left = static_cast<std::size_t>(r);
+                    while (cnt && left >= iov->iov_len){
+                        left -= iov->iov_len;
+                        ++iov; --cnt;
+                    }
+                    if (cnt){
+                        iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+                        iov->iov_len -= left;
+                    }
+                }
+                return true;
+            #endif
+        }
+
+        // // data + size; the timestamps are not worth an extra journal write per sync
+        bool sync_fd(int fd){
+            #if defined(_WIN32)
+                return _commit(fd) == 0;
+            #elif defined(__linux__)
+                return ::fdatasync(fd) == 0;
+            #else
+                return ::fsync(fd) == 0;
+            #endif
+        }
+
+        // // reserve blocks past the end without changing the size; unsupported filesystem -> grow on write as before
+        void prealloc_fd(int fd, std::uint64_t bytes){
+            #if defined(__linux__)
+                (void)::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(bytes));
+            #else
+                (void)fd; (void)bytes;
+            #endif
+        }
+
+        // // size -> the written size: drops the O_DIRECT padding and the preallocated blocks past it
+        bool trim_fd(int fd, std::uint64_t size){
+            #if defined(_WIN32)
+                return _chsize_s(fd, static_cast<__int64>(size)) == 0;
+            #else
+                return ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+            #endif
+        }
+
+        void close_fd(int fd){
+            #if defined(_WIN32)
+                _close(fd);
+            #else
+                ::close(fd);
+            #endif
+        }
+    } // namespace
+
+    SegmentWriter::~SegmentWriter(){
+        if (flusher_.joinable()){
+            if (fd_ >= 0) close_async();
+            {
+                std::lock_guard<std::mutex> lk(mu_);
+                quit_ = true;
+            }
+            cv_work_.notify_one();
+            flusher_.join();
+        }else if (fd_ >= 0){
+            close_fd(fd_);
+        }
+        for (std::byte* b : bufs_) ::operator delete(b, std::align_val_t{kPage});
+    }
+
+    bool SegmentWriter::start(std::size_t buf_bytes, std::size_t nbufs, const IoOptions& io){
+        if (flusher_.joinable()) return true;
+        buf_bytes_ = std::max<std::size_t>(kPage, (buf_bytes + kPage - 1) / kPage * kPage);
+        nbufs = std::max<std::size_t>(2, nbufs);
+        io_ = io;
+        #if !defined(__linux__)
+            io_ = IoOptions{};
+        #endif
+        // // O_DIRECT: one page on top for the carried partial page (see hand_over_)
+        const std::size_t alloc = buf_bytes_ + (io_.direct ? kPage : 0);
+
+        bufs_.reserve(nbufs);
+        free_.reserve(nbufs);
+        for (std::size_t i = 0; i < nbufs; ++i){
+            auto* b = static_cast<std::byte*>(::operator new(alloc, std::align_val_t{kPage}, std::nothrow));
+            if (!b) return false;
+            bufs_.push_back(b);
+            free_.push_back(nbufs - 1 - i);
+        }
+        jobs_.assign(nbufs + kCtlJobs, Job{});
+        flusher_ = std::thread([this]{ flusher_main_(); });
+        return true;
+    }
+
+    bool SegmentWriter::open(const std::string& path){
+        if (fd_ >= 0) close_async();
+        if (!flusher_.joinable()) return false;   // // start() first
+        #if defined(_WIN32)
+            fd_ = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+        #else
+            constexpr int kFlags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+            fd_ = -1;
+            direct_fd_ = false;
+            #if defined(__linux__)
+                if (io_.direct){
+                    fd_ = ::open(path.c_str(), kFlags | O_DIRECT, 0644);
+                    direct_fd_ = fd_ >= 0;
+                }
+            #endif
+            if (fd_ < 0) fd_ = ::open(path.c_str(), kFlags, 0644);   // // tmpfs and friends refuse O_DIRECT
+        #endif
+        file_off_ = 0;
+        if (have_cur_) used_ -= carry_;   // // a carried page belongs to the previous segment
+        carry_ = 0;
+        if (fd_ < 0) return false;
+        if (io_.prealloc_bytes){
+            std::unique_lock<std::mutex> lk(mu_);
+            push_(lk, Job{Job::kPrealloc, fd_, 0, 0, io_.prealloc_bytes});   // // on the flusher, open does not wait
+        }
+        return true;
+    }
+
+    char* SegmentWriter::reserve(std::size_t n){
+        if (have_cur_ && n > room_()) hand_over_();
+        if (!have_cur_){
+            std::unique_lock<std::mutex> lk(mu_);
+            take_(lk);
+        }
+        return reinterpret_cast<char*>(bufs_[cur_]) + used_;
+    }
+
+    void SegmentWriter::take_(std::unique_lock<std::mutex>& lk){
+        cv_done_.wait(lk, [&]{ return !free_.empty(); });
+        cur_ = free_.back();
+        free_.pop_back();
+        have_cur_ = true;
+        used_ = 0;
+        carry_ = 0;
+    }
+
+    void SegmentWriter::write(const char* p, std::size_t n){
+        while (n){
+            char* dst = reserve(1);
+            const std::size_t k = std::min(n, room_());
+            std::memcpy(dst, p, k);
+            commit(k);
+            p += k; n -= k;
+        }
+    }
+
+    /*
+    O_DIRECT: offsets and lengths are whole pages -> the buffer goes out zero padded to a page, the file offset only
+        advances over whole pages and the partial last page is copied to the front of the next buffer (carry_),
+        so it is written again, completed, with the next data; trim_fd() cuts the padding at close
+    */
+    void SegmentWriter::hand_over_(){
+        if (!have_cur_ || used_ == carry_) return;
+        if (fd_ < 0){
+            used_ = carry_ = 0;   // // no file -> nothing to keep
+            return;
+        }
+        std::size_t len = used_;
+        const std::size_t tail = direct_fd_ ? used_ % kPage : 0;
+        std::byte* const b = bufs_[cur_];
+        if (tail){
+            len = used_ - tail + kPage;
+            std::memset(b + used_, 0, len - used_);
+        }
+        std::unique_lock<std::mutex> lk(mu_);
+        push_(lk, Job{Job::kWrite, fd_, cur_, len, file_off_});
+        file_off_ += used_ - tail;
+        have_cur_ = false;
+        used_ = carry_ = 0;
+        if (tail){
+            // // the flusher only reads the old buffer, copying out of it meanwhile is fine
+            take_(lk);
+            std::memcpy(bufs_[cur_], b + (len - kPage), tail);
+            used_ = carry_ = tail;
+        }
+    }
+
+    void SegmentWriter::push_(std::unique_lock<std::mutex>& lk, const Job& j){
+        cv_done_.wait(lk, [&]{ return job_count_ < jobs_.size(); });
+        jobs_[(job_head_ + job_count_) % jobs_.size()] = j;
+        ++job_count_;
+        cv_work_.notify_one();
+    }
+
+    void SegmentWriter::sync_async(){
+        hand_over_();
+        if (fd_ < 0) return;
+        std::unique_lock<std::mutex> lk(mu_);
+        push_(lk, Job{Job::kSync, fd_, 0, 0, 0});
+    }
+
+    void SegmentWriter::close_async(){
+        hand_over_();
+        if (fd_ < 0) return;
+        {
+            std::unique_lock<std::mutex> lk(mu_);
+            push_(lk, Job{Job::kClose, fd_, 0, 0, file_off_ + carry_});
+        }
+        fd_ = -1;
+        file_off_ = 0;
+        if (have_cur_) used_ -= carry_;
+        carry_ = 0;
+    }
+
+    void SegmentWriter::wait_idle(){
+        std::unique_lock<std::mutex> lk(mu_);
+        cv_done_.wait(lk, [&]{ return job_count_ == 0 && in_flight_ == 0; });
+    }
+
+    void SegmentWriter::flusher_main_(){
+        std::vector<Job> batch(jobs_.size());
+        for (;;){
+            std::size_t n = 0;
+            {
+                std::unique_lock<std::mutex> lk(mu_);
+                cv_work_.wait(lk, [&]{ return quit_ || job_count_ > 0; });
+                if (job_count_ == 0) return;   // // quit with nothing queued
+                n = job_count_;
+                for (std::size_t i = 0; i < n; ++i) batch[i] = jobs_[(job_head_ + i) % jobs_.size()];
+                job_head_ = (job_head_ + n) % jobs_.size();
+                job_count_ = 0;
+                in_flight_ = n;
+            }
+            cv_done_.notify_all();   // // ring room
+
+            run_(batch.data(), n);
+
+            {
+                std::lock_guard<std::mutex> lk(mu_);
+                for (std::size_t i = 0; i < n; ++i){
+                    if (batch[i].kind == Job::kWrite) free_.push_back(batch[i].buf);
+                }
+                in_flight_ = 0;
+            }
+            cv_done_.notify_all();
+        }
+    }
+
+    void SegmentWriter::run_(const Job* jobs, std::size_t n){
+        struct iovec iov[kMaxIov];
+        for (std::size_t i = 0; i < n;){
+            const Job& j = jobs[i];
+            if (j.kind == Job::kWrite){
+                // // consecutive buffers of the same file, back to back on disk -> one call
+                std::size_t cnt = 0;
+                std::uint64_t end = j.off;
+                while (i < n && cnt < kMaxIov && jobs[i].kind == Job::kWrite && jobs[i].fd == j.fd && jobs[i].off == end){
+                    iov[cnt].iov_base = bufs_[jobs[i].buf];
+                    iov[cnt].iov_len = jobs[i].len;
+                    end += jobs[i].len;
+                    ++cnt; ++i;
+                }
+                if (!write_all(j.fd, iov, cnt, j.off)) io_errors_.fetch_add(1, std::memory_order_relaxed);
+                else writeback_(j.fd, end);
+                continue;
+            }
+            if (j.kind == Job::kSync){
+                if (!sync_fd(j.fd)) io_errors_.fetch_add(1, std::memory_order_relaxed);
+            }else if (j.kind == Job::kPrealloc){
+                prealloc_fd(j.fd, j.off);
+            }else{
+                // // trim only when something can lie past the data; a plain file already has its size
+                const bool trim = io_.prealloc_bytes || io_.direct;
+                if ((trim && !trim_fd(j.fd, j.off)) || !sync_fd(j.fd)) io_errors_.fetch_add(1, std::memory_order_relaxed);
+                close_fd(j.fd);
+                if (j.fd == wb_fd_) wb_fd_ = -1;
+            }
+            ++i;
+        }
+    }
+
+    /*
+    Write-out in windows of writeback_bytes: start the new window, wait for the one before (normally done by then)
+        -> dirty pages of the segment stay under ~2 windows, flush latency does not depend on how much the
+        page cache chose to hold back; fdatasync at rotation finds only the last window
+    */
+    void SegmentWriter::writeback_(int fd, std::uint64_t end){
+        #if defined(__linux__)
+            if (!io_.writeback_bytes) return;   // // O_DIRECT fd: nothing dirty, the call returns at once
+            if (fd != wb_fd_){
+                wb_fd_ = fd;
+                wb_mark_ = wb_prev_ = wb_prev_len_ = 0;
+            }
+            if (end < wb_mark_ + io_.writeback_bytes) return;
+            if (wb_prev_len_){
+                (void)::sync_file_range(fd, static_cast<off_t>(wb_prev_), static_cast<off_t>(wb_prev_len_),
+                    SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+            }
+            (void)::sync_file_range(fd, static_cast<off_t>(wb_mark_), static_cast<off_t>(end - wb_mark_), SYNC_FILE_RANGE_WRITE);
+            wb_prev_ = wb_mark_;
+            wb_prev_len_ = end - wb_mark_;
+            wb_mark_ = end;
+        #else
+            (void)fd; (void)end;
+        #endif
+    }
+
+} // namespace ictk::tools::detail
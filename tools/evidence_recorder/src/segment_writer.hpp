@@ -0,0 +1,160 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <condition_variable>
+
+#include "ictk/tools/recorder.hpp"
+
+/*
+SegmentWriter: buffered segment file output with a background flusher
+    caller: formats straight into the current buffer (reserve() / commit()); a full buffer is handed to the flusher
+        and the next free one is taken -> no allocation, no syscall per record
+    flusher thread: writes handed over buffers in order (consecutive buffers of one file -> one pwritev),
+        then runs the queued fsync / close; the caller only waits when every buffer is still in flight (backpressure)
+    buffers: nbufs x buf_bytes, page aligned, allocated once in start()
+    sync_async() / close_async(): queue an fsync / fsync + close behind the data handed over so far and return
+    wait_idle(): barrier, everything handed over so far is written (and synced / closed if queued)
+    IoOptions (Linux; elsewhere plain buffered writes):
+        prealloc_bytes: every segment's blocks reserved at open (fallocate, KEEP_SIZE -> the file size stays the
+            written size); blocks past the end are released when the segment closes
+        writeback_bytes: after each written window the flusher starts its write-out (sync_file_range) and waits
+            for the window before -> at most ~2 windows of dirty pages, so fdatasync / close only find a small tail
+        direct: O_DIRECT, whole pages only; a partial page is written zero padded and rewritten from the next
+            buffer, the file is cut to its real size at close; buffered where the filesystem refuses O_DIRECT
+    syncs are fdatasync (data + size), close = trim + fdatasync + close
+*/
+namespace ictk::tools::detail{
+
+    struct SegmentIo{
+        std::uint64_t prealloc_bytes{0};    // 0 -> grow on write
+        std::uint64_t writeback_bytes{0};   // 0 -> write-out left to the page cache
+        bool direct{false};
+    };
+
+    class SegmentWriter{
+        public:
+            static constexpr std::size_t kPage = 4096;
+
+            using IoOptions = SegmentIo;
+
+            SegmentWriter() = default;
+            ~SegmentWriter();
+
+            SegmentWriter(const SegmentWriter&) = delete;
+            SegmentWriter& operator=(const SegmentWriter&) = delete;
+
+            // // buffers + flusher thread (once); false -> no memory / thread
+            bool start(std::size_t buf_bytes, std::size_t nbufs, const IoOptions& io = {});
+
+            // // new segment file (truncate); the previous one must have been close_async()'d
+            bool open(const std::string& path);
+
+            bool is_open() const noexcept{
+                return fd_ >= 0;
+            }
+
+            // // current segment is written with O_DIRECT
+            bool direct() const noexcept{
+                return direct_fd_;
+            }
+
+            // // n contiguous bytes in the current buffer (n <= buffer_bytes()); hands the buffer over if n does not fit
+            char* reserve(std::size_t n);
+
+            void commit(std::size_t n) noexcept{
+                used_ += n;
+            }
+
+            // // any size, copied through the buffers
+            void write(const char* p, std::size_t n);
+
+            // // hand the current buffer over, queue fsync; does not wait
+            void sync_async();
+
+            // // hand the current buffer over, queue fsync + close; does not wait; is_open() -> false
+            void close_async();
+
+            void wait_idle();
+
+            std::size_t buffer_bytes() const noexcept{
+                return buf_bytes_;
+            }
+
+            // // failed writes / syncs seen by the flusher
+            std::uint64_t io_errors() const noexcept{
+                return io_errors_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            struct Job{
+                enum Kind : std::uint8_t{kWrite, kSync, kClose, kPrealloc} kind{kWrite};
+                int fd{-1};
+                std::size_t buf{0};
+                std::size_t len{0};
+                std::uint64_t off{0};   // // kClose / kPrealloc: file size
+            };
+
+            // // caller side
+            void hand_over_();
+            void take_(std::unique_lock<std::mutex>& lk);
+            std::size_t room_() const noexcept{
+                return buf_bytes_ + carry_ - used_;
+            }
+            void push_(std::unique_lock<std::mutex>& lk, const Job& j);
+
+            // // flusher side
+            void flusher_main_();
+            void run_(const Job* jobs, std::size_t n);
+            void writeback_(int fd, std::uint64_t end);
+
+            std::vector<std::byte*> bufs_;
+            std::size_t buf_bytes_{0};
+            IoOptions io_{};
+
+            // // free buffer stack and the job ring, sized in start()
+            std::vector<std::size_t> free_;
+            std::vector<Job> jobs_;
+            std::size_t job_head_{0};
+            std::size_t job_count_{0};
+            std::size_t in_flight_{0};
+
+            std::mutex mu_;
+            std::condition_variable cv_work_;
+            std::condition_variable cv_done_;
+            std::thread flusher_;
+            bool quit_{false};
+
+            // // caller state
+            int fd_{-1};
+            std::uint64_t file_off_{0};
+            std::size_t cur_{0};
+            bool have_cur_{false};
+            std::size_t used_{0};
+            bool direct_fd_{false};
+            std::size_t carry_{0};  // // O_DIRECT: partial page at the buffer start, already written padded
+
+            // // flusher state: write-out windows of the file being written
+            int wb_fd_{-1};
+            std::uint64_t wb_mark_{0};
+            std::uint64_t wb_prev_{0};
+            std::uint64_t wb_prev_len_{0};
+
+            std::atomic<std::uint64_t> io_errors_{0};
+    };
+
+    // // RecorderOptions -> SegmentWriter I/O
+    inline SegmentWriter::IoOptions seg_io(const RecorderOptions& opt) noexcept{
+        SegmentWriter::IoOptions io;
+        io.prealloc_bytes = opt.preallocate ? opt.segment_max_mb * 1024ull * 1024ull : 0;
+        io.writeback_bytes = opt.writeback_kb * 1024ull;
+        io.direct = opt.direct_io;
+        return io;
+    }
+
+} // namespace ictk::tools::detail
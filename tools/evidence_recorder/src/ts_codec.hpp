@@ -0,0 +1,425 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "ictk/tools/columnar.hpp"
+
+/*
+Time-series codec for columnar kTicks blocks (BlockEncoding::kTimeSeries)
+    t_ns            : delta-of-delta, zigzag LEB128 -> constant dt = 1 byte / row
+    lat_ns          : delta, zigzag LEB128
+    y0 r0 u_pre0 u_post0 : Gorilla XOR (repeat = 1 bit, slow drift = reused leading / trailing zero window)
+    extra columns   : Gorilla XOR, one stream per column (vector channels, envelope; bit exact for the i64 env_n too)
+    health columns  : run length (value, run) LEB128 pairs on the 64 bit pattern -> an all-zero column = 2 bytes
+    flags           : run length on the byte
+
+    encoders are streaming (put() per value) and write into caller memory: no allocation, bounded by encoded_bound()
+    block payload: u32 stream offset per column + end (kTickCols + extra + 1), then the streams in column order
+    decode_ticks() expands into the raw column layout (col_offset), so readers see the same spans either way;
+        run length and repeat-XOR decode to straight fills
+*/
+namespace ictk::tools::columnar::tsc{
+
+    // // LEB128
+    inline std::uint8_t* put_varint(std::uint8_t* p, std::uint64_t v) noexcept{
+        while (v >= 0x80u){
+            *p++ = static_cast<std::uint8_t>(v | 0x80u);
+            v >>= 7;
+        }
+        *p++ = static_cast<std::uint8_t>(v);
+        return p;
+    }
+
+    // nullptr -> truncated / over long
+    inline const std::uint8_t* get_varint(const std::uint8_t* p, const std::uint8_t* end, std::uint64_t& v) noexcept{
+        v = 0;
+        for (unsigned s = 0; s < 64 && p < end; s += 7){
+            const std::uint8_t b = *p++;
+            v |= static_cast<std::uint64_t>(b & 0x7fu) << s;
+            if (!(b & 0x80u)) return p;
+        }
+        return nullptr;
+    }
+
+    constexpr std::uint64_t zigzag(std::uint64_t d) noexcept{
+        return (d << 1) ^ (0u - (d >> 63));
+    }
+
+    constexpr std::uint64_t unzigzag(std::uint64_t u) noexcept{
+        return (u >> 1) ^ (0u - (u & 1u));
+    }
+
+    // // Order 1: delta, Order 2: delta of delta; modular u64 arithmetic, any int64 sequence round trips
+    template <int Order>
+    class DeltaEncoder{
+        public:
+            explicit DeltaEncoder(std::uint8_t* out) noexcept : p_(out){}
+
+            void put(std::int64_t v) noexcept{
+                const auto u = static_cast<std::uint64_t>(v);
+                const std::uint64_t d = u - prev_;
+                p_ = put_varint(p_, zigzag(Order == 1 ? d : d - prev_d_));
+                prev_ = u;
+                prev_d_ = d;
+            }
+
+            std::uint8_t* finish() noexcept{
+                return p_;
+            }
+
+        private:
+            std::uint8_t* p_;
+            std::uint64_t prev_{0};
+            std::uint64_t prev_d_{0};
+    };
+
+    template <int Order>
+    bool decode_delta(const std::uint8_t* p, const std::uint8_t* end, std::int64_t* out, std::size_t n) noexcept{
+        std::uint64_t prev = 0, prev_d = 0;
+        for (std::size_t i = 0; i < n; ++i){
+            std::uint64_t z;
+            if (!(p = get_varint(p, end, z))) return false;
+            const std::uint64_t d = Order == 1 ? unzigzag(z) : unzigzag(z) + prev_d;
+            prev += d;
+            prev_d = d;
+            out[i] = static_cast<std::int64_t>(prev);
+        }
+        return p == end;
+    }
+
+    // // MSB first bit stream
+    class BitWriter{
+        public:
+            explicit BitWriter(std::uint8_t* out) noexcept : p_(out){}
+
+            // low n bits of v, n in 1..64
+            void put(std::uint64_t v, unsigned n) noexcept{
+                if (n > 32){
+                    put(v >> 32, n - 32);
+                    n = 32;
+                }
+                acc_ = (acc_ << n) | (v & ((1ull << n) - 1u));
+                nb_ += n;
+                while (nb_ >= 8){
+                    nb_ -= 8;
+                    *p_++ = static_cast<std::uint8_t>(acc_ >> nb_);
+                }
+            }
+
+            std::uint8_t* finish() noexcept{
+                if (nb_) *p_++ = static_cast<std::uint8_t>(acc_ << (8 - nb_));
+                nb_ = 0;
+                return p_;
+            }
+
+        private:
+            std::uint8_t* p_;
+            std::uint64_t acc_{0};
+            unsigned nb_{0};
+    };
+
+    class BitReader{
+        public:
+            BitReader(const std::uint8_t* p, const std::uint8_t* end) noexcept : p_(p), end_(end){}
+
+            // n in 1..64
+            std::uint64_t get(unsigned n) noexcept{
+                if (n > 56){
+                    const std::uint64_t hi = get(n - 32);
+                    return (hi << 32) | get(32);
+                }
+                if (nb_ < n){
+                    refill_();
+                    if (nb_ < n){   // // stream ends short: zeros, flagged
+                        bad_ = true;
+                        acc_ <<= (n - nb_);
+                        nb_ = n;
+                    }
+                }
+                nb_ -= n;
+                return (acc_ >> nb_) & ((1ull << n) - 1u);
+            }
+
+            // // read past the end -> corrupt stream
+            bool bad() const noexcept{
+                return bad_;
+            }
+
+            const std::uint8_t* pos() const noexcept{
+                return p_;
+            }
+
+        private:
+            static std::uint64_t load_be64_(const std::uint8_t* p) noexcept{
+                std::uint64_t w;
+                std::memcpy(&w, p, 8);
+                if constexpr (std::endian::native == std::endian::little){
+                    #if defined(__GNUC__) || defined(__clang__)
+                        w = __builtin_bswap64(w);
+                    #else
+                        std::uint64_t r = 0;
+                        for (int i = 0; i < 8; ++i, w >>= 8) r = (r << 8) | (w & 0xffu);
+                        w = r;
+                    #endif
+                }
+                return w;
+            }
+
+            // // top up to >= 56 valid bits (less at the end of the stream); whole bytes, 8 at a time away from the end
+            void refill_() noexcept{
+                if (end_ - p_ >= 8){
+                    const std::uint64_t w = load_be64_(p_);
+                    const unsigned k = (63 - nb_) / 8;
+                    acc_ = (acc_ << (8 * k)) | (w >> (64 - 8 * k));
+                    p_ += k;
+                    nb_ += 8 * k;
+                    return;
+                }
+                while (nb_ <= 56 && p_ < end_){
+                    acc_ = (acc_ << 8) | *p_++;
+                    nb_ += 8;
+                }
+            }
+
+            const std::uint8_t* p_;
+            const std::uint8_t* end_;
+            std::uint64_t acc_{0};
+            unsigned nb_{0};
+            bool bad_{false};
+    };
+
+    // // Gorilla: first value raw; then '0' = same bits, '10' = xor inside the previous window, '11' + lz(5) + len-1(6) = new window
+    class XorEncoder{
+        public:
+            explicit XorEncoder(std::uint8_t* out) noexcept : w_(out){}
+
+            void put(double d) noexcept{
+                const auto v = std::bit_cast<std::uint64_t>(d);
+                if (first_){
+                    w_.put(v, 64);
+                    first_ = false;
+                    prev_ = v;
+                    return;
+                }
+                const std::uint64_t x = v ^ prev_;
+                prev_ = v;
+                if (x == 0){
+                    w_.put(0, 1);
+                    return;
+                }
+                const auto lz = std::min<unsigned>(static_cast<unsigned>(std::countl_zero(x)), 31u);
+                const auto tz = static_cast<unsigned>(std::countr_zero(x));
+                if (win_ && lz >= lz_ && tz >= tz_){
+                    w_.put(0b10, 2);
+                    w_.put(x >> tz_, 64 - lz_ - tz_);
+                    return;
+                }
+                const unsigned len = 64 - lz - tz;
+                w_.put(0b11, 2);
+                w_.put(lz, 5);
+                w_.put(len - 1, 6);
+                w_.put(x >> tz, len);
+                win_ = true;
+                lz_ = lz;
+                tz_ = tz;
+            }
+
+            std::uint8_t* finish() noexcept{
+                return w_.finish();
+            }
+
+        private:
+            BitWriter w_;
+            std::uint64_t prev_{0};
+            bool first_{true};
+            bool win_{false};
+            unsigned lz_{0}, tz_{0};
+    };
+
+    inline bool decode_xor(const std::uint8_t* p, const std::uint8_t* end, double* out, std::size_t n) noexcept{
+        if (n == 0) return p == end;
+        BitReader r(p, end);
+        std::uint64_t v = r.get(64);
+        out[0] = std::bit_cast<double>(v);
+        bool win = false;
+        unsigned lz = 0, tz = 0;
+        for (std::size_t i = 1; i < n; ++i){
+            if (r.get(1) != 0){
+                if (r.get(1) == 0){
+                    if (!win) return false;
+                    v ^= r.get(64 - lz - tz) << tz;
+                }else{
+                    lz = static_cast<unsigned>(r.get(5));
+                    const unsigned len = static_cast<unsigned>(r.get(6)) + 1;
+                    if (lz + len > 64) return false;
+                    tz = 64 - lz - len;
+                    win = true;
+                    v ^= r.get(len) << tz;
+                }
+            }
+            out[i] = std::bit_cast<double>(v);
+        }
+        return !r.bad() && r.pos() == end;
+    }
+
+    // // (value, run) pairs
+    class RleEncoder{
+        public:
+            explicit RleEncoder(std::uint8_t* out) noexcept : p_(out){}
+
+            void put(std::uint64_t v) noexcept{
+                if (run_ && v == cur_){
+                    ++run_;
+                    return;
+                }
+                flush_();
+                cur_ = v;
+                run_ = 1;
+            }
+
+            std::uint8_t* finish() noexcept{
+                flush_();
+                run_ = 0;
+                return p_;
+            }
+
+        private:
+            void flush_() noexcept{
+                if (!run_) return;
+                p_ = put_varint(p_, cur_);
+                p_ = put_varint(p_, run_);
+            }
+
+            std::uint8_t* p_;
+            std::uint64_t cur_{0};
+            std::uint64_t run_{0};
+    };
+
+    template <class T>
+    bool decode_rle(const std::uint8_t* p, const std::uint8_t* end, T* out, std::size_t n) noexcept{
+        std::size_t i = 0;
+        while (i < n){
+            std::uint64_t v, run;
+            if (!(p = get_varint(p, end, v)) || !(p = get_varint(p, end, run))) return false;
+            if (run == 0 || run > n - i) return false;
+            T t;
+            if constexpr (sizeof(T) == 1){
+                if (v > 0xffu) return false;
+                t = static_cast<T>(v);
+            }else{
+                std::memcpy(&t, &v, sizeof(T));
+            }
+            std::fill_n(out + i, static_cast<std::size_t>(run), t);
+            i += static_cast<std::size_t>(run);
+        }
+        return p == end;
+    }
+
+    enum class Codec : std::uint8_t{kDod, kDelta, kXor, kRle64, kRle8};
+
+    // // c >= kTickCols: extra columns (vector channels / envelope: doubles that move like y0 / u0)
+    constexpr Codec codec_of(std::uint32_t c) noexcept{
+        if (c == kTNs) return Codec::kDod;
+        if (c == kLatNs) return Codec::kDelta;
+        if (c >= kY0 && c <= kUPost0) return Codec::kXor;
+        if (c == kFlags) return Codec::kRle8;
+        if (c >= kTickCols) return Codec::kXor;
+        return Codec::kRle64;
+    }
+
+    // // directory: one u32 start offset per column + the end offset
+    constexpr std::size_t dir_bytes(std::uint32_t extra) noexcept{
+        return 4u * (kTickCols + extra + 1u);
+    }
+
+    inline constexpr std::size_t kDirBytes = dir_bytes(0);
+
+    // // worst case encoded payload: 20 bytes / value (rle value + run), the directory, bit stream tails
+    constexpr std::size_t encoded_bound(std::size_t rows, std::uint32_t extra = 0) noexcept{
+        const std::size_t cols = kTickCols + extra;
+        return dir_bytes(extra) + rows * cols * 20u + cols * 16u;
+    }
+
+    /*
+    encode `rows` rows of column-major stage (column c at col_offset(c, stride)) into out (>= encoded_bound(rows, extra))
+    returns the payload bytes used (before kAlign padding)
+    */
+    inline std::size_t encode_ticks(const std::byte* stage, std::size_t stride, std::size_t rows, std::uint8_t* out,
+                                    std::uint32_t extra = 0) noexcept{
+        const std::uint32_t cols = kTickCols + extra;
+        std::uint8_t* p = out + dir_bytes(extra);
+        for (std::uint32_t c = 0; c < cols; ++c){
+            const std::uint32_t off = static_cast<std::uint32_t>(p - out);
+            std::memcpy(out + 4u * c, &off, 4);
+            const std::byte* src = stage + col_offset(c, stride);
+            switch (codec_of(c)){
+                case Codec::kDod:{
+                    DeltaEncoder<2> e(p);
+                    for (std::size_t i = 0; i < rows; ++i) e.put(reinterpret_cast<const std::int64_t*>(src)[i]);
+                    p = e.finish();
+                    break;
+                }
+                case Codec::kDelta:{
+                    DeltaEncoder<1> e(p);
+                    for (std::size_t i = 0; i < rows; ++i) e.put(reinterpret_cast<const std::int64_t*>(src)[i]);
+                    p = e.finish();
+                    break;
+                }
+                case Codec::kXor:{
+                    XorEncoder e(p);
+                    for (std::size_t i = 0; i < rows; ++i) e.put(reinterpret_cast<const double*>(src)[i]);
+                    p = e.finish();
+                    break;
+                }
+                case Codec::kRle64:{
+                    RleEncoder e(p);
+                    for (std::size_t i = 0; i < rows; ++i) e.put(reinterpret_cast<const std::uint64_t*>(src)[i]);
+                    p = e.finish();
+                    break;
+                }
+                case Codec::kRle8:{
+                    RleEncoder e(p);
+                    for (std::size_t i = 0; i < rows; ++i) e.put(reinterpret_cast<const std::uint8_t*>(src)[i]);
+                    p = e.finish();
+                    break;
+                }
+            }
+        }
+        const std::uint32_t end = static_cast<std::uint32_t>(p - out);
+        std::memcpy(out + 4u * cols, &end, 4);
+        return end;
+    }
+
+    // // payload -> raw column layout of `rows` rows in cols (>= tick_payload_bytes(rows, extra)); false -> corrupt
+    inline bool decode_ticks(const std::uint8_t* in, std::size_t bytes, std::size_t rows, std::byte* cols,
+                             std::uint32_t extra = 0) noexcept{
+        const std::uint32_t ncol = kTickCols + extra;
+        if (bytes < dir_bytes(extra)) return false;
+        std::uint32_t lo, hi;
+        std::memcpy(&lo, in, 4);
+        if (lo != dir_bytes(extra)) return false;
+        for (std::uint32_t c = 0; c < ncol; ++c){
+            std::memcpy(&hi, in + 4u * (c + 1u), 4);
+            if (hi < lo || hi > bytes) return false;
+            const std::uint8_t* p = in + lo;
+            const std::uint8_t* e = in + hi;
+            std::byte* dst = cols + col_offset(c, rows);
+            bool ok = false;
+            switch (codec_of(c)){
+                case Codec::kDod:   ok = decode_delta<2>(p, e, reinterpret_cast<std::int64_t*>(dst), rows); break;
+                case Codec::kDelta: ok = decode_delta<1>(p, e, reinterpret_cast<std::int64_t*>(dst), rows); break;
+                case Codec::kXor:   ok = decode_xor(p, e, reinterpret_cast<double*>(dst), rows); break;
+                case Codec::kRle64: ok = decode_rle(p, e, reinterpret_cast<std::uint64_t*>(dst), rows); break;
+                case Codec::kRle8:  ok = decode_rle(p, e, reinterpret_cast<std::uint8_t*>(dst), rows); break;
+            }
+            if (!ok) return false;
+            lo = hi;
+        }
+        return true;
+    }
+
+} // namespace ictk::tools::columnar::tsc
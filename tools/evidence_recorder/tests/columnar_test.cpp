@@ -0,0 +1,167 @@
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <filesystem>
+
+#include "ictk/tools/recorder.hpp"
+#include "ictk/tools/columnar.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk::tools;
+
+static bool copy_prefix(const fs::path& from, const fs::path& to, std::size_t cut, long flip_at){
+    std::FILE* f = std::fopen(from.string().c_str(), "rb");
+    if (!f) return false;
+    std::vector<char> b(static_cast<std::size_t>(fs::file_size(from)));
+    const std::size_t got = std::fread(b.data(), 1, b.size(), f);
+    std::fclose(f);
+    if (got != b.size() || cut > b.size()) return false;
+    b.resize(b.size() - cut);
+    if (flip_at >= 0) b[static_cast<std::size_t>(flip_at)] ^= 0x5a;
+    std::FILE* o = std::fopen(to.string().c_str(), "wb");
+    if (!o) return false;
+    std::fwrite(b.data(), 1, b.size(), o);
+    std::fclose(o);
+    return true;
+}
+
+int main(){
+    const char* out_dir = "evidence_columnar";
+    fs::remove_all(out_dir);
+    fs::create_directories(out_dir);
+
+    // Case 1: xxh64 reference values
+    if (columnar::xxh64("", 0) != 0xEF46DB3751D8E999ull) return 1;
+    if (columnar::xxh64("abc", 3) != 0x44BC2CF5AD770999ull) return 1;
+
+    // Case 2: write through Recorder::open -> small blocks + small segments, every field round trips bit exact
+    const int kTicks = 30000;
+    {
+        RecorderOptions opt;
+        opt.backend = RecorderOptions::Columnar;
+        opt.out_dir = out_dir;
+        opt.dt_ns_hint = 1000000;
+        opt.segment_max_mb = 1;
+        opt.block_rows = 64;
+        opt.controller_id = "pid_test";
+        opt.fixed_mode = ictk::kShadow;
+        auto rec = Recorder::open(opt);
+        if (!rec) return 2;
+        rec->write_buildinfo();
+        rec->write_time_anchor(11, 22);
+        for (int i = 0; i < kTicks; ++i){
+            TickSample s{};
+            s.t = 1000000LL * i;
+            s.y0 = 0.25 * i;
+            s.r0 = 1.0 / (i + 1);
+            s.u_pre0 = -0.1 * i;
+            s.u_post0 = 3.0;
+            s.lat_ns = 1000 + i;
+            s.h.rate_limit_hits = static_cast<std::uint64_t>(i);
+            s.h.jerk_hit_mask = static_cast<std::uint64_t>(i) << 3;
+            s.h.last_jerk_clip_mag = 0.5 * i;
+            s.h.novelty_flag = (i % 7) == 0;
+            rec->write_tick(s);
+            rec->rotate_if_needed();
+        }
+        ictk::KpiCounters k{};
+        k.updates = kTicks;
+        rec->write_kpi(k);
+        rec->flush();
+    }
+
+    std::vector<fs::path> segs;
+    for (auto& e : fs::directory_iterator(out_dir)){
+        if (e.path().extension() == ".ictkcol") segs.push_back(e.path());
+    }
+    if (segs.size() < 2) return 3;
+
+    std::vector<bool> seen(kTicks, false);
+    std::size_t total = 0;
+    bool have_kpi = false, have_bi = false;
+    for (const fs::path& p : segs){
+        auto r = columnar::Reader::open(p.string());
+        if (!r || !r->indexed() || !r->verify()) return 4;
+        if (r->header().mode != static_cast<std::uint32_t>(ictk::kShadow) || r->header().block_rows != 64) return 4;
+
+        for (std::size_t b = 0; b < r->index().size(); ++b){
+            if (r->index()[b].kind != static_cast<std::uint32_t>(columnar::BlockKind::kTicks)) continue;
+            const columnar::TickBlock t = r->ticks(b);
+            if (reinterpret_cast<std::uintptr_t>(t.y0.data()) % 64 != 0) return 5;
+            for (std::size_t j = 0; j < t.rows(); ++j){
+                const long long i = t.t_ns[j] / 1000000LL;
+                if (i < 0 || i >= kTicks || seen[static_cast<std::size_t>(i)]) return 6;
+                seen[static_cast<std::size_t>(i)] = true;
+                const double d = static_cast<double>(i);
+                if (t.y0[j] != 0.25 * d || t.r0[j] != 1.0 / (d + 1) || t.u_pre0[j] != -0.1 * d || t.u_post0[j] != 3.0) return 7;
+                if (t.lat_ns[j] != 1000 + i || t.rate_limit_hits[j] != static_cast<std::uint64_t>(i)) return 7;
+                if (t.jerk_hit_mask[j] != static_cast<std::uint64_t>(i) << 3 || t.last_jerk_clip_mag[j] != 0.5 * d) return 7;
+                if (((t.flags[j] & columnar::kFlagNovelty) != 0) != ((i % 7) == 0)) return 7;
+            }
+            total += t.rows();
+        }
+        if (r->tick_rows() == 0 && !r->kpi()) return 8;
+
+        columnar::BuildInfoView bi;
+        if (r->buildinfo(bi)){
+            have_bi = true;
+            if (bi.controller_id != "pid_test" || bi.dt_ns != 1000000u) return 9;
+            if (!r->time_anchor() || r->time_anchor()->epoch_utc_ns != 22) return 9;
+        }
+        if (const columnar::KpiRecord* k = r->kpi()){
+            have_kpi = true;
+            if (k->updates != static_cast<std::uint64_t>(kTicks) || k->lat_samples != static_cast<std::uint64_t>(kTicks)) return 10;
+        }
+    }
+    if (total != static_cast<std::size_t>(kTicks) || !have_bi || !have_kpi) return 11;
+    if (std::find(seen.begin(), seen.end(), false) != seen.end()) return 11;
+
+    // Case 3: flipped payload byte -> that block fails its checksum
+    std::sort(segs.begin(), segs.end(), [](const fs::path& a, const fs::path& b){ return fs::file_size(a) > fs::file_size(b); });
+    const fs::path bad = fs::path(out_dir) / "bad.bin";
+    {
+        auto r = columnar::Reader::open(segs[0].string());
+        if (!r || r->index().size() < 3) return 12;
+        const long at = static_cast<long>(r->index()[2].offset + sizeof(columnar::BlockHeader) + 100);
+        if (!copy_prefix(segs[0], bad, 0, at)) return 12;
+        auto c = columnar::Reader::open(bad.string());
+        if (!c || c->verify() || c->verify(2) || !c->verify(1)) return 13;
+    }
+
+    // Case 4: footer cut off (segment never closed) -> forward scan recovers every block
+    {
+        auto r = columnar::Reader::open(segs[0].string());
+        if (!copy_prefix(segs[0], bad, 100, -1)) return 14;
+        auto c = columnar::Reader::open(bad.string());
+        if (!c || c->indexed() || !c->verify()) return 15;
+        if (c->tick_rows() != r->tick_rows() || c->index().size() != r->index().size()) return 15;
+    }
+
+    // Case 5: not a segment
+    if (columnar::Reader::open((fs::path(out_dir) / "missing.ictkcol").string())) return 16;
+
+    // Case 6: out_dir is a file -> the open fails once, every later tick is counted as dropped
+    {
+        const fs::path blocked = fs::path(out_dir) / "blocked";
+        if (std::FILE* f = std::fopen(blocked.string().c_str(), "wb")) std::fclose(f);
+        const std::string dir = (blocked / "sub").string();
+        RecorderOptions opt;
+        opt.backend = RecorderOptions::Columnar;
+        opt.out_dir = dir.c_str();
+        auto rec = Recorder::open(opt);
+        if (!rec) return 17;
+        rec->write_buildinfo();
+        for (int i = 0; i < 1000; ++i){
+            TickSample s{};
+            s.t = 1000000LL * i;
+            rec->write_tick(s);
+        }
+        rec->flush();
+        if (rec->dropped_ticks() != 1000) return 18;
+    }
+
+    fs::remove_all(out_dir);
+    return 0;
+}
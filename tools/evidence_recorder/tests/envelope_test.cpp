@@ -0,0 +1,210 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <algorithm>
+#include <filesystem>
+
+#include "ictk/tools/recorder.hpp"
+#include "ictk/tools/columnar.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk::tools;
+using ictk::Scalar;
+
+constexpr int kTicks = 1003;        // // 100 full windows + a short one (flushed)
+constexpr int kWindow = 10;
+constexpr int kSpike = 437;         // // not on a window boundary: sampling drops it
+constexpr double kSpikeU = 99.0;
+
+// // y channel 1 = -y0, u channel 1 = 2 u_pre0
+static TickSample sample(int i){
+    TickSample s{};
+    s.t = 1'000'000LL * i;
+    s.y0 = std::sin(0.01 * i);
+    s.r0 = 1.0;
+    s.u_pre0 = i == kSpike ? kSpikeU : 0.5 * s.y0;
+    s.u_post0 = std::clamp(s.u_pre0, -3.0, 3.0);
+    s.lat_ns = i == kSpike + 1 ? 500'000 : 2000;
+    s.h.last_clamp_mag = std::fabs(s.u_pre0 - s.u_post0);
+    s.h.sat_hit_mask = i == kSpike ? 4u : 0u;
+    s.h.rate_limit_hits = i % 3 == 0 ? 1u : 0u;
+    s.h.novelty_flag = i == 555;
+    return s;
+}
+
+static RecorderOptions options(const char* dir, RecorderOptions::Backend b, RecorderOptions::Decimation d, bool compress){
+    RecorderOptions opt;
+    opt.backend = b;
+    opt.out_dir = dir;
+    opt.dt_ns_hint = 1'000'000;
+    opt.block_rows = 64;
+    opt.compress = compress;
+    opt.tick_decimation = kWindow;
+    opt.decimation = d;
+    opt.dims = ictk::Dims{2, 2, 0};
+    return opt;
+}
+
+static void write(const RecorderOptions& opt){
+    fs::remove_all(opt.out_dir);
+    auto rec = Recorder::open(opt);
+    rec->write_buildinfo();
+    for (int i = 0; i < kTicks; ++i){
+        const TickSample s = sample(i);
+        const Scalar y[2] = {static_cast<Scalar>(s.y0), static_cast<Scalar>(-s.y0)};
+        const Scalar r[2] = {1.0, 1.0};
+        const Scalar u[2] = {static_cast<Scalar>(s.u_pre0), static_cast<Scalar>(2.0 * s.u_pre0)};
+        TickVector v{s.t, y, r, u, u, {}, s.h, s.lat_ns};
+        rec->write_tick_vec(v);
+        rec->rotate_if_needed();
+    }
+    rec->write_kpi({});
+    rec->flush();
+}
+
+// // expected envelope of window w, signal y0 / u_pre0 / u channel 1
+struct Want{
+    int n{0};
+    double y_min{1e9}, y_max{-1e9}, y_sum{0.0}, u_max{-1e9}, u1_max{-1e9}, clamp{0.0};
+    std::uint64_t mask{0}, rate{0};
+    std::int64_t lat{0}, t_last{0};
+    bool novelty{false};
+};
+
+static Want want(int w){
+    Want e;
+    for (int i = w * kWindow; i < std::min(kTicks, (w + 1) * kWindow); ++i){
+        const TickSample s = sample(i);
+        ++e.n;
+        e.y_min = std::min(e.y_min, s.y0);
+        e.y_max = std::max(e.y_max, s.y0);
+        e.y_sum += s.y0;
+        e.u_max = std::max(e.u_max, s.u_pre0);
+        e.u1_max = std::max(e.u1_max, 2.0 * s.u_pre0);
+        e.clamp = std::max(e.clamp, s.h.last_clamp_mag);
+        e.mask |= s.h.sat_hit_mask;
+        e.rate = std::max(e.rate, s.h.rate_limit_hits);
+        e.lat = std::max(e.lat, s.lat_ns);
+        e.t_last = s.t;
+        e.novelty = e.novelty || s.h.novelty_flag;
+    }
+    return e;
+}
+
+static int check_columnar(const char* dir){
+    int w = 0;
+    columnar::TickScratch scratch;
+    for (auto& f : fs::directory_iterator(dir)){
+        auto r = columnar::Reader::open(f.path().string());
+        if (!r || !r->verify()) return 1;
+        if (r->header().env_window != kWindow || r->header().extra_cols() != 8u + 1u + 3u * (4u + 8u)) return 2;
+        for (std::size_t b = 0; b < r->index().size(); ++b){
+            if (r->index()[b].kind != static_cast<std::uint32_t>(columnar::BlockKind::kTicks)) continue;
+            const columnar::TickBlock t = r->ticks(b, scratch);
+            if (t.env_n.size() != t.rows()) return 3;
+            for (std::size_t j = 0; j < t.rows(); ++j, ++w){
+                const Want e = want(w);
+                const TickSample last = sample(static_cast<int>(e.t_last / 1'000'000LL));
+                if (t.env_n[j] != e.n || t.t_ns[j] != e.t_last || t.lat_ns[j] != e.lat) return 4;
+                if (t.y0[j] != last.y0 || t.y(1)[j] != -last.y0) return 5;
+                if (t.env_min(0)[j] != e.y_min || t.env_max(0)[j] != e.y_max) return 6;
+                if (std::fabs(t.env_mean(0)[j] - e.y_sum / e.n) > 1e-12) return 6;
+                if (t.env_max(2)[j] != e.u_max || t.env_max(4 + 4 + 1)[j] != e.u1_max) return 7;   // // u_pre channel 1
+                if (t.last_clamp_mag[j] != e.clamp || t.sat_hit_mask[j] != e.mask || t.rate_limit_hits[j] != e.rate) return 8;
+                if (((t.flags[j] & columnar::kFlagNovelty) != 0) != e.novelty) return 8;
+            }
+        }
+    }
+    return w == (kTicks + kWindow - 1) / kWindow ? 0 : 9;
+}
+
+int main(){
+    // Case 1: columnar envelope, raw and compressed -> one row per window, the spike survives
+    write(options("evidence_env_raw", RecorderOptions::Columnar, RecorderOptions::Envelope, false));
+    if (int rc = check_columnar("evidence_env_raw")) return 10 + rc;
+    write(options("evidence_env_ts", RecorderOptions::Columnar, RecorderOptions::Envelope, true));
+    if (int rc = check_columnar("evidence_env_ts")) return 20 + rc;
+
+    // Case 2: sampling at the same rate loses it
+    write(options("evidence_env_sample", RecorderOptions::Columnar, RecorderOptions::Sample, false));
+    {
+        double u_max = 0.0;
+        std::size_t rows = 0;
+        for (auto& f : fs::directory_iterator("evidence_env_sample")){
+            auto r = columnar::Reader::open(f.path().string());
+            if (!r || r->header().env_window != 0) return 30;
+            for (std::size_t b = 0; b < r->index().size(); ++b){
+                const columnar::TickBlock t = r->ticks(b);
+                for (double u : t.u_pre0) u_max = std::max(u_max, u);
+                rows += t.rows();
+            }
+        }
+        if (rows != (kTicks + kWindow - 1) / kWindow || u_max >= kSpikeU) return 31;
+    }
+
+    // Case 3: JSONL envelope -> same record count, "env" arrays carry the peak
+    write(options("evidence_env_jsonl", RecorderOptions::Jsonl, RecorderOptions::Envelope, false));
+    {
+        std::size_t ticks = 0, full = 0, peak = 0;
+        for (auto& f : fs::directory_iterator("evidence_env_jsonl")){
+            std::ifstream in(f.path());
+            std::string line;
+            while (std::getline(in, line)){
+                if (line.find("\"/ictk/tick\"") == std::string::npos) continue;
+                ++ticks;
+                if (line.find("\"env\":{\"n\":10,") != std::string::npos) ++full;
+                const std::size_t mx = line.find("\"max\":[");
+                if (mx == std::string::npos) return 40;
+                if (line.find(",99,", mx) < line.find(']', mx)) ++peak;
+            }
+        }
+        if (ticks != (kTicks + kWindow - 1) / kWindow || full != kTicks / kWindow || peak != 1) return 41;
+    }
+
+    // Case 4: a NaN in the middle of a window -> that window's min / max (and clamp magnitude) are NaN, the others finite
+    {
+        constexpr int kNan = 14;
+        RecorderOptions opt = options("evidence_env_nan", RecorderOptions::Columnar, RecorderOptions::Envelope, false);
+        opt.dims = ictk::Dims{};
+        fs::remove_all(opt.out_dir);
+        {
+            auto rec = Recorder::open(opt);
+            if (!rec) return 50;
+            for (int i = 0; i < 3 * kWindow; ++i){
+                TickSample s = sample(i);
+                if (i == kNan){
+                    s.y0 = std::numeric_limits<double>::quiet_NaN();
+                    s.h.last_clamp_mag = s.y0;
+                }
+                rec->write_tick(s);
+            }
+            rec->flush();
+        }
+        int rows = 0;
+        columnar::TickScratch scratch;
+        for (auto& f : fs::directory_iterator(opt.out_dir)){
+            auto r = columnar::Reader::open(f.path().string());
+            if (!r || !r->verify()) return 51;
+            for (std::size_t b = 0; b < r->index().size(); ++b){
+                if (r->index()[b].kind != static_cast<std::uint32_t>(columnar::BlockKind::kTicks)) continue;
+                const columnar::TickBlock t = r->ticks(b, scratch);
+                for (std::size_t j = 0; j < t.rows(); ++j, ++rows){
+                    const bool hit = rows == kNan / kWindow;
+                    if (std::isnan(t.env_min(0)[j]) != hit || std::isnan(t.env_max(0)[j]) != hit) return 52;
+                    if (std::isnan(t.last_clamp_mag[j]) != hit || std::isnan(t.env_max(2)[j])) return 53;
+                }
+            }
+        }
+        if (rows != 3) return 54;
+    }
+
+    fs::remove_all("evidence_env_raw");
+    fs::remove_all("evidence_env_ts");
+    fs::remove_all("evidence_env_nan");
+    fs::remove_all("evidence_env_sample");
+    fs::remove_all("evidence_env_jsonl");
+    return 0;
+}
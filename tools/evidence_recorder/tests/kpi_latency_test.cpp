@@ -0,0 +1,150 @@
+#include <array>
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+
+#include "ictk/tools/recorder.hpp"
+#include "ictk/runtime/cyclic_executor.hpp"
+#include "kpi_calc.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk::tools;
+
+// // value of "key": in the kpi_report line
+static double kpi_field(const std::string& s, const char* key){
+    const std::size_t kpi = s.find("/ictk/kpi_report");
+    if (kpi == std::string::npos) return -1.0;
+    const std::string k = std::string("\"") + key + "\":";
+    const std::size_t pos = s.find(k, kpi);
+    if (pos == std::string::npos) return -1.0;
+    return std::strtod(s.c_str() + pos + k.size(), nullptr);
+}
+
+// // busy for a fixed time per update() -> a known latency floor
+class Busy final : public ictk::IController{
+    public:
+        [[nodiscard]] ictk::Status init(const ictk::Dims&, ictk::dt_ns, ictk::MemoryArena&, const ictk::Hooks& = {}) noexcept override{ return ictk::Status::kOK; }
+        [[nodiscard]] ictk::Status start() noexcept override{ return ictk::Status::kOK; }
+        [[nodiscard]] ictk::Status stop() noexcept override{ return ictk::Status::kOK; }
+        [[nodiscard]] ictk::Status reset() noexcept override{ return ictk::Status::kOK; }
+        [[nodiscard]] ictk::Status update(const ictk::UpdateContext&, ictk::Result& out) noexcept override{
+            const auto t0 = std::chrono::steady_clock::now();
+            while (std::chrono::steady_clock::now() - t0 < std::chrono::microseconds(200)){}
+            out.u[0] = 1.0;
+            return ictk::Status::kOK;
+        }
+        ictk::CommandMode mode() const noexcept override{ return ictk::CommandMode::Primary; }
+};
+
+// // actuate hook: the executor's measured update() time -> TickSample::lat_ns
+static void record_tick(const ictk::Result& out, ictk::Status, void* user){
+    TickSample s{};
+    s.u_post0 = static_cast<double>(out.u[0]);
+    s.lat_ns = out.update_ns;
+    static_cast<Recorder*>(user)->write_tick(s);
+}
+
+static std::string read_only_segment(const fs::path& dir){
+    std::string s;
+    for (auto& e : fs::directory_iterator(dir)){
+        if (e.path().extension() != ".jsonl") continue;
+        std::FILE* f = std::fopen(e.path().string().c_str(), "rb");
+        if (!f) return {};
+        char buf[4096];
+        for (std::size_t n; (n = std::fread(buf, 1, sizeof(buf), f)) > 0;) s.append(buf, n);
+        std::fclose(f);
+    }
+    return s;
+}
+
+int main(){
+    // Case 1: accumulator -> every sample counts (no 2048 window), p99.9 and max reported
+    {
+        static detail::KpiAcc acc{};
+        for (int i = 0; i < 100000; ++i) acc.on_latency_ns(i < 99000 ? 10'000 : 2'000'000);   // 1 % at 2 ms
+        acc.on_latency_ns(0);    // not measured -> ignored
+        acc.finalize_latency_percentiles();
+        if (acc.lat.count() != 100000) return 1;
+        if (acc.p50_lat_us < 9.9 || acc.p50_lat_us > 10.1) return 2;
+        if (acc.p99_lat_us < 9.9 || acc.p99_lat_us > 10.1) return 3;
+        if (acc.p999_lat_us < 1980.0 || acc.max_lat_us != 2000.0) return 4;
+
+        // // a second segment / thread folds in
+        static ictk::LatencyHistogram other;
+        other.record(50'000'000);
+        acc.merge_latency(other);
+        acc.finalize_latency_percentiles();
+        if (acc.lat.count() != 100001 || acc.max_lat_us != 50000.0) return 5;
+    }
+
+    // Case 2: JSONL recorder -> TickSample::lat_ns feeds kpi_report, decimated ticks included
+    const char* out_dir = "evidence_kpi_latency";
+    fs::remove_all(out_dir);
+    fs::create_directories(out_dir);
+    {
+        RecorderOptions opt;
+        opt.out_dir = out_dir;
+        opt.dt_ns_hint = 1000000;
+        opt.tick_decimation = 10;
+        auto rec = Recorder::open(opt);
+        if (!rec) return 6;
+        rec->write_buildinfo();
+        for (int i = 0; i < 5000; ++i){
+            TickSample s{};
+            s.t = 1000000LL * i;
+            s.lat_ns = (i == 4321) ? 7'000'000 : 20'000;   // the spike is on a decimated tick
+            rec->write_tick(s);
+        }
+        rec->write_kpi({});
+        rec->flush();
+    }
+    const std::string s = read_only_segment(out_dir);
+    if (kpi_field(s, "lat_samples") != 5000.0) return 7;
+    if (kpi_field(s, "max_lat_us") != 7000.0) return 8;
+    const double p99 = kpi_field(s, "p99_lat_us");
+    if (p99 < 19.8 || p99 > 20.2) return 9;
+    if (kpi_field(s, "p999_lat_us") < 0.0) return 10;
+
+#if defined(__linux__)
+    // Case 3: CyclicExecutor times update() -> Result::update_ns -> lat_ns -> real p50..max
+    fs::remove_all(out_dir);
+    fs::create_directories(out_dir);
+    {
+        RecorderOptions opt;
+        opt.out_dir = out_dir;
+        opt.dt_ns_hint = 1000000;
+        auto rec = Recorder::open(opt);
+        if (!rec) return 11;
+
+        alignas(64) static std::byte buf[1 << 14];
+        ictk::MemoryArena arena(buf, sizeof(buf));
+        Busy ctl;
+        std::array<ictk::Scalar, 1> u{};
+        ictk::UpdateContext ctx{};
+        ictk::Result out{};
+        out.u = u;
+
+        ictk::runtime::CyclicExecutor ex;
+        if (ex.init(1, arena) != ictk::Status::kOK) return 12;
+        ictk::runtime::CyclicTask tk{};
+        tk.ctl = &ctl;
+        tk.period = 1000000;
+        tk.ctx = &ctx;
+        tk.out = &out;
+        tk.actuate = &record_tick;
+        tk.user = rec.get();
+        if (ex.add(tk) != ictk::Status::kOK || ex.build() != ictk::Status::kOK) return 13;
+        if (ex.run(50) != ictk::Status::kOK) return 14;
+        rec->write_kpi({});
+        rec->flush();
+    }
+    const std::string c = read_only_segment(out_dir);
+    if (kpi_field(c, "lat_samples") != 50.0) return 15;
+    if (kpi_field(c, "p50_lat_us") < 195.0 || kpi_field(c, "max_lat_us") < kpi_field(c, "p50_lat_us")) return 16;
+#endif
+
+    fs::remove_all(out_dir);
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+
+#include "ictk/tools/recorder.hpp"
+#include "segment_writer.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk::tools;
+
+static std::string readall(const fs::path& p){
+    std::string s;
+    std::FILE* f = std::fopen(p.string().c_str(), "rb");
+    if (!f) return s;
+    char buf[1 << 14];
+    for (std::size_t n; (n = std::fread(buf, 1, sizeof(buf), f)) > 0;) s.append(buf, n);
+    std::fclose(f);
+    return s;
+}
+
+static std::size_t count(const std::string& s, const char* what){
+    std::size_t n = 0;
+    for (std::size_t pos = s.find(what); pos != std::string::npos; pos = s.find(what, pos + 1)) ++n;
+    return n;
+}
+
+// // Case 1 under other segment I/O options: a.bin / b.bin, syncs in between, exact file sizes; 0 or the failing check
+static int two_files(const char* out_dir, const detail::SegmentWriter::IoOptions& io){
+    detail::SegmentWriter w;
+    if (!w.start(4096, 2, io)) return 1;
+    std::string want_a, want_b;
+    for (int i = 0; i < 5000; ++i){
+        const std::string rec = "record " + std::to_string(i) + std::string(static_cast<std::size_t>(i % 97), 'x') + "\n";
+        std::string& want = i < 2500 ? want_a : want_b;
+        if (i == 0 && !w.open((fs::path(out_dir) / "a.bin").string())) return 2;
+        if (i == 2500){
+            w.close_async();
+            if (!w.open((fs::path(out_dir) / "b.bin").string())) return 2;
+        }
+        if (i % 2){
+            w.write(rec.data(), rec.size());
+        }else{
+            char* p = w.reserve(rec.size());
+            rec.copy(p, rec.size());
+            w.commit(rec.size());
+        }
+        want += rec;
+        if (i % 1000 == 0) w.sync_async();
+    }
+    w.write(std::string(20000, 'y').data(), 20000);   // larger than a buffer
+    want_b += std::string(20000, 'y');
+    w.close_async();
+    w.wait_idle();
+    if (w.io_errors() != 0) return 3;
+    if (readall(fs::path(out_dir) / "a.bin") != want_a) return 4;
+    if (readall(fs::path(out_dir) / "b.bin") != want_b) return 5;
+    if (fs::file_size(fs::path(out_dir) / "b.bin") != want_b.size()) return 6;
+    return 0;
+}
+
+int main(){
+    const char* out_dir = "evidence_segment_writer";
+    fs::remove_all(out_dir);
+    fs::create_directories(out_dir);
+
+    // Case 1: SegmentWriter -> bytes land in order across buffer boundaries and two files
+    {
+        detail::SegmentWriter w;
+        if (!w.start(4096, 2)) return 1;
+        std::string want_a, want_b;
+        for (int i = 0; i < 5000; ++i){
+            const std::string rec = "record " + std::to_string(i) + std::string(static_cast<std::size_t>(i % 97), 'x') + "\n";
+            std::string& want = i < 2500 ? want_a : want_b;
+            if (i == 0 && !w.open((fs::path(out_dir) / "a.bin").string())) return 2;
+            if (i == 2500){
+                w.close_async();
+                if (!w.open((fs::path(out_dir) / "b.bin").string())) return 2;
+            }
+            if (i % 2){
+                w.write(rec.data(), rec.size());
+            }else{
+                char* p = w.reserve(rec.size());
+                rec.copy(p, rec.size());
+                w.commit(rec.size());
+            }
+            want += rec;
+            if (i % 1000 == 0) w.sync_async();
+        }
+        w.write(std::string(20000, 'y').data(), 20000);   // larger than a buffer
+        want_b += std::string(20000, 'y');
+        w.close_async();
+        w.wait_idle();
+        if (w.io_errors() != 0) return 3;
+        if (readall(fs::path(out_dir) / "a.bin") != want_a) return 4;
+        if (readall(fs::path(out_dir) / "b.bin") != want_b) return 5;
+    }
+
+    // Case 2: JSONL recorder on small buffers + small segments -> every tick once, in order, across rotations
+    const int kTicks = 60000;
+    {
+        RecorderOptions opt;
+        opt.out_dir = out_dir;
+        opt.dt_ns_hint = 1000000;
+        opt.segment_max_mb = 4;
+        opt.fsync_n_mb = 1;
+        opt.io_buffer_kb = 16;
+        opt.io_buffers = 2;
+        auto rec = Recorder::open(opt);
+        if (!rec) return 6;
+        rec->write_buildinfo();
+        for (int i = 0; i < kTicks; ++i){
+            TickSample s{};
+            s.t = 1000000LL * i;
+            s.y0 = 0.25 * i;
+            s.h.rate_limit_hits = static_cast<std::uint64_t>(i);
+            rec->write_tick(s);
+            rec->rotate_if_needed();
+        }
+        rec->write_kpi({});
+        rec->flush();
+    }
+
+    std::size_t ticks = 0, health = 0, segments = 0;
+    std::vector<bool> seen(kTicks, false);
+    for (auto& e : fs::directory_iterator(out_dir)){
+        if (e.path().extension() != ".jsonl") continue;
+        ++segments;
+        const std::string s = readall(e.path());
+        if (s.empty() || s.back() != '\n') return 7;
+        ticks += count(s, "\"ch\":\"/ictk/tick\"");
+        health += count(s, "\"ch\":\"/ictk/health\"");
+        for (std::size_t pos = s.find("\"t_ns\":"); pos != std::string::npos; pos = s.find("\"t_ns\":", pos + 1)){
+            const long long t = std::strtoll(s.c_str() + pos + 7, nullptr, 10);
+            const long long k = t / 1000000LL;
+            if (k < 0 || k >= kTicks || seen[static_cast<std::size_t>(k)]) return 8;
+            seen[static_cast<std::size_t>(k)] = true;
+        }
+    }
+    if (ticks != static_cast<std::size_t>(kTicks) || health != ticks) return 9;
+    if (segments < 2) return 10;
+
+    // Case 3: preallocated segments + windowed write-out -> the same bytes, the reserved blocks cut at close
+    detail::SegmentWriter::IoOptions io;
+    io.prealloc_bytes = 1u << 20;
+    io.writeback_bytes = 64u << 10;
+    if (const int rc = two_files(out_dir, io); rc) return 20 + rc;
+
+    // Case 4: O_DIRECT on top (buffered where the filesystem refuses it) -> the same bytes, no zero padded tail
+    io.direct = true;
+    if (const int rc = two_files(out_dir, io); rc) return 30 + rc;
+
+    fs::remove_all(out_dir);
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+
+#include "ictk/tools/recorder.hpp"
+#include "ictk/tools/columnar.hpp"
+#include "ts_codec.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk::tools;
+using namespace ictk::tools::columnar;
+
+static std::uintmax_t dir_bytes(const char* dir){
+    std::uintmax_t n = 0;
+    for (auto& e : fs::directory_iterator(dir)) n += e.file_size();
+    return n;
+}
+
+// // 1 kHz first order loop: r0 steps, y0 follows, u saturates now and then -> realistic evidence
+static TickSample sample(int i){
+    static double y = 0.0;
+    if (i == 0) y = 0.0;
+    TickSample s{};
+    s.t = 5'000'000'000LL + 1'000'000LL * i;
+    s.r0 = (i / 2000) % 2 ? 2.5 : 1.0;
+    s.u_pre0 = 4.0 * (s.r0 - y);
+    s.u_post0 = std::fmin(std::fmax(s.u_pre0, -3.0), 3.0);
+    y += 0.002 * (s.u_post0 - y);
+    s.y0 = y;
+    s.lat_ns = 2000 + (i * 37) % 400;
+    if (s.u_post0 != s.u_pre0){
+        s.h.saturation_pct = 100.0;
+        s.h.last_clamp_mag = std::fabs(s.u_pre0 - s.u_post0);
+        s.h.sat_hit_mask = 1;
+    }
+    return s;
+}
+
+int main(){
+    std::mt19937_64 rng(7);
+    std::vector<std::uint8_t> buf(1 << 20);
+
+    // Case 1: varint / zigzag extremes
+    for (std::uint64_t v : {0ull, 1ull, 127ull, 128ull, 0xffffffffffffffffull, 0x8000000000000000ull}){
+        std::uint64_t back = 0;
+        const std::uint8_t* e = tsc::put_varint(buf.data(), v);
+        if (tsc::get_varint(buf.data(), e, back) != e || back != v) return 1;
+        if (tsc::unzigzag(tsc::zigzag(v)) != v) return 1;
+    }
+    if (tsc::zigzag(static_cast<std::uint64_t>(-1LL)) != 1u || tsc::zigzag(1u) != 2u) return 1;
+
+    // Case 2: each codec, bit exact on hostile input (random bits, NaN payloads, -0, int64 wrap)
+    {
+        const std::size_t n = 5000;
+        std::vector<std::int64_t> iv(n), ib(n);
+        std::vector<double> dv(n), db(n);
+        std::vector<std::uint64_t> uv(n), ub(n);
+        for (std::size_t i = 0; i < n; ++i){
+            iv[i] = i % 3 ? static_cast<std::int64_t>(rng()) : static_cast<std::int64_t>(i);
+            dv[i] = i % 5 ? std::bit_cast<double>(rng()) : (i % 2 ? -0.0 : std::bit_cast<double>(0x7ff8dead0000beefull));
+            uv[i] = (i / 100) % 3 ? 0u : rng() >> (i % 64);
+        }
+        iv[1] = std::numeric_limits<std::int64_t>::min();
+        iv[2] = std::numeric_limits<std::int64_t>::max();
+
+        tsc::DeltaEncoder<2> d2(buf.data());
+        for (auto v : iv) d2.put(v);
+        if (!tsc::decode_delta<2>(buf.data(), d2.finish(), ib.data(), n) || ib != iv) return 2;
+
+        tsc::DeltaEncoder<1> d1(buf.data());
+        for (auto v : iv) d1.put(v);
+        if (!tsc::decode_delta<1>(buf.data(), d1.finish(), ib.data(), n) || ib != iv) return 3;
+
+        tsc::XorEncoder x(buf.data());
+        for (auto v : dv) x.put(v);
+        const std::uint8_t* xe = x.finish();
+        if (!tsc::decode_xor(buf.data(), xe, db.data(), n)) return 4;
+        if (std::memcmp(db.data(), dv.data(), n * sizeof(double)) != 0) return 4;
+        if (tsc::decode_xor(buf.data(), xe - 1, db.data(), n)) return 4;   // // truncated -> rejected
+
+        tsc::RleEncoder r(buf.data());
+        for (auto v : uv) r.put(v);
+        if (!tsc::decode_rle(buf.data(), r.finish(), ub.data(), n) || ub != uv) return 5;
+    }
+
+    // Case 3: whole block, stage stride != rows (short block) -> raw layout of `rows`
+    {
+        const std::size_t stride = 256, rows = 200;
+        std::vector<std::byte> stage(tick_payload_bytes(stride)), cols(tick_payload_bytes(rows));
+        for (std::size_t k = 0; k < stage.size(); ++k) stage[k] = static_cast<std::byte>(rng());
+        std::vector<std::uint8_t> enc(tsc::encoded_bound(stride));
+        const std::size_t used = tsc::encode_ticks(stage.data(), stride, rows, enc.data());
+        if (used > tsc::encoded_bound(rows)) return 6;
+        if (!tsc::decode_ticks(enc.data(), used, rows, cols.data())) return 6;
+        for (std::uint32_t c = 0; c < kTickCols; ++c){
+            const std::size_t w = c == kFlags ? 1u : 8u;
+            if (std::memcmp(cols.data() + col_offset(c, rows), stage.data() + col_offset(c, stride), rows * w) != 0) return 7;
+        }
+        enc[tsc::kDirBytes + 3] ^= 0xffu;   // // corrupt the t_ns stream
+        tsc::decode_ticks(enc.data(), used, rows, cols.data());   // // must not read out of bounds (sanitizer builds)
+    }
+
+    // Case 4: recorder end to end -> >= 10x smaller than JSONL, same values back through the reader
+    const int kTicks = 60000;
+    const char* dir_c = "evidence_ts_codec";
+    const char* dir_j = "evidence_ts_codec_jsonl";
+    fs::remove_all(dir_c);
+    fs::remove_all(dir_j);
+    for (int pass = 0; pass < 2; ++pass){
+        RecorderOptions opt;
+        opt.out_dir = pass ? dir_j : dir_c;
+        opt.backend = pass ? RecorderOptions::Jsonl : RecorderOptions::Columnar;
+        opt.compress = true;
+        opt.dt_ns_hint = 1'000'000;
+        auto rec = Recorder::open(opt);
+        if (!rec) return 8;
+        rec->write_buildinfo();
+        for (int i = 0; i < kTicks; ++i){
+            rec->write_tick(sample(i));
+            rec->rotate_if_needed();
+        }
+        rec->write_kpi({});
+        rec->flush();
+    }
+    const std::uintmax_t bc = dir_bytes(dir_c), bj = dir_bytes(dir_j);
+    if (bc * 10 > bj) return 9;
+
+    int i = 0;
+    TickScratch scratch;
+    for (auto& e : fs::directory_iterator(dir_c)){
+        auto r = Reader::open(e.path().string());
+        if (!r || !r->verify()) return 10;
+        for (std::size_t b = 0; b < r->index().size(); ++b){
+            if (r->index()[b].kind != static_cast<std::uint32_t>(BlockKind::kTicks)) continue;
+            if (r->encoding(b) != BlockEncoding::kTimeSeries || r->ticks(b).rows() != 0) return 11;
+            const TickBlock t = r->ticks(b, scratch);
+            if (t.rows() != r->index()[b].rows) return 12;
+            for (std::size_t j = 0; j < t.rows(); ++j, ++i){
+                const TickSample s = sample(i);
+                if (t.t_ns[j] != s.t || t.lat_ns[j] != s.lat_ns) return 13;
+                if (t.y0[j] != s.y0 || t.r0[j] != s.r0 || t.u_pre0[j] != s.u_pre0 || t.u_post0[j] != s.u_post0) return 13;
+                if (t.last_clamp_mag[j] != s.h.last_clamp_mag || t.sat_hit_mask[j] != s.h.sat_hit_mask) return 13;
+            }
+        }
+    }
+    if (i != kTicks) return 14;
+
+    fs::remove_all(dir_c);
+    fs::remove_all(dir_j);
+    return 0;
+}
@@ -0,0 +1,180 @@
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+#include "ictk/tools/recorder.hpp"
+#include "ictk/tools/columnar.hpp"
+#include "ictk/tools/async_recorder.hpp"
+
+namespace fs = std::filesystem;
+using namespace ictk::tools;
+using ictk::Scalar;
+
+// // 16 axis machine: ny = nu = 16, 4 observer states
+constexpr std::size_t kNy = 16, kNu = 16, kNx = 4;
+
+static double val(int i, std::size_t field, std::size_t ch){
+    return 0.5 * i + 100.0 * static_cast<double>(field) + 0.001 * static_cast<double>(ch);
+}
+
+// // all channels of tick i; every 5th tick has no observer (xhat empty -> recorded as 0)
+struct Channels{
+    Scalar y[kNy], r[kNy], u_pre[kNu], u_post[kNu], xhat[kNx];
+
+    TickVector view(int i) const{
+        TickVector v{};
+        v.t = 1'000'000LL * i;
+        v.y = y;
+        v.r = r;
+        v.u_pre = u_pre;
+        v.u_post = u_post;
+        if (i % 5) v.xhat = xhat;
+        v.h.rate_limit_hits = static_cast<std::uint64_t>(i);
+        v.lat_ns = 1000 + i;
+        return v;
+    }
+};
+
+static Channels make(int i){
+    Channels c{};
+    for (std::size_t k = 0; k < kNy; ++k){
+        c.y[k] = static_cast<Scalar>(val(i, 0, k));
+        c.r[k] = static_cast<Scalar>(val(i, 1, k));
+    }
+    for (std::size_t k = 0; k < kNu; ++k){
+        c.u_pre[k] = static_cast<Scalar>(val(i, 2, k));
+        c.u_post[k] = static_cast<Scalar>(val(i, 3, k));
+    }
+    for (std::size_t k = 0; k < kNx; ++k) c.xhat[k] = static_cast<Scalar>(val(i, 4, k));
+    return c;
+}
+
+static RecorderOptions options(const char* dir, RecorderOptions::Backend b, bool compress){
+    RecorderOptions opt;
+    opt.backend = b;
+    opt.out_dir = dir;
+    opt.dt_ns_hint = 1'000'000;
+    opt.block_rows = 64;
+    opt.compress = compress;
+    opt.dims = ictk::Dims{kNy, kNu, kNx};
+    return opt;
+}
+
+// // every channel of every tick back through the reader; ticks i % 7 == 3 were scalar writes (channel 0 only)
+static int check_columnar(const char* dir, int n_ticks){
+    int seen = 0;
+    columnar::TickScratch scratch;
+    for (auto& e : fs::directory_iterator(dir)){
+        auto r = columnar::Reader::open(e.path().string());
+        if (!r || !r->verify()) return 1;
+        if (r->header().ny != kNy || r->header().nu != kNu || r->header().nx != kNx) return 2;
+        for (std::size_t b = 0; b < r->index().size(); ++b){
+            if (r->index()[b].kind != static_cast<std::uint32_t>(columnar::BlockKind::kTicks)) continue;
+            const columnar::TickBlock t = r->ticks(b, scratch);
+            if (t.rows() != r->index()[b].rows || t.vec.size() != t.rows() * (2 * kNy + 2 * kNu + kNx)) return 3;
+            for (std::size_t j = 0; j < t.rows(); ++j, ++seen){
+                const int i = static_cast<int>(t.t_ns[j] / 1'000'000LL);
+                const bool scalar = i % 7 == 3;
+                if (i != seen || t.lat_ns[j] != 1000 + i || t.rate_limit_hits[j] != static_cast<std::uint64_t>(i)) return 4;
+                if (t.y0[j] != val(i, 0, 0) || t.u_post0[j] != val(i, 3, 0)) return 4;
+                for (std::uint32_t k = 0; k < kNy; ++k){
+                    const bool on = !scalar || k == 0;
+                    if (t.y(k)[j] != (on ? val(i, 0, k) : 0.0) || t.r(k)[j] != (on ? val(i, 1, k) : 0.0)) return 5;
+                }
+                for (std::uint32_t k = 0; k < kNu; ++k){
+                    const bool on = !scalar || k == 0;
+                    if (t.u_pre(k)[j] != (on ? val(i, 2, k) : 0.0) || t.u_post(k)[j] != (on ? val(i, 3, k) : 0.0)) return 6;
+                }
+                for (std::uint32_t k = 0; k < kNx; ++k){
+                    const bool on = !scalar && i % 5 != 0;
+                    if (t.xhat(k)[j] != (on ? val(i, 4, k) : 0.0)) return 7;
+                }
+            }
+        }
+    }
+    return seen == n_ticks ? 0 : 8;
+}
+
+static int write_direct(const char* dir, RecorderOptions::Backend b, bool compress, int n_ticks){
+    fs::remove_all(dir);
+    auto rec = Recorder::open(options(dir, b, compress));
+    if (!rec) return 1;
+    rec->write_buildinfo();
+    for (int i = 0; i < n_ticks; ++i){
+        const Channels c = make(i);
+        const TickVector v = c.view(i);
+        if (i % 7 == 3) rec->write_tick(channel0(v));
+        else rec->write_tick_vec(v);
+        rec->rotate_if_needed();
+    }
+    rec->write_kpi({});
+    rec->flush();
+    return 0;
+}
+
+int main(){
+    const int kTicks = 1000;   // // not a multiple of block_rows -> short last block
+
+    // Case 1: columnar raw + compressed, every channel bit exact
+    if (write_direct("evidence_vec_raw", RecorderOptions::Columnar, false, kTicks)) return 10;
+    if (int rc = check_columnar("evidence_vec_raw", kTicks)) return 10 + rc;
+    if (write_direct("evidence_vec_ts", RecorderOptions::Columnar, true, kTicks)) return 20;
+    if (int rc = check_columnar("evidence_vec_ts", kTicks)) return 20 + rc;
+
+    // Case 2: JSONL -> packed arrays in the tick body, dims wide
+    if (write_direct("evidence_vec_jsonl", RecorderOptions::Jsonl, false, kTicks)) return 30;
+    {
+        int ticks = 0;
+        for (auto& e : fs::directory_iterator("evidence_vec_jsonl")){
+            std::ifstream in(e.path());
+            std::string line;
+            while (std::getline(in, line)){
+                if (line.find("\"/ictk/tick\"") == std::string::npos) continue;
+                const std::size_t y = line.find("\"y\":[");
+                const std::size_t x = line.find("\"xhat\":[");
+                if (y == std::string::npos || x == std::string::npos || line.find("\"u_post\":[") == std::string::npos) return 31;
+                const std::string arr = line.substr(y + 5, line.find(']', y) - y - 5);
+                std::size_t commas = 0;
+                for (char ch : arr) commas += ch == ',';
+                if (commas != kNy - 1) return 32;
+                double first = 0.0;
+                std::istringstream(arr) >> first;
+                if (first != val(ticks, 0, 0)) return 33;
+                ++ticks;
+            }
+        }
+        if (ticks != kTicks) return 34;
+    }
+
+    // Case 3: AsyncRecorder -> spans copied into the ring slot, written through write_tick_vec on the writer thread
+    {
+        const char* dir = "evidence_vec_async";
+        fs::remove_all(dir);
+        AsyncRecorderOptions ao;
+        ao.rec = options(dir, RecorderOptions::Columnar, true);
+        ao.capacity = 2048;
+        auto rec = AsyncRecorder::open(ao);
+        if (!rec) return 40;
+        for (int i = 0; i < kTicks; ++i){
+            const Channels c = make(i);
+            const TickVector v = c.view(i);
+            const bool ok = i % 7 == 3 ? rec->enqueue(channel0(v)) : rec->enqueue(v);
+            if (!ok) return 41;
+        }
+        rec->write_kpi({});
+        rec->flush();
+        if (rec->written() != static_cast<std::uint64_t>(kTicks)) return 42;
+        rec.reset();
+        if (int rc = check_columnar(dir, kTicks)) return 40 + rc;
+    }
+
+    fs::remove_all("evidence_vec_raw");
+    fs::remove_all("evidence_vec_ts");
+    fs::remove_all("evidence_vec_jsonl");
+    fs::remove_all("evidence_vec_async");
+    return 0;
+}